@@ -62,6 +62,10 @@ public class ClothDesign : ModuleRules
 				"MeshConversion",
 				"GeometryScriptingEditor",
 				"GeometryScriptingCore", 
+				"AnimationCore",
+				"DerivedDataCache",
+				"DesktopPlatform",
+				"ImageCore",
 			}
 			);
 		
@@ -0,0 +1,521 @@
+#include "Canvas/CanvasBackgroundTiles.h"
+#include "Engine/Texture2D.h"
+#include "Brushes/SlateDynamicImageBrush.h"
+#include "Rendering/DrawElements.h"
+#include "Async/ParallelFor.h"
+#include "Containers/Ticker.h"
+
+
+namespace
+{
+	constexpr int32 MaxPendingTiles = 16;     // tile copies in flight at once
+	constexpr int32 MaxUploadsPerTick = 8;    // tile textures created per tick, to keep ticks short
+
+	// shared by all canvases, since Slate resource names are global
+	uint32 NextTileGeneration = 0;
+
+
+	/** @brief Full-resolution level 0 in a format the pyramid works on. */
+	bool MakeBaseLevel(FImage&& Source, FImage& OutBase)
+	{
+		if (Source.SizeX <= 0 || Source.SizeY <= 0)
+		{
+			return false;
+		}
+
+		if (Source.Format == ERawImageFormat::G8 || Source.Format == ERawImageFormat::BGRA8)
+		{
+			OutBase = MoveTemp(Source);
+		}
+		else
+		{
+			// 16-bit and float sources; 8 bits are plenty for a tracing reference
+			Source.CopyTo(OutBase, ERawImageFormat::BGRA8, EGammaSpace::sRGB);
+		}
+		return true;
+	}
+}
+
+
+FCanvasBackgroundTiles::~FCanvasBackgroundTiles()
+{
+	Reset();
+}
+
+
+void FCanvasBackgroundTiles::SetTexture(UTexture2D* InTexture)
+{
+	if (InTexture == Texture.Get() && (InTexture != nullptr || TextureBrush.GetResourceObject() == nullptr))
+	{
+		return;
+	}
+
+	Reset();
+	if (!InTexture)
+	{
+		return;
+	}
+
+	Texture = InTexture;
+	Generation = ++NextTileGeneration;
+
+	TextureBrush.SetResourceObject(InTexture);
+	TextureBrush.ImageSize = FVector2D(InTexture->GetSizeX(), InTexture->GetSizeY());
+
+#if WITH_EDITORONLY_DATA
+	// small images gain nothing from tiling
+	const FTextureSource& Source = InTexture->Source;
+	if (!Source.IsValid() || FMath::Max(Source.GetSizeX(), Source.GetSizeY()) <= TileSize)
+	{
+		return;
+	}
+
+	// decompressing a large source takes a while; the strong pointer keeps it loaded meanwhile
+	LoadingTexture.Reset(InTexture);
+	PyramidCancel = MakeShared<std::atomic<bool>, ESPMode::ThreadSafe>(false);
+	PendingPyramid = UE::Tasks::Launch(UE_SOURCE_LOCATION, [InTexture, Cancel = PyramidCancel]() -> FPyramidPtr
+	{
+		FImage SourceImage;
+		FImage Base;
+		if (!InTexture->Source.GetMipImage(SourceImage, 0, 0, 0) ||
+			Cancel->load(std::memory_order_relaxed) ||
+			!MakeBaseLevel(MoveTemp(SourceImage), Base))
+		{
+			return nullptr;
+		}
+
+		FPyramidPtr Built = MakeShared<FPyramid, ESPMode::ThreadSafe>();
+		Built->SourceSize = FIntPoint(Base.SizeX, Base.SizeY);
+		Built->BytesPerPixel = Base.Format == ERawImageFormat::G8 ? 1 : 4;
+		Built->Bytes = Base.RawData.Num();
+
+		const int32 NumLevels = GetNumLevels(Built->SourceSize);
+		Built->Levels.Reserve(NumLevels);
+		Built->Levels.Add(MakeShared<FImage, ESPMode::ThreadSafe>(MoveTemp(Base)));
+		for (int32 Level = 1; Level < NumLevels; ++Level)
+		{
+			if (Cancel->load(std::memory_order_relaxed))
+			{
+				return nullptr;
+			}
+			TSharedRef<FImage, ESPMode::ThreadSafe> Next = MakeShared<FImage, ESPMode::ThreadSafe>();
+			DownsampleLevel(*Built->Levels[Level - 1], *Next);
+			Built->Bytes += Next->RawData.Num();
+			Built->Levels.Add(Next);
+		}
+		return Built;
+	});
+#endif
+}
+
+
+void FCanvasBackgroundTiles::Reset()
+{
+	if (PendingPyramid.IsValid())
+	{
+		// the build stops at its next check; until it has, a ticker keeps its texture loaded
+		PyramidCancel->store(true, std::memory_order_relaxed);
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+			[Build = PendingPyramid, KeepLoaded = LoadingTexture](float)
+			{
+				return !Build.IsCompleted();
+			}));
+		PendingPyramid = UE::Tasks::TTask<FPyramidPtr>();
+	}
+	PyramidCancel.Reset();
+	LoadingTexture.Reset();
+
+	// running tile copies hold their own reference to their level; their results are dropped
+	PendingTiles.Empty();
+	Tiles.Empty();
+	CachedBytes = 0;
+	Pyramid.Reset();
+
+	Texture.Reset();
+	TextureBrush = FSlateBrush();
+	++Version;
+}
+
+
+void FCanvasBackgroundTiles::Tick(int64 BudgetBytes)
+{
+	if (PendingPyramid.IsValid() && PendingPyramid.IsCompleted())
+	{
+		Pyramid = PendingPyramid.GetResult();
+		PendingPyramid = UE::Tasks::TTask<FPyramidPtr>();
+		PyramidCancel.Reset();
+		LoadingTexture.Reset();
+
+		if (!Pyramid.IsValid() && Texture.IsValid())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Could not read the source image of %s; drawing it untiled."), *Texture->GetName());
+		}
+		++Version;
+	}
+
+	int32 NumUploads = 0;
+	for (auto It = PendingTiles.CreateIterator(); It && NumUploads < MaxUploadsPerTick; ++It)
+	{
+		if (!It->Value.IsCompleted())
+		{
+			continue;
+		}
+
+		const FCanvasBackgroundTileKey& Key = It->Key;
+		const FTilePixels& Pixels = It->Value.GetResult();
+		const FName ResourceName(*FString::Printf(TEXT("ClothDesignBackgroundTile_%u_%d_%d_%d"), Generation, Key.Level, Key.X, Key.Y));
+
+		FCachedTile& Tile = Tiles.Add(Key);
+		Tile.Brush = FSlateDynamicImageBrush::CreateWithImageData(ResourceName, FVector2D(Pixels.Size), Pixels.Bytes);
+		Tile.Bytes = Tile.Brush.IsValid() ? Pixels.Bytes.Num() : 0;
+		Tile.LastDrawn = DrawSerial;
+		CachedBytes += Tile.Bytes;
+
+		It.RemoveCurrent();
+		++NumUploads;
+	}
+
+	if (NumUploads > 0)
+	{
+		++Version;
+	}
+
+	TrimPyramid(BudgetBytes);
+	Evict(FMath::Max<int64>(0, BudgetBytes - GetPyramidBytes()));
+}
+
+
+void FCanvasBackgroundTiles::TrimPyramid(int64 BudgetBytes)
+{
+	if (!Pyramid.IsValid())
+	{
+		return;
+	}
+
+	const int32 FirstLevel = GetFinestLevelInBudget(Pyramid->SourceSize, Pyramid->BytesPerPixel, BudgetBytes);
+	if (FirstLevel <= Pyramid->FirstLevel)
+	{
+		return;
+	}
+
+	// running tile copies keep their own level alive; uploaded tiles of dropped levels age out in Evict
+	for (int32 Level = Pyramid->FirstLevel; Level < FirstLevel; ++Level)
+	{
+		Pyramid->Bytes -= Pyramid->Levels[Level]->RawData.Num();
+		Pyramid->Levels[Level].Reset();
+	}
+	Pyramid->FirstLevel = FirstLevel;
+
+	UE_LOG(LogTemp, Log, TEXT("Background image pyramid is over the tile budget; drawing from level %d (%d x %d)."),
+		FirstLevel, GetLevelSize(Pyramid->SourceSize, FirstLevel).X, GetLevelSize(Pyramid->SourceSize, FirstLevel).Y);
+	++Version;
+}
+
+
+void FCanvasBackgroundTiles::Evict(int64 BudgetBytes)
+{
+	if (CachedBytes <= BudgetBytes)
+	{
+		return;
+	}
+
+	// tiles the last paint used may still be referenced by cached draw elements
+	TArray<TPair<uint32, FCanvasBackgroundTileKey>> Candidates;
+	for (const TPair<FCanvasBackgroundTileKey, FCachedTile>& Pair : Tiles)
+	{
+		if (Pair.Value.LastDrawn != DrawSerial)
+		{
+			Candidates.Emplace(Pair.Value.LastDrawn, Pair.Key);
+		}
+	}
+	Candidates.Sort([](const TPair<uint32, FCanvasBackgroundTileKey>& A, const TPair<uint32, FCanvasBackgroundTileKey>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	for (const TPair<uint32, FCanvasBackgroundTileKey>& Candidate : Candidates)
+	{
+		if (CachedBytes <= BudgetBytes)
+		{
+			break;
+		}
+		FCachedTile Removed;
+		Tiles.RemoveAndCopyValue(Candidate.Value, Removed);
+		CachedBytes -= Removed.Bytes;
+	}
+}
+
+
+int32 FCanvasBackgroundTiles::Draw(
+	const FGeometry& Geo,
+	FSlateWindowElementList& OutDraw,
+	int32 Layer,
+	const FBox2D& ScreenRect,
+	const FLinearColor& Tint)
+{
+	++DrawSerial;
+
+	const FVector2D ScreenSize = ScreenRect.GetSize();
+	if (ScreenSize.X <= 0.0 || ScreenSize.Y <= 0.0)
+	{
+		return Layer;
+	}
+
+	if (!Pyramid.IsValid())
+	{
+		if (!TextureBrush.GetResourceObject())
+		{
+			return Layer;
+		}
+
+		FSlateDrawElement::MakeBox(
+			OutDraw,
+			Layer,
+			Geo.ToPaintGeometry(FVector2f(ScreenSize), FSlateLayoutTransform(FVector2f(ScreenRect.Min))),
+			&TextureBrush,
+			ESlateDrawEffect::None,
+			Tint);
+		return Layer + 1;
+	}
+
+	const FIntPoint SourceSize = Pyramid->SourceSize;
+	const int32 NumLevels = Pyramid->Levels.Num();
+	const double ScreenPixelsPerTexel = FMath::Min(ScreenSize.X / SourceSize.X, ScreenSize.Y / SourceSize.Y);
+
+	// the coarsest level is one tile covering everything; finer tiles draw over it as they arrive
+	const FCanvasBackgroundTileKey BaseKey{ NumLevels - 1, 0, 0 };
+	DrawTile(BaseKey, Geo, OutDraw, Layer, ScreenRect, Tint);
+
+	const int32 Level = FMath::Max(SelectLevel(ScreenPixelsPerTexel, NumLevels), Pyramid->FirstLevel);
+	if (Level != BaseKey.Level)
+	{
+		const FVector2D TexelsPerScreenPixel = FVector2D(SourceSize) / ScreenSize;
+		const FBox2D VisibleRect(
+			(FVector2D::ZeroVector - ScreenRect.Min) * TexelsPerScreenPixel,
+			(FVector2D(Geo.GetLocalSize()) - ScreenRect.Min) * TexelsPerScreenPixel);
+
+		const FIntRect Range = GetVisibleTiles(SourceSize, Level, VisibleRect);
+		for (int32 Y = Range.Min.Y; Y < Range.Max.Y; ++Y)
+		{
+			for (int32 X = Range.Min.X; X < Range.Max.X; ++X)
+			{
+				DrawTile({ Level, X, Y }, Geo, OutDraw, Layer + 1, ScreenRect, Tint);
+			}
+		}
+	}
+
+	return Layer + 2;
+}
+
+
+void FCanvasBackgroundTiles::DrawTile(
+	const FCanvasBackgroundTileKey& Key,
+	const FGeometry& Geo,
+	FSlateWindowElementList& OutDraw,
+	int32 Layer,
+	const FBox2D& ScreenRect,
+	const FLinearColor& Tint)
+{
+	if (FCachedTile* Tile = Tiles.Find(Key))
+	{
+		Tile->LastDrawn = DrawSerial;
+		if (!Tile->Brush.IsValid())
+		{
+			return;
+		}
+
+		const FIntPoint SourceSize = Pyramid->SourceSize;
+		const FVector2D ScreenPerTexel = ScreenRect.GetSize() / FVector2D(SourceSize);
+		const FBox2D SourceRect = GetTileSourceRect(SourceSize, Key);
+		const FVector2D TopLeft = ScreenRect.Min + SourceRect.Min * ScreenPerTexel;
+		const FVector2D Size = SourceRect.GetSize() * ScreenPerTexel;
+
+		FSlateDrawElement::MakeBox(
+			OutDraw,
+			Layer,
+			Geo.ToPaintGeometry(FVector2f(Size), FSlateLayoutTransform(FVector2f(TopLeft))),
+			Tile->Brush.Get(),
+			ESlateDrawEffect::None,
+			Tint);
+		return;
+	}
+
+	if (PendingTiles.Contains(Key) || PendingTiles.Num() >= MaxPendingTiles)
+	{
+		// the next upload changes the version, which repaints and asks again
+		return;
+	}
+
+	PendingTiles.Add(Key, UE::Tasks::Launch(UE_SOURCE_LOCATION, [LevelImage = Pyramid->Levels[Key.Level], Key]()
+	{
+		return CopyTile(*LevelImage, Key.X, Key.Y);
+	}));
+}
+
+
+int32 FCanvasBackgroundTiles::GetNumLevels(const FIntPoint& SourceSize)
+{
+	int32 NumLevels = 1;
+	while (true)
+	{
+		const FIntPoint Size = GetLevelSize(SourceSize, NumLevels - 1);
+		if (FMath::Max(Size.X, Size.Y) <= TileSize)
+		{
+			return NumLevels;
+		}
+		++NumLevels;
+	}
+}
+
+
+FIntPoint FCanvasBackgroundTiles::GetLevelSize(const FIntPoint& SourceSize, int32 Level)
+{
+	const int32 Divisor = 1 << Level;
+	return FIntPoint(
+		FMath::Max(1, FMath::DivideAndRoundUp(SourceSize.X, Divisor)),
+		FMath::Max(1, FMath::DivideAndRoundUp(SourceSize.Y, Divisor)));
+}
+
+
+int32 FCanvasBackgroundTiles::SelectLevel(double ScreenPixelsPerTexel, int32 NumLevels)
+{
+	if (ScreenPixelsPerTexel >= 1.0 || NumLevels <= 1)
+	{
+		return 0;
+	}
+	if (ScreenPixelsPerTexel <= 0.0)
+	{
+		return NumLevels - 1;
+	}
+	return FMath::Clamp(FMath::FloorToInt32(FMath::Log2(1.0 / ScreenPixelsPerTexel)), 0, NumLevels - 1);
+}
+
+
+int32 FCanvasBackgroundTiles::GetFinestLevelInBudget(const FIntPoint& SourceSize, int32 BytesPerPixel, int64 BudgetBytes)
+{
+	const int32 NumLevels = GetNumLevels(SourceSize);
+
+	// accumulate from the coarsest level up until the next finer one no longer fits
+	int64 Bytes = 0;
+	for (int32 Level = NumLevels - 1; Level >= 0; --Level)
+	{
+		const FIntPoint Size = GetLevelSize(SourceSize, Level);
+		Bytes += static_cast<int64>(Size.X) * Size.Y * BytesPerPixel;
+		if (Bytes > BudgetBytes)
+		{
+			return FMath::Min(Level + 1, NumLevels - 1);
+		}
+	}
+	return 0;
+}
+
+
+FIntRect FCanvasBackgroundTiles::GetVisibleTiles(const FIntPoint& SourceSize, int32 Level, const FBox2D& VisibleRect)
+{
+	const FIntPoint LevelSize = GetLevelSize(SourceSize, Level);
+	const FIntPoint NumTiles(FMath::DivideAndRoundUp(LevelSize.X, TileSize), FMath::DivideAndRoundUp(LevelSize.Y, TileSize));
+
+	// one tile of this level spans this many full resolution texels
+	const double TileTexels = static_cast<double>(TileSize) * (1 << Level);
+
+	FIntRect Range;
+	Range.Min.X = FMath::Max(0, FMath::FloorToInt32(VisibleRect.Min.X / TileTexels));
+	Range.Min.Y = FMath::Max(0, FMath::FloorToInt32(VisibleRect.Min.Y / TileTexels));
+	Range.Max.X = FMath::Min(NumTiles.X, FMath::CeilToInt32(VisibleRect.Max.X / TileTexels));
+	Range.Max.Y = FMath::Min(NumTiles.Y, FMath::CeilToInt32(VisibleRect.Max.Y / TileTexels));
+
+	if (Range.Max.X <= Range.Min.X || Range.Max.Y <= Range.Min.Y)
+	{
+		return FIntRect();
+	}
+	return Range;
+}
+
+
+FBox2D FCanvasBackgroundTiles::GetTileSourceRect(const FIntPoint& SourceSize, const FCanvasBackgroundTileKey& Key)
+{
+	const FIntPoint LevelSize = GetLevelSize(SourceSize, Key.Level);
+	const FIntPoint First(Key.X * TileSize, Key.Y * TileSize);
+	const FIntPoint Last(FMath::Min(First.X + TileSize, LevelSize.X), FMath::Min(First.Y + TileSize, LevelSize.Y));
+
+	// the last texel of an odd-sized level covers less than its full share of the source
+	const double Texels = static_cast<double>(1 << Key.Level);
+	return FBox2D(
+		FVector2D(First) * Texels,
+		FVector2D(FMath::Min(Last.X * Texels, static_cast<double>(SourceSize.X)), FMath::Min(Last.Y * Texels, static_cast<double>(SourceSize.Y))));
+}
+
+
+void FCanvasBackgroundTiles::DownsampleLevel(const FImage& Src, FImage& OutDest)
+{
+	check(Src.Format == ERawImageFormat::G8 || Src.Format == ERawImageFormat::BGRA8);
+
+	const int32 BytesPerPixel = Src.Format == ERawImageFormat::G8 ? 1 : 4;
+	const int32 DestX = FMath::Max(1, FMath::DivideAndRoundUp(Src.SizeX, 2));
+	const int32 DestY = FMath::Max(1, FMath::DivideAndRoundUp(Src.SizeY, 2));
+	OutDest.Init(DestX, DestY, Src.Format, Src.GammaSpace);
+
+	const uint8* SrcData = Src.RawData.GetData();
+	uint8* DestData = OutDest.RawData.GetData();
+	const int64 SrcStride = static_cast<int64>(Src.SizeX) * BytesPerPixel;
+	const int64 DestStride = static_cast<int64>(DestX) * BytesPerPixel;
+
+	ParallelFor(DestY, [&](int32 Y)
+	{
+		const uint8* Row0 = SrcData + (2 * Y) * SrcStride;
+		const uint8* Row1 = SrcData + FMath::Min(2 * Y + 1, Src.SizeY - 1) * SrcStride;
+		uint8* Dest = DestData + Y * DestStride;
+
+		for (int32 X = 0; X < DestX; ++X)
+		{
+			const int64 X0 = static_cast<int64>(2 * X) * BytesPerPixel;
+			const int64 X1 = static_cast<int64>(FMath::Min(2 * X + 1, Src.SizeX - 1)) * BytesPerPixel;
+			for (int32 C = 0; C < BytesPerPixel; ++C)
+			{
+				const uint32 Sum = Row0[X0 + C] + Row0[X1 + C] + Row1[X0 + C] + Row1[X1 + C];
+				Dest[X * BytesPerPixel + C] = static_cast<uint8>((Sum + 2) / 4);
+			}
+		}
+	});
+}
+
+
+FCanvasBackgroundTiles::FTilePixels FCanvasBackgroundTiles::CopyTile(const FImage& LevelImage, int32 TileX, int32 TileY)
+{
+	check(LevelImage.Format == ERawImageFormat::G8 || LevelImage.Format == ERawImageFormat::BGRA8);
+
+	FTilePixels Pixels;
+	const int32 FirstX = TileX * TileSize;
+	const int32 FirstY = TileY * TileSize;
+	Pixels.Size.X = FMath::Clamp(LevelImage.SizeX - FirstX, 0, TileSize);
+	Pixels.Size.Y = FMath::Clamp(LevelImage.SizeY - FirstY, 0, TileSize);
+	if (Pixels.Size.X == 0 || Pixels.Size.Y == 0)
+	{
+		Pixels.Size = FIntPoint::ZeroValue;
+		return Pixels;
+	}
+
+	Pixels.Bytes.SetNumUninitialized(Pixels.Size.X * Pixels.Size.Y * 4);
+	const bool bGrey = LevelImage.Format == ERawImageFormat::G8;
+	const int32 BytesPerPixel = bGrey ? 1 : 4;
+
+	for (int32 Y = 0; Y < Pixels.Size.Y; ++Y)
+	{
+		const uint8* Src = LevelImage.RawData.GetData() + ((static_cast<int64>(FirstY + Y) * LevelImage.SizeX) + FirstX) * BytesPerPixel;
+		uint8* Dest = Pixels.Bytes.GetData() + Y * Pixels.Size.X * 4;
+
+		if (!bGrey)
+		{
+			FMemory::Memcpy(Dest, Src, Pixels.Size.X * 4);
+			continue;
+		}
+		for (int32 X = 0; X < Pixels.Size.X; ++X)
+		{
+			Dest[X * 4 + 0] = Src[X];
+			Dest[X * 4 + 1] = Src[X];
+			Dest[X * 4 + 2] = Src[X];
+			Dest[X * 4 + 3] = 255;
+		}
+	}
+	return Pixels;
+}
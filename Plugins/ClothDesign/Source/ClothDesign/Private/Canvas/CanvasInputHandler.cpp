@@ -7,6 +7,7 @@
 #include "ClothDesignCanvas.h"
 #include "Canvas/CanvasUtils.h"
 #include "PatternCreation/PatternSewing.h"
+#include "Canvas/CanvasSpatialIndex.h"
 
 
 
@@ -27,7 +28,7 @@ FReply FCanvasInputHandler::HandleDraw(const FGeometry& Geo, const FPointerEvent
 	FVector2D LocalClick  = Geo.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition());
 	FVector2D CanvasClickPos = Canvas->InverseTransformPoint(LocalClick);
 
-	FCanvasUtils::SaveStateForUndo(Canvas->UndoStack, Canvas->RedoStack, Canvas->GetCurrentCanvasState());
+	Canvas->SaveStateForUndo(ECanvasUndoScope::CurrentCurve);
 
 	// add a point
 	FInterpCurve<FVector2D>& CurvePoints = Canvas->CurvePoints;
@@ -107,21 +108,13 @@ FReply FCanvasInputHandler::HandleSew(const FVector2D& CanvasClickPos)
         }
     }
 
-    // Then each completed shape
-    for (int32 s = 0; s < CompletedShapes.Num(); ++s)
+    // Then each completed shape, through the hit index
+    Canvas->HitIndex.Sync(CompletedShapes, Canvas->CompletedBezierFlags, Canvas->GetSewingManager().SeamDefinitions, Canvas->CompletedShapeTransforms);
+    FCanvasHitItem Hit;
+    if (Canvas->HitIndex.FindNearest(CanvasClickPos, { ECanvasHitType::Point }, BestDistSq, Hit))
     {
-        for (int32 i = 0; i < CompletedShapes[s].Points.Num(); ++i)
-        {
-            FVector2D Pt = CompletedShapes[s].Points[i].OutVal;
-            float D2 = FVector2D::DistSquared(Pt, CanvasClickPos);
-	        
-            if (D2 < BestDistSq)
-            {
-                BestDistSq = D2;
-                BestShape  = s;
-                BestPoint  = i;
-            }
-        }
+        BestShape = Hit.Index;
+        BestPoint = Hit.SubIndex;
     }
 	
     if (BestPoint == INDEX_NONE)
@@ -184,7 +177,7 @@ FReply FCanvasInputHandler::HandleSew(const FVector2D& CanvasClickPos)
     switch (SeamClickState)
     {
     case ESeamClickState::None:
-    	FCanvasUtils::SaveStateForUndo(Canvas->UndoStack, Canvas->RedoStack, Canvas->GetCurrentCanvasState());
+    	Canvas->SaveStateForUndo(ECanvasUndoScope::Seams);
     	AStartTarget = { BestShape, BestPoint };
     	SeamClickState = ESeamClickState::ClickedAStart;
     	Canvas->GetSewingManager().AddPreviewPoint(BestShape, BestPoint);
@@ -200,7 +193,7 @@ FReply FCanvasInputHandler::HandleSew(const FVector2D& CanvasClickPos)
     		UE_LOG(LogTemp, Warning, TEXT("Sew: AEnd rejected because it is on a different shape (%d) than AStart (%d)"), BestShape, AStartTarget.ShapeIndex);
     		return FReply::Handled(); // do not advance state or add preview point
     	}
-    	FCanvasUtils::SaveStateForUndo(Canvas->UndoStack, Canvas->RedoStack, Canvas->GetCurrentCanvasState());
+    	Canvas->SaveStateForUndo(ECanvasUndoScope::Seams);
 
     	AEndTarget = { BestShape, BestPoint };
     	SeamClickState = ESeamClickState::ClickedAEnd;
@@ -210,7 +203,7 @@ FReply FCanvasInputHandler::HandleSew(const FVector2D& CanvasClickPos)
     	break;
     	
     case ESeamClickState::ClickedAEnd:
-    	FCanvasUtils::SaveStateForUndo(Canvas->UndoStack, Canvas->RedoStack, Canvas->GetCurrentCanvasState());
+    	Canvas->SaveStateForUndo(ECanvasUndoScope::Seams);
 
     	BStartTarget = { BestShape, BestPoint };
     	SeamClickState = ESeamClickState::ClickedBStart;
@@ -228,7 +221,7 @@ FReply FCanvasInputHandler::HandleSew(const FVector2D& CanvasClickPos)
     		UE_LOG(LogTemp, Warning, TEXT("Sew: BEnd rejected because it is on a different shape (%d) than BStart (%d)"), BestShape, BStartTarget.ShapeIndex);
     		return FReply::Handled(); // do not advance state or add preview point
     	}
-    	FCanvasUtils::SaveStateForUndo(Canvas->UndoStack, Canvas->RedoStack, Canvas->GetCurrentCanvasState());
+    	Canvas->SaveStateForUndo(ECanvasUndoScope::Seams);
 
     	BEndTarget = { BestShape, BestPoint };
 
@@ -281,22 +274,19 @@ FReply FCanvasInputHandler::HandleSelect(const FVector2D& CanvasClickPos)
 	
 	// Selecting whole points on completed shapes
 	constexpr float SelectionRadius = 10.f;
-	for (int32 ShapeIndex = 0; ShapeIndex < CompletedShapes.Num(); ++ShapeIndex)
+	const TArray<FSeamDefinition>& Seams = Canvas->GetSewingManager().SeamDefinitions;
+	Canvas->HitIndex.Sync(CompletedShapes, BezierFlags, Seams, Canvas->CompletedShapeTransforms);
+
+	FCanvasHitItem Hit;
+	float PointDistSq = FMath::Square(SelectionRadius / ZoomFactor);
+	if (Canvas->HitIndex.FindNearest(CanvasClickPos, { ECanvasHitType::Point }, PointDistSq, Hit))
 	{
-		const FInterpCurve<FVector2D>& Shape = CompletedShapes[ShapeIndex];
-		for (int32 i = 0; i < Shape.Points.Num(); ++i)
-		{
-			FVector2D WorldPoint = Shape.Points[i].OutVal;
-			if (FVector2D::Distance(WorldPoint, CanvasClickPos) < SelectionRadius / ZoomFactor)
-			{
-				FCanvasUtils::SaveStateForUndo(Canvas->UndoStack, Canvas->RedoStack, Canvas->GetCurrentCanvasState());
-				Canvas->SelectedShapeIndex = ShapeIndex;
-				Canvas->SelectedPointIndex = i;
-				Canvas->bIsShapeSelected   = true;
-				Canvas->bIsDraggingPoint   = true;
-				return FReply::Handled();
-			}
-		}
+		Canvas->SaveStateForUndo(ECanvasUndoScope::Shape, Hit.Index);
+		Canvas->SelectedShapeIndex = Hit.Index;
+		Canvas->SelectedPointIndex = Hit.SubIndex;
+		Canvas->bIsShapeSelected   = true;
+		Canvas->bIsDraggingPoint   = true;
+		return FReply::Handled();
 	}
 
 	//  Selecting points in the in-progress curve
@@ -305,7 +295,7 @@ FReply FCanvasInputHandler::HandleSelect(const FVector2D& CanvasClickPos)
 		FVector2D WorldPoint = CurvePoints.Points[i].OutVal;
 		if (FVector2D::Distance(WorldPoint, CanvasClickPos) < SelectionRadius / ZoomFactor)
 		{
-			FCanvasUtils::SaveStateForUndo(Canvas->UndoStack, Canvas->RedoStack, Canvas->GetCurrentCanvasState());
+			Canvas->SaveStateForUndo(ECanvasUndoScope::CurrentCurve);
 			Canvas->SelectedShapeIndex = INDEX_NONE;
 			Canvas->SelectedPointIndex = i;
 			Canvas->bIsShapeSelected   = true;
@@ -317,46 +307,17 @@ FReply FCanvasInputHandler::HandleSelect(const FVector2D& CanvasClickPos)
 	float TangentRadius = 25.0f;
 
     // Try selecting a tangent handle on completed shapes
-    for (int32 ShapeIndex = 0; ShapeIndex < CompletedShapes.Num(); ++ShapeIndex)
+    float HandleDistSq = FMath::Square(TangentRadius / ZoomFactor);
+    if (Canvas->HitIndex.FindNearest(CanvasClickPos, { ECanvasHitType::ArriveHandle, ECanvasHitType::LeaveHandle }, HandleDistSq, Hit))
     {
-        const FInterpCurve<FVector2D>& Shape = CompletedShapes[ShapeIndex];
-        const TArray<bool>& Flags = BezierFlags[ShapeIndex];
-        int32 NumPts = Shape.Points.Num();
-
-        for (int32 i = 0; i < NumPts; ++i)
-        {
-            const FInterpCurvePoint<UE::Math::TVector2<double>>& Pt = Shape.Points[i];
-            FVector2D World = Pt.OutVal;
-
-            FVector2D Arrive = Flags[i]
-                ? (World - Pt.ArriveTangent)
-                : (World + (i > 0 ? Shape.Points[i-1].OutVal : World)) * 0.5f;
-
-            FVector2D Leave = Flags[i]
-                ? (World + Pt.LeaveTangent)
-                : (World + (i < NumPts-1 ? Shape.Points[i+1].OutVal : World)) * 0.5f;
-
-            if (!Flags[i]) continue;
-
-            if (FVector2D::Distance(CanvasClickPos, Arrive) < TangentRadius / ZoomFactor)
-            {
-                FCanvasUtils::SaveStateForUndo(Canvas->UndoStack, Canvas->RedoStack, Canvas->GetCurrentCanvasState());
-                Canvas->SelectedShapeIndex    = ShapeIndex;
-                Canvas->SelectedPointIndex    = i;
-                Canvas->SelectedTangentHandle = SClothDesignCanvas::ETangentHandle::Arrive;
-                Canvas->bIsDraggingTangent    = true;
-                return FReply::Handled();
-            }
-            else if (FVector2D::Distance(CanvasClickPos, Leave) < TangentRadius / ZoomFactor)
-            {
-                FCanvasUtils::SaveStateForUndo(Canvas->UndoStack, Canvas->RedoStack, Canvas->GetCurrentCanvasState());
-                Canvas->SelectedShapeIndex    = ShapeIndex;
-                Canvas->SelectedPointIndex    = i;
-                Canvas->SelectedTangentHandle = SClothDesignCanvas::ETangentHandle::Leave;
-                Canvas->bIsDraggingTangent    = true;
-                return FReply::Handled();
-            }
-        }
+        Canvas->SaveStateForUndo(ECanvasUndoScope::Shape, Hit.Index);
+        Canvas->SelectedShapeIndex    = Hit.Index;
+        Canvas->SelectedPointIndex    = Hit.SubIndex;
+        Canvas->SelectedTangentHandle = Hit.Type == ECanvasHitType::ArriveHandle
+            ? SClothDesignCanvas::ETangentHandle::Arrive
+            : SClothDesignCanvas::ETangentHandle::Leave;
+        Canvas->bIsDraggingTangent    = true;
+        return FReply::Handled();
     }
 
     // Then the in-progress shape’s handles
@@ -371,7 +332,7 @@ FReply FCanvasInputHandler::HandleSelect(const FVector2D& CanvasClickPos)
 
         if (FVector2D::Distance(CanvasClickPos, Arrive) < TangentRadius / ZoomFactor)
         {
-            FCanvasUtils::SaveStateForUndo(Canvas->UndoStack, Canvas->RedoStack, Canvas->GetCurrentCanvasState());
+            Canvas->SaveStateForUndo(ECanvasUndoScope::CurrentCurve);
             Canvas->SelectedShapeIndex    = INDEX_NONE;
             Canvas->SelectedPointIndex    = i;
             Canvas->SelectedTangentHandle = SClothDesignCanvas::ETangentHandle::Arrive;
@@ -380,7 +341,7 @@ FReply FCanvasInputHandler::HandleSelect(const FVector2D& CanvasClickPos)
         }
         else if (FVector2D::Distance(CanvasClickPos, Leave) < TangentRadius / ZoomFactor)
         {
-            FCanvasUtils::SaveStateForUndo(Canvas->UndoStack, Canvas->RedoStack, Canvas->GetCurrentCanvasState());
+            Canvas->SaveStateForUndo(ECanvasUndoScope::CurrentCurve);
             Canvas->SelectedShapeIndex    = INDEX_NONE;
             Canvas->SelectedPointIndex    = i;
             Canvas->SelectedTangentHandle = SClothDesignCanvas::ETangentHandle::Leave;
@@ -392,94 +353,45 @@ FReply FCanvasInputHandler::HandleSelect(const FVector2D& CanvasClickPos)
 
 
 	
-	// used to match the coordinate system for the seam selection
-	const FVector2D LocalMousePos = Canvas->TransformPoint(CanvasClickPos);
-
+	// seam lines are indexed in canvas space, so the pixel threshold is scaled by the zoom
 	constexpr float SeamSelectionRadius = 25.0f ; // pixels threshold
-	constexpr float SeamSelectionRadiusSq = SeamSelectionRadius * SeamSelectionRadius;
+	float SeamDistSq = FMath::Square(SeamSelectionRadius / ZoomFactor);
 
-	UE_LOG(LogTemp, Warning, TEXT("HandleSelect called, click pos: (%f, %f), ZoomFactor: %f, Seams count:"), CanvasClickPos.X, CanvasClickPos.Y, ZoomFactor);
-	UE_LOG(LogTemp, Warning, TEXT("Seams count: %d"), Canvas->GetSewingManager().SeamDefinitions.Num());
+	UE_LOG(LogTemp, Verbose, TEXT("HandleSelect called, click pos: (%f, %f), ZoomFactor: %f, Seams count: %d"), CanvasClickPos.X, CanvasClickPos.Y, ZoomFactor, Seams.Num());
 
-	const TArray<FSeamDefinition>& Seams = Canvas->GetSewingManager().SeamDefinitions;
-	for (int32 s = 0; s < Seams.Num(); ++s)
+	if (Canvas->HitIndex.FindNearest(CanvasClickPos, { ECanvasHitType::SeamLine }, SeamDistSq, Hit))
 	{
-	    const FSeamDefinition& SD = Seams[s];
-
-	    auto ResolvePoint = [&](int32 ShapeIndex, int32 PtIdx, FVector2D& OutPatternPt) -> bool {
-	        if (PtIdx == INDEX_NONE) return false;
-	        if (ShapeIndex == INDEX_NONE)
-	        {
-	            if (Canvas->CurvePoints.Points.IsValidIndex(PtIdx))
-	            {
-	                OutPatternPt = Canvas->CurvePoints.Points[PtIdx].OutVal;
-	                return true;
-	            }
-	            return false;
-	        }
-	        if (!Canvas->CompletedShapes.IsValidIndex(ShapeIndex)) return false;
-	        const FInterpCurve<FVector2D>& Shape = Canvas->CompletedShapes[ShapeIndex];
-	        if (!Shape.Points.IsValidIndex(PtIdx)) return false;
-	        OutPatternPt = Shape.Points[PtIdx].OutVal;
-	        return true;
-	    };
-
-	    FVector2D Astart, Bstart, Aend, Bend;
-	    bool bAstart = ResolvePoint(SD.ShapeA, SD.EdgeA.Start, Astart);
-	    bool bBstart = ResolvePoint(SD.ShapeB, SD.EdgeB.Start, Bstart);
-	    bool bAend   = ResolvePoint(SD.ShapeA, SD.EdgeA.End,   Aend);
-	    bool bBend   = ResolvePoint(SD.ShapeB, SD.EdgeB.End,   Bend);
-		UE_LOG(LogTemp, Warning, TEXT("Checking seam %d: bAstart=%d bBstart=%d bAend=%d bBend=%d"), s, bAstart, bBstart, bAend, bBend);
-
-		
-	    // check start-start line
-	    if (bAstart && bBstart)
-	    {
-	        FVector2D Ps = Canvas->TransformPoint(Astart);
-	        FVector2D Pe = Canvas->TransformPoint(Bstart);
-	    	float DistSq = DistPointToSegmentSq(LocalMousePos, Ps, Pe);
-	    	UE_LOG(LogTemp, Warning, TEXT("Seam %d start-start dist sq: %f (threshold %f)"), s, DistSq, SeamSelectionRadiusSq);
-	    	if (DistSq <= SeamSelectionRadiusSq)
-	    	{
-	    		UE_LOG(LogTemp, Warning, TEXT("Seam %d start-start line selected"), s);
-	    		FCanvasUtils::SaveStateForUndo(Canvas->UndoStack, Canvas->RedoStack, Canvas->GetCurrentCanvasState());
-
-	            // select this seam
-	            Canvas->SelectedSeamIndex = s;
-	            Canvas->SelectedShapeIndex = INDEX_NONE; // clear point selection
-	            Canvas->SelectedPointIndex = INDEX_NONE;
-	    		UE_LOG(LogTemp, Warning, TEXT("Seam %d selected!"), s);
-
-	            return FReply::Handled();
-	        }
-	    }
-
-	    // check end-end line
-	    if (bAend && bBend)
-	    {
-	        FVector2D Ps = Canvas->TransformPoint(Aend);
-	        FVector2D Pe = Canvas->TransformPoint(Bend);
-	    	UE_LOG(LogTemp, Warning, TEXT("Debug coords: LocalMouse=(%f,%f) CanvasClick(pos maybe pattern)=(%f,%f) Ps=(%f,%f) Pe=(%f,%f) Zoom=%f Pan=(%f,%f)"),
-				LocalMousePos.X, LocalMousePos.Y,
-				CanvasClickPos.X, CanvasClickPos.Y,
-				Ps.X, Ps.Y, Pe.X, Pe.Y,
-				Canvas->ZoomFactor, Canvas->PanOffset.X, Canvas->PanOffset.Y);
-	    	
-	    	float DistSq = DistPointToSegmentSq(LocalMousePos, Ps, Pe);
-	    	UE_LOG(LogTemp, Warning, TEXT("Seam %d end-end dist sq: %f (threshold %f)"), s, DistSq, SeamSelectionRadiusSq);
-	    	if (DistSq <= SeamSelectionRadiusSq)
-	    	{
-	    		UE_LOG(LogTemp, Warning, TEXT("Seam %d end-end line selected"), s);
-	    		FCanvasUtils::SaveStateForUndo(Canvas->UndoStack, Canvas->RedoStack, Canvas->GetCurrentCanvasState());
-
-	            Canvas->SelectedSeamIndex = s;
-	            Canvas->SelectedShapeIndex = INDEX_NONE;
-	            Canvas->SelectedPointIndex = INDEX_NONE;
-	    		UE_LOG(LogTemp, Warning, TEXT("Seam %d selected!"), s);
-
-	            return FReply::Handled();
-	        }
-	    }
+		UE_LOG(LogTemp, Warning, TEXT("Seam %d %s line selected"), Hit.Index, Hit.SubIndex == 0 ? TEXT("start-start") : TEXT("end-end"));
+		Canvas->SaveStateForUndo(ECanvasUndoScope::None);
+
+		// select this seam
+		Canvas->SelectedSeamIndex = Hit.Index;
+		Canvas->SelectedShapeIndex = INDEX_NONE; // clear point selection
+		Canvas->SelectedPointIndex = INDEX_NONE;
+
+		return FReply::Handled();
+	}
+
+	// Clicking inside a completed shape picks up the whole piece; topmost (last drawn) first
+	for (int32 ShapeIdx = CompletedShapes.Num() - 1; ShapeIdx >= 0; --ShapeIdx)
+	{
+		const FShapeTransform2D& Transform = FShapeTransform2D::Get(Canvas->CompletedShapeTransforms, ShapeIdx);
+		const FCanvasCachedShape& Cached = Canvas->ShapeCache.GetShape(ShapeIdx, CompletedShapes[ShapeIdx], Seams);
+		if (!Cached.bClosed) continue;
+
+		const FVector2D LocalClick = Transform.InverseTransformPoint(CanvasClickPos);
+		if (!Cached.Bounds.IsInside(LocalClick) || !FCanvasUtils::IsPointInPolyline(LocalClick, Cached.Polyline)) continue;
+
+		// recorded for undo once the piece actually moves
+		Canvas->SelectedSeamIndex  = INDEX_NONE;
+		Canvas->SelectedShapeIndex = ShapeIdx;
+		Canvas->SelectedPointIndex = INDEX_NONE;
+		Canvas->bIsShapeSelected   = true;
+		Canvas->bIsDraggingShape   = true;
+		Canvas->ShapeDragAnchor    = CanvasClickPos;
+		Canvas->ShapeDragStartTransform = Transform;
+		Canvas->bShapeDragRecorded = false;
+		return FReply::Handled();
 	}
 
 	Canvas->SelectedSeamIndex = INDEX_NONE;
@@ -488,19 +400,3 @@ FReply FCanvasInputHandler::HandleSelect(const FVector2D& CanvasClickPos)
 	
     return FReply::Handled();
 }
-
-// returns squared distance from point P to segment AB (all FVector2D)
-float FCanvasInputHandler::DistPointToSegmentSq(const FVector2D& P, const FVector2D& A, const FVector2D& B)
-{
-	const FVector2D AB = B - A;
-	const FVector2D AP = P - A;
-	float ABLen2 = AB.SizeSquared();
-	if (ABLen2 <= KINDA_SMALL_NUMBER)
-	{
-		return AP.SizeSquared(); // A==B degenerate
-	}
-	float t = FVector2D::DotProduct(AP, AB) / ABLen2;
-	t = FMath::Clamp(t, 0.0f, 1.0f);
-	FVector2D Closest = A + AB * t;
-	return FVector2D::DistSquared(Closest, P);
-}
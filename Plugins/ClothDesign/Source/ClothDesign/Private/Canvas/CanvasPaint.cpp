@@ -1,6 +1,8 @@
 #include "Canvas/CanvasPaint.h"
 #include "ClothDesignCanvas.h"
 #include "Rendering/DrawElements.h"
+#include "Canvas/CanvasShapeCache.h"
+#include "Canvas/CanvasPointBatch.h"
 
 
 // class members
@@ -48,69 +50,76 @@ int32 FCanvasPaint::DrawBackground(
 
     FVector2D ScreenTopLeft = Canvas->TransformPoint(WorldTopLeft) ;
     const FVector2D ScreenBottomRight = Canvas->TransformPoint(WorldTopLeft + WorldSize);
-    const FVector2D ScreenSize = ScreenBottomRight - ScreenTopLeft;
 
-    FSlateBrush Brush;
-    Brush.SetResourceObject(Canvas->BackgroundTexture.Get());
-    Brush.ImageSize = NativeImageSize;
-    Brush.TintColor = FSlateColor(FLinearColor(1,1,1,1)); // fully white
     FLinearColor DrawTint(1,1,1,0.25f); // actual opacity
 
-    FPaintGeometry ImageGeo = Geo.ToPaintGeometry(
-            FVector2f(ScreenSize),
-            FSlateLayoutTransform(FVector2f(ScreenTopLeft)));
-    
-    FSlateDrawElement::MakeBox(
+    // tiles and brushes are cached; only the part of the image in view is drawn
+    return Canvas->BackgroundTiles.Draw(
+        Geo,
         OutDraw,
         Layer,
-        ImageGeo,
-        &Brush,
-        ESlateDrawEffect::None,
+        FBox2D(ScreenTopLeft, ScreenBottomRight),
         DrawTint);
-    
-    return Layer + 1;
 }
 
-void FCanvasPaint::DrawGridLines(
-    const FGeometry& Geo,
-    FSlateWindowElementList& OutDraw,
-    int32 Layer,
-    bool bVertical,
-    float Spacing,
-    const FLinearColor& Color,
-    bool bSkipMajor) const
+void FCanvasPaint::BuildGridPolyline(
+    const FVector2D& Size,
+    const FVector2D& ScreenOrigin,
+    const FVector2D& ScreenScale,
+    float WorldSpacing,
+    int32 SkipEvery,
+    TArray<FVector2f>& OutPoints)
 {
-    const FVector2D Size = Geo.GetLocalSize();
+    // connectors between lines run this far outside the widget so the clip hides them
+    constexpr float Pad = 4.f;
 
-    FVector2D WorldTopLeft = Canvas->InverseTransformPoint(FVector2D::ZeroVector);
-    FVector2D WorldBottomRight = Canvas->InverseTransformPoint(Size);
-    
-    float StartX = FMath::FloorToFloat(WorldTopLeft.X / WorldGridSpacing)*WorldGridSpacing;
-    float EndX   = WorldBottomRight.X;
-    float StartY = FMath::FloorToFloat(WorldTopLeft.Y / WorldGridSpacing) * WorldGridSpacing;
-    float EndY   = WorldBottomRight.Y;
-    
-    
-    for (float w = bVertical ? StartX : StartY; w <= (bVertical ? EndX : EndY); w += Spacing)
+    const int32 StartNum = OutPoints.Num();
+
+    auto IsSkipped = [SkipEvery](int64 k)
     {
-        if (bSkipMajor && FMath::IsNearlyZero(FMath::Fmod(w, WorldGridSpacing), 0.01f))
-            continue;
+        return SkipEvery > 1 && ((k % SkipEvery) + SkipEvery) % SkipEvery == 0;
+    };
 
-        FVector2D A_world = bVertical ? FVector2D(w, WorldTopLeft.Y) : FVector2D(WorldTopLeft.X, w);
-        FVector2D B_world = bVertical ? FVector2D(w, WorldBottomRight.Y) : FVector2D(WorldBottomRight.X, w);
+    for (int32 Axis = 0; Axis < 2; ++Axis)
+    {
+        const bool bVertical = (Axis == 0);
+        const double Origin  = bVertical ? ScreenOrigin.X : ScreenOrigin.Y;
+        const double Scale   = bVertical ? ScreenScale.X : ScreenScale.Y;
+        const double Extent  = bVertical ? Size.X : Size.Y;
+        const double Across  = bVertical ? Size.Y : Size.X;
+        const double Step    = WorldSpacing * Scale;
+        if (Step <= UE_KINDA_SMALL_NUMBER) continue;
+
+        const int64 First = FMath::CeilToInt64((0.0 - Origin) / Step);
+        const int64 Last  = FMath::FloorToInt64((Extent - Origin) / Step);
+
+        bool bForward = true;
+        for (int64 k = First; k <= Last; ++k)
+        {
+            if (IsSkipped(k)) continue;
 
-        FVector2D A_screen = Canvas->TransformPoint(A_world);
-        FVector2D B_screen = Canvas->TransformPoint(B_world);
+            const float Pos  = static_cast<float>(Origin + k * Step);
+            const float From = bForward ? -Pad : static_cast<float>(Across + Pad);
+            const float To   = bForward ? static_cast<float>(Across + Pad) : -Pad;
 
-        FVector2D Start = bVertical ? FVector2D(A_screen.X, 0) : FVector2D(0, A_screen.Y);
-        FVector2D End   = bVertical ? FVector2D(B_screen.X, Size.Y) : FVector2D(Size.X, B_screen.Y);
+            if (bVertical)
+            {
+                OutPoints.Add(FVector2f(Pos, From));
+                OutPoints.Add(FVector2f(Pos, To));
+            }
+            else
+            {
+                OutPoints.Add(FVector2f(From, Pos));
+                OutPoints.Add(FVector2f(To, Pos));
+            }
+            bForward = !bForward;
+        }
 
-        FSlateDrawElement::MakeLines(
-            OutDraw, Layer,
-            Geo.ToPaintGeometry(),
-            { Start, End },
-            ESlateDrawEffect::None, Color, true, 2.0f
-        );
+        if (bVertical && OutPoints.Num() > StartNum)
+        {
+            // route from the last vertical line to the left edge, where the horizontal lines start
+            OutPoints.Add(FVector2f(-Pad, OutPoints.Last().Y));
+        }
     }
 }
 
@@ -120,17 +129,103 @@ int32 FCanvasPaint::DrawGrid(
     FSlateWindowElementList& OutDraw,
     int32 Layer) const
 {
-    Layer = DrawBackground(Geo, OutDraw, Layer);
-    
-    DrawGridLines(Geo, OutDraw, Layer, true,  WorldGridSpacing,      GridColour,      false); // Vertical major
-    DrawGridLines(Geo, OutDraw, Layer, false, WorldGridSpacing,      GridColour,      false); // Horizontal major
-    DrawGridLines(Geo, OutDraw, Layer, true,  SubGridSpacing,        GridColourSmall, true);  // Vertical minor
-    DrawGridLines(Geo, OutDraw, Layer, false, SubGridSpacing,        GridColourSmall, true);  // Horizontal minor
+    const FVector2D Size = Geo.GetLocalSize();
+    const FVector2D ScreenOrigin = Canvas->TransformPoint(FVector2D::ZeroVector);
+    const FVector2D ScreenScale  = Canvas->TransformPoint(FVector2D::UnitVector) - ScreenOrigin;
+    const float PixelsPerUnit = static_cast<float>(FMath::Min(FMath::Abs(ScreenScale.X), FMath::Abs(ScreenScale.Y)));
+
+    // coarsen the major level until its lines are comfortably apart
+    float MajorSpacing = WorldGridSpacing;
+    while (MajorSpacing * PixelsPerUnit < FullGridPixelSpacing * NumSubdivisions * 0.5f)
+    {
+        MajorSpacing *= NumSubdivisions;
+    }
+    const float MinorSpacing = MajorSpacing / NumSubdivisions;
+
+    const FPaintGeometry GridGeo = Geo.ToPaintGeometry();
+
+    // minor lines fade out as they get dense instead of popping
+    const float MinorAlpha = FMath::GetMappedRangeValueClamped(
+        FVector2f(MinGridPixelSpacing, FullGridPixelSpacing), FVector2f(0.f, 1.f), MinorSpacing * PixelsPerUnit);
+    if (MinorAlpha > 0.f)
+    {
+        TArray<FVector2f> MinorPoints;
+        BuildGridPolyline(Size, ScreenOrigin, ScreenScale, MinorSpacing, NumSubdivisions, MinorPoints);
+        if (MinorPoints.Num() >= 2)
+        {
+            FLinearColor MinorColour = GridColourSmall;
+            MinorColour.A *= MinorAlpha;
+            FSlateDrawElement::MakeLines(
+                OutDraw, Layer,
+                GridGeo,
+                MoveTemp(MinorPoints),
+                ESlateDrawEffect::None, MinorColour, true, 2.0f
+            );
+        }
+    }
+
+    TArray<FVector2f> MajorPoints;
+    BuildGridPolyline(Size, ScreenOrigin, ScreenScale, MajorSpacing, 0, MajorPoints);
+    if (MajorPoints.Num() >= 2)
+    {
+        FSlateDrawElement::MakeLines(
+            OutDraw, Layer,
+            GridGeo,
+            MoveTemp(MajorPoints),
+            ESlateDrawEffect::None, GridColour, true, 2.0f
+        );
+    }
 
     return Layer + 1;
 }
 
 
+FBox2D FCanvasPaint::GetVisibleWorldBounds(const FGeometry& Geo, float PixelMargin) const
+{
+    const FVector2D Size = Geo.GetLocalSize();
+    const FVector2D Margin(PixelMargin, PixelMargin);
+
+    FBox2D Visible(ForceInit);
+    Visible += Canvas->InverseTransformPoint(-Margin);
+    Visible += Canvas->InverseTransformPoint(Size + Margin);
+    return Visible;
+}
+
+
+void FCanvasPaint::SetPass(EPaintPass InPass, int32 InActiveShapeIndex)
+{
+    Pass = InPass;
+    ActiveShapeIndex = InActiveShapeIndex;
+}
+
+
+bool FCanvasPaint::ShouldDrawShape(int32 ShapeIndex) const
+{
+    switch (Pass)
+    {
+    case EPaintPass::Static: return ShapeIndex != ActiveShapeIndex;
+    case EPaintPass::Active: return ShapeIndex == ActiveShapeIndex;
+    default:                 return true;
+    }
+}
+
+
+bool FCanvasPaint::ShouldDrawSeam(const FSeamDefinition& Seam) const
+{
+    // seams on the in-progress curve or the edited shape move with the edit
+    const bool bMoving =
+        Seam.ShapeA == INDEX_NONE || Seam.ShapeB == INDEX_NONE ||
+        (ActiveShapeIndex != INDEX_NONE && (Seam.ShapeA == ActiveShapeIndex || Seam.ShapeB == ActiveShapeIndex));
+
+    switch (Pass)
+    {
+    case EPaintPass::Static: return !bMoving;
+    case EPaintPass::Active: return bMoving;
+    default:                 return true;
+    }
+}
+
+
 // for highlighting the shapes edge segment that is sewn
 // Return set of segment start indices that lie on the shortest arc from startIdx -> endIdx
 void FCanvasPaint::BuildShortestArcSegments(
@@ -173,189 +268,136 @@ int32 FCanvasPaint::DrawCompletedShapes(
 {
     const TArray<FInterpCurve<FVector2D>>& Shapes       = Canvas->CompletedShapes;
     const TArray<TArray<bool>>& BezierFlags  = Canvas->CompletedBezierFlags;
+    const TArray<FShapeTransform2D>& Transforms = Canvas->CompletedShapeTransforms;
     const int32 NumShapes    = Shapes.Num();
 
     const TArray<FSeamDefinition>& SeamDefs = Canvas->GetSewingManager().SeamDefinitions;
 
+    // pan and zoom are a per-axis scale and offset; resolve them once per frame
+    const FVector2D ScreenOrigin = Canvas->TransformPoint(FVector2D::ZeroVector);
+    const FVector2D ScreenScale  = Canvas->TransformPoint(FVector2D::UnitVector) - ScreenOrigin;
+    const FPaintGeometry LineGeo = Geo.ToPaintGeometry();
+
+    FCanvasShapeCache& Cache = Canvas->ShapeCache;
+    Cache.SetNumShapes(NumShapes);
+
+    const FBox2D Visible = GetVisibleWorldBounds(Geo, CullPixelMargin);
+
+    // shapes whose handles or points may be visible; filled by the line pass
+    TBitArray<> ShapeControlsVisible(false, NumShapes);
+
     for (int32 ShapeIdx = 0; ShapeIdx < NumShapes; ++ShapeIdx)
     {
-        const FInterpCurve<FVector2D>& Shape = Shapes[ShapeIdx];
-        const int32 NumPts = Shape.Points.Num();
-        if (NumPts < 2) continue;
+        if (!ShouldDrawShape(ShapeIdx)) continue;
 
-        TSet<int32> SegmentsToHighlight;
-        for (const FSeamDefinition& SD : SeamDefs)
-        {
-            if (SD.ShapeA == ShapeIdx)
-            {
-                BuildShortestArcSegments(SD.EdgeA.Start, SD.EdgeA.End, NumPts, SegmentsToHighlight);
-            }
-            if (SD.ShapeB == ShapeIdx)
-            {
-                BuildShortestArcSegments(SD.EdgeB.Start, SD.EdgeB.End, NumPts, SegmentsToHighlight);
-            }
-        }
+        // the cache is in shape-local space; only its bounds and output points are transformed
+        const FCanvasCachedShape& Cached = Cache.GetShape(ShapeIdx, Shapes[ShapeIdx], SeamDefs);
+        const FShapeTransform2D& Transform = FShapeTransform2D::Get(Transforms, ShapeIdx);
+        const FBox2D ControlBounds = Transform.TransformBox(Cached.ControlBounds);
+        ShapeControlsVisible[ShapeIdx] = ControlBounds.bIsValid && ControlBounds.Intersect(Visible);
 
-        const bool bClosed = (NumPts > 2);
+        const int32 NumSegments = Cached.NumSegments();
+        if (NumSegments == 0 || !Transform.TransformBox(Cached.Bounds).Intersect(Visible)) continue;
 
-        for (int32 Seg = 0; Seg < NumPts - 1; ++Seg)
+        auto SegmentColour = [&](int32 Seg) -> FLinearColor
         {
-            bool bThisSegIsSewn = SegmentsToHighlight.Contains(Seg);
-
-            FLinearColor LineCol = bThisSegIsSewn ? SewingLineColour : CompletedLineColour;
+            if (Cached.SewnSegments[Seg]) return SewingLineColour;
+            return (Cached.bClosed && Seg == NumSegments - 1) ? FLinearColor::Black : CompletedLineColour;
+        };
 
-            // draw samples for this segment
-            float AIn = Shape.Points[Seg].InVal;
-            float BIn = Shape.Points[Seg + 1].InVal;
-            constexpr int SamplesPerSegment = 10;
-            
-            for (int i = 0; i < SamplesPerSegment; ++i)
+        // one polyline per run of equally coloured segments
+        int32 RunStart = 0;
+        while (RunStart < NumSegments)
+        {
+            const FLinearColor RunColour = SegmentColour(RunStart);
+            int32 RunEnd = RunStart + 1;
+            while (RunEnd < NumSegments && SegmentColour(RunEnd) == RunColour)
             {
-                float t0 = FMath::Lerp(AIn, BIn, static_cast<float>(i) / SamplesPerSegment);
-                float t1 = FMath::Lerp(AIn, BIn, static_cast<float>(i + 1) / SamplesPerSegment);
-                
-                FVector2D P0 = Canvas->TransformPoint(Shape.Eval(t0));
-                FVector2D P1 = Canvas->TransformPoint(Shape.Eval(t1));
-                FPaintGeometry LineGeo = Geo.ToPaintGeometry();
-
-                FSlateDrawElement::MakeLines(
-                    OutDraw, Layer,
-                    LineGeo,
-                    TArray<FVector2f>{ FVector2f(P0), FVector2f(P1) },
-                    ESlateDrawEffect::None,
-                    LineCol,
-                    true, 2.0f
-                );
+                ++RunEnd;
             }
-        }
 
+            const int32 FirstVert = Cached.SegmentStarts[RunStart];
+            const int32 LastVert  = Cached.SegmentStarts[RunEnd];
 
+            TArray<FVector2f> ScreenPoints;
+            ScreenPoints.SetNumUninitialized(LastVert - FirstVert + 1);
+            for (int32 v = FirstVert; v <= LastVert; ++v)
+            {
+                ScreenPoints[v - FirstVert] = FVector2f(ScreenOrigin + Transform.TransformPoint(Cached.Polyline[v]) * ScreenScale);
+            }
 
-        if (bClosed)
-        {
-            int32 seg = NumPts - 1; 
-            bool bThisSegIsSewn = SegmentsToHighlight.Contains(seg);
-            FLinearColor LineCol = bThisSegIsSewn ? SewingLineColour : FLinearColor::Black;
-
-            FVector2D LastPt = Canvas->TransformPoint(Shape.Points.Last().OutVal);
-            FVector2D FirstPt = Canvas->TransformPoint(Shape.Points[0].OutVal);
-            FPaintGeometry LoopGeo = Geo.ToPaintGeometry();
             FSlateDrawElement::MakeLines(
                 OutDraw, Layer,
-                LoopGeo,
-                TArray<FVector2f>{ FVector2f(LastPt), FVector2f(FirstPt) },
+                LineGeo,
+                MoveTemp(ScreenPoints),
                 ESlateDrawEffect::None,
-                LineCol,
+                RunColour,
                 true, 2.0f
             );
+
+            RunStart = RunEnd;
         }
 
         ++Layer;
     }    
 
     
-    // Draw each shape's Bezier handles
+    // Draw each shape's Bezier handles, all shapes in one batch
+    FCanvasPointBatch Batch(Geo);
     for (int32 ShapeIdx = 0; ShapeIdx < NumShapes; ++ShapeIdx)
     {
+        if (!ShapeControlsVisible[ShapeIdx]) continue;
+
         const FInterpCurve<FVector2D>& Shape = Shapes[ShapeIdx];
         const TArray<bool>& Flags = BezierFlags[ShapeIdx];
+        const FShapeTransform2D& Transform = FShapeTransform2D::Get(Transforms, ShapeIdx);
 
         for (int32 i = 0; i < Shape.Points.Num(); ++i)
         {
             if (!Flags[i]) continue; // skip N-points entirely
 
             const FInterpCurvePoint<UE::Math::TVector2<double>>& Pt = Shape.Points[i];
-            FVector2D World = Pt.OutVal;
+            FVector2D World = Transform.TransformPoint(Pt.OutVal);
             FVector2D Screen = Canvas->TransformPoint(World);
-            FVector2D H1 = Canvas->TransformPoint(World - Pt.ArriveTangent);
-            FVector2D H2 = Canvas->TransformPoint(World + Pt.LeaveTangent);
-            
-            FPaintGeometry HandleLineGeo = Geo.ToPaintGeometry();
-
-            
-            // Lines to handles
-            FSlateDrawElement::MakeLines(
-                OutDraw, Layer,
-                HandleLineGeo,
-                TArray<FVector2f>{ FVector2f(Screen), FVector2f(H1) },
-                ESlateDrawEffect::None,
-                CompletedBezierHandleColour,
-                true, 1.0f
-            );
-            FSlateDrawElement::MakeLines(
-                OutDraw, Layer,
-                HandleLineGeo,
-                TArray<FVector2f>{ FVector2f(Screen), FVector2f(H2) },
-                ESlateDrawEffect::None,
-                CompletedBezierHandleColour,
-                true, 1.0f
-            );
-
-            // Boxes at handle endpoints
-            for (const UE::Math::TVector2<double>& PtScreen : {H1, H2})
-            {
-                FVector2f BoxPos = FVector2f(PtScreen - FVector2D(3, 3));
-                FVector2f BoxSize = FVector2f(6, 6);
-                FSlateLayoutTransform LayoutTransform(BoxPos);
-
-                FPaintGeometry BoxGeo = Geo.ToPaintGeometry(BoxSize, LayoutTransform);
-                FSlateDrawElement::MakeBox(
-                    OutDraw, Layer,
-                    BoxGeo,
-                    FCoreStyle::Get().GetBrush("WhiteBrush"),
-                    ESlateDrawEffect::None,
-                    PostCurrentPointColour
-                );
-            }
+            FVector2D H1 = Canvas->TransformPoint(World - Transform.TransformVector(Pt.ArriveTangent));
+            FVector2D H2 = Canvas->TransformPoint(World + Transform.TransformVector(Pt.LeaveTangent));
+
+            // Lines to both handles, then boxes at handle endpoints
+            Batch.AddLine(H1, Screen, 1.0f, CompletedBezierHandleColour);
+            Batch.AddLine(Screen, H2, 1.0f, CompletedBezierHandleColour);
+            Batch.AddBox(H1, PointHalfSize, PostCurrentPointColour);
+            Batch.AddBox(H2, PointHalfSize, PostCurrentPointColour);
         }
-
-        ++Layer;
     }
+    Batch.Submit(OutDraw, Layer);
+    ++Layer;
     
     
     // --- Section 2: Draw each shape's points ---
+    const FPatternSewing& Sewing = Canvas->GetSewingManager();
     for (int32 ShapeIdx = 0; ShapeIdx < NumShapes; ++ShapeIdx)
     {
+        if (!ShapeControlsVisible[ShapeIdx]) continue;
+
         const FInterpCurve<FVector2D>& Shape = Shapes[ShapeIdx];
+        const FShapeTransform2D& Transform = FShapeTransform2D::Get(Transforms, ShapeIdx);
+        const TSet<int32>* SewnSet = Canvas->SewnPointIndicesPerShape.Find(ShapeIdx);
+        const TSet<int32>* PreviewSet = Sewing.CurrentSeamPreviewPoints.Find(ShapeIdx);
         
         for (int32 PtIdx = 0; PtIdx < Shape.Points.Num(); ++PtIdx)
         {
-            bool bIsSewn = false;
-
-            // check permanent sewn points
-            if (const TSet<int32>* SewnSet = Canvas->SewnPointIndicesPerShape.Find(ShapeIdx))
-            {
-                if (SewnSet->Contains(PtIdx))
-                    bIsSewn = true;
-            }
+            // permanent sewn points and preview points (currently being sewn)
+            const bool bIsSewn = (SewnSet && SewnSet->Contains(PtIdx)) || (PreviewSet && PreviewSet->Contains(PtIdx));
 
-            // Check preview points (currently being sewn)
-            if (const TSet<int32>* PreviewSet = Canvas->GetSewingManager().CurrentSeamPreviewPoints.Find(ShapeIdx))
-            {
-                if (PreviewSet->Contains(PtIdx))
-                    bIsSewn = true;
-            }
-            
-            FVector2D Pos = Canvas->TransformPoint(Shape.Points[PtIdx].OutVal);
-            FVector2f BoxPos = FVector2f(Pos - FVector2D(3, 3));
-            FVector2f BoxSize = FVector2f(6, 6);
-            FSlateLayoutTransform LayoutTransform(BoxPos);
-
-            FPaintGeometry BoxGeo = Geo.ToPaintGeometry(BoxSize, LayoutTransform);
             // Choose highlight if this point is sewn
             FLinearColor UseColor = bIsSewn ?
                             SewingPointColour : PostCurrentPointColour;
 
-            FSlateDrawElement::MakeBox(
-                OutDraw, Layer,
-                BoxGeo,
-                FCoreStyle::Get().GetBrush("WhiteBrush"),
-                ESlateDrawEffect::None,
-                UseColor
-            );
+            Batch.AddBox(Canvas->TransformPoint(Transform.TransformPoint(Shape.Points[PtIdx].OutVal)), PointHalfSize, UseColor);
         }
-        ++Layer;
     }
+    Batch.Submit(OutDraw, Layer);
+    ++Layer;
 
     
     return Layer;
@@ -371,9 +413,16 @@ int FCanvasPaint::DrawFinalisedSeamLines(
     const TArray<FSeamDefinition>& Seams = Sewing.SeamDefinitions;
     
 
+    const TArray<FBox2D>& SeamBounds = Canvas->ShapeCache.GetSeamBounds(Seams, Canvas->CompletedShapes, Canvas->CompletedShapeTransforms);
+    const FBox2D Visible = GetVisibleWorldBounds(Geo, CullPixelMargin);
+
     for (int32 s = 0; s < Seams.Num(); ++s)
     {
         const FSeamDefinition& SD = Seams[s];
+        if (!ShouldDrawSeam(SD)) continue;
+
+        // an invalid box marks a seam on the in-progress curve, which is always drawn
+        if (SeamBounds[s].bIsValid && !SeamBounds[s].Intersect(Visible)) continue;
 
         // helper to get a 2D point (pattern-space) from a (shapeIndex, pointIndex)
         auto GetPatternPoint2D = [&](int32 ShapeIndex, int32 PtIdx, FVector2D& OutPt) -> bool
@@ -391,7 +440,7 @@ int FCanvasPaint::DrawFinalisedSeamLines(
             if (!Canvas->CompletedShapes.IsValidIndex(ShapeIndex)) return false;
             const FInterpCurve<FVector2D>& Shape = Canvas->CompletedShapes[ShapeIndex];
             if (!Shape.Points.IsValidIndex(PtIdx)) return false;
-            OutPt = Shape.Points[PtIdx].OutVal;
+            OutPt = FShapeTransform2D::Get(Canvas->CompletedShapeTransforms, ShapeIndex).TransformPoint(Shape.Points[PtIdx].OutVal);
             return true;
         };
 
@@ -457,35 +506,31 @@ int32 FCanvasPaint::DrawCurrentShape(
     
 	if (CurvePoints.Points.Num() >= 2)
 	{
-
-		for (int SegIndex = 0; SegIndex < CurvePoints.Points.Num() - 1; ++SegIndex)
+		// the active curve changes constantly, so it is sampled per frame but still drawn as one polyline
+		FCanvasCachedShape Sampled;
+		FCanvasShapeCache::Tessellate(CurvePoints, Sampled);
+
+		const FVector2D ScreenOrigin = Canvas->TransformPoint(FVector2D::ZeroVector);
+		const FVector2D ScreenScale  = Canvas->TransformPoint(FVector2D::UnitVector) - ScreenOrigin;
+
+		// the closing edge is drawn separately in black below
+		const int32 NumCurveVerts = Sampled.SegmentStarts[CurvePoints.Points.Num() - 1] + 1;
+		TArray<FVector2f> ScreenPoints;
+		ScreenPoints.SetNumUninitialized(NumCurveVerts);
+		for (int32 v = 0; v < NumCurveVerts; ++v)
 		{
-			float StartInVal = CurvePoints.Points[SegIndex].InVal;
-			float EndInVal   = CurvePoints.Points[SegIndex + 1].InVal;
-		    constexpr int SamplesPerSegment = 10; // Smoothness
-
-			for (int i = 0; i < SamplesPerSegment; ++i)
-			{
-			    float t0 = FMath::Lerp(StartInVal, EndInVal, static_cast<float>(i) / SamplesPerSegment);
-			    float t1 = FMath::Lerp(StartInVal, EndInVal, static_cast<float>(i + 1) / SamplesPerSegment);
-
-			    FVector2D P0 = Canvas->TransformPoint(CurvePoints.Eval(t0));
-			    FVector2D P1 = Canvas->TransformPoint(CurvePoints.Eval(t1));
-			    
-			    FPaintGeometry LineGeo = Geo.ToPaintGeometry();
-
-                
-			    FSlateDrawElement::MakeLines(
-                    OutDraw, Layer,
-                    LineGeo,
-                    TArray<FVector2f>{ FVector2f(P0), FVector2f(P1) },
-                    ESlateDrawEffect::None,
-                    LineColour,
-                    true, 2.0f
-                );
-			}
+			ScreenPoints[v] = FVector2f(ScreenOrigin + Sampled.Polyline[v] * ScreenScale);
 		}
 
+		FSlateDrawElement::MakeLines(
+			OutDraw, Layer,
+			Geo.ToPaintGeometry(),
+			MoveTemp(ScreenPoints),
+			ESlateDrawEffect::None,
+			LineColour,
+			true, 2.0f
+		);
+
 		++Layer;
 	}
 
@@ -511,6 +556,7 @@ int32 FCanvasPaint::DrawCurrentShape(
 
     
         // //  Draw shape's Bezier handles 
+    FCanvasPointBatch Batch(Geo);
 	for (int32 i = 0; i < CurvePoints.Points.Num(); ++i)
     {
         if (!bUseBezierPerPoint[i]) continue; // skip N-points entirely
@@ -521,69 +567,24 @@ int32 FCanvasPaint::DrawCurrentShape(
         FVector2D Screen  = Canvas->TransformPoint(World);
         FVector2D H1      = Canvas->TransformPoint(World - Pt.ArriveTangent);
         FVector2D H2      = Canvas->TransformPoint(World + Pt.LeaveTangent);
-	    
-
-	   FPaintGeometry HandleLineGeo = Geo.ToPaintGeometry();
 
-        // Lines to handles
-        FSlateDrawElement::MakeLines(
-            OutDraw, Layer,
-            HandleLineGeo,
-            TArray<FVector2f>{ FVector2f(Screen), FVector2f(H1) },
-            ESlateDrawEffect::None,
-            BezierHandleColour,
-            true, 1.0f
-        );
-        FSlateDrawElement::MakeLines(
-            OutDraw, Layer,
-            HandleLineGeo,
-            TArray<FVector2f>{ FVector2f(Screen), FVector2f(H2) },
-            ESlateDrawEffect::None,
-            BezierHandleColour,
-            true, 1.0f
-        );
-
-        // Boxes at handle endpoints
-        for (const UE::Math::TVector2<double>& PtScreen : {H1, H2})
-        {
-            FVector2f BoxPos = FVector2f(PtScreen - FVector2D(3, 3));
-            FVector2f BoxSize = FVector2f(6, 6);
-            FSlateLayoutTransform LayoutTransform(BoxPos);
-
-            FPaintGeometry BoxGeo = Geo.ToPaintGeometry(BoxSize, LayoutTransform);
-
-            FSlateDrawElement::MakeBox(
-                OutDraw, Layer,
-                BoxGeo,
-                FCoreStyle::Get().GetBrush("WhiteBrush"),
-                ESlateDrawEffect::None,
-                PointColour
-            );
-        }
+        // Lines to handles, then boxes at handle endpoints
+        Batch.AddLine(Screen, H1, 1.0f, BezierHandleColour);
+        Batch.AddLine(Screen, H2, 1.0f, BezierHandleColour);
+        Batch.AddBox(H1, PointHalfSize, PointColour);
+        Batch.AddBox(H2, PointHalfSize, PointColour);
     }
+    Batch.Submit(OutDraw, Layer);
     ++Layer;
     
 
     // Draw shape's points
 	for (int32 i = 0; i < CurvePoints.Points.Num(); ++i)
     {
-	    FVector2D Pos = Canvas->TransformPoint(CurvePoints.Points[i].OutVal);
-	    
-	    FVector2f BoxPos = FVector2f(Pos - FVector2D(3, 3));
-	    FVector2f BoxSize = FVector2f(6, 6);
-	    FSlateLayoutTransform LayoutTransform(BoxPos);
-
-	    FPaintGeometry BoxGeo = Geo.ToPaintGeometry(BoxSize, LayoutTransform);
-	    
-        FSlateDrawElement::MakeBox(
-            OutDraw, Layer,
-            BoxGeo,
-            FCoreStyle::Get().GetBrush("WhiteBrush"),
-            ESlateDrawEffect::None,
-            PointColour
-        );
-        ++Layer;
+        Batch.AddBox(Canvas->TransformPoint(CurvePoints.Points[i].OutVal), PointHalfSize, PointColour);
     }
+    Batch.Submit(OutDraw, Layer);
+    ++Layer;
     return Layer + 1;
 }
 
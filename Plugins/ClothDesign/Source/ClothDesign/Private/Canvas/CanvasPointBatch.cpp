@@ -0,0 +1,74 @@
+#include "Canvas/CanvasPointBatch.h"
+#include "Rendering/DrawElements.h"
+#include "Rendering/SlateRenderer.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Styling/CoreStyle.h"
+
+
+FCanvasPointBatch::FCanvasPointBatch(const FGeometry& Geo)
+	: RenderTransform(Geo.GetAccumulatedRenderTransform())
+{
+}
+
+
+void FCanvasPointBatch::AddBox(const FVector2D& LocalCentre, float HalfSize, const FLinearColor& Colour)
+{
+	const FVector2f C(LocalCentre);
+	AddQuad(
+		C + FVector2f(-HalfSize, -HalfSize),
+		C + FVector2f(HalfSize, -HalfSize),
+		C + FVector2f(HalfSize, HalfSize),
+		C + FVector2f(-HalfSize, HalfSize),
+		Colour);
+}
+
+
+void FCanvasPointBatch::AddLine(const FVector2D& LocalStart, const FVector2D& LocalEnd, float Thickness, const FLinearColor& Colour)
+{
+	const FVector2f A(LocalStart);
+	const FVector2f B(LocalEnd);
+	const FVector2f Dir = B - A;
+	const float Len = Dir.Size();
+	if (Len <= UE_KINDA_SMALL_NUMBER)
+	{
+		return;
+	}
+
+	const FVector2f Side = FVector2f(-Dir.Y, Dir.X) * (0.5f * Thickness / Len);
+	AddQuad(A - Side, B - Side, B + Side, A + Side, Colour);
+}
+
+
+void FCanvasPointBatch::AddQuad(const FVector2f& A, const FVector2f& B, const FVector2f& C, const FVector2f& D, const FLinearColor& Colour)
+{
+	const FColor Packed = Colour.ToFColorSRGB();
+	const SlateIndex Base = static_cast<SlateIndex>(Vertices.Num());
+
+	Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, A, FVector2f(0.f, 0.f), Packed));
+	Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, B, FVector2f(1.f, 0.f), Packed));
+	Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, C, FVector2f(1.f, 1.f), Packed));
+	Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, D, FVector2f(0.f, 1.f), Packed));
+
+	Indices.Append({ Base, Base + 1, Base + 2, Base, Base + 2, Base + 3 });
+}
+
+
+void FCanvasPointBatch::Submit(FSlateWindowElementList& OutDraw, int32 Layer)
+{
+	if (Vertices.Num() == 0)
+	{
+		return;
+	}
+
+	// the white brush leaves vertex colours unmodified
+	FSlateResourceHandle WhiteHandle;
+	if (FSlateApplication::IsInitialized() && FSlateApplication::Get().GetRenderer())
+	{
+		WhiteHandle = FSlateApplication::Get().GetRenderer()->GetResourceHandle(*FCoreStyle::Get().GetBrush("WhiteBrush"));
+	}
+
+	FSlateDrawElement::MakeCustomVerts(OutDraw, Layer, WhiteHandle, Vertices, Indices, nullptr, 0, 0);
+
+	Vertices.Reset();
+	Indices.Reset();
+}
@@ -0,0 +1,221 @@
+#include "Canvas/CanvasShapeCache.h"
+#include "Canvas/CanvasPaint.h"
+#include "PatternCreation/PatternSewing.h"
+
+
+const FCanvasCachedShape& FCanvasShapeCache::GetShape(
+	int32 ShapeIndex,
+	const FInterpCurve<FVector2D>& Shape,
+	const TArray<FSeamDefinition>& Seams)
+{
+	if (!Entries.IsValidIndex(ShapeIndex))
+	{
+		SetNumShapes(ShapeIndex + 1);
+	}
+	FCanvasCachedShape& Entry = Entries[ShapeIndex];
+
+	// a point count mismatch means an edit was not reported; resample rather than draw garbage
+	const int32 NumPts = Shape.Points.Num();
+	const int32 ExpectedSegments = NumPts < 2 ? 0 : (NumPts > 2 ? NumPts : NumPts - 1);
+	if (Entry.NumSegments() != ExpectedSegments)
+	{
+		Entry.bGeometryDirty = true;
+	}
+
+	if (Entry.bGeometryDirty)
+	{
+		bSeamBoundsDirty = true;
+		Tessellate(Shape, Entry);
+		Entry.bGeometryDirty = false;
+		Entry.bSeamsDirty = true;
+	}
+
+	if (Entry.bSeamsDirty)
+	{
+		TSet<int32> SegmentsToHighlight;
+		for (const FSeamDefinition& SD : Seams)
+		{
+			if (SD.ShapeA == ShapeIndex)
+			{
+				FCanvasPaint::BuildShortestArcSegments(SD.EdgeA.Start, SD.EdgeA.End, NumPts, SegmentsToHighlight);
+			}
+			if (SD.ShapeB == ShapeIndex)
+			{
+				FCanvasPaint::BuildShortestArcSegments(SD.EdgeB.Start, SD.EdgeB.End, NumPts, SegmentsToHighlight);
+			}
+		}
+
+		Entry.SewnSegments.Init(false, Entry.NumSegments());
+		for (int32 Seg : SegmentsToHighlight)
+		{
+			if (Seg >= 0 && Seg < Entry.NumSegments())
+			{
+				Entry.SewnSegments[Seg] = true;
+			}
+		}
+		Entry.bSeamsDirty = false;
+	}
+
+	return Entry;
+}
+
+
+void FCanvasShapeCache::SetNumShapes(int32 NumShapes)
+{
+	if (Entries.Num() != NumShapes)
+	{
+		bSeamBoundsDirty = true;
+		++StaticVersion;
+	}
+	Entries.SetNum(NumShapes);
+}
+
+
+void FCanvasShapeCache::MarkShapeDirty(int32 ShapeIndex)
+{
+	if (Entries.IsValidIndex(ShapeIndex))
+	{
+		Entries[ShapeIndex].bGeometryDirty = true;
+	}
+	bSeamBoundsDirty = true;
+	if (ShapeIndex != ActiveShapeIndex)
+	{
+		++StaticVersion;
+	}
+}
+
+
+void FCanvasShapeCache::MarkShapeMoved(int32 ShapeIndex)
+{
+	// the local tessellation is unchanged; only canvas-space seam ends moved
+	bSeamBoundsDirty = true;
+	if (ShapeIndex != ActiveShapeIndex)
+	{
+		++StaticVersion;
+	}
+}
+
+
+void FCanvasShapeCache::MarkSeamsDirty()
+{
+	for (FCanvasCachedShape& Entry : Entries)
+	{
+		Entry.bSeamsDirty = true;
+	}
+	bSeamBoundsDirty = true;
+	++StaticVersion;
+}
+
+
+void FCanvasShapeCache::InvalidateAll()
+{
+	for (FCanvasCachedShape& Entry : Entries)
+	{
+		Entry.bGeometryDirty = true;
+		Entry.bSeamsDirty = true;
+	}
+	bSeamBoundsDirty = true;
+	++StaticVersion;
+}
+
+
+void FCanvasShapeCache::SetActiveShape(int32 ShapeIndex)
+{
+	if (ShapeIndex != ActiveShapeIndex)
+	{
+		// the shape moves between the cached layer and the live overlay
+		ActiveShapeIndex = ShapeIndex;
+		++StaticVersion;
+	}
+}
+
+
+const TArray<FBox2D>& FCanvasShapeCache::GetSeamBounds(
+	const TArray<FSeamDefinition>& Seams,
+	const TArray<FInterpCurve<FVector2D>>& Shapes,
+	const TArray<FShapeTransform2D>& Transforms)
+{
+	if (!bSeamBoundsDirty && SeamBounds.Num() == Seams.Num())
+	{
+		return SeamBounds;
+	}
+
+	SeamBounds.SetNum(Seams.Num());
+	for (int32 s = 0; s < Seams.Num(); ++s)
+	{
+		const FSeamDefinition& SD = Seams[s];
+		FBox2D Box(ForceInit);
+		bool bCullable = Shapes.IsValidIndex(SD.ShapeA) && Shapes.IsValidIndex(SD.ShapeB);
+
+		// seams on the in-progress curve move with every edit, so they are never culled
+		for (const TPair<int32, int32>& End : {
+			TPair<int32, int32>(SD.ShapeA, SD.EdgeA.Start), TPair<int32, int32>(SD.ShapeA, SD.EdgeA.End),
+			TPair<int32, int32>(SD.ShapeB, SD.EdgeB.Start), TPair<int32, int32>(SD.ShapeB, SD.EdgeB.End) })
+		{
+			if (!bCullable) break;
+			if (End.Value == INDEX_NONE) continue;
+			if (!Shapes[End.Key].Points.IsValidIndex(End.Value))
+			{
+				bCullable = false;
+				break;
+			}
+			Box += FShapeTransform2D::Get(Transforms, End.Key).TransformPoint(Shapes[End.Key].Points[End.Value].OutVal);
+		}
+
+		SeamBounds[s] = bCullable ? Box : FBox2D(ForceInit);
+	}
+
+	bSeamBoundsDirty = false;
+	return SeamBounds;
+}
+
+
+void FCanvasShapeCache::Tessellate(const FInterpCurve<FVector2D>& Shape, FCanvasCachedShape& Out)
+{
+	Out.Polyline.Reset();
+	Out.SegmentStarts.Reset();
+	Out.Bounds = FBox2D(ForceInit);
+
+	const int32 NumPts = Shape.Points.Num();
+	Out.bClosed = NumPts > 2;
+	if (NumPts < 2)
+	{
+		return;
+	}
+
+	Out.Polyline.Reserve((NumPts - 1) * SamplesPerSegment + 2);
+	Out.SegmentStarts.Reserve(NumPts + 1);
+
+	Out.Polyline.Add(Shape.Eval(Shape.Points[0].InVal));
+	for (int32 Seg = 0; Seg < NumPts - 1; ++Seg)
+	{
+		Out.SegmentStarts.Add(Out.Polyline.Num() - 1);
+
+		const float AIn = Shape.Points[Seg].InVal;
+		const float BIn = Shape.Points[Seg + 1].InVal;
+		for (int32 i = 1; i <= SamplesPerSegment; ++i)
+		{
+			Out.Polyline.Add(Shape.Eval(FMath::Lerp(AIn, BIn, static_cast<float>(i) / SamplesPerSegment)));
+		}
+	}
+
+	if (Out.bClosed)
+	{
+		// straight closing edge back to the first control point
+		Out.SegmentStarts.Add(Out.Polyline.Num() - 1);
+		Out.Polyline.Add(Shape.Points[0].OutVal);
+	}
+	Out.SegmentStarts.Add(Out.Polyline.Num() - 1);
+
+	for (const FVector2D& P : Out.Polyline)
+	{
+		Out.Bounds += P;
+	}
+
+	Out.ControlBounds = Out.Bounds;
+	for (const FInterpCurvePoint<FVector2D>& Pt : Shape.Points)
+	{
+		Out.ControlBounds += Pt.OutVal - Pt.ArriveTangent;
+		Out.ControlBounds += Pt.OutVal + Pt.LeaveTangent;
+	}
+}
@@ -0,0 +1,72 @@
+#include "Canvas/CanvasShapeTransform.h"
+
+
+const FShapeTransform2D FShapeTransform2D::Identity;
+
+
+FVector2D FShapeTransform2D::TransformPoint(const FVector2D& Local) const
+{
+	return TransformVector(Local) + Translation;
+}
+
+
+FVector2D FShapeTransform2D::TransformVector(const FVector2D& Local) const
+{
+	if (RotationDegrees == 0.0)
+	{
+		return Local;
+	}
+	double S, C;
+	FMath::SinCos(&S, &C, FMath::DegreesToRadians(RotationDegrees));
+	return FVector2D(C * Local.X - S * Local.Y, S * Local.X + C * Local.Y);
+}
+
+
+FVector2D FShapeTransform2D::InverseTransformPoint(const FVector2D& World) const
+{
+	const FVector2D D = World - Translation;
+	if (RotationDegrees == 0.0)
+	{
+		return D;
+	}
+	double S, C;
+	FMath::SinCos(&S, &C, FMath::DegreesToRadians(RotationDegrees));
+	return FVector2D(C * D.X + S * D.Y, -S * D.X + C * D.Y);
+}
+
+
+FBox2D FShapeTransform2D::TransformBox(const FBox2D& Local) const
+{
+	if (!Local.bIsValid)
+	{
+		return Local;
+	}
+	if (RotationDegrees == 0.0)
+	{
+		return FBox2D(Local.Min + Translation, Local.Max + Translation);
+	}
+
+	FBox2D Out(ForceInit);
+	Out += TransformPoint(Local.Min);
+	Out += TransformPoint(Local.Max);
+	Out += TransformPoint(FVector2D(Local.Min.X, Local.Max.Y));
+	Out += TransformPoint(FVector2D(Local.Max.X, Local.Min.Y));
+	return Out;
+}
+
+
+void FShapeTransform2D::RotateAbout(const FVector2D& WorldPivot, double DeltaDegrees)
+{
+	FShapeTransform2D Delta;
+	Delta.RotationDegrees = DeltaDegrees;
+
+	// R' = Rd * R and t' = Rd * (t - p) + p keep the pivot fixed
+	Translation = Delta.TransformVector(Translation - WorldPivot) + WorldPivot;
+	RotationDegrees = FRotator::NormalizeAxis(RotationDegrees + DeltaDegrees);
+}
+
+
+const FShapeTransform2D& FShapeTransform2D::Get(const TArray<FShapeTransform2D>& Transforms, int32 ShapeIndex)
+{
+	return Transforms.IsValidIndex(ShapeIndex) ? Transforms[ShapeIndex] : Identity;
+}
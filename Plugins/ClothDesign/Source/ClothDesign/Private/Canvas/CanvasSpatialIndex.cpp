@@ -0,0 +1,283 @@
+#include "Canvas/CanvasSpatialIndex.h"
+#include "PatternCreation/PatternSewing.h"
+
+
+void FCanvasSpatialIndex::Sync(
+	const TArray<FInterpCurve<FVector2D>>& Shapes,
+	const TArray<TArray<bool>>& BezierFlags,
+	const TArray<FSeamDefinition>& Seams,
+	const TArray<FShapeTransform2D>& Transforms)
+{
+	const int32 NumShapes = Shapes.Num();
+
+	// drop shapes that no longer exist
+	for (int32 s = NumShapes; s < ShapeCells.Num(); ++s)
+	{
+		RemoveFromCells(ShapeCells[s], [s](const FCanvasHitItem& Item)
+		{
+			return Item.Type != ECanvasHitType::SeamLine && Item.Index == s;
+		});
+	}
+	if (ShapeCells.Num() != NumShapes)
+	{
+		bSeamsDirty = true;
+	}
+
+	const int32 OldNum = ShapeCells.Num();
+	ShapeCells.SetNum(NumShapes);
+	ShapePointCounts.SetNum(NumShapes);
+	DirtyShapes.SetNumUninitialized(NumShapes);
+	if (NumShapes > OldNum)
+	{
+		DirtyShapes.SetRange(OldNum, NumShapes - OldNum, true);
+	}
+
+	bool bAnyShapeDirty = false;
+	for (int32 s = 0; s < NumShapes; ++s)
+	{
+		if (ShapePointCounts[s] != Shapes[s].Points.Num())
+		{
+			DirtyShapes[s] = true;
+		}
+		if (DirtyShapes[s] && BezierFlags.IsValidIndex(s))
+		{
+			IndexShape(s, Shapes[s], BezierFlags[s], FShapeTransform2D::Get(Transforms, s));
+			bAnyShapeDirty = true;
+		}
+	}
+
+	if (bSeamsDirty || SeamCells.Num() != Seams.Num())
+	{
+		for (int32 s = 0; s < SeamCells.Num(); ++s)
+		{
+			RemoveFromCells(SeamCells[s], [](const FCanvasHitItem& Item) { return Item.Type == ECanvasHitType::SeamLine; });
+		}
+		Unbucketed.Reset();
+		SeamCells.SetNum(Seams.Num());
+		for (int32 s = 0; s < Seams.Num(); ++s)
+		{
+			SeamCells[s].Reset();
+			IndexSeam(s, Seams[s], Shapes, Transforms);
+		}
+		bSeamsDirty = false;
+	}
+	else if (bAnyShapeDirty)
+	{
+		// only the seams attached to edited shapes moved
+		for (int32 s = 0; s < Seams.Num(); ++s)
+		{
+			const FSeamDefinition& SD = Seams[s];
+			const bool bTouchesDirty =
+				(DirtyShapes.IsValidIndex(SD.ShapeA) && DirtyShapes[SD.ShapeA]) ||
+				(DirtyShapes.IsValidIndex(SD.ShapeB) && DirtyShapes[SD.ShapeB]);
+			if (!bTouchesDirty) continue;
+
+			RemoveFromCells(SeamCells[s], [s](const FCanvasHitItem& Item)
+			{
+				return Item.Type == ECanvasHitType::SeamLine && Item.Index == s;
+			});
+			Unbucketed.RemoveAllSwap([s](const FCanvasHitItem& Item) { return Item.Index == s; });
+			SeamCells[s].Reset();
+			IndexSeam(s, SD, Shapes, Transforms);
+		}
+	}
+
+	DirtyShapes.SetRange(0, NumShapes, false);
+}
+
+
+void FCanvasSpatialIndex::MarkShapeDirty(int32 ShapeIndex)
+{
+	if (DirtyShapes.IsValidIndex(ShapeIndex))
+	{
+		DirtyShapes[ShapeIndex] = true;
+	}
+}
+
+
+void FCanvasSpatialIndex::MarkSeamsDirty()
+{
+	bSeamsDirty = true;
+}
+
+
+void FCanvasSpatialIndex::InvalidateAll()
+{
+	Cells.Reset();
+	Unbucketed.Reset();
+	ShapeCells.Reset();
+	ShapePointCounts.Reset();
+	DirtyShapes.Reset();
+	SeamCells.Reset();
+	bSeamsDirty = true;
+}
+
+
+bool FCanvasSpatialIndex::FindNearest(
+	const FVector2D& Pos,
+	std::initializer_list<ECanvasHitType> Types,
+	float& InOutBestDistSq,
+	FCanvasHitItem& OutHit) const
+{
+	bool bFound = false;
+	auto TestItem = [&](const FCanvasHitItem& Item)
+	{
+		bool bWanted = false;
+		for (ECanvasHitType Type : Types)
+		{
+			bWanted |= (Item.Type == Type);
+		}
+		if (!bWanted) return;
+
+		const float DistSq = DistPointToSegmentSq(Pos, Item.A, Item.B);
+		if (DistSq < InOutBestDistSq)
+		{
+			InOutBestDistSq = DistSq;
+			OutHit = Item;
+			bFound = true;
+		}
+	};
+
+	const float Radius = FMath::Sqrt(InOutBestDistSq);
+	const FIntPoint MinCell = CellOf(Pos - FVector2D(Radius));
+	const FIntPoint MaxCell = CellOf(Pos + FVector2D(Radius));
+	const int64 NumQueryCells = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1);
+
+	if (NumQueryCells > Cells.Num())
+	{
+		// zoomed far out: visiting occupied cells is cheaper than probing empty ones
+		for (const TPair<FIntPoint, TArray<FCanvasHitItem>>& Cell : Cells)
+		{
+			for (const FCanvasHitItem& Item : Cell.Value) TestItem(Item);
+		}
+	}
+	else
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+			{
+				if (const TArray<FCanvasHitItem>* Items = Cells.Find(FIntPoint(X, Y)))
+				{
+					for (const FCanvasHitItem& Item : *Items) TestItem(Item);
+				}
+			}
+		}
+	}
+
+	for (const FCanvasHitItem& Item : Unbucketed) TestItem(Item);
+
+	return bFound;
+}
+
+
+float FCanvasSpatialIndex::DistPointToSegmentSq(const FVector2D& P, const FVector2D& A, const FVector2D& B)
+{
+	const FVector2D AB = B - A;
+	const FVector2D AP = P - A;
+	float ABLen2 = AB.SizeSquared();
+	if (ABLen2 <= KINDA_SMALL_NUMBER)
+	{
+		return AP.SizeSquared(); // A==B degenerate
+	}
+	float t = FVector2D::DotProduct(AP, AB) / ABLen2;
+	t = FMath::Clamp(t, 0.0f, 1.0f);
+	FVector2D Closest = A + AB * t;
+	return FVector2D::DistSquared(Closest, P);
+}
+
+
+FIntPoint FCanvasSpatialIndex::CellOf(const FVector2D& Pos)
+{
+	return FIntPoint(FMath::FloorToInt32(Pos.X / CellSize), FMath::FloorToInt32(Pos.Y / CellSize));
+}
+
+
+void FCanvasSpatialIndex::Insert(const FCanvasHitItem& Item, TSet<FIntPoint>& OutCells)
+{
+	const FIntPoint MinCell = CellOf(FVector2D(FMath::Min(Item.A.X, Item.B.X), FMath::Min(Item.A.Y, Item.B.Y)));
+	const FIntPoint MaxCell = CellOf(FVector2D(FMath::Max(Item.A.X, Item.B.X), FMath::Max(Item.A.Y, Item.B.Y)));
+	const int64 NumItemCells = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1);
+
+	if (NumItemCells > MaxCellsPerSegment)
+	{
+		Unbucketed.Add(Item);
+		return;
+	}
+
+	for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+	{
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			const FIntPoint Key(X, Y);
+			Cells.FindOrAdd(Key).Add(Item);
+			OutCells.Add(Key);
+		}
+	}
+}
+
+
+void FCanvasSpatialIndex::RemoveFromCells(const TSet<FIntPoint>& CellKeys, TFunctionRef<bool(const FCanvasHitItem&)> Pred)
+{
+	for (const FIntPoint& Key : CellKeys)
+	{
+		if (TArray<FCanvasHitItem>* Items = Cells.Find(Key))
+		{
+			Items->RemoveAllSwap([&Pred](const FCanvasHitItem& Item) { return Pred(Item); });
+			if (Items->Num() == 0)
+			{
+				Cells.Remove(Key);
+			}
+		}
+	}
+}
+
+
+void FCanvasSpatialIndex::IndexShape(int32 ShapeIndex, const FInterpCurve<FVector2D>& Shape, const TArray<bool>& Flags, const FShapeTransform2D& Transform)
+{
+	RemoveFromCells(ShapeCells[ShapeIndex], [ShapeIndex](const FCanvasHitItem& Item)
+	{
+		return Item.Type != ECanvasHitType::SeamLine && Item.Index == ShapeIndex;
+	});
+	ShapeCells[ShapeIndex].Reset();
+
+	for (int32 i = 0; i < Shape.Points.Num(); ++i)
+	{
+		// points are stored in shape-local space; the index works in canvas space
+		const FInterpCurvePoint<FVector2D>& Pt = Shape.Points[i];
+		const FVector2D World = Transform.TransformPoint(Pt.OutVal);
+		Insert({ World, World, ECanvasHitType::Point, ShapeIndex, i }, ShapeCells[ShapeIndex]);
+
+		// N-points have no draggable handles
+		if (!Flags.IsValidIndex(i) || !Flags[i]) continue;
+
+		const FVector2D Arrive = World - Transform.TransformVector(Pt.ArriveTangent);
+		const FVector2D Leave = World + Transform.TransformVector(Pt.LeaveTangent);
+		Insert({ Arrive, Arrive, ECanvasHitType::ArriveHandle, ShapeIndex, i }, ShapeCells[ShapeIndex]);
+		Insert({ Leave, Leave, ECanvasHitType::LeaveHandle, ShapeIndex, i }, ShapeCells[ShapeIndex]);
+	}
+
+	ShapePointCounts[ShapeIndex] = Shape.Points.Num();
+}
+
+
+void FCanvasSpatialIndex::IndexSeam(int32 SeamIndex, const FSeamDefinition& Seam, const TArray<FInterpCurve<FVector2D>>& Shapes, const TArray<FShapeTransform2D>& Transforms)
+{
+	// seams are only created between completed shapes; HandleSew finalises the curve first
+	auto Resolve = [&Shapes, &Transforms](int32 ShapeIndex, int32 PtIdx, FVector2D& Out) -> bool
+	{
+		if (!Shapes.IsValidIndex(ShapeIndex) || !Shapes[ShapeIndex].Points.IsValidIndex(PtIdx)) return false;
+		Out = FShapeTransform2D::Get(Transforms, ShapeIndex).TransformPoint(Shapes[ShapeIndex].Points[PtIdx].OutVal);
+		return true;
+	};
+
+	FVector2D AStart, BStart, AEnd, BEnd;
+	if (Resolve(Seam.ShapeA, Seam.EdgeA.Start, AStart) && Resolve(Seam.ShapeB, Seam.EdgeB.Start, BStart))
+	{
+		Insert({ AStart, BStart, ECanvasHitType::SeamLine, SeamIndex, 0 }, SeamCells[SeamIndex]);
+	}
+	if (Resolve(Seam.ShapeA, Seam.EdgeA.End, AEnd) && Resolve(Seam.ShapeB, Seam.EdgeB.End, BEnd))
+	{
+		Insert({ AEnd, BEnd, ECanvasHitType::SeamLine, SeamIndex, 1 }, SeamCells[SeamIndex]);
+	}
+}
@@ -0,0 +1,43 @@
+#include "Canvas/CanvasStaticLayer.h"
+#include "Canvas/CanvasPaint.h"
+#include "ClothDesignCanvas.h"
+#include "Rendering/DrawElements.h"
+
+
+void SCanvasStaticLayer::Construct(const FArguments& InArgs)
+{
+	Canvas = InArgs._Canvas;
+	SetClipping(EWidgetClipping::ClipToBounds);
+}
+
+
+int32 SCanvasStaticLayer::OnPaint(
+	const FPaintArgs& Args,
+	const FGeometry& AllottedGeometry,
+	const FSlateRect& CullingRect,
+	FSlateWindowElementList& OutDrawElements,
+	int32 LayerId,
+	const FWidgetStyle& InWidgetStyle,
+	bool bParentEnabled) const
+{
+	if (!Canvas)
+	{
+		return LayerId;
+	}
+
+	// grid connectors rely on clipping, and cached elements keep the clip they were recorded with
+	FSlateClippingZone ClippingZone(AllottedGeometry);
+	OutDrawElements.PushClip(ClippingZone);
+
+	int32 Layer = LayerId + 1;
+	FCanvasPaint Drawer(Canvas);
+	Drawer.SetPass(EPaintPass::Static, Canvas->GetActiveShapeIndex());
+
+	Layer = Drawer.DrawBackground(AllottedGeometry, OutDrawElements, Layer);
+	Layer = Drawer.DrawGrid(AllottedGeometry, OutDrawElements, Layer);
+	Layer = Drawer.DrawFinalisedSeamLines(AllottedGeometry, OutDrawElements, Layer);
+	Layer = Drawer.DrawCompletedShapes(AllottedGeometry, OutDrawElements, Layer);
+
+	OutDrawElements.PopClip();
+	return Layer;
+}
@@ -0,0 +1,277 @@
+#include "Canvas/CanvasUndoHistory.h"
+
+
+SIZE_T FCanvasUndoDelta::GetAllocatedSize() const
+{
+	SIZE_T Size = sizeof(FCanvasUndoDelta);
+	Size += CurvePoints.Points.GetAllocatedSize() + bUseBezierPerPoint.GetAllocatedSize();
+
+	Size += Shapes.GetAllocatedSize() + Moves.GetAllocatedSize();
+	for (const FCanvasShapeUndoRecord& Record : Shapes)
+	{
+		Size += Record.Curve.Points.GetAllocatedSize() + Record.BezierFlags.GetAllocatedSize();
+	}
+
+	Size += Seams.SeamDefinitions.GetAllocatedSize() + Seams.AllDefinedSeams.GetAllocatedSize();
+	for (const FPatternSewingConstraint& Seam : Seams.AllDefinedSeams)
+	{
+		Size += Seam.ScreenPointsA.GetAllocatedSize() + Seam.ScreenPointsB.GetAllocatedSize();
+	}
+	Size += Seams.PreviewPoints.GetAllocatedSize();
+	for (const TPair<int32, TSet<int32>>& Pair : Seams.PreviewPoints)
+	{
+		Size += Pair.Value.GetAllocatedSize();
+	}
+	return Size;
+}
+
+
+FCanvasUndoDelta FCanvasUndoHistory::Capture(const FCanvasUndoTarget& Target, ECanvasUndoScope Scope, int32 ShapeIndex)
+{
+	FCanvasUndoDelta Delta;
+	Delta.Scope = Scope;
+
+	// placement arrays from before shapes had transforms may be short; missing entries are identity
+	auto TransformOf = [&Target](int32 Index) { return FShapeTransform2D::Get(Target.CompletedShapeTransforms, Index); };
+	Delta.PanOffset = Target.PanOffset;
+	Delta.ZoomFactor = Target.ZoomFactor;
+	Delta.SelectedSeamIndex = Target.SelectedSeamIndex;
+
+	if (EnumHasAnyFlags(Scope, ECanvasUndoScope::CurrentCurve))
+	{
+		Delta.CurvePoints = Target.CurvePoints;
+		Delta.bUseBezierPerPoint = Target.bUseBezierPerPoint;
+	}
+
+	if (EnumHasAnyFlags(Scope, ECanvasUndoScope::AllShapes))
+	{
+		Delta.NumCompletedShapes = Target.CompletedShapes.Num();
+		Delta.Shapes.Reserve(Target.CompletedShapes.Num());
+		for (int32 i = 0; i < Target.CompletedShapes.Num(); ++i)
+		{
+			Delta.Shapes.Add({ i, Target.CompletedShapes[i], Target.CompletedBezierFlags[i], TransformOf(i) });
+		}
+	}
+	else
+	{
+		if (EnumHasAnyFlags(Scope, ECanvasUndoScope::Shape) && Target.CompletedShapes.IsValidIndex(ShapeIndex))
+		{
+			Delta.Shapes.Add({ ShapeIndex, Target.CompletedShapes[ShapeIndex], Target.CompletedBezierFlags[ShapeIndex], TransformOf(ShapeIndex) });
+		}
+		if (EnumHasAnyFlags(Scope, ECanvasUndoScope::ShapeMove) && Target.CompletedShapes.IsValidIndex(ShapeIndex))
+		{
+			Delta.Moves.Add({ ShapeIndex, TransformOf(ShapeIndex) });
+		}
+		if (EnumHasAnyFlags(Scope, ECanvasUndoScope::ShapeCount))
+		{
+			Delta.NumCompletedShapes = Target.CompletedShapes.Num();
+		}
+	}
+
+	if (EnumHasAnyFlags(Scope, ECanvasUndoScope::Seams))
+	{
+		const FPatternSewing& Sewing = Target.Sewing;
+		Delta.Seams.SeamDefinitions = Sewing.SeamDefinitions;
+		Delta.Seams.AllDefinedSeams = Sewing.AllDefinedSeams;
+		Delta.Seams.PreviewPoints = Sewing.CurrentSeamPreviewPoints;
+		Delta.Seams.ClickState = Sewing.SeamClickState;
+		Delta.Seams.AStart = Sewing.AStartTarget;
+		Delta.Seams.AEnd = Sewing.AEndTarget;
+		Delta.Seams.BStart = Sewing.BStartTarget;
+		Delta.Seams.BEnd = Sewing.BEndTarget;
+	}
+
+	return Delta;
+}
+
+
+void FCanvasUndoHistory::Apply(const FCanvasUndoTarget& Target, FCanvasUndoDelta& Delta)
+{
+	if (EnumHasAnyFlags(Delta.Scope, ECanvasUndoScope::CurrentCurve))
+	{
+		Swap(Target.CurvePoints, Delta.CurvePoints);
+		Swap(Target.bUseBezierPerPoint, Delta.bUseBezierPerPoint);
+	}
+
+	// Shape count changes only ever happen at the end of the array.
+	const int32 LiveNum = Target.CompletedShapes.Num();
+	Target.CompletedShapeTransforms.SetNum(LiveNum);
+	const bool bResize = Delta.NumCompletedShapes != INDEX_NONE && Delta.NumCompletedShapes != LiveNum;
+	if (bResize)
+	{
+		if (Delta.NumCompletedShapes > LiveNum)
+		{
+			Target.CompletedShapes.SetNum(Delta.NumCompletedShapes);
+			Target.CompletedBezierFlags.SetNum(Delta.NumCompletedShapes);
+			Target.CompletedShapeTransforms.SetNum(Delta.NumCompletedShapes);
+		}
+		else
+		{
+			// Records past the restored count describe shapes that will not exist.
+			const int32 NewNum = Delta.NumCompletedShapes;
+			Delta.Shapes.RemoveAll([NewNum](const FCanvasShapeUndoRecord& Record) { return Record.ShapeIndex >= NewNum; });
+			Delta.Moves.RemoveAll([NewNum](const FCanvasShapeMoveUndoRecord& Record) { return Record.ShapeIndex >= NewNum; });
+		}
+	}
+
+	for (FCanvasShapeUndoRecord& Record : Delta.Shapes)
+	{
+		if (!Target.CompletedShapes.IsValidIndex(Record.ShapeIndex)) continue;
+		Swap(Target.CompletedShapes[Record.ShapeIndex], Record.Curve);
+		Swap(Target.CompletedBezierFlags[Record.ShapeIndex], Record.BezierFlags);
+		Swap(Target.CompletedShapeTransforms[Record.ShapeIndex], Record.Transform);
+	}
+
+	for (FCanvasShapeMoveUndoRecord& Record : Delta.Moves)
+	{
+		if (!Target.CompletedShapeTransforms.IsValidIndex(Record.ShapeIndex)) continue;
+		Swap(Target.CompletedShapeTransforms[Record.ShapeIndex], Record.Transform);
+	}
+
+	if (bResize)
+	{
+		if (Delta.NumCompletedShapes > LiveNum)
+		{
+			// The grown slots were swapped with the recorded shapes and now hold empty curves.
+			Delta.Shapes.RemoveAll([LiveNum](const FCanvasShapeUndoRecord& Record) { return Record.ShapeIndex >= LiveNum; });
+		}
+		else
+		{
+			// Keep the removed tail so the inverse edit can bring it back.
+			for (int32 i = Delta.NumCompletedShapes; i < LiveNum; ++i)
+			{
+				Delta.Shapes.Add({ i, MoveTemp(Target.CompletedShapes[i]), MoveTemp(Target.CompletedBezierFlags[i]), Target.CompletedShapeTransforms[i] });
+			}
+			Target.CompletedShapes.SetNum(Delta.NumCompletedShapes);
+			Target.CompletedBezierFlags.SetNum(Delta.NumCompletedShapes);
+			Target.CompletedShapeTransforms.SetNum(Delta.NumCompletedShapes);
+		}
+	}
+	if (Delta.NumCompletedShapes != INDEX_NONE)
+	{
+		Delta.NumCompletedShapes = LiveNum;
+	}
+
+	if (EnumHasAnyFlags(Delta.Scope, ECanvasUndoScope::Seams))
+	{
+		FPatternSewing& Sewing = Target.Sewing;
+		Swap(Sewing.SeamDefinitions, Delta.Seams.SeamDefinitions);
+		Swap(Sewing.AllDefinedSeams, Delta.Seams.AllDefinedSeams);
+		Swap(Sewing.CurrentSeamPreviewPoints, Delta.Seams.PreviewPoints);
+		Swap(Sewing.SeamClickState, Delta.Seams.ClickState);
+		Swap(Sewing.AStartTarget, Delta.Seams.AStart);
+		Swap(Sewing.AEndTarget, Delta.Seams.AEnd);
+		Swap(Sewing.BStartTarget, Delta.Seams.BStart);
+		Swap(Sewing.BEndTarget, Delta.Seams.BEnd);
+	}
+
+	Swap(Target.PanOffset, Delta.PanOffset);
+	Swap(Target.ZoomFactor, Delta.ZoomFactor);
+	Swap(Target.SelectedSeamIndex, Delta.SelectedSeamIndex);
+}
+
+
+void FCanvasUndoHistory::Record(FCanvasUndoDelta&& Delta)
+{
+	for (const FCanvasUndoDelta& Redo : RedoStack)
+	{
+		UsedMemoryBytes -= Redo.GetAllocatedSize();
+	}
+	RedoStack.Reset();
+
+	UsedMemoryBytes += Delta.GetAllocatedSize();
+	UndoStack.Add(MoveTemp(Delta));
+
+	EnforceMemoryCap();
+}
+
+
+void FCanvasUndoHistory::ApplyAndCollect(const FCanvasUndoTarget& Target, FCanvasUndoDelta& Delta, TArray<int32>* OutEditedShapes)
+{
+	// records hold the shapes about to be swapped in; collect them before Apply turns the delta around
+	TArray<int32> Edited;
+	if (OutEditedShapes)
+	{
+		Edited.Reserve(Delta.Shapes.Num());
+		for (const FCanvasShapeUndoRecord& Record : Delta.Shapes)
+		{
+			Edited.Add(Record.ShapeIndex);
+		}
+	}
+
+	Apply(Target, Delta);
+
+	if (OutEditedShapes)
+	{
+		const int32 NumShapes = Target.CompletedShapes.Num();
+		Edited.RemoveAll([NumShapes](int32 ShapeIndex) { return ShapeIndex < 0 || ShapeIndex >= NumShapes; });
+		*OutEditedShapes = MoveTemp(Edited);
+	}
+}
+
+
+bool FCanvasUndoHistory::Undo(const FCanvasUndoTarget& Target, TArray<int32>* OutEditedShapes)
+{
+	if (UndoStack.Num() == 0)
+	{
+		return false;
+	}
+
+	FCanvasUndoDelta Delta = UndoStack.Pop(EAllowShrinking::No);
+	UsedMemoryBytes -= Delta.GetAllocatedSize();
+
+	ApplyAndCollect(Target, Delta, OutEditedShapes);
+
+	UsedMemoryBytes += Delta.GetAllocatedSize();
+	RedoStack.Add(MoveTemp(Delta));
+	return true;
+}
+
+
+bool FCanvasUndoHistory::Redo(const FCanvasUndoTarget& Target, TArray<int32>* OutEditedShapes)
+{
+	if (RedoStack.Num() == 0)
+	{
+		return false;
+	}
+
+	FCanvasUndoDelta Delta = RedoStack.Pop(EAllowShrinking::No);
+	UsedMemoryBytes -= Delta.GetAllocatedSize();
+
+	ApplyAndCollect(Target, Delta, OutEditedShapes);
+
+	UsedMemoryBytes += Delta.GetAllocatedSize();
+	UndoStack.Add(MoveTemp(Delta));
+	return true;
+}
+
+
+void FCanvasUndoHistory::Reset()
+{
+	UndoStack.Empty();
+	RedoStack.Empty();
+	UsedMemoryBytes = 0;
+}
+
+
+void FCanvasUndoHistory::SetMaxMemoryBytes(SIZE_T InMaxMemoryBytes)
+{
+	MaxMemoryBytes = InMaxMemoryBytes;
+	EnforceMemoryCap();
+}
+
+
+void FCanvasUndoHistory::EnforceMemoryCap()
+{
+	// Drop the oldest steps first, but always keep the newest one.
+	int32 NumToDrop = 0;
+	while (UsedMemoryBytes > MaxMemoryBytes && NumToDrop < UndoStack.Num() - 1)
+	{
+		UsedMemoryBytes -= UndoStack[NumToDrop].GetAllocatedSize();
+		++NumToDrop;
+	}
+	if (NumToDrop > 0)
+	{
+		UndoStack.RemoveAt(0, NumToDrop, EAllowShrinking::No);
+	}
+}
@@ -1,52 +1,36 @@
 #include "Canvas/CanvasUtils.h"
 
-void FCanvasUtils::SaveStateForUndo(
-	TArray<FCanvasState>& UndoStack,
-	TArray<FCanvasState>& RedoStack,
-	const FCanvasState& CurrentState)
+void FCanvasUtils::RecalculateNTangents(
+	FInterpCurve<FVector2D>& Curve,
+	const TArray<bool>&      bBezierFlags)
 {
-	UndoStack.Add(CurrentState);
-	RedoStack.Empty();
+	RecalculateNTangentsInRange(Curve, bBezierFlags, 0, Curve.Points.Num() - 1);
 }
 
 
-bool FCanvasUtils::Undo(
-	TArray<FCanvasState>& UndoStack,
-	TArray<FCanvasState>& RedoStack,
-	FCanvasState& CurrentState)
-{
-	if (UndoStack.Num() > 0)
-	{
-		RedoStack.Add(CurrentState);
-		CurrentState = UndoStack.Pop();
-		return true;
-	}
-	return false;
-}
-
-bool FCanvasUtils::Redo(
-	TArray<FCanvasState>& UndoStack,
-	TArray<FCanvasState>& RedoStack,
-	FCanvasState& CurrentState)
+void FCanvasUtils::RecalculateNTangentsAround(
+	FInterpCurve<FVector2D>& Curve,
+	const TArray<bool>&      bBezierFlags,
+	int32                    PointIndex)
 {
-	if (RedoStack.Num() > 0)
-	{
-		UndoStack.Add(CurrentState);
-		CurrentState = RedoStack.Pop();
-		return true;
-	}
-	return false;
+	// a point's N-tangents only depend on its direct neighbours
+	RecalculateNTangentsInRange(Curve, bBezierFlags, PointIndex - 1, PointIndex + 1);
 }
 
 
-void FCanvasUtils::RecalculateNTangents(
+void FCanvasUtils::RecalculateNTangentsInRange(
 	FInterpCurve<FVector2D>& Curve,
-	const TArray<bool>&      bBezierFlags)
+	const TArray<bool>&      bBezierFlags,
+	int32                    FirstIndex,
+	int32                    LastIndex)
 {
 	int32 Num = Curve.Points.Num();
 	if (Num < 2) return;
 
-	for (int32 i = 0; i < Num; ++i)
+	FirstIndex = FMath::Max(FirstIndex, 0);
+	LastIndex  = FMath::Min(LastIndex, Num - 1);
+
+	for (int32 i = FirstIndex; i <= LastIndex; ++i)
 	{
 		// Only operate on N‑points/ linear points
 		if (bBezierFlags[i]) continue;
@@ -136,3 +120,18 @@ void FCanvasUtils::TranslateDynamicMeshBy(UE::Geometry::FDynamicMesh3& Mesh, con
 }
 
 
+bool FCanvasUtils::IsPointInPolyline(const FVector2D& P, const TArray<FVector2D>& Polyline)
+{
+	bool bInside = false;
+	for (int32 i = 0, j = Polyline.Num() - 1; i < Polyline.Num(); j = i++)
+	{
+		const FVector2D& A = Polyline[i];
+		const FVector2D& B = Polyline[j];
+		if (((A.Y > P.Y) != (B.Y > P.Y)) &&
+			(P.X < (B.X - A.X) * (P.Y - A.Y) / (B.Y - A.Y) + A.X))
+		{
+			bInside = !bInside;
+		}
+	}
+	return bInside;
+}
@@ -18,23 +18,122 @@
 #include "Misc/PackageName.h"
 
 #include "Canvas/CanvasPaint.h"
+#include "Canvas/CanvasStaticLayer.h"
+#include "Slate/SInvalidationPanel.h"
 #include "Canvas/CanvasUtils.h"
 #include "Canvas/CanvasInputHandler.h"
 #include "PatternCreation/MeshTriangulation.h"
+#include "PatternCreation/PatternLiveDeform.h"
+#include "PatternCreation/PatternRetriangulation.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
 #include "Editor.h"
 #include "Engine/World.h"
 #include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+#include "Misc/Paths.h"
+#include "Algo/Accumulate.h"
+#include "PatternCreation/PatternCurveFit.h"
+
+static TAutoConsoleVariable<int32> CVarClothDesignUndoMemoryMB(
+	TEXT("ClothDesign.UndoMemoryMB"),
+	64,
+	TEXT("Memory budget in MB for the 2D canvas undo/redo history. The oldest steps are dropped first."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarClothDesignLiveMeshUpdate(
+	TEXT("ClothDesign.LiveMeshUpdate"),
+	1,
+	TEXT("If non-zero, spawned pattern meshes follow point and tangent drags and are re-triangulated on release."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarClothDesignLiveRetriangulate(
+	TEXT("ClothDesign.LiveRetriangulate"),
+	1,
+	TEXT("If non-zero, edited shapes are re-triangulated on worker threads while dragging instead of synchronously on release."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarClothDesignRetriangulateBudgetMs(
+	TEXT("ClothDesign.LiveRetriangulateBudgetMs"),
+	2.0f,
+	TEXT("Milliseconds per frame spent swapping finished background triangulations into their actors."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarClothDesignAutosaveIntervalSeconds(
+	TEXT("ClothDesign.AutosaveIntervalSeconds"),
+	0.0f,
+	TEXT("Seconds between background autosaves of an edited canvas to ClothDesignAssets/Autosave. 0 disables autosave."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarClothDesignFitTolerance(
+	TEXT("ClothDesign.FitTolerance"),
+	0.1f,
+	TEXT("Largest distance in canvas units between a dense outline and its Bezier fit, used when importing and simplifying shapes. 0 keeps imported outlines as they are."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarClothDesignBackgroundTileBudgetMB(
+	TEXT("ClothDesign.BackgroundTileBudgetMB"),
+	256,
+	TEXT("Megabytes per canvas for the background image: its CPU mip pyramid (about 1.33x the full image) plus uploaded tiles. The finest pyramid levels are dropped when the pyramid alone is over budget; tiles on screen are kept even above it."),
+	ECVF_Default);
+
+namespace
+{
+	/** Shows the outcome of a background save in the editor's notification area. */
+	void NotifySaveFinished(const FString& AssetName, bool bSucceeded, bool bAutosave)
+	{
+		// successful autosaves stay quiet, they happen in the background by design
+		if (bAutosave && bSucceeded)
+		{
+			return;
+		}
+
+		const FString Message = bSucceeded
+			? FString::Printf(TEXT("Saved %s"), *AssetName)
+			: FString::Printf(TEXT("%s %s failed"), bAutosave ? TEXT("Autosave of") : TEXT("Saving"), *AssetName);
+
+		FNotificationInfo Info(FText::FromString(Message));
+		Info.ExpireDuration = 3.0f;
+		TSharedPtr<SNotificationItem> Item = FSlateNotificationManager::Get().AddNotification(Info);
+		if (Item.IsValid())
+		{
+			Item->SetCompletionState(bSucceeded ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+		}
+	}
+
+	/** Shows the outcome of a pattern file import. */
+	void NotifyImportFinished(const FPatternImportResult& Result)
+	{
+		const FString FileName = FPaths::GetCleanFilename(Result.FilePath);
+		const FString Message = Result.bSucceeded
+			? FString::Printf(TEXT("Imported %d pieces from %s"), Result.Data.CompletedShapes.Num(), *FileName)
+			: FString::Printf(TEXT("Importing %s failed: %s"), *FileName, *Result.Error);
+
+		FNotificationInfo Info(FText::FromString(Message));
+		Info.ExpireDuration = Result.bSucceeded ? 3.0f : 6.0f;
+		TSharedPtr<SNotificationItem> Item = FSlateNotificationManager::Get().AddNotification(Info);
+		if (Item.IsValid())
+		{
+			Item->SetCompletionState(Result.bSucceeded ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+		}
+	}
+}
 
 void SClothDesignCanvas::Construct(const FArguments& InArgs)
 {
+	// static content is cached by the invalidation panel; OnPaint draws the edited shape on top
 	ChildSlot
 	[
 		SNew(SOverlay)
 		+ SOverlay::Slot()
 		[
-			SNullWidget::NullWidget
+			SNew(SInvalidationPanel)
+			[
+				SAssignNew(StaticLayer, SCanvasStaticLayer)
+				.Canvas(this)
+			]
 		]
 	];
 	
@@ -55,6 +154,126 @@ FVector2D SClothDesignCanvas::InverseTransformPoint(const FVector2D& ScreenPoint
 	return (ScreenPoint - PanOffset) / ZoomFactor;
 }
 
+int32 SClothDesignCanvas::GetActiveShapeIndex() const
+{
+	return (bIsDraggingPoint || bIsDraggingTangent || bIsDraggingShape) ? SelectedShapeIndex : INDEX_NONE;
+}
+
+
+void SClothDesignCanvas::SetShapeTransform(int32 ShapeIndex, const FShapeTransform2D& NewTransform)
+{
+	if (!CompletedShapes.IsValidIndex(ShapeIndex))
+	{
+		return;
+	}
+	CompletedShapeTransforms.SetNum(CompletedShapes.Num());
+
+	const FShapeTransform2D OldTransform = CompletedShapeTransforms[ShapeIndex];
+	if (OldTransform == NewTransform)
+	{
+		return;
+	}
+	CompletedShapeTransforms[ShapeIndex] = NewTransform;
+
+	// the points did not change, so the tessellation and the mesh stay valid
+	ShapeCache.MarkShapeMoved(ShapeIndex);
+	HitIndex.MarkShapeDirty(ShapeIndex);
+
+	if (APatternMesh* Actor = GetShapeActor(ShapeIndex))
+	{
+		FMeshTriangulation::MoveActorWithShape(Actor, OldTransform, NewTransform);
+	}
+}
+
+
+bool SClothDesignCanvas::RotateSelectedShape(double DeltaDegrees)
+{
+	if (!CompletedShapes.IsValidIndex(SelectedShapeIndex))
+	{
+		return false;
+	}
+
+	const FCanvasCachedShape& Cached = ShapeCache.GetShape(SelectedShapeIndex, CompletedShapes[SelectedShapeIndex], SewingManager.SeamDefinitions);
+	if (!Cached.Bounds.bIsValid)
+	{
+		return false;
+	}
+
+	SaveStateForUndo(ECanvasUndoScope::ShapeMove, SelectedShapeIndex);
+
+	FShapeTransform2D Transform = FShapeTransform2D::Get(CompletedShapeTransforms, SelectedShapeIndex);
+	Transform.RotateAbout(Transform.TransformPoint(Cached.Bounds.GetCenter()), DeltaDegrees);
+	SetShapeTransform(SelectedShapeIndex, Transform);
+
+	Invalidate(EInvalidateWidgetReason::Paint);
+	return true;
+}
+
+void SClothDesignCanvas::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	ApplyPendingDrag();
+
+	if (AssetSaver.IsBusy())
+	{
+		AssetSaver.Tick();
+	}
+	TickAutosave(InCurrentTime);
+
+	if (PendingImport.IsValid())
+	{
+		TickPendingImport();
+	}
+
+	if (RetriangulationQueue.IsBusy())
+	{
+		TArray<APatternMesh*> Rebuilt;
+		RetriangulationQueue.Tick(CVarClothDesignRetriangulateBudgetMs.GetValueOnGameThread() / 1000.0, &Rebuilt);
+
+		// the deform weights refer to the replaced triangulation; rebind on the next drag update
+		if (Rebuilt.Contains(LiveDeform.GetBoundActor()))
+		{
+			LiveDeform.Reset();
+		}
+	}
+
+	BackgroundTiles.SetTexture(BackgroundTexture.Get());
+	BackgroundTiles.Tick(static_cast<int64>(FMath::Max(0, CVarClothDesignBackgroundTileBudgetMB.GetValueOnGameThread())) * 1024 * 1024);
+
+	if (!StaticLayer.IsValid())
+	{
+		return;
+	}
+
+	ShapeCache.SetActiveShape(GetActiveShapeIndex());
+
+	// everything the cached layer depends on; edits to the dragged shape are excluded by the cache
+	int32 NumPreviewPoints = 0;
+	for (const TPair<int32, TSet<int32>>& Pair : SewingManager.CurrentSeamPreviewPoints)
+	{
+		NumPreviewPoints += Pair.Value.Num();
+	}
+
+	uint32 Key = GetTypeHash(ShapeCache.GetStaticVersion());
+	Key = HashCombineFast(Key, GetTypeHash(PanOffset));
+	Key = HashCombineFast(Key, GetTypeHash(ZoomFactor));
+	Key = HashCombineFast(Key, GetTypeHash(AllottedGeometry.GetLocalSize()));
+	Key = HashCombineFast(Key, GetTypeHash(BackgroundTexture.Get()));
+	Key = HashCombineFast(Key, GetTypeHash(BackgroundImageScale));
+	Key = HashCombineFast(Key, GetTypeHash(BackgroundTiles.GetVersion()));
+	Key = HashCombineFast(Key, GetTypeHash(CompletedShapes.Num()));
+	Key = HashCombineFast(Key, GetTypeHash(SewingManager.SeamDefinitions.Num()));
+	Key = HashCombineFast(Key, GetTypeHash(SelectedSeamIndex));
+	Key = HashCombineFast(Key, GetTypeHash(NumPreviewPoints));
+
+	if (Key != StaticLayerKey)
+	{
+		StaticLayerKey = Key;
+		StaticLayer->Invalidate(EInvalidateWidgetReason::Paint);
+	}
+}
+
 int32 SClothDesignCanvas::OnPaint(
 	const FPaintArgs& Args,
 	const FGeometry& AllottedGeometry,
@@ -72,11 +291,24 @@ int32 SClothDesignCanvas::OnPaint(
 	
 	int32 Layer = LayerId + 1;  // Instead of 0 as it errors
 	FCanvasPaint Drawer(const_cast<SClothDesignCanvas*>(this));
-	
-	Layer = Drawer.DrawBackground(AllottedGeometry, OutDrawElements, Layer);
-	Layer = Drawer.DrawGrid(AllottedGeometry, OutDrawElements, Layer);
-	Layer = Drawer.DrawFinalisedSeamLines(AllottedGeometry, OutDrawElements, Layer);
-	Layer = Drawer.DrawCompletedShapes(AllottedGeometry, OutDrawElements, Layer);
+
+	if (StaticLayer.IsValid())
+	{
+		// cached background, grid, seams and shapes, then only the edited shape live on top
+		Layer = SCompoundWidget::OnPaint(Args, AllottedGeometry, CullingRect, OutDrawElements, Layer, InWidgetStyle, bParentEnabled) + 1;
+
+		// with no active shape this still draws seams attached to the in-progress curve
+		Drawer.SetPass(EPaintPass::Active, GetActiveShapeIndex());
+		Layer = Drawer.DrawFinalisedSeamLines(AllottedGeometry, OutDrawElements, Layer);
+		Layer = Drawer.DrawCompletedShapes(AllottedGeometry, OutDrawElements, Layer);
+	}
+	else
+	{
+		Layer = Drawer.DrawBackground(AllottedGeometry, OutDrawElements, Layer);
+		Layer = Drawer.DrawGrid(AllottedGeometry, OutDrawElements, Layer);
+		Layer = Drawer.DrawFinalisedSeamLines(AllottedGeometry, OutDrawElements, Layer);
+		Layer = Drawer.DrawCompletedShapes(AllottedGeometry, OutDrawElements, Layer);
+	}
 	Layer = Drawer.DrawCurrentShape(AllottedGeometry, OutDrawElements, Layer);
 
 	
@@ -189,113 +421,280 @@ FReply SClothDesignCanvas::OnMouseMove(const FGeometry& Geometry, const FPointer
 		FVector2D LocalMousePos = Geometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition());
 		const FVector2D CanvasMousePos = InverseTransformPoint(LocalMousePos);
 
-		if (bIsDraggingTangent && SelectedPointIndex != INDEX_NONE)
+		// coalesced: the drag is applied at most once per frame, in Tick
+		if (((bIsDraggingTangent || bIsDraggingPoint) && SelectedPointIndex != INDEX_NONE) ||
+			(bIsDraggingShape && CompletedShapes.IsValidIndex(SelectedShapeIndex)))
 		{
-			
-			if (SelectedShapeIndex == INDEX_NONE)
-			{
-	
-				// In-progress point (CurvePoints)
-				FInterpCurvePoint<FVector2D>& Pt = CurvePoints.Points[SelectedPointIndex];
-				FVector2D PointPos = Pt.OutVal;
-				FVector2D Delta = CanvasMousePos - PointPos;
+			PendingDragPos = CanvasMousePos;
+			return FReply::Handled();
+		}
+	}
 
-				bool bIsBezierPoint = bUseBezierPerPoint[SelectedPointIndex];
-				bool bLinkTangents  = bIsBezierPoint && !bSeparateTangents;
+	return FReply::Unhandled();
+}
 
-				if (SelectedTangentHandle == ETangentHandle::Arrive)
-				{
-					Pt.ArriveTangent = -Delta;
-					if (bLinkTangents)
-					{
-						float LeaveLen = Pt.LeaveTangent.Size();
-						FVector2D OppositeDir = -Delta.GetSafeNormal();
-						Pt.LeaveTangent = OppositeDir * LeaveLen;
-					}
-				}
-				else // Leave
+
+void SClothDesignCanvas::ApplyPendingDrag()
+{
+	if (!PendingDragPos.IsSet())
+	{
+		return;
+	}
+	const FVector2D CanvasMousePos = PendingDragPos.GetValue();
+	PendingDragPos.Reset();
+
+	if (bIsDraggingTangent && SelectedPointIndex != INDEX_NONE)
+	{
+		
+		if (SelectedShapeIndex == INDEX_NONE)
+		{
+
+			// In-progress point (CurvePoints)
+			FInterpCurvePoint<FVector2D>& Pt = CurvePoints.Points[SelectedPointIndex];
+			FVector2D PointPos = Pt.OutVal;
+			FVector2D Delta = CanvasMousePos - PointPos;
+
+			bool bIsBezierPoint = bUseBezierPerPoint[SelectedPointIndex];
+			bool bLinkTangents  = bIsBezierPoint && !bSeparateTangents;
+
+			if (SelectedTangentHandle == ETangentHandle::Arrive)
+			{
+				Pt.ArriveTangent = -Delta;
+				if (bLinkTangents)
 				{
-					Pt.LeaveTangent = Delta;
-					if (bLinkTangents)
-					{
-						float ArriveLen = Pt.ArriveTangent.Size();  // preserve original length
-						FVector2D OppositeDir = Delta.GetSafeNormal();
-						Pt.ArriveTangent = OppositeDir * ArriveLen;
-					}
+					float LeaveLen = Pt.LeaveTangent.Size();
+					FVector2D OppositeDir = -Delta.GetSafeNormal();
+					Pt.LeaveTangent = OppositeDir * LeaveLen;
 				}
-
 			}
-			else
+			else // Leave
 			{
-				// Completed shape
-				FInterpCurvePoint<FVector2D>& Pt = CompletedShapes[SelectedShapeIndex].Points[SelectedPointIndex];
-				FVector2D PointPos = Pt.OutVal;
-				FVector2D Delta = CanvasMousePos - PointPos;
-				
-				TArray<bool>& BezierFlags = CompletedBezierFlags[SelectedShapeIndex];
-				if (!BezierFlags[SelectedPointIndex])
+				Pt.LeaveTangent = Delta;
+				if (bLinkTangents)
 				{
-					BezierFlags[SelectedPointIndex] = true;
+					float ArriveLen = Pt.ArriveTangent.Size();  // preserve original length
+					FVector2D OppositeDir = Delta.GetSafeNormal();
+					Pt.ArriveTangent = OppositeDir * ArriveLen;
 				}
-				bool bIsBezierPoint = CompletedBezierFlags[SelectedShapeIndex][SelectedPointIndex];
-				bool bLinkTangents   = bIsBezierPoint && !bSeparateTangents;
+			}
 
-				if (SelectedTangentHandle == ETangentHandle::Arrive)
+		}
+		else
+		{
+			// Completed shape; its points are in local space
+			FInterpCurvePoint<FVector2D>& Pt = CompletedShapes[SelectedShapeIndex].Points[SelectedPointIndex];
+			FVector2D PointPos = Pt.OutVal;
+			FVector2D Delta = FShapeTransform2D::Get(CompletedShapeTransforms, SelectedShapeIndex).InverseTransformPoint(CanvasMousePos) - PointPos;
+			
+			TArray<bool>& BezierFlags = CompletedBezierFlags[SelectedShapeIndex];
+			if (!BezierFlags[SelectedPointIndex])
+			{
+				BezierFlags[SelectedPointIndex] = true;
+			}
+			bool bIsBezierPoint = CompletedBezierFlags[SelectedShapeIndex][SelectedPointIndex];
+			bool bLinkTangents   = bIsBezierPoint && !bSeparateTangents;
+
+			if (SelectedTangentHandle == ETangentHandle::Arrive)
+			{
+				// Always set the arrive tangent
+				Pt.ArriveTangent = -Delta;
+				// Link it to the leave tangent only if decided to link
+				if (bLinkTangents)
 				{
-					// Always set the arrive tangent
-					Pt.ArriveTangent = -Delta;
-					// Link it to the leave tangent only if decided to link
-					if (bLinkTangents)
-					{
-						float LeaveLen = Pt.LeaveTangent.Size();
-						FVector2D OppositeDir = -Delta.GetSafeNormal();
-						Pt.LeaveTangent = OppositeDir * LeaveLen;
-					}
+					float LeaveLen = Pt.LeaveTangent.Size();
+					FVector2D OppositeDir = -Delta.GetSafeNormal();
+					Pt.LeaveTangent = OppositeDir * LeaveLen;
 				}
-				else
+			}
+			else
+			{
+				Pt.LeaveTangent = Delta;
+				if (bLinkTangents)
 				{
-					Pt.LeaveTangent = Delta;
-					if (bLinkTangents)
-					{
-						float ArriveLen = Pt.ArriveTangent.Size();  // preserve original length
-						FVector2D OppositeDir = Delta.GetSafeNormal();
-						Pt.ArriveTangent = OppositeDir * ArriveLen;
-					}
+					float ArriveLen = Pt.ArriveTangent.Size();  // preserve original length
+					FVector2D OppositeDir = Delta.GetSafeNormal();
+					Pt.ArriveTangent = OppositeDir * ArriveLen;
 				}
-				
 			}
+			ShapeCache.MarkShapeDirty(SelectedShapeIndex);
+			HitIndex.MarkShapeDirty(SelectedShapeIndex);
+			UpdateLiveMesh(SelectedShapeIndex);
+		}
 
-			UE_LOG(LogTemp, Warning, TEXT("Dragging tangent for point %d in shape %d"), SelectedPointIndex, SelectedShapeIndex);
-			return FReply::Handled();
+		UE_LOG(LogTemp, Verbose, TEXT("Dragging tangent for point %d in shape %d"), SelectedPointIndex, SelectedShapeIndex);
+		return;
+	}
+
+	// moving a whole shape only changes its placement
+	if (bIsDraggingShape && CompletedShapes.IsValidIndex(SelectedShapeIndex))
+	{
+		FShapeTransform2D Transform = ShapeDragStartTransform;
+		Transform.Translation += CanvasMousePos - ShapeDragAnchor;
+
+		// capture before the first change, while the shape is still at its start placement
+		if (!bShapeDragRecorded && Transform != FShapeTransform2D::Get(CompletedShapeTransforms, SelectedShapeIndex))
+		{
+			SaveStateForUndo(ECanvasUndoScope::ShapeMove, SelectedShapeIndex);
+			bShapeDragRecorded = true;
 		}
+		SetShapeTransform(SelectedShapeIndex, Transform);
+
+		UE_LOG(LogTemp, Verbose, TEXT("Dragging shape %d"), SelectedShapeIndex);
+		return;
+	}
 
-		// dragging shape points
-		if (bIsDraggingPoint && SelectedPointIndex != INDEX_NONE)
+	// dragging shape points
+	if (bIsDraggingPoint && SelectedPointIndex != INDEX_NONE)
+	{
+		if (SelectedShapeIndex == INDEX_NONE)
 		{
-			if (SelectedShapeIndex == INDEX_NONE)
-			{
-				CurvePoints.Points[SelectedPointIndex].OutVal = CanvasMousePos;
-				// In‑progress curve:
-				if (!bUseBezierPerPoint[SelectedPointIndex])
-					FCanvasUtils::RecalculateNTangents(CurvePoints, bUseBezierPerPoint);
-			}
-			else
-			{
-				CompletedShapes[SelectedShapeIndex].Points[SelectedPointIndex].OutVal = CanvasMousePos;
-				if (!CompletedBezierFlags[SelectedShapeIndex][SelectedPointIndex])
-					FCanvasUtils::RecalculateNTangents(
-						CompletedShapes[SelectedShapeIndex],
-						CompletedBezierFlags[SelectedShapeIndex]
-					);
-			}
+			CurvePoints.Points[SelectedPointIndex].OutVal = CanvasMousePos;
+			// In‑progress curve: only the point and its neighbours change
+			FCanvasUtils::RecalculateNTangentsAround(CurvePoints, bUseBezierPerPoint, SelectedPointIndex);
+		}
+		else
+		{
+			CompletedShapes[SelectedShapeIndex].Points[SelectedPointIndex].OutVal =
+				FShapeTransform2D::Get(CompletedShapeTransforms, SelectedShapeIndex).InverseTransformPoint(CanvasMousePos);
+			FCanvasUtils::RecalculateNTangentsAround(
+				CompletedShapes[SelectedShapeIndex],
+				CompletedBezierFlags[SelectedShapeIndex],
+				SelectedPointIndex
+			);
+			ShapeCache.MarkShapeDirty(SelectedShapeIndex);
+			HitIndex.MarkShapeDirty(SelectedShapeIndex);
+			UpdateLiveMesh(SelectedShapeIndex);
+		}
 
-			UE_LOG(LogTemp, Warning, TEXT("Dragging point %d in shape %d"), SelectedPointIndex, SelectedShapeIndex);
-			return FReply::Handled();
+		UE_LOG(LogTemp, Verbose, TEXT("Dragging point %d in shape %d"), SelectedPointIndex, SelectedShapeIndex);
+	}
+}
+
+
+void SClothDesignCanvas::UpdateLiveMesh(int32 ShapeIndex)
+{
+	if (!CompletedShapes.IsValidIndex(ShapeIndex))
+	{
+		return;
+	}
+
+	APatternMesh* Actor = GetShapeActor(ShapeIndex);
+	if (!Actor || !Actor->MeshComponent)
+	{
+		return;
+	}
+
+	if (CVarClothDesignLiveRetriangulate.GetValueOnGameThread() != 0)
+	{
+		// supersedes any build of an older snapshot of this shape
+		RetriangulationQueue.Request(ShapeIndex, CompletedShapes[ShapeIndex], Actor);
+	}
+
+	if (CVarClothDesignLiveMeshUpdate.GetValueOnGameThread() == 0)
+	{
+		return;
+	}
+
+	if (LiveDeform.GetBoundActor() != Actor && !LiveDeform.Bind(*Actor))
+	{
+		return;
+	}
+
+	TArray<FVector2f> Boundary;
+	FMeshTriangulation::SampleBoundary(CompletedShapes[ShapeIndex], Boundary);
+
+	TArray<FVector> Positions;
+	if (!LiveDeform.Deform(Boundary, Positions))
+	{
+		return;
+	}
+
+	// collision is not re-cooked for every drag frame; FinishLiveMesh restores it
+	if (FProcMeshSection* Section = Actor->MeshComponent->GetProcMeshSection(0))
+	{
+		Section->bEnableCollision = false;
+	}
+
+	// position-only update; normals, UVs, colours and tangents are left as they are
+	Actor->MeshComponent->UpdateMeshSection_LinearColor(0, Positions, {}, {}, {}, {});
+}
+
+
+void SClothDesignCanvas::RebuildEditedMeshes(int32 ShapeIndex)
+{
+	if (CVarClothDesignLiveMeshUpdate.GetValueOnGameThread() == 0 &&
+		CVarClothDesignLiveRetriangulate.GetValueOnGameThread() == 0)
+	{
+		// the reminder on entering Select mode covers this
+		return;
+	}
+
+	if (SewingManager.SpawnedPatternActors.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 First = ShapeIndex == INDEX_NONE ? 0 : ShapeIndex;
+	const int32 Last = ShapeIndex == INDEX_NONE ? CompletedShapes.Num() - 1 : ShapeIndex;
+	for (int32 Index = First; Index <= Last && CompletedShapes.IsValidIndex(Index); ++Index)
+	{
+		// a shape without its own actor (added, loaded, or merged away) needs a regenerate
+		APatternMesh* Actor = GetShapeActor(Index);
+		if (!Actor)
+		{
+			bMeshesStale = true;
+			continue;
 		}
-		
+		RetriangulationQueue.Request(Index, CompletedShapes[Index], Actor);
 	}
+}
 
-	return FReply::Unhandled();
+
+APatternMesh* SClothDesignCanvas::GetShapeActor(int32 ShapeIndex) const
+{
+	if (!SewingManager.SpawnedPatternActors.IsValidIndex(ShapeIndex))
+	{
+		return nullptr;
+	}
+
+	APatternMesh* Actor = SewingManager.SpawnedPatternActors[ShapeIndex].Get();
+	if (!Actor || Actor->SourceShapeIndex != ShapeIndex || Actor->SourcePatternGeneration != PatternGeneration)
+	{
+		return nullptr;
+	}
+	return Actor;
+}
+
+
+void SClothDesignCanvas::FinishLiveMesh()
+{
+	APatternMesh* Actor = LiveDeform.GetBoundActor();
+	const bool bWasBound = LiveDeform.IsBound();
+	LiveDeform.Reset();
+
+	if (!bWasBound || !Actor || !Actor->MeshComponent)
+	{
+		return;
+	}
+
+	// a rebuild recreates the section, collision included
+	const int32 ShapeIndex = Actor->SourceShapeIndex;
+	if (CVarClothDesignLiveRetriangulate.GetValueOnGameThread() == 0 &&
+		CompletedShapes.IsValidIndex(ShapeIndex) &&
+		GetShapeActor(ShapeIndex) == Actor &&
+		FMeshTriangulation::RebuildMeshInPlace(CompletedShapes[ShapeIndex], Actor))
+	{
+		return;
+	}
+
+	// the queued background build may still be dropped, so cook the deformed section once now
+	FProcMeshSection* Section = Actor->MeshComponent->GetProcMeshSection(0);
+	if (Section && !Section->bEnableCollision)
+	{
+		FProcMeshSection Restored = *Section;
+		Restored.bEnableCollision = true;
+		Actor->MeshComponent->SetProcMeshSection(0, Restored);
+	}
 }
 
 
@@ -309,10 +708,15 @@ FReply SClothDesignCanvas::OnMouseButtonUp(const FGeometry& Geometry, const FPoi
 
 	if (MouseEvent.GetEffectingButton() == EKeys::LeftMouseButton)
 	{
-		bool WasDragging = bIsDraggingPoint || bIsDraggingTangent;
+		bool WasDragging = bIsDraggingPoint || bIsDraggingTangent || bIsDraggingShape;
+
+		// land exactly where the button was released, even mid-frame
+		ApplyPendingDrag();
+		FinishLiveMesh();
 
 		bIsDraggingPoint = false;
 		bIsDraggingTangent = false;
+		bIsDraggingShape = false;
 		SelectedTangentHandle = ETangentHandle::None;
 		
 		if (WasDragging)
@@ -339,7 +743,7 @@ FReply SClothDesignCanvas::OnKeyDown(const FGeometry& Geometry, const FKeyEvent&
 		// If a seam is selected, delete the seam (remove its bookkeeping + runtime constraint)
 		if (SelectedSeamIndex != INDEX_NONE)
 		{
-			FCanvasUtils::SaveStateForUndo(UndoStack, RedoStack, GetCurrentCanvasState());
+			SaveStateForUndo(ECanvasUndoScope::Seams);
 
 			int32 idx = SelectedSeamIndex;
 
@@ -368,7 +772,7 @@ FReply SClothDesignCanvas::OnKeyDown(const FGeometry& Geometry, const FKeyEvent&
 		
 		if (SelectedPointIndex != INDEX_NONE)
 		{
-			FCanvasUtils::SaveStateForUndo(UndoStack, RedoStack, GetCurrentCanvasState());
+			SaveStateForUndo(SelectedShapeIndex == INDEX_NONE ? ECanvasUndoScope::CurrentCurve : ECanvasUndoScope::Shape, SelectedShapeIndex);
 
 
 			if (SelectedShapeIndex == INDEX_NONE)
@@ -389,6 +793,9 @@ FReply SClothDesignCanvas::OnKeyDown(const FGeometry& Geometry, const FKeyEvent&
 					CompletedShapes[SelectedShapeIndex].Points.RemoveAt(SelectedPointIndex);
 					CompletedBezierFlags[SelectedShapeIndex].RemoveAt(SelectedPointIndex);
 					CompletedShapes[SelectedShapeIndex].AutoSetTangents();
+					ShapeCache.MarkShapeDirty(SelectedShapeIndex);
+					HitIndex.MarkShapeDirty(SelectedShapeIndex);
+					RebuildEditedMeshes(SelectedShapeIndex);
 				}
 			}
 
@@ -429,20 +836,16 @@ FReply SClothDesignCanvas::OnKeyDown(const FGeometry& Geometry, const FKeyEvent&
 	
 	if (Key == EKeys::Z && InKeyEvent.IsControlDown())
 	{
-		FCanvasState CurrentState = GetCurrentCanvasState();
-		if (FCanvasUtils::Undo(UndoStack, RedoStack, CurrentState))
+		if (UndoLastEdit())
 		{
-			RestoreCanvasState(CurrentState);
 			return FReply::Handled();
 		}
 	}
 
 	if (Key == EKeys::Y && InKeyEvent.IsControlDown())
 	{
-		FCanvasState CurrentState = GetCurrentCanvasState();
-		if (FCanvasUtils::Redo(UndoStack, RedoStack, CurrentState))
+		if (RedoLastEdit())
 		{
-			RestoreCanvasState(CurrentState);
 			return FReply::Handled();
 		}
 	}
@@ -460,6 +863,16 @@ FReply SClothDesignCanvas::OnKeyDown(const FGeometry& Geometry, const FKeyEvent&
 			bSeparateTangents = true;
 			return FReply::Handled();
 		}
+
+		// rotate the selected piece; shift for fine steps
+		if (Key == EKeys::Q || Key == EKeys::E)
+		{
+			const double Step = InKeyEvent.IsShiftDown() ? 1.0 : 15.0;
+			if (RotateSelectedShape(Key == EKeys::Q ? Step : -Step))
+			{
+				return FReply::Handled();
+			}
+		}
 	}
 	
 	if (CurrentMode == EClothEditorMode::Draw)
@@ -499,7 +912,7 @@ int32 SClothDesignCanvas::FinaliseCurrentShape(bool bGenerateNow, TArray<TWeakOb
         return INDEX_NONE;
     }
 	
-	FCanvasUtils::SaveStateForUndo(UndoStack, RedoStack, GetCurrentCanvasState());
+	SaveStateForUndo(ECanvasUndoScope::CurrentCurve | ECanvasUndoScope::ShapeCount);
 	
 
     if (CurvePoints.Points.Num() >= 2)
@@ -517,6 +930,7 @@ int32 SClothDesignCanvas::FinaliseCurrentShape(bool bGenerateNow, TArray<TWeakOb
 
     CompletedShapes.Add(CurvePoints);
     CompletedBezierFlags.Add(bUseBezierPerPoint); // keep existing boolean flags array in sync
+    CompletedShapeTransforms.SetNum(CompletedShapes.Num()); // drawn in canvas space, so placed at identity
 
 	int32 NewIndex = CompletedShapes.Num() - 1;
 
@@ -565,11 +979,12 @@ void SClothDesignCanvas::FocusViewportOnPoints()
 	}
 
 	// Collect points from completed shapes
-	for (const FInterpCurve<FVector2D>& Shape : CompletedShapes)
+	for (int32 ShapeIdx = 0; ShapeIdx < CompletedShapes.Num(); ++ShapeIdx)
 	{
-		for (const FInterpCurvePoint<UE::Math::TVector2<double>>& Pt : Shape.Points)
+		const FShapeTransform2D& Transform = FShapeTransform2D::Get(CompletedShapeTransforms, ShapeIdx);
+		for (const FInterpCurvePoint<UE::Math::TVector2<double>>& Pt : CompletedShapes[ShapeIdx].Points)
 		{
-			AllPoints.Add(Pt.OutVal);
+			AllPoints.Add(Transform.TransformPoint(Pt.OutVal));
 		}
 	}
 
@@ -613,7 +1028,7 @@ bool SClothDesignCanvas::AreAtLeastTwoClothMeshesInScene() const
 	for (TActorIterator<APatternMesh> It(World); It; ++It)
 	{
 		APatternMesh* Actor = *It;
-		if (Actor)
+		if (Actor && !FPatternMergePreview::IsPreviewActor(Actor))
 		{
 			Count++;
 			if (Count >= 2)
@@ -633,7 +1048,11 @@ FReply SClothDesignCanvas::OnModeButtonClicked(EClothEditorMode NewMode)
 	CurrentMode = NewMode;
 	Invalidate(EInvalidateWidget::Paint);
 	
-	if (NewMode == EClothEditorMode::Select && ModeReminderText.IsValid())
+	// with live updates the meshes follow edits, unless an edit left them stale
+	const bool bLiveUpdates =
+		CVarClothDesignLiveMeshUpdate.GetValueOnGameThread() != 0 ||
+		CVarClothDesignLiveRetriangulate.GetValueOnGameThread() != 0;
+	if (NewMode == EClothEditorMode::Select && ModeReminderText.IsValid() && (!bLiveUpdates || bMeshesStale))
 	{
 		if (AreAtLeastTwoClothMeshesInScene())
 		{
@@ -697,6 +1116,7 @@ FCanvasState SClothDesignCanvas::GetCurrentCanvasState() const
 	FCanvasState State;
 	State.CurvePoints = CurvePoints; 
 	State.CompletedShapes = CompletedShapes;
+	State.CompletedShapeTransforms = CompletedShapeTransforms;
 	
 	State.bUseBezierPerPoint = bUseBezierPerPoint;
 	State.CompletedBezierFlags = CompletedBezierFlags;
@@ -732,9 +1152,18 @@ void SClothDesignCanvas::RestoreCanvasState(const FCanvasState& State)
 	// to avoid the redo/undo crashes
 	ensure(State.CurvePoints.Points.Num() == State.bUseBezierPerPoint.Num());
 	ensure(State.CompletedShapes.Num() == State.CompletedBezierFlags.Num());
+
+	// spawned actors belong to the previous pattern: finish a live drag on its shapes, drop
+	// pending rebuilds and stop the new pattern's shape indices from reaching those actors
+	FinishLiveMesh();
+	RetriangulationQueue.CancelAll();
+	++PatternGeneration;
+	bMeshesStale = SewingManager.SpawnedPatternActors.Num() > 0;
 	
 	CurvePoints = State.CurvePoints;
 	CompletedShapes = State.CompletedShapes;
+	CompletedShapeTransforms = State.CompletedShapeTransforms;
+	CompletedShapeTransforms.SetNum(CompletedShapes.Num());
 	
 	bUseBezierPerPoint = State.bUseBezierPerPoint;
 	CompletedBezierFlags = State.CompletedBezierFlags;
@@ -757,6 +1186,11 @@ void SClothDesignCanvas::RestoreCanvasState(const FCanvasState& State)
 	SewingMgr.BEndTarget   = { State.BEndTarget.X,   State.BEndTarget.Y };
 
 	SelectedSeamIndex = State.SelectedSeamIndex;
+
+	// recorded deltas refer to shapes of the previous pattern
+	UndoHistory.Reset();
+	ShapeCache.InvalidateAll();
+	HitIndex.InvalidateAll();
 	
 	UpdateSewnPointSets();
 
@@ -764,6 +1198,121 @@ void SClothDesignCanvas::RestoreCanvasState(const FCanvasState& State)
 }
 
 
+void SClothDesignCanvas::SaveStateForUndo(ECanvasUndoScope Scope, int32 ShapeIndex)
+{
+	SaveStateForUndo(FCanvasUndoHistory::Capture(MakeUndoTarget(), Scope, ShapeIndex));
+}
+
+
+void SClothDesignCanvas::SaveStateForUndo(FCanvasUndoDelta&& Before)
+{
+	const ECanvasUndoScope Scope = Before.Scope;
+	UndoHistory.SetMaxMemoryBytes(static_cast<SIZE_T>(FMath::Max(1, CVarClothDesignUndoMemoryMB.GetValueOnGameThread())) * 1024 * 1024);
+	UndoHistory.Record(MoveTemp(Before));
+
+	// selection-only steps leave nothing new to autosave
+	if (Scope != ECanvasUndoScope::None)
+	{
+		++EditSerial;
+	}
+}
+
+
+bool SClothDesignCanvas::UndoLastEdit()
+{
+	const TArray<FShapeTransform2D> PreviousTransforms = CompletedShapeTransforms;
+	const bool bChangesContent = UndoHistory.GetNextUndoScope() != ECanvasUndoScope::None;
+	TArray<int32> EditedShapes;
+	if (!UndoHistory.Undo(MakeUndoTarget(), &EditedShapes))
+	{
+		return false;
+	}
+	OnUndoHistoryApplied();
+	MoveActorsToTransforms(PreviousTransforms);
+	// selection-only and placement-only steps report no shapes, so they rebuild nothing
+	for (const int32 ShapeIndex : EditedShapes)
+	{
+		RebuildEditedMeshes(ShapeIndex);
+	}
+	if (bChangesContent)
+	{
+		++EditSerial;
+	}
+	return true;
+}
+
+
+bool SClothDesignCanvas::RedoLastEdit()
+{
+	const TArray<FShapeTransform2D> PreviousTransforms = CompletedShapeTransforms;
+	const bool bChangesContent = UndoHistory.GetNextRedoScope() != ECanvasUndoScope::None;
+	TArray<int32> EditedShapes;
+	if (!UndoHistory.Redo(MakeUndoTarget(), &EditedShapes))
+	{
+		return false;
+	}
+	OnUndoHistoryApplied();
+	MoveActorsToTransforms(PreviousTransforms);
+	// selection-only and placement-only steps report no shapes, so they rebuild nothing
+	for (const int32 ShapeIndex : EditedShapes)
+	{
+		RebuildEditedMeshes(ShapeIndex);
+	}
+	if (bChangesContent)
+	{
+		++EditSerial;
+	}
+	return true;
+}
+
+
+void SClothDesignCanvas::MoveActorsToTransforms(const TArray<FShapeTransform2D>& Previous)
+{
+	for (int32 ShapeIdx = 0; ShapeIdx < CompletedShapes.Num(); ++ShapeIdx)
+	{
+		// after a load, import or merge the actor at this index may belong to another shape
+		APatternMesh* Actor = GetShapeActor(ShapeIdx);
+		if (!Actor)
+		{
+			continue;
+		}
+		FMeshTriangulation::MoveActorWithShape(
+			Actor,
+			FShapeTransform2D::Get(Previous, ShapeIdx),
+			FShapeTransform2D::Get(CompletedShapeTransforms, ShapeIdx));
+	}
+}
+
+
+FCanvasUndoTarget SClothDesignCanvas::MakeUndoTarget()
+{
+	return { CurvePoints, bUseBezierPerPoint, CompletedShapes, CompletedBezierFlags,
+		CompletedShapeTransforms, SewingManager, PanOffset, ZoomFactor, SelectedSeamIndex };
+}
+
+
+void SClothDesignCanvas::OnUndoHistoryApplied()
+{
+	// to avoid the redo/undo crashes
+	ensure(CurvePoints.Points.Num() == bUseBezierPerPoint.Num());
+	ensure(CompletedShapes.Num() == CompletedBezierFlags.Num());
+	CompletedShapeTransforms.SetNum(CompletedShapes.Num());
+
+	PendingDragPos.Reset();
+	LiveDeform.Reset();
+	RetriangulationQueue.CancelAll();
+	SelectedPointIndex = INDEX_NONE;
+	SelectedShapeIndex = INDEX_NONE;
+
+	ShapeCache.InvalidateAll();
+
+	HitIndex.InvalidateAll();
+	UpdateSewnPointSets();
+
+	Invalidate(EInvalidateWidgetReason::Paint | EInvalidateWidgetReason::Layout);
+}
+
+
 
 
 FString SClothDesignCanvas::GetSelectedTexturePath() const
@@ -807,6 +1356,13 @@ void SClothDesignCanvas::OnShapeAssetSelected(const FAssetData& AssetData)
 	{
 
 		RestoreCanvasState(LoadedState);
+
+		// a sewn pattern comes back ready to merge: meshes (cached) and seam constraints are rebuilt
+		if (SewingManager.SeamDefinitions.Num() > 0)
+		{
+			RegeneratePatternMeshes();
+		}
+
 		FocusViewportOnPoints();
 		Invalidate(EInvalidateWidgetReason::Paint);
 	}
@@ -815,8 +1371,13 @@ void SClothDesignCanvas::OnShapeAssetSelected(const FAssetData& AssetData)
 
 void SClothDesignCanvas::ClearAllShapeData()
 {
+	SaveStateForUndo(ECanvasUndoScope::CurrentCurve | ECanvasUndoScope::AllShapes | ECanvasUndoScope::Seams);
+
 	CompletedShapes.Empty();
 	CompletedBezierFlags.Empty();
+	CompletedShapeTransforms.Empty();
+	ShapeCache.SetNumShapes(0);
+	HitIndex.InvalidateAll();
 
 	CurvePoints.Points.Empty();
 	bUseBezierPerPoint.Empty();
@@ -830,6 +1391,50 @@ void SClothDesignCanvas::ClearAllShapeData()
 }
 
 
+void SClothDesignCanvas::SimplifyShapesClick()
+{
+	const double Tolerance = CVarClothDesignFitTolerance.GetValueOnGameThread();
+	if (Tolerance <= 0.0 || CompletedShapes.Num() == 0)
+	{
+		return;
+	}
+
+	// seams address points by index, so sewn shapes keep theirs
+	TBitArray<> ShapeMask(true, CompletedShapes.Num());
+	for (const FSeamDefinition& Seam : SewingManager.SeamDefinitions)
+	{
+		for (const int32 ShapeIndex : { Seam.ShapeA, Seam.ShapeB })
+		{
+			if (ShapeMask.IsValidIndex(ShapeIndex))
+			{
+				ShapeMask[ShapeIndex] = false;
+			}
+		}
+	}
+
+	// captured up front but only recorded if a shape actually changes
+	FCanvasUndoDelta Before = FCanvasUndoHistory::Capture(MakeUndoTarget(), ECanvasUndoScope::AllShapes);
+
+	const int32 NumPointsBefore = Algo::TransformAccumulate(CompletedShapes, [](const FInterpCurve<FVector2D>& S) { return S.Points.Num(); }, 0);
+	const int32 NumFitted = FPatternCurveFit::FitShapes(CompletedShapes, CompletedBezierFlags, Tolerance, &ShapeMask);
+	const int32 NumPointsAfter = Algo::TransformAccumulate(CompletedShapes, [](const FInterpCurve<FVector2D>& S) { return S.Points.Num(); }, 0);
+
+	UE_LOG(LogTemp, Log, TEXT("Simplified %d shapes: %d -> %d control points"), NumFitted, NumPointsBefore, NumPointsAfter);
+	if (NumFitted == 0)
+	{
+		return;
+	}
+
+	SaveStateForUndo(MoveTemp(Before));
+	RebuildEditedMeshes(INDEX_NONE);
+
+	SelectedPointIndex = INDEX_NONE;
+	ShapeCache.InvalidateAll();
+	HitIndex.InvalidateAll();
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+
 void SClothDesignCanvas::SewingClick()
 {
 	SewingManager.BuildAndAlignAllSeams();
@@ -841,11 +1446,28 @@ void SClothDesignCanvas::MergeClick()
 	SewingManager.MergeSewnPatternPieces();
 }
 
+void SClothDesignCanvas::CommitMergeClick()
+{
+	SewingManager.CommitMergedPatternPieces();
+}
+
+FString SClothDesignCanvas::GetSkinningBodyMeshPath() const
+{
+	return SewingManager.SkinningBodyMesh.IsValid() ? SewingManager.SkinningBodyMesh->GetPathName() : FString();
+}
+
+void SClothDesignCanvas::OnSkinningBodyMeshSelected(const FAssetData& AssetData)
+{
+	SewingManager.SkinningBodyMesh = Cast<USkeletalMesh>(AssetData.GetAsset());
+}
+
 void SClothDesignCanvas::ClearAllSewing()
 {
 	SewnPointIndicesPerShape.Empty();
 	GetSewingManager().CurrentSeamPreviewPoints.Empty();
 	SewingManager.ClearAllSeams();
+	ShapeCache.MarkSeamsDirty();
+	HitIndex.MarkSeamsDirty();
 }
 
 
@@ -857,32 +1479,118 @@ FReply SClothDesignCanvas::SaveClick(const FString& SaveName)
 		return FReply::Handled();
 	}
 	
-	bool bOK = FPatternAssets::SaveShapeAsset(
+	LastSaveName = SaveName;
+
+	// copying the arrays is cheap; converting and writing them happens off the Slate thread
+	AssetSaver.SaveAsync(
 		TEXT("SavedClothMeshes"),
 		SaveName,
-		CompletedShapes,
-		CompletedBezierFlags,
-		CurvePoints,
-		bUseBezierPerPoint
-	);
-
-	UE_LOG(LogTemp, Log, TEXT("Save %s: %s"), *SaveName, bOK ? TEXT("Success") : TEXT("FAILED"));
+		MakeSaveSnapshot(),
+		[](const FString& AssetName, bool bSucceeded) { NotifySaveFinished(AssetName, bSucceeded, false); });
 
 	return FReply::Handled();
 }
 
 
+void SClothDesignCanvas::ImportPatternFile(const FString& FilePath)
+{
+	if (PendingImport.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("An import is already running; ignoring %s"), *FilePath);
+		return;
+	}
+
+	FPatternImportOptions Options;
+	Options.FitTolerance = CVarClothDesignFitTolerance.GetValueOnGameThread();
+	PendingImport = FPatternImport::ImportFileAsync(FilePath, Options);
+}
+
+
+void SClothDesignCanvas::TickPendingImport()
+{
+	if (!PendingImport.IsCompleted())
+	{
+		return;
+	}
+
+	FPatternImportResult Result = MoveTemp(PendingImport.GetResult());
+	PendingImport = UE::Tasks::TTask<FPatternImportResult>();
+
+	if (!Result.bSucceeded)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Could not import %s: %s"), *Result.FilePath, *Result.Error);
+		NotifyImportFinished(Result);
+		return;
+	}
+
+	// report before the data is moved into the canvas
+	NotifyImportFinished(Result);
+
+	FCanvasState ImportedState;
+	FPatternAssets::MakeCanvasState(MoveTemp(Result.Data), ImportedState);
+	RestoreCanvasState(ImportedState);
+
+	// the imported pieces exist nowhere else yet, so they count as an unsaved edit
+	++EditSerial;
+	LastSaveName = FPaths::GetBaseFilename(Result.FilePath);
+
+	FocusViewportOnPoints();
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+
+FLoadedShapeData SClothDesignCanvas::MakeSaveSnapshot() const
+{
+	FLoadedShapeData Snapshot;
+	Snapshot.CompletedShapes = CompletedShapes;
+	Snapshot.CompletedBezierFlags = CompletedBezierFlags;
+	Snapshot.CurvePoints = CurvePoints;
+	Snapshot.bUseBezierPerPoint = bUseBezierPerPoint;
+	Snapshot.CompletedShapeTransforms = CompletedShapeTransforms;
+	Snapshot.SeamDefinitions = SewingManager.SeamDefinitions;
+	return Snapshot;
+}
+
+
+void SClothDesignCanvas::TickAutosave(double CurrentTime)
+{
+	const float Interval = CVarClothDesignAutosaveIntervalSeconds.GetValueOnGameThread();
+	if (Interval <= 0.f || EditSerial == AutosavedEditSerial)
+	{
+		LastAutosaveTime = CurrentTime;
+		return;
+	}
+	if (CurrentTime - LastAutosaveTime < Interval)
+	{
+		return;
+	}
+
+	LastAutosaveTime = CurrentTime;
+	AutosavedEditSerial = EditSerial;
+
+	const FString AutosaveName = LastSaveName.IsEmpty() ? TEXT("Untitled") : LastSaveName;
+	AssetSaver.SaveAsync(
+		TEXT("Autosave"),
+		AutosaveName,
+		MakeSaveSnapshot(),
+		[](const FString& AssetName, bool bSucceeded) { NotifySaveFinished(AssetName, bSucceeded, true); });
+}
+
+
 void SClothDesignCanvas::DeleteOldClothMeshesFromScene()
 {
 	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
 	if (!World) return;
 
+	// the preview hides the pieces about to be deleted and draws from them
+	SewingManager.MergePreview.Clear();
+
 	GEditor->BeginTransaction(FText::FromString(TEXT("DeleteActorsOfTypeWithPrefix")));
 
 	for (TActorIterator<APatternMesh> It(World); It; ++It)
 	{
 		APatternMesh* Actor = *It;
-		if (Actor) 
+		if (Actor && !FPatternMergePreview::IsPreviewActor(Actor))
 		{
 			Actor->Modify();  // make undoable
 			World->DestroyActor(Actor);
@@ -895,10 +1603,6 @@ void SClothDesignCanvas::DeleteOldClothMeshesFromScene()
 
 void SClothDesignCanvas::GenerateMeshesClick()
 {
-	// Delete old meshes first
-	DeleteOldClothMeshesFromScene();
-	SewingManager.SpawnedPatternActors.Empty();
-
 	if (CurvePoints.Points.Num() >= 3)
 	{
 		EAppReturnType::Type Choice = FMessageDialog::Open(
@@ -913,23 +1617,50 @@ void SClothDesignCanvas::GenerateMeshesClick()
 
 	}
 
+	RegeneratePatternMeshes();
+}
+
+
+void SClothDesignCanvas::RegeneratePatternMeshes()
+{
+	// Delete old meshes first
+	DeleteOldClothMeshesFromScene();
+	SewingManager.SpawnedPatternActors.Empty();
+	RetriangulationQueue.CancelAll();
+	LiveDeform.Reset();
+	bMeshesStale = false;
+
 	TArray<FDynamicMesh3> AllMeshes;
 	FMeshTriangulation CanvasMesh;
 	
 	CanvasMesh.TriangulateAndBuildAllMeshes(
 		CompletedShapes,
 		AllMeshes,
-		SewingManager.SpawnedPatternActors);
+		SewingManager.SpawnedPatternActors,
+		CompletedShapeTransforms);
+
+	for (const TWeakObjectPtr<APatternMesh>& Spawned : SewingManager.SpawnedPatternActors)
+	{
+		if (APatternMesh* Actor = Spawned.Get())
+		{
+			Actor->SourcePatternGeneration = PatternGeneration;
+		}
+	}
 	
 
 
 	UE_LOG(LogTemp, Log, TEXT("Built %d meshes"), AllMeshes.Num());
+
+	// the old constraints point at the components that were just deleted
+	SewingManager.RebindSeamConstraints(CompletedShapes);
 }
 
 
 void SClothDesignCanvas::UpdateSewnPointSets()
 {
 	SewingManager.BuildSewnPointSets(SewnPointIndicesPerShape);
+	ShapeCache.MarkSeamsDirty();
+	HitIndex.MarkSeamsDirty();
 	
 	Invalidate(EInvalidateWidget::Paint);
 }
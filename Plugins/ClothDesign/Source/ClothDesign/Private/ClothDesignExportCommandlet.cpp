@@ -0,0 +1,90 @@
+#include "ClothDesignExportCommandlet.h"
+
+#include "PatternMesh.h"
+#include "PatternCreation/PatternMerge.h"
+#include "PatternCreation/PatternExport.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "UObject/Package.h"
+
+
+UClothDesignExportCommandlet::UClothDesignExportCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+
+int32 UClothDesignExportCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	const FString* MapName = ParamValues.Find(TEXT("Map"));
+	const FString* OutputPath = ParamValues.Find(TEXT("Output"));
+	if (!MapName || !OutputPath)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Export] Usage: -run=ClothDesignExport -Map=<level> -Output=<file.glb|file.obj> [-Scale=<s>] [-NoSeams] [-KeepZUp]"));
+		return 1;
+	}
+
+	FPatternExportOptions Options;
+	if (const FString* Scale = ParamValues.Find(TEXT("Scale")))
+	{
+		Options.Scale = FCString::Atod(**Scale);
+	}
+	Options.bWriteSeams = !Switches.Contains(TEXT("NoSeams"));
+	Options.bConvertToYUp = !Switches.Contains(TEXT("KeepZUp"));
+
+	UPackage* Package = LoadPackage(nullptr, **MapName, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (!World || !World->PersistentLevel)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Export] Could not load level %s"), **MapName);
+		return 1;
+	}
+
+	TArray<APatternMesh*> Pieces;
+	for (AActor* Actor : World->PersistentLevel->Actors)
+	{
+		APatternMesh* Piece = Cast<APatternMesh>(Actor);
+		if (!Piece || Piece->DynamicMesh.TriangleCount() == 0)
+		{
+			continue;
+		}
+
+		// the level is loaded but never initialised, so component transforms are not up to date yet
+		if (USceneComponent* Root = Piece->GetRootComponent())
+		{
+			Root->UpdateComponentToWorld();
+		}
+		Pieces.Add(Piece);
+	}
+	if (Pieces.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Export] %s has no pattern pieces with saved geometry"), **MapName);
+		return 1;
+	}
+
+	UE::Geometry::FDynamicMesh3 Garment;
+	if (!FPatternMerge::MergeActorsToDynamicMesh(Pieces, Garment))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Export] Merging %d pieces produced no triangles"), Pieces.Num());
+		return 1;
+	}
+
+	FString Error;
+	if (!FPatternExport::ExportFile(*OutputPath, { &Garment }, Options, Error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Export] %s"), *Error);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("[Export] Wrote %d pieces (%d triangles) from %s to %s"),
+		Pieces.Num(), Garment.TriangleCount(), **MapName, **OutputPath);
+	return 0;
+}
@@ -11,6 +11,9 @@
 #include "EditorModeRegistry.h"
 #include "ClothDesignEditorMode.h"
 #include "ClothDesignStyle.h"
+#include "Engine/SkeletalMesh.h"
+#include "DesktopPlatformModule.h"
+#include "Misc/Paths.h"
 
 // This file was started using the Unreal Engine 5.5 Editor Mode C++ template.
 // This template can be created directly in Unreal Engine in the plugins section.
@@ -57,6 +60,8 @@ void FClothDesignModule::ShutdownModule()
 	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(TwoDTabName);
 	UToolMenus::UnregisterOwner(this);
 
+	ThumbnailPool.Reset();
+
 	FClothDesignCommands::Unregister();
 	FClothDesignStyle::Shutdown();
 
@@ -108,7 +113,8 @@ TSharedRef<SWidget> FClothDesignModule::MakeObjectPicker(
 	const FText& LabelText,
 	const UClass* AllowedClass,
 	TFunction<FString()> GetPath,
-	TFunction<void(const FAssetData&)> OnChanged)
+	TFunction<void(const FAssetData&)> OnChanged,
+	TSharedPtr<FAssetThumbnailPool> InThumbnailPool)
 {
 	return SNew(SHorizontalBox)
 
@@ -125,6 +131,8 @@ TSharedRef<SWidget> FClothDesignModule::MakeObjectPicker(
 		[
 			SNew(SObjectPropertyEntryBox)
 			.AllowedClass(AllowedClass)
+			.ThumbnailPool(InThumbnailPool)
+			.DisplayThumbnail(InThumbnailPool.IsValid())
 			.ObjectPath_Lambda(MoveTemp(GetPath))
 			.OnObjectChanged_Lambda([this, OnChanged](const FAssetData& Asset)
 			{
@@ -202,6 +210,11 @@ TSharedRef<SWidget> FClothDesignModule::MakeBackgroundControls()
 
 TSharedRef<SWidget> FClothDesignModule::MakeLoadSavePanel()
 {
+    if (!ThumbnailPool.IsValid())
+    {
+        ThumbnailPool = MakeShared<FAssetThumbnailPool>(64);
+    }
+
     return SNew(SExpandableArea)
         .AreaTitle(LOCTEXT("LoadSaveSection", "Save / Load"))
         .InitiallyCollapsed(true)
@@ -216,7 +229,8 @@ TSharedRef<SWidget> FClothDesignModule::MakeLoadSavePanel()
                         LOCTEXT("LoadLabel", "Load:"),
                         UClothShapeAsset::StaticClass(),
                         [this]() { return CanvasWidget->GetSelectedShapeAssetPath(); },
-                        [this](auto Asset) { CanvasWidget->OnShapeAssetSelected(Asset); }
+                        [this](auto Asset) { CanvasWidget->OnShapeAssetSelected(Asset); },
+                        ThumbnailPool
                     )
                 ]
                 
@@ -248,6 +262,19 @@ TSharedRef<SWidget> FClothDesignModule::MakeLoadSavePanel()
                         .OnClicked(FOnClicked::CreateRaw(this, &FClothDesignModule::OnSaveClicked))
                     ]
                 ]
+                + SVerticalBox::Slot()
+		        .AutoHeight()
+		        .Padding(10)
+		        .HAlign(HAlign_Left)
+                [
+                    SNew(SBox).WidthOverride(250.f)
+                    [
+                        SNew(SButton)
+                        .Text(LOCTEXT("ImportPatternBtn", "Import Pattern..."))
+                        .ToolTipText(LOCTEXT("ImportPatternTooltip", "Replace the canvas with the pieces of a DXF-AAMA/ASTM or SVG pattern file"))
+                        .OnClicked(FOnClicked::CreateRaw(this, &FClothDesignModule::OnImportPatternClicked))
+                    ]
+                ]
         ];
 }
 
@@ -274,6 +301,22 @@ TSharedRef<SWidget> FClothDesignModule::MakeActionButtons()
 				]
 			]
 
+			// Simplify dense outlines
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(10)
+			.HAlign(HAlign_Left)
+			[
+				SNew(SBox)
+				.WidthOverride(250.f)
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("SimplifyShapesBtn", "Simplify Shapes"))
+					.ToolTipText(LOCTEXT("SimplifyShapesTooltip", "Refit dense outlines with fewer Bezier points (tolerance: ClothDesign.FitTolerance)"))
+					.OnClicked(FOnClicked::CreateRaw(this, &FClothDesignModule::OnSimplifyShapesClicked))
+				]
+			]
+
 			// Sewing
 			+ SVerticalBox::Slot()
 			.AutoHeight()
@@ -288,6 +331,19 @@ TSharedRef<SWidget> FClothDesignModule::MakeActionButtons()
 					.OnClicked(FOnClicked::CreateRaw(this, &FClothDesignModule::OnSewingClicked))
 				]
 			]
+			// Body to skin merged garments to
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(10, 4)
+			.HAlign(HAlign_Left)
+			[
+				MakeObjectPicker(
+					LOCTEXT("SkinBodyLabel", "Skin To Body:"),
+					USkeletalMesh::StaticClass(),
+					[this]() { return CanvasWidget.IsValid() ? CanvasWidget->GetSkinningBodyMeshPath() : FString(); },
+					[this](const FAssetData& Asset) { if (CanvasWidget.IsValid()) CanvasWidget->OnSkinningBodyMeshSelected(Asset); }
+				)
+			]
 			// Merge meshes
 			+ SVerticalBox::Slot()
 			.AutoHeight()
@@ -302,6 +358,20 @@ TSharedRef<SWidget> FClothDesignModule::MakeActionButtons()
 					.OnClicked(FOnClicked::CreateRaw(this, &FClothDesignModule::OnMergeMeshesClicked))
 				]
 			]
+			// Commit merge preview
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(10)
+			.HAlign(HAlign_Left)
+			[
+				SNew(SBox)
+				.WidthOverride(250.f)
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("CommitMergeBtn", "Commit Merge"))
+					.OnClicked(FOnClicked::CreateRaw(this, &FClothDesignModule::OnCommitMergeClicked))
+				]
+			]
 
 		];
 }
@@ -522,6 +592,15 @@ FReply FClothDesignModule::OnSewingClicked()
 	return FReply::Handled();
 }
 
+FReply FClothDesignModule::OnSimplifyShapesClicked()
+{
+	if (CanvasWidget.IsValid())
+	{
+		CanvasWidget->SimplifyShapesClick();
+	}
+	return FReply::Handled();
+}
+
 FReply FClothDesignModule::OnMergeMeshesClicked()
 {
 	if (CanvasWidget.IsValid())
@@ -531,6 +610,15 @@ FReply FClothDesignModule::OnMergeMeshesClicked()
 	return FReply::Handled();
 }
 
+FReply FClothDesignModule::OnCommitMergeClicked()
+{
+	if (CanvasWidget.IsValid())
+	{
+		CanvasWidget->CommitMergeClick();
+	}
+	return FReply::Handled();
+}
+
 FReply FClothDesignModule::OnSaveClicked()
 {
 	if (CanvasWidget.IsValid())
@@ -542,6 +630,33 @@ FReply FClothDesignModule::OnSaveClicked()
 
 
 
+FReply FClothDesignModule::OnImportPatternClicked()
+{
+	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+	if (!CanvasWidget.IsValid() || !DesktopPlatform)
+	{
+		return FReply::Handled();
+	}
+
+	TArray<FString> Files;
+	const bool bPicked = DesktopPlatform->OpenFileDialog(
+		FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr),
+		TEXT("Import Pattern"),
+		FPaths::ProjectDir(),
+		TEXT(""),
+		TEXT("Pattern files (*.dxf;*.svg)|*.dxf;*.svg|DXF-AAMA/ASTM (*.dxf)|*.dxf|SVG (*.svg)|*.svg"),
+		EFileDialogFlags::None,
+		Files);
+
+	if (bPicked && Files.Num() > 0)
+	{
+		CanvasWidget->ImportPatternFile(Files[0]);
+	}
+	return FReply::Handled();
+}
+
+
+
 FReply FClothDesignModule::OnClearClicked()
 {
 	// ClearAllShapeData
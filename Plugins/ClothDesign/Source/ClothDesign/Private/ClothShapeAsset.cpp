@@ -0,0 +1,244 @@
+#include "ClothShapeAsset.h"
+#include "Serialization/CustomVersion.h"
+#include "Containers/BitArray.h"
+
+
+/** Versions of the UClothShapeAsset on-disk layout. */
+struct FClothShapeAssetCustomVersion
+{
+	enum Type
+	{
+		BeforeCustomVersionWasAdded = 0,
+
+		// shapes are stored as packed columns after the tagged properties
+		PackedShapeColumns,
+
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	static const FGuid GUID;
+};
+
+const FGuid FClothShapeAssetCustomVersion::GUID(0x5C1A7D42, 0x3E8B4F90, 0xA2D61C57, 0x9B04E3F8);
+
+static FCustomVersionRegistration GRegisterClothShapeAssetCustomVersion(
+	FClothShapeAssetCustomVersion::GUID,
+	FClothShapeAssetCustomVersion::LatestVersion,
+	TEXT("ClothShapeAssetVer"));
+
+
+namespace
+{
+	/** Flags written at the start of the packed block. */
+	enum EPackedShapeFlags : uint8
+	{
+		PackedShape_FloatPrecision = 1 << 0,
+	};
+
+	/** Only package saves and loads use the packed block; undo buffers and copies stay tagged. */
+	bool UsesPackedShapes(const FArchive& Ar)
+	{
+		return Ar.IsPersistent() && !Ar.IsTransacting() && !Ar.IsObjectReferenceCollector() && !Ar.IsCountingMemory();
+	}
+
+	/** All curve points of an asset, one column per field; the working curve is the last run. */
+	struct FPackedShapeColumns
+	{
+		TArray<int32> PointCounts;
+		TArray<float> InputKeys;
+		TArray<FVector2D> Positions;
+		TArray<FVector2D> ArriveTangents;
+		TArray<FVector2D> LeaveTangents;
+		TBitArray<> BezierFlags;
+		TArray<FVector2D> Translations;
+		TArray<double> Rotations;
+
+		void Reserve(int32 NumPoints)
+		{
+			InputKeys.Reserve(NumPoints);
+			Positions.Reserve(NumPoints);
+			ArriveTangents.Reserve(NumPoints);
+			LeaveTangents.Reserve(NumPoints);
+			BezierFlags.Reserve(NumPoints);
+		}
+
+		void AddRun(const TArray<FCurvePointData>& Points)
+		{
+			PointCounts.Add(Points.Num());
+			for (const FCurvePointData& P : Points)
+			{
+				InputKeys.Add(P.InputKey);
+				Positions.Add(P.Position);
+				ArriveTangents.Add(P.ArriveTangent);
+				LeaveTangents.Add(P.LeaveTangent);
+				BezierFlags.Add(P.bUseBezier);
+			}
+		}
+
+		void ReadRun(int32& Cursor, int32 Count, TArray<FCurvePointData>& OutPoints) const
+		{
+			OutPoints.SetNum(Count);
+			for (FCurvePointData& P : OutPoints)
+			{
+				P.InputKey = InputKeys[Cursor];
+				P.Position = Positions[Cursor];
+				P.ArriveTangent = ArriveTangents[Cursor];
+				P.LeaveTangent = LeaveTangents[Cursor];
+				P.bUseBezier = BezierFlags[Cursor];
+				++Cursor;
+			}
+		}
+	};
+
+	/** Bulk-serialises a vector column, narrowing to floats when requested. */
+	void SerializeVectorColumn(FArchive& Ar, TArray<FVector2D>& Column, bool bFloatPrecision)
+	{
+		if (!bFloatPrecision)
+		{
+			Column.BulkSerialize(Ar);
+			return;
+		}
+
+		TArray<FVector2f> Narrow;
+		if (Ar.IsSaving())
+		{
+			Narrow.SetNumUninitialized(Column.Num());
+			for (int32 i = 0; i < Column.Num(); ++i)
+			{
+				Narrow[i] = FVector2f(Column[i]);
+			}
+		}
+
+		Narrow.BulkSerialize(Ar);
+
+		if (Ar.IsLoading())
+		{
+			Column.SetNumUninitialized(Narrow.Num());
+			for (int32 i = 0; i < Narrow.Num(); ++i)
+			{
+				Column[i] = FVector2D(Narrow[i]);
+			}
+		}
+	}
+}
+
+
+void UClothShapeAsset::Serialize(FArchive& Ar)
+{
+	Ar.UsingCustomVersion(FClothShapeAssetCustomVersion::GUID);
+
+	if (!UsesPackedShapes(Ar))
+	{
+		Super::Serialize(Ar);
+		return;
+	}
+
+	if (Ar.IsSaving())
+	{
+		// empty arrays match the defaults, so the tagged stream skips them entirely
+		TArray<FCurvePointData> SavedCurvePoints = MoveTemp(ClothCurvePoints);
+		TArray<FShapeData> SavedShapes = MoveTemp(ClothShapes);
+		Super::Serialize(Ar);
+		ClothCurvePoints = MoveTemp(SavedCurvePoints);
+		ClothShapes = MoveTemp(SavedShapes);
+
+		SerializePackedShapes(Ar);
+		return;
+	}
+
+	// older assets carry their shapes in the tagged properties
+	Super::Serialize(Ar);
+	if (Ar.CustomVer(FClothShapeAssetCustomVersion::GUID) >= FClothShapeAssetCustomVersion::PackedShapeColumns)
+	{
+		SerializePackedShapes(Ar);
+	}
+}
+
+
+void UClothShapeAsset::SerializePackedShapes(FArchive& Ar)
+{
+	FPackedShapeColumns Columns;
+	uint8 Flags = 0;
+
+	if (Ar.IsSaving())
+	{
+		int32 NumPoints = ClothCurvePoints.Num();
+		for (const FShapeData& Shape : ClothShapes)
+		{
+			NumPoints += Shape.CompletedClothShape.Num();
+		}
+		Columns.Reserve(NumPoints);
+		Columns.Translations.Reserve(ClothShapes.Num());
+		Columns.Rotations.Reserve(ClothShapes.Num());
+
+		for (const FShapeData& Shape : ClothShapes)
+		{
+			Columns.AddRun(Shape.CompletedClothShape);
+			Columns.Translations.Add(Shape.Translation);
+			Columns.Rotations.Add(Shape.RotationDegrees);
+		}
+		Columns.AddRun(ClothCurvePoints);
+
+		Flags = bQuantizePoints ? PackedShape_FloatPrecision : 0;
+	}
+
+	Ar << Flags;
+	const bool bFloatPrecision = (Flags & PackedShape_FloatPrecision) != 0;
+
+	Columns.PointCounts.BulkSerialize(Ar);
+	Columns.InputKeys.BulkSerialize(Ar);
+	SerializeVectorColumn(Ar, Columns.Positions, bFloatPrecision);
+	SerializeVectorColumn(Ar, Columns.ArriveTangents, bFloatPrecision);
+	SerializeVectorColumn(Ar, Columns.LeaveTangents, bFloatPrecision);
+	Ar << Columns.BezierFlags;
+	Columns.Translations.BulkSerialize(Ar);
+	Columns.Rotations.BulkSerialize(Ar);
+
+	if (!Ar.IsLoading())
+	{
+		return;
+	}
+
+	// validate before touching the arrays, a truncated block must not leave half a pattern behind
+	const int32 NumPoints = Columns.InputKeys.Num();
+	int64 CountedPoints = 0;
+	for (int32 Count : Columns.PointCounts)
+	{
+		if (Count < 0)
+		{
+			CountedPoints = INDEX_NONE;
+			break;
+		}
+		CountedPoints += Count;
+	}
+	const bool bValid = !Ar.IsError()
+		&& Columns.PointCounts.Num() >= 1
+		&& CountedPoints == NumPoints
+		&& Columns.Positions.Num() == NumPoints
+		&& Columns.ArriveTangents.Num() == NumPoints
+		&& Columns.LeaveTangents.Num() == NumPoints
+		&& Columns.BezierFlags.Num() == NumPoints
+		&& Columns.Translations.Num() == Columns.PointCounts.Num() - 1
+		&& Columns.Rotations.Num() == Columns.PointCounts.Num() - 1;
+	if (!bValid)
+	{
+		UE_LOG(LogTemp, Error, TEXT("ClothShapeAsset %s: packed shape data is corrupt; shapes not loaded"), *GetPathName());
+		Ar.SetError();
+		return;
+	}
+
+	bQuantizePoints = bFloatPrecision;
+
+	const int32 NumShapes = Columns.PointCounts.Num() - 1;
+	int32 Cursor = 0;
+	ClothShapes.SetNum(NumShapes);
+	for (int32 ShapeIdx = 0; ShapeIdx < NumShapes; ++ShapeIdx)
+	{
+		FShapeData& Shape = ClothShapes[ShapeIdx];
+		Columns.ReadRun(Cursor, Columns.PointCounts[ShapeIdx], Shape.CompletedClothShape);
+		Shape.Translation = Columns.Translations[ShapeIdx];
+		Shape.RotationDegrees = Columns.Rotations[ShapeIdx];
+	}
+	Columns.ReadRun(Cursor, Columns.PointCounts.Last(), ClothCurvePoints);
+}
@@ -3,9 +3,40 @@
 #include "DynamicMesh/DynamicMesh3.h"
 #include "CoreMinimal.h"
 #include "ClothDesignCanvas.h"
+#include "PatternCreation/PatternMeshCache.h"
 
 
 
+// evaluates SamplesPerSegment points per segment, the same positions for meshing and live deformation
+static void AppendBoundarySamples(
+	const FInterpCurve<FVector2D>& Shape,
+	int SamplesPerSegment,
+	TArray<FVector2f>& OutSamples)
+{
+	for (int Seg = 0; Seg < Shape.Points.Num() - 1; ++Seg)
+	{
+		float In0 = Shape.Points[Seg].InVal;
+		float In1 = Shape.Points[Seg + 1].InVal;
+
+		for (int i = 0; i < SamplesPerSegment; ++i)
+		{
+			float Alpha = static_cast<float>(i) / SamplesPerSegment;
+			FVector2D P2 = Shape.Eval(FMath::Lerp(In0, In1, Alpha));
+			OutSamples.Add(FVector2f(P2.X, P2.Y));
+		}
+	}
+}
+
+
+void FMeshTriangulation::SampleBoundary(
+	const FInterpCurve<FVector2D>& Shape,
+	TArray<FVector2f>& OutSamples)
+{
+	OutSamples.Reset();
+	AppendBoundarySamples(Shape, BoundarySamplesPerSegment, OutSamples);
+}
+
+
 // even–odd rule point-in-polygon test
 bool FMeshTriangulation::IsPointInPolygon(
 	const FVector2f& Test, 
@@ -56,25 +87,19 @@ void FMeshTriangulation::SampleShapeCurve(
 
 	OutSeamVertexIDs.Empty();
 
-	for (int Seg = 0; Seg < Shape.Points.Num() - 1; ++Seg)
+	const int32 FirstSample = OutPolyVerts.Num();
+	AppendBoundarySamples(Shape, SamplesPerSegment, OutPolyVerts);
+
+	for (int32 Idx = FirstSample; Idx < OutPolyVerts.Num(); ++Idx, ++SampleCounter)
 	{
-		float In0 = Shape.Points[Seg].InVal;
-		float In1 = Shape.Points[Seg + 1].InVal;
+		const FVector2f& P2 = OutPolyVerts[Idx];
+		int VID = Mesh.AppendVertex(FVector3d(P2.X, P2.Y, 0));
+		OutVertexIDs.Add(VID);
 
-		for (int i = 0; i < SamplesPerSegment; ++i, ++SampleCounter)
+		// record seam if this sample falls in the integer [MinSample,MaxSample] range
+		if (bRecordSeam && SampleCounter >= MinSample && SampleCounter <= MaxSample)
 		{
-			float Alpha = static_cast<float>(i) / SamplesPerSegment;
-			FVector2D P2 = Shape.Eval(FMath::Lerp(In0, In1, Alpha));
-			OutPolyVerts.Add(FVector2f(P2.X, P2.Y));
-
-			int VID = Mesh.AppendVertex(FVector3d(P2.X, P2.Y, 0));
-			OutVertexIDs.Add(VID);
-
-			// record seam if this sample falls in the integer [MinSample,MaxSample] range
-			if (bRecordSeam && SampleCounter >= MinSample && SampleCounter <= MaxSample)
-			{
-				OutSeamVertexIDs.Add(VID);
-			}
+			OutSeamVertexIDs.Add(VID);
 		}
 	}
 }
@@ -102,7 +127,7 @@ void FMeshTriangulation::AddGridInteriorPoints(
 	}
 
 	// grid parameters
-	constexpr int32 GridRes = 40;    // 10×10 grid → up to 100 interior seeds
+	constexpr int32 GridRes = GridInteriorResolution;
 	int32 Added = 0;
 
 	// sample on a regular grid, keep only centers inside the original polygon
@@ -222,14 +247,8 @@ void FMeshTriangulation::ExtractVerticesAndIndices(
 
 
 void FMeshTriangulation::CreateProceduralMesh(
-	const TArray<FVector>& Vertices,
-	const TArray<int32>& Indices,
-	FDynamicMesh3&& DynamicMesh,
-	TArray<int32>&& SeamVertexIDs,
-	const TArray<FVector2f>& BoundarySamples2D,
-	const TArray<int32>& BoundarySampleVIDs,
-	TArray<TWeakObjectPtr<APatternMesh>>& OutSpawnedActors,
-	FVector MeshCentroid)
+	FPatternMeshData&& Data,
+	TArray<TWeakObjectPtr<APatternMesh>>& OutSpawnedActors)
 {
     UWorld* World = GEditor->GetEditorWorldContext().World();
     if (!World) return;
@@ -248,21 +267,47 @@ void FMeshTriangulation::CreateProceduralMesh(
 	
     {
         const FVector CurrentActorLoc = MeshActor->GetActorLocation();
-        const FVector CentroidWorldPos = MeshActor->GetActorTransform().TransformPosition(MeshCentroid);
+        const FVector CentroidWorldPos = MeshActor->GetActorTransform().TransformPosition(Data.Centroid);
         const FVector WorldOffset = CentroidWorldPos - CurrentActorLoc;
 
         // Move the actor by the computed world offset
         MeshActor->SetActorLocation(CurrentActorLoc + WorldOffset);
     }
 
+    MeshActor->SetFolderPath(FName(TEXT("ClothDesignActors")));
+#if WITH_EDITOR
+    MeshActor->SetActorLabel(UniqueLabel);
+#endif
+
     // store transform-dependent data AFTER repositioning so world samples are correct
-    MeshActor->DynamicMesh        = MoveTemp(DynamicMesh);
-    MeshActor->LastSeamVertexIDs  = MoveTemp(SeamVertexIDs);
+    ApplyPatternMeshData(MeshActor, MoveTemp(Data));
+}
+
 
-    MeshActor->BoundarySamplePoints2D = BoundarySamples2D;
-    MeshActor->BoundarySampleVertexIDs = BoundarySampleVIDs;
+void FMeshTriangulation::ApplyPatternMeshData(
+	APatternMesh* MeshActor,
+	FPatternMeshData&& Data)
+{
+    MeshActor->PatternPivot2D     = FVector2D(Data.Centroid.X, Data.Centroid.Y);
+    MeshActor->DynamicMesh        = MoveTemp(Data.DynamicMesh);
+    // in-place rebuilds record no seam; boundary samples keep their vertex IDs while the
+    // sample count is unchanged, so the sewing's seam vertices stay valid if they still exist
+    if (Data.SeamVertexIDs.Num() > 0)
+    {
+        MeshActor->LastSeamVertexIDs = MoveTemp(Data.SeamVertexIDs);
+    }
+    else
+    {
+        const TSet<int32> BoundaryVIDs(Data.BoundarySampleVIDs);
+        MeshActor->LastSeamVertexIDs.RemoveAll([&BoundaryVIDs](int32 VID) { return !BoundaryVIDs.Contains(VID); });
+    }
+    MeshActor->SetPolyIndexToVID(Data.PolyIndexToVID);
 
-    // compute and store world positions for convenience (move this AFTER reposition)
+    MeshActor->BoundarySamplePoints2D = MoveTemp(Data.BoundarySamples2D);
+    MeshActor->BoundarySampleVertexIDs = MoveTemp(Data.BoundarySampleVIDs);
+
+    // compute and store world positions for convenience
+    const TArray<int32>& BoundarySampleVIDs = MeshActor->BoundarySampleVertexIDs;
     MeshActor->BoundarySampleWorldPositions.Reset();
     MeshActor->BoundarySampleWorldPositions.SetNum(BoundarySampleVIDs.Num());
     for (int i = 0; i < BoundarySampleVIDs.Num(); ++i)
@@ -280,11 +325,7 @@ void FMeshTriangulation::CreateProceduralMesh(
         }
     }
 
-    MeshActor->SetFolderPath(FName(TEXT("ClothDesignActors")));
-#if WITH_EDITOR
-    MeshActor->SetActorLabel(UniqueLabel);
-#endif
-
+    const TArray<FVector>& Vertices = Data.Vertices;
     TArray<FVector>      Normals;      Normals.AddUninitialized(Vertices.Num());
     TArray<FVector2D>    UV0;          UV0.AddUninitialized(Vertices.Num());
     TArray<FLinearColor> VertexColors; VertexColors.AddUninitialized(Vertices.Num());
@@ -299,45 +340,98 @@ void FMeshTriangulation::CreateProceduralMesh(
     }
 
     MeshActor->MeshComponent->CreateMeshSection_LinearColor(
-        0, Vertices, Indices,
+        0, Vertices, Data.Indices,
         Normals, UV0, VertexColors, Tangents,
         true
     );
 }
 
 
+bool FMeshTriangulation::RebuildMeshInPlace(
+	const FInterpCurve<FVector2D>& Shape,
+	APatternMesh* Actor)
+{
+	if (!Actor || !Actor->MeshComponent)
+	{
+		return false;
+	}
+
+	FPatternMeshData Data;
+	if (!BuildPatternMeshData(Shape, false, 0, 0, Data))
+	{
+		return false;
+	}
+
+	return ApplyRebuiltMesh(Actor, MoveTemp(Data));
+}
+
+
+bool FMeshTriangulation::ApplyRebuiltMesh(
+	APatternMesh* Actor,
+	FPatternMeshData&& Data)
+{
+	if (!Actor || !Actor->MeshComponent)
+	{
+		return false;
+	}
+
+	// the pivot follows the new centroid; shift the actor by the same canvas-space offset
+	const FVector PivotDelta(Data.Centroid.X - Actor->PatternPivot2D.X, Data.Centroid.Y - Actor->PatternPivot2D.Y, 0.0);
+	Actor->SetActorLocation(Actor->GetActorLocation() + Actor->GetActorTransform().TransformVector(PivotDelta));
+
+	ApplyPatternMeshData(Actor, MoveTemp(Data));
+	return true;
+}
+
+
+void FMeshTriangulation::MoveActorWithShape(
+	APatternMesh* Actor,
+	const FShapeTransform2D& From,
+	const FShapeTransform2D& To)
+{
+	if (!Actor || From == To)
+	{
+		return;
+	}
+
+	const FVector2D OldPivot = From.TransformPoint(Actor->PatternPivot2D);
+	const FVector2D NewPivot = To.TransformPoint(Actor->PatternPivot2D);
+
+	Actor->SetActorLocation(Actor->GetActorLocation() + FVector(NewPivot.X - OldPivot.X, NewPivot.Y - OldPivot.Y, 0.0));
+	Actor->AddActorWorldRotation(FRotator(0.0, To.RotationDegrees - From.RotationDegrees, 0.0));
+}
 
 
 // second version but with steiner points, grid spaced constrained delaunay
-void FMeshTriangulation::TriangulateAndBuildMesh(
+bool FMeshTriangulation::BuildPatternMeshData(
 	const FInterpCurve<FVector2D>& Shape,
-	bool bRecordSeam ,
+	bool bRecordSeam,
 	int32 StartPointIdx2D,
 	int32 EndPointIdx2D,
-	TArray<int32>& LastSeamVertexIDs,
-	FDynamicMesh3& LastBuiltMesh,
-	TArray<int32>& LastBuiltSeamVertexIDs,
-	TArray<TWeakObjectPtr<APatternMesh>>& OutSpawnedActors)
+	FPatternMeshData& OutData,
+	const TFunction<bool()>& ShouldCancel)
 {
+	auto IsCancelled = [&ShouldCancel]() { return ShouldCancel && ShouldCancel(); };
+
 	if (Shape.Points.Num() < 3)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Need at least 3 points to triangulate"));
-		return;
+		return false;
 	}
 
 	TArray<FVector2f> PolyVerts;
-	constexpr int SamplesPerSegment = 10;
 	FDynamicMesh3 Mesh;
 	
 	// Sample shape curve points and build seam info
 	TArray<int32> VertexIDs;
-	SampleShapeCurve(Shape, bRecordSeam, StartPointIdx2D, EndPointIdx2D, SamplesPerSegment, PolyVerts, LastSeamVertexIDs, VertexIDs, Mesh);
+	SampleShapeCurve(Shape, bRecordSeam, StartPointIdx2D, EndPointIdx2D, BoundarySamplesPerSegment, PolyVerts, OutData.SeamVertexIDs, VertexIDs, Mesh);
 
 	// Keep track of boundary vertices for polygon test
 	int32 OriginalBoundaryCount = PolyVerts.Num();
 
 	// Add interior points on a grid inside polygon
 	AddGridInteriorPoints(PolyVerts, OriginalBoundaryCount, VertexIDs, Mesh);
+	if (IsCancelled()) return false;
 
 	// Build constrained edges from boundary vertices
 	TArray<UE::Geometry::FIndex2i> BoundaryEdges;
@@ -346,80 +440,78 @@ void FMeshTriangulation::TriangulateAndBuildMesh(
 	// Run constrained Delaunay triangulation
 	UE::Geometry::TConstrainedDelaunay2<float> CDT;
 	RunConstrainedDelaunay(PolyVerts, BoundaryEdges, CDT);
+	if (IsCancelled()) return false;
 
 	
 	
 	// Convert CDT result to dynamic mesh
-	UE::Geometry::FDynamicMesh3 OutMesh;
-	TArray<int32> PolyIndexToVID;
-	ConvertCDTToDynamicMesh(CDT, OutMesh, PolyIndexToVID);
+	ConvertCDTToDynamicMesh(CDT, OutData.DynamicMesh, OutData.PolyIndexToVID);
 
-	// Debug: make sure CDT produced triangles
-	UE_LOG(LogTemp, Warning, TEXT("[Triangulate] CDT produced: vertices=%d triangles=%d"),
-		   CDT.Vertices.Num(), CDT.Triangles.Num());
-	
-	if (OutSpawnedActors.Num() > 0 && OutSpawnedActors.Last().IsValid())
+	// runs on retriangulation workers for every drag step, so only failures are logged (by RunConstrainedDelaunay)
+	if (OutData.DynamicMesh.TriangleCount() == 0)
 	{
-		OutSpawnedActors.Last()->SetPolyIndexToVID(PolyIndexToVID);
+		return false;
 	}
 
-	TArray<FVector2f> BoundarySamples2D;
-	TArray<int32> BoundarySampleVIDs;
-	TArray<FVector> BoundarySampleWorld;
-
-	BoundarySamples2D.Reserve(OriginalBoundaryCount);
-	BoundarySampleVIDs.Reserve(OriginalBoundaryCount);
+	OutData.BoundarySamples2D.Reserve(OriginalBoundaryCount);
+	OutData.BoundarySampleVIDs.Reserve(OriginalBoundaryCount);
 
 	for (int b = 0; b < OriginalBoundaryCount; ++b)
 	{
-		BoundarySamples2D.Add(PolyVerts[b]);
-		int VID = (b >= 0 && b < PolyIndexToVID.Num()) ? PolyIndexToVID[b] : INDEX_NONE;
-		BoundarySampleVIDs.Add(VID);
+		OutData.BoundarySamples2D.Add(PolyVerts[b]);
+		int VID = (b >= 0 && b < OutData.PolyIndexToVID.Num()) ? OutData.PolyIndexToVID[b] : INDEX_NONE;
+		OutData.BoundarySampleVIDs.Add(VID);
 	}
 
 	
 	
 	// Extract vertices and indices for procedural mesh
-	TArray<FVector> Vertices;
-	TArray<int32> Indices;
-	ExtractVerticesAndIndices(OutMesh, Vertices, Indices);
-
-	UE_LOG(LogTemp, Warning, TEXT("[Triangulate] OutMesh has %d verts, %d triangles"), OutMesh.VertexCount(), OutMesh.TriangleCount());
-
-	
-	LastBuiltMesh = MoveTemp(OutMesh);
-	LastBuiltSeamVertexIDs = MoveTemp(LastSeamVertexIDs);
+	ExtractVerticesAndIndices(OutData.DynamicMesh, OutData.Vertices, OutData.Indices);
 
 
 	
 	FDynamicMesh3 CentroidTempMesh;
 	// Fill TempMesh with Vertices + Indices
-	for (const FVector& V : Vertices)
+	for (const FVector& V : OutData.Vertices)
 	{
 		CentroidTempMesh.AppendVertex(FVector3d(V));
 	}
-	for (int i = 0; i < Indices.Num(); i += 3)
+	for (int i = 0; i < OutData.Indices.Num(); i += 3)
 	{
-		CentroidTempMesh.AppendTriangle(Indices[i], Indices[i+1], Indices[i+2]);
+		CentroidTempMesh.AppendTriangle(OutData.Indices[i], OutData.Indices[i+1], OutData.Indices[i+2]);
 	}
 	FVector3d MeshCentroid = FCanvasUtils::ComputeAreaWeightedCentroid(CentroidTempMesh);
-	FCanvasUtils::CenterMeshVerticesToOrigin(Vertices, MeshCentroid);
-	FVector3d Centroid3d(MeshCentroid);
-	FCanvasUtils::TranslateDynamicMeshBy(LastBuiltMesh, Centroid3d);	
+	FCanvasUtils::CenterMeshVerticesToOrigin(OutData.Vertices, MeshCentroid);
+	FCanvasUtils::TranslateDynamicMeshBy(OutData.DynamicMesh, MeshCentroid);
+	OutData.Centroid = MeshCentroid;
 
+	return true;
+}
 
-	
-	CreateProceduralMesh(
-	Vertices,
-	Indices,
-	MoveTemp(LastBuiltMesh),
-	MoveTemp(LastBuiltSeamVertexIDs),
-	BoundarySamples2D,
-	BoundarySampleVIDs,
-	OutSpawnedActors,
-	MeshCentroid
 
-		);
+void FMeshTriangulation::TriangulateAndBuildMesh(
+	const FInterpCurve<FVector2D>& Shape,
+	bool bRecordSeam ,
+	int32 StartPointIdx2D,
+	int32 EndPointIdx2D,
+	TArray<int32>& LastSeamVertexIDs,
+	FDynamicMesh3& LastBuiltMesh,
+	TArray<int32>& LastBuiltSeamVertexIDs,
+	TArray<TWeakObjectPtr<APatternMesh>>& OutSpawnedActors)
+{
+	// unchanged shapes come straight from the derived data cache
+	FPatternMeshData Data;
+	if (!FPatternMeshCache::LoadOrBuild(Shape, bRecordSeam, StartPointIdx2D, EndPointIdx2D, Data))
+	{
+		return;
+	}
+
+	// callers keep a copy of the built mesh and seam; the actor takes the originals
+	LastSeamVertexIDs = Data.SeamVertexIDs;
+	LastBuiltMesh = Data.DynamicMesh;
+	LastBuiltSeamVertexIDs = Data.SeamVertexIDs;
+
+	CreateProceduralMesh(MoveTemp(Data), OutSpawnedActors);
 }
 
 
@@ -427,23 +519,38 @@ void FMeshTriangulation::TriangulateAndBuildMesh(
 void FMeshTriangulation::TriangulateAndBuildAllMeshes(
 	const TArray<FInterpCurve<FVector2D>>& CompletedShapes,
 	TArray<FDynamicMesh3>& OutMeshes,
-	TArray<TWeakObjectPtr<APatternMesh>>& OutSpawnedActors)
+	TArray<TWeakObjectPtr<APatternMesh>>& OutSpawnedActors,
+	const TArray<FShapeTransform2D>& ShapeTransforms)
 {
 	
-	for (const FInterpCurve<FVector2D>& Shape : CompletedShapes)
+	for (int32 ShapeIdx = 0; ShapeIdx < CompletedShapes.Num(); ++ShapeIdx)
 	{
 		FDynamicMesh3 Mesh;
 		TArray<int32> SeamVerts;
 		TArray<int32> TempSeamVerts;
 
+		const int32 NumActorsBefore = OutSpawnedActors.Num();
 		TriangulateAndBuildMesh(
-			Shape,
+			CompletedShapes[ShapeIdx],
 			false,
 			0, 0,
 			SeamVerts,
 			Mesh,
 			TempSeamVerts,
 			OutSpawnedActors);
+
+		// the mesh is built in shape-local space; the canvas placement goes on the actor
+		if (OutSpawnedActors.Num() > NumActorsBefore)
+		{
+			APatternMesh* Spawned = OutSpawnedActors.Last().Get();
+			MoveActorWithShape(Spawned, FShapeTransform2D::Identity, FShapeTransform2D::Get(ShapeTransforms, ShapeIdx));
+
+			// a shape that fails to build shifts every later actor, so the index is recorded
+			if (Spawned)
+			{
+				Spawned->SourceShapeIndex = ShapeIdx;
+			}
+		}
 		
 		OutMeshes.Add(Mesh);
 	}
@@ -0,0 +1,158 @@
+#include "PatternCreation/PatternAssetSaver.h"
+#include "PatternCreation/PatternThumbnail.h"
+#include "UObject/Package.h"
+#include "HAL/FileManager.h"
+
+
+namespace
+{
+	// a write that has not landed by then is waited for, so a save never stays pending
+	constexpr double WriteTimeoutSeconds = 10.0;
+}
+
+
+FPatternAssetSaver::~FPatternAssetSaver()
+{
+	// a snapshot handed over for saving must not be lost when the canvas closes
+	Flush();
+}
+
+
+void FPatternAssetSaver::SaveAsync(const FString& AssetPath, const FString& AssetName, FLoadedShapeData&& Snapshot, FOnSaveFinished OnFinished)
+{
+	// a newer snapshot of the same asset supersedes one that has not started yet
+	Queue.RemoveAll([&AssetPath, &AssetName](const FRequest& Request)
+	{
+		return Request.AssetPath == AssetPath && Request.AssetName == AssetName;
+	});
+
+	Queue.Add({ AssetPath, AssetName, MoveTemp(Snapshot), MoveTemp(OnFinished) });
+
+	if (Stage == EStage::Idle)
+	{
+		StartNext();
+	}
+}
+
+
+void FPatternAssetSaver::StartNext()
+{
+	if (Queue.Num() == 0)
+	{
+		Stage = EStage::Idle;
+		return;
+	}
+
+	Active = MoveTemp(Queue[0]);
+	Queue.RemoveAt(0);
+	Stage = EStage::Building;
+
+	BuildTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Snapshot = MoveTemp(Active.Snapshot)]()
+	{
+		FBuiltArrays Built;
+		FPatternAssets::BuildAssetArrays(Snapshot, Built.Shapes, Built.CurvePoints, Built.Seams);
+		FPatternThumbnail::Rasterize(Snapshot, FPatternThumbnail::DefaultSize, Built.Thumbnail);
+		return Built;
+	});
+}
+
+
+void FPatternAssetSaver::Tick()
+{
+	if (Stage == EStage::Building && BuildTask.IsCompleted())
+	{
+		FBuiltArrays& Built = BuildTask.GetResult();
+
+		FString PackageFileName;
+		UClothShapeAsset* Asset = FPatternAssets::FindOrCreateShapeAsset(Active.AssetPath, Active.AssetName, PackageFileName);
+		if (!Asset)
+		{
+			Finish(false);
+			return;
+		}
+
+		Asset->ClothShapes = MoveTemp(Built.Shapes);
+		Asset->ClothCurvePoints = MoveTemp(Built.CurvePoints);
+		Asset->Seams = MoveTemp(Built.Seams);
+		FPatternThumbnail::CacheInPackage(Asset, Built.Thumbnail, FPatternThumbnail::DefaultSize);
+		BuildTask = UE::Tasks::TTask<FBuiltArrays>();
+
+		// a missing file reports FDateTime::MinValue, so any write is newer
+		PreviousTimeStamp = IFileManager::Get().GetTimeStamp(*PackageFileName);
+		if (!FPatternAssets::WriteShapeAsset(Asset, PackageFileName, true, &ExpectedFileSize))
+		{
+			Finish(false);
+			return;
+		}
+
+		Stage = EStage::Writing;
+		WriteFileName = PackageFileName;
+		WriteDeadline = FPlatformTime::Seconds() + WriteTimeoutSeconds;
+	}
+
+	if (Stage == EStage::Writing)
+	{
+		if (IsWriteFinished())
+		{
+			Finish(true);
+		}
+		else if (FPlatformTime::Seconds() > WriteDeadline)
+		{
+			// file times too coarse to tell this write from the previous one
+			UE_LOG(LogTemp, Verbose, TEXT("Save %s: write not observed in time, waiting for the async writer"), *Active.AssetName);
+			UPackage::WaitForAsyncFileWrites();
+			Finish(true);
+		}
+	}
+}
+
+
+bool FPatternAssetSaver::IsWriteFinished() const
+{
+	IFileManager& FileManager = IFileManager::Get();
+	return FileManager.FileSize(*WriteFileName) == ExpectedFileSize &&
+		FileManager.GetTimeStamp(*WriteFileName) > PreviousTimeStamp;
+}
+
+
+void FPatternAssetSaver::Finish(bool bSucceeded)
+{
+	UE_LOG(LogTemp, Log, TEXT("Save %s: %s"), *Active.AssetName, bSucceeded ? TEXT("Success") : TEXT("FAILED"));
+
+	FRequest Done = MoveTemp(Active);
+	Active = FRequest();
+	BuildTask = UE::Tasks::TTask<FBuiltArrays>();
+	WriteFileName.Reset();
+	StartNext();
+
+	if (Done.OnFinished)
+	{
+		Done.OnFinished(Done.AssetName, bSucceeded);
+	}
+}
+
+
+void FPatternAssetSaver::Flush()
+{
+	while (IsBusy())
+	{
+		if (Stage == EStage::Building)
+		{
+			BuildTask.Wait();
+		}
+		else if (Stage == EStage::Writing)
+		{
+			// blocking is the point of Flush, so the engine-wide wait is fine here
+			UPackage::WaitForAsyncFileWrites();
+			Finish(true);
+			continue;
+		}
+		Tick();
+	}
+}
+
+
+bool FPatternAssetSaver::IsBusy() const
+{
+	return Stage != EStage::Idle || Queue.Num() > 0;
+}
@@ -1,4 +1,6 @@
 #include "PatternCreation/PatternAssets.h"
+#include "PatternCreation/PatternImport.h"
+#include "PatternCreation/PatternThumbnail.h"
 
 #include "UObject/SavePackage.h"
 #include "AssetRegistry/AssetRegistryModule.h"
@@ -11,57 +13,57 @@ bool FPatternAssets::SaveShapeAsset(
 	const TArray<FInterpCurve<FVector2D>>& CompletedShapes,
 	const TArray<TArray<bool>>& CompletedBezierFlags,
 	const FInterpCurve<FVector2D>& CurvePoints,
-	const TArray<bool>& bUseBezierPerPoint)
+	const TArray<bool>& bUseBezierPerPoint,
+	const TArray<FShapeTransform2D>& CompletedShapeTransforms,
+	const TArray<FSeamDefinition>& SeamDefinitions)
 {
-	if (AssetPath.Contains(TEXT(":")) || AssetPath.Contains(TEXT("?")))
-	{
-		return false; // reject illegal chars
-	}
-	
-	// Create package path
-	FString PackageName = FString::Printf(TEXT("/Game/ClothDesignAssets/%s/%s"), *AssetPath, *AssetName);
-	FString SanitizedPackageName = UPackageTools::SanitizePackageName(PackageName);
-	
-	UPackage* Package = LoadPackage(nullptr, *SanitizedPackageName, LOAD_None);
-	if (!Package)
-	{
-		// If the package doesn't exist, create it
-		Package = CreatePackage(*SanitizedPackageName);
-	}
-	if (!Package)
+	FString PackageFileName;
+	UClothShapeAsset* TargetAsset = FindOrCreateShapeAsset(AssetPath, AssetName, PackageFileName);
+	if (!TargetAsset)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to create package for saving asset"));
 		return false;
 	}
 
-	// Force full load of the package
-	Package->FullyLoad();
+	FLoadedShapeData Data;
+	Data.CompletedShapes = CompletedShapes;
+	Data.CompletedBezierFlags = CompletedBezierFlags;
+	Data.CurvePoints = CurvePoints;
+	Data.bUseBezierPerPoint = bUseBezierPerPoint;
+	Data.CompletedShapeTransforms = CompletedShapeTransforms;
+	Data.SeamDefinitions = SeamDefinitions;
+	BuildAssetArrays(Data, TargetAsset->ClothShapes, TargetAsset->ClothCurvePoints, TargetAsset->Seams);
+
+	// this path is synchronous by design; FPatternAssetSaver rasterises on a worker instead
+	TArray<FColor> Thumbnail;
+	FPatternThumbnail::Rasterize(Data, FPatternThumbnail::DefaultSize, Thumbnail);
+	FPatternThumbnail::CacheInPackage(TargetAsset, Thumbnail, FPatternThumbnail::DefaultSize);
+
+	return WriteShapeAsset(TargetAsset, PackageFileName, false);
+}
 
-	
-	UClothShapeAsset* ExistingAsset = FindObject<UClothShapeAsset>(Package, *AssetName);
-	UClothShapeAsset* TargetAsset = ExistingAsset;
 
-	if (!TargetAsset)
-	{
-		TargetAsset = NewObject<UClothShapeAsset>(Package, *AssetName, RF_Public | RF_Standalone);
-		if (!TargetAsset)
-		{
-			UE_LOG(LogTemp, Error, TEXT("Failed to create new UClothShapeAsset"));
-			return false;
-		}
-	}
+void FPatternAssets::BuildAssetArrays(
+	const FLoadedShapeData& Data,
+	TArray<FShapeData>& OutShapes,
+	TArray<FCurvePointData>& OutCurvePoints,
+	TArray<FSeamData>& OutSeams)
+{
+	OutShapes.Reset(Data.CompletedShapes.Num());
+	OutCurvePoints.Reset(Data.CurvePoints.Points.Num());
+	OutSeams.Reset(Data.SeamDefinitions.Num());
 
-	TargetAsset->ClothShapes.Empty();
-	TargetAsset->ClothCurvePoints.Empty();
-	
+	static const TArray<bool> NoFlags;
 	
-	for (int32 ShapeIdx = 0; ShapeIdx < CompletedShapes.Num(); ++ShapeIdx)
+	for (int32 ShapeIdx = 0; ShapeIdx < Data.CompletedShapes.Num(); ++ShapeIdx)
 	{
-		const FInterpCurve<FVector2D>& ShapeCurve = CompletedShapes[ShapeIdx];
-		const TArray<bool>& ShapeFlags = CompletedBezierFlags[ShapeIdx];
-		
-		FShapeData SavedShape;
+		const FInterpCurve<FVector2D>& ShapeCurve = Data.CompletedShapes[ShapeIdx];
+		const TArray<bool>& ShapeFlags = Data.CompletedBezierFlags.IsValidIndex(ShapeIdx) ? Data.CompletedBezierFlags[ShapeIdx] : NoFlags;
 		
+		FShapeData& SavedShape = OutShapes.AddDefaulted_GetRef();
+		const FShapeTransform2D& Transform = FShapeTransform2D::Get(Data.CompletedShapeTransforms, ShapeIdx);
+		SavedShape.Translation = Transform.Translation;
+		SavedShape.RotationDegrees = Transform.RotationDegrees;
+		SavedShape.CompletedClothShape.Reserve(ShapeCurve.Points.Num());
 		
 		for (int32 i = 0; i < ShapeCurve.Points.Num(); ++i)
 		{
@@ -76,48 +78,129 @@ bool FPatternAssets::SaveShapeAsset(
 									  ? ShapeFlags[i] 
 									  : true;
 			SavedShape.CompletedClothShape.Add(NewPoint);
-			
 		}
-
-		TargetAsset->ClothShapes.Add(SavedShape);
 	}
 
-	
 	// Iterate over FInterpCurve keys (points)
-	for (int32 i = 0; i < CurvePoints.Points.Num(); ++i)
+	for (int32 i = 0; i < Data.CurvePoints.Points.Num(); ++i)
 	{
-		const FInterpCurvePoint<FVector2D>& Point = CurvePoints.Points[i];
+		const FInterpCurvePoint<FVector2D>& Point = Data.CurvePoints.Points[i];
 
 		FCurvePointData NewPoint;
 		NewPoint.InputKey = Point.InVal;
 		NewPoint.Position = Point.OutVal;
 		NewPoint.ArriveTangent = Point.ArriveTangent;
 		NewPoint.LeaveTangent = Point.LeaveTangent;
-		NewPoint.bUseBezier = bUseBezierPerPoint.IsValidIndex(i) ? bUseBezierPerPoint[i] : true;
+		NewPoint.bUseBezier = Data.bUseBezierPerPoint.IsValidIndex(i) ? Data.bUseBezierPerPoint[i] : true;
 		
 		// Add to the array
-		TargetAsset->ClothCurvePoints.Add(NewPoint);
+		OutCurvePoints.Add(NewPoint);
+	}
+
+	// seams on the unfinished curve have no stable shape index to come back to
+	for (const FSeamDefinition& Def : Data.SeamDefinitions)
+	{
+		if (!Data.CompletedShapes.IsValidIndex(Def.ShapeA) || !Data.CompletedShapes.IsValidIndex(Def.ShapeB))
+		{
+			continue;
+		}
+
+		FSeamData& Seam = OutSeams.AddDefaulted_GetRef();
+		Seam.ShapeA = Def.ShapeA;
+		Seam.EdgeA = FIntPoint(Def.EdgeA.Start, Def.EdgeA.End);
+		Seam.ShapeB = Def.ShapeB;
+		Seam.EdgeB = FIntPoint(Def.EdgeB.Start, Def.EdgeB.End);
 	}
+}
+
 
+UClothShapeAsset* FPatternAssets::FindOrCreateShapeAsset(
+	const FString& AssetPath,
+	const FString& AssetName,
+	FString& OutPackageFileName)
+{
+	if (AssetPath.Contains(TEXT(":")) || AssetPath.Contains(TEXT("?")))
+	{
+		return nullptr; // reject illegal chars
+	}
+	
+	// Create package path
+	FString PackageName = FString::Printf(TEXT("/Game/ClothDesignAssets/%s/%s"), *AssetPath, *AssetName);
+	FString SanitizedPackageName = UPackageTools::SanitizePackageName(PackageName);
+	OutPackageFileName = FPackageName::LongPackageNameToFilename(SanitizedPackageName, FPackageName::GetAssetPackageExtension());
 	
+	// an asset saved earlier in this session is still in memory; only go to disk otherwise
+	UPackage* Package = FindPackage(nullptr, *SanitizedPackageName);
+	if (!Package && FPackageName::DoesPackageExist(SanitizedPackageName))
+	{
+		Package = LoadPackage(nullptr, *SanitizedPackageName, LOAD_None);
+	}
+	if (!Package)
+	{
+		// If the package doesn't exist, create it
+		Package = CreatePackage(*SanitizedPackageName);
+	}
+	if (!Package)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to create package for saving asset"));
+		return nullptr;
+	}
 
-	FAssetRegistryModule::AssetCreated(TargetAsset);
+	if (!Package->IsFullyLoaded())
+	{
+		Package->FullyLoad();
+	}
 	
+	UClothShapeAsset* TargetAsset = FindObject<UClothShapeAsset>(Package, *AssetName);
+	if (!TargetAsset)
+	{
+		TargetAsset = NewObject<UClothShapeAsset>(Package, *AssetName, RF_Public | RF_Standalone);
+		if (!TargetAsset)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to create new UClothShapeAsset"));
+			return nullptr;
+		}
+		FAssetRegistryModule::AssetCreated(TargetAsset);
+	}
+
+	return TargetAsset;
+}
+
 
-	// Save package to disk
-	FString PackageFileName = FPackageName::LongPackageNameToFilename(SanitizedPackageName, FPackageName::GetAssetPackageExtension());
+bool FPatternAssets::WriteShapeAsset(
+	UClothShapeAsset* Asset,
+	const FString& PackageFileName,
+	bool bAsyncWrite,
+	int64* OutFileSize)
+{
+	if (!Asset)
+	{
+		return false;
+	}
+
+	UPackage* Package = Asset->GetOutermost();
 	
 	FSavePackageArgs SaveArgs;
 	SaveArgs.TopLevelFlags   = RF_Public | RF_Standalone;
 	SaveArgs.Error           = GError;
 	SaveArgs.bWarnOfLongFilename = false;
+	if (bAsyncWrite)
+	{
+		// serialise to memory here, the file write runs on the async writer
+		SaveArgs.SaveFlags |= SAVE_Async;
+	}
 
-	bool bSaved = UPackage::SavePackage(
+	const FSavePackageResultStruct Result = UPackage::Save(
 		Package,                  // UPackage* InOuter
-		TargetAsset,              // UObject* Base
+		Asset,                    // UObject* Base
 		*PackageFileName,         // const TCHAR* Filename
 		SaveArgs                  // const FSavePackageArgs& Args
 	);
+	const bool bSaved = Result.IsSuccessful();
+	if (bSaved && OutFileSize)
+	{
+		*OutFileSize = Result.TotalFileSize;
+	}
 	
 	if (bSaved)
 	{
@@ -145,7 +228,10 @@ bool FPatternAssets::LoadCanvasState(UClothShapeAsset* ClothAsset, FCanvasState&
     // Start with a fresh state
     OutState = FCanvasState(); 
 
-    // Completed shapes
+    // Completed shapes; empty ones are dropped, so remember where each saved index went
+    TArray<int32> LoadedShapeIndex;
+    LoadedShapeIndex.Init(INDEX_NONE, ClothAsset->ClothShapes.Num());
+
     for (int32 ShapeIdx = 0; ShapeIdx < ClothAsset->ClothShapes.Num(); ++ShapeIdx)
     {
         const FShapeData& SavedShape = ClothAsset->ClothShapes[ShapeIdx];
@@ -170,8 +256,14 @@ bool FPatternAssets::LoadCanvasState(UClothShapeAsset* ClothAsset, FCanvasState&
 
         if (Curve.Points.Num() > 0)
         {
+            LoadedShapeIndex[ShapeIdx] = OutState.CompletedShapes.Num();
             OutState.CompletedShapes.Add(MoveTemp(Curve));
             OutState.CompletedBezierFlags.Add(MoveTemp(BezierFlags));
+
+            FShapeTransform2D Transform;
+            Transform.Translation = SavedShape.Translation;
+            Transform.RotationDegrees = SavedShape.RotationDegrees;
+            OutState.CompletedShapeTransforms.Add(Transform);
         }
     }
 
@@ -197,6 +289,34 @@ bool FPatternAssets::LoadCanvasState(UClothShapeAsset* ClothAsset, FCanvasState&
         OutState.CurvePoints       = MoveTemp(Curve);
     }
 
+    // Seams; anything that no longer matches the shapes is skipped rather than guessed
+    for (const FSeamData& Seam : ClothAsset->Seams)
+    {
+        const int32 ShapeA = LoadedShapeIndex.IsValidIndex(Seam.ShapeA) ? LoadedShapeIndex[Seam.ShapeA] : INDEX_NONE;
+        const int32 ShapeB = LoadedShapeIndex.IsValidIndex(Seam.ShapeB) ? LoadedShapeIndex[Seam.ShapeB] : INDEX_NONE;
+        if (ShapeA == INDEX_NONE || ShapeB == INDEX_NONE)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Skipping seam between missing shapes %d and %d"), Seam.ShapeA, Seam.ShapeB);
+            continue;
+        }
+
+        const TArray<FInterpCurvePoint<FVector2D>>& PointsA = OutState.CompletedShapes[ShapeA].Points;
+        const TArray<FInterpCurvePoint<FVector2D>>& PointsB = OutState.CompletedShapes[ShapeB].Points;
+        if (!PointsA.IsValidIndex(Seam.EdgeA.X) || !PointsA.IsValidIndex(Seam.EdgeA.Y) ||
+            !PointsB.IsValidIndex(Seam.EdgeB.X) || !PointsB.IsValidIndex(Seam.EdgeB.Y))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Skipping seam with out-of-range points between shapes %d and %d"), Seam.ShapeA, Seam.ShapeB);
+            continue;
+        }
+
+        FSeamDefinition Def;
+        Def.ShapeA = ShapeA;
+        Def.EdgeA = { Seam.EdgeA.X, Seam.EdgeA.Y };
+        Def.ShapeB = ShapeB;
+        Def.EdgeB = { Seam.EdgeB.X, Seam.EdgeB.Y };
+        OutState.SeamDefinitions.Add(Def);
+    }
+
     // reset selection / pan / zoom to defaults
     OutState.SelectedPointIndex = INDEX_NONE;
     OutState.PanOffset          = FVector2D::ZeroVector;
@@ -207,6 +327,42 @@ bool FPatternAssets::LoadCanvasState(UClothShapeAsset* ClothAsset, FCanvasState&
 
 
 
+bool FPatternAssets::ImportPatternFile(const FString& FilePath, FCanvasState& OutState)
+{
+	FLoadedShapeData Data;
+	FString Error;
+	if (!FPatternImport::ImportFile(FilePath, FPatternImportOptions(), Data, Error))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Could not import %s: %s"), *FilePath, *Error);
+		return false;
+	}
+
+	MakeCanvasState(MoveTemp(Data), OutState);
+	return true;
+}
+
+
+void FPatternAssets::MakeCanvasState(FLoadedShapeData&& Data, FCanvasState& OutState)
+{
+	OutState = FCanvasState();
+
+	OutState.CompletedShapes          = MoveTemp(Data.CompletedShapes);
+	OutState.CompletedBezierFlags     = MoveTemp(Data.CompletedBezierFlags);
+	OutState.CompletedShapeTransforms = MoveTemp(Data.CompletedShapeTransforms);
+	OutState.CurvePoints              = MoveTemp(Data.CurvePoints);
+	OutState.bUseBezierPerPoint       = MoveTemp(Data.bUseBezierPerPoint);
+	OutState.SeamDefinitions          = MoveTemp(Data.SeamDefinitions);
+
+	OutState.CompletedBezierFlags.SetNum(OutState.CompletedShapes.Num());
+	OutState.CompletedShapeTransforms.SetNum(OutState.CompletedShapes.Num());
+
+	OutState.SelectedPointIndex = INDEX_NONE;
+	OutState.PanOffset          = FVector2D::ZeroVector;
+	OutState.ZoomFactor         = 5.0f;
+}
+
+
+
 FString FPatternAssetManager::GetSelectedShapeAssetPath() const
 {
 	return ClothAsset.IsValid() ? ClothAsset->GetPathName() : FString();
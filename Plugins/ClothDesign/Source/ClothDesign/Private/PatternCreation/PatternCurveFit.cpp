@@ -0,0 +1,479 @@
+#include "PatternCreation/PatternCurveFit.h"
+#include "Canvas/CanvasUtils.h"
+#include "Async/ParallelFor.h"
+#include <atomic>
+
+
+namespace
+{
+	constexpr int32 MaxReparameterizeIterations = 4;
+	constexpr int32 MaxSplitDepth = 32;
+
+	struct FCubic
+	{
+		FVector2D P0, C1, C2, P3;
+
+		FVector2D Eval(double T) const
+		{
+			const double S = 1.0 - T;
+			return P0 * (S * S * S) + C1 * (3.0 * S * S * T) + C2 * (3.0 * S * T * T) + P3 * (T * T * T);
+		}
+
+		FVector2D Derivative(double T) const
+		{
+			const double S = 1.0 - T;
+			return (C1 - P0) * (3.0 * S * S) + (C2 - C1) * (6.0 * S * T) + (P3 - C2) * (3.0 * T * T);
+		}
+
+		FVector2D SecondDerivative(double T) const
+		{
+			return (C2 - C1 * 2.0 + P0) * (6.0 * (1.0 - T)) + (P3 - C2 * 2.0 + C1) * (6.0 * T);
+		}
+	};
+
+	/** One edge of the fitted outline, from P0 to the next edge's P0. */
+	struct FFittedEdge
+	{
+		FVector2D P0;
+		FVector2D C1;
+		FVector2D C2;
+		bool bCurve = false;
+	};
+
+	double DistanceToSegmentSquared(const FVector2D& P, const FVector2D& A, const FVector2D& B)
+	{
+		return FVector2D::DistSquared(P, FMath::ClosestPointOnSegment2D(P, A, B));
+	}
+
+	void ChordLengthParameterize(const FVector2D* Pts, int32 Num, TArray<double>& OutU)
+	{
+		OutU.SetNumUninitialized(Num);
+		OutU[0] = 0.0;
+		for (int32 i = 1; i < Num; ++i)
+		{
+			OutU[i] = OutU[i - 1] + FVector2D::Distance(Pts[i], Pts[i - 1]);
+		}
+		const double Total = OutU[Num - 1];
+		for (int32 i = 1; i < Num; ++i)
+		{
+			OutU[i] = Total > 0.0 ? OutU[i] / Total : static_cast<double>(i) / (Num - 1);
+		}
+	}
+
+	/** Least-squares handle lengths along fixed end tangents. */
+	FCubic GenerateBezier(const FVector2D* Pts, int32 Num, const TArray<double>& U, const FVector2D& T1, const FVector2D& T2)
+	{
+		FCubic Bez;
+		Bez.P0 = Pts[0];
+		Bez.P3 = Pts[Num - 1];
+
+		double C00 = 0.0, C01 = 0.0, C11 = 0.0, X0 = 0.0, X1 = 0.0;
+		for (int32 i = 0; i < Num; ++i)
+		{
+			const double T = U[i];
+			const double S = 1.0 - T;
+			const double B0 = S * S * S, B1 = 3.0 * S * S * T, B2 = 3.0 * S * T * T, B3 = T * T * T;
+			const FVector2D A0 = T1 * B1;
+			const FVector2D A1 = T2 * B2;
+			C00 += A0 | A0;
+			C01 += A0 | A1;
+			C11 += A1 | A1;
+			const FVector2D Tmp = Pts[i] - (Bez.P0 * (B0 + B1) + Bez.P3 * (B2 + B3));
+			X0 += A0 | Tmp;
+			X1 += A1 | Tmp;
+		}
+
+		const double Det = C00 * C11 - C01 * C01;
+		double AlphaL = FMath::Abs(Det) > UE_DOUBLE_SMALL_NUMBER ? (X0 * C11 - X1 * C01) / Det : 0.0;
+		double AlphaR = FMath::Abs(Det) > UE_DOUBLE_SMALL_NUMBER ? (C00 * X1 - C01 * X0) / Det : 0.0;
+
+		// degenerate or backwards handles: fall back to the usual third of the chord
+		const double SegLength = FVector2D::Distance(Bez.P0, Bez.P3);
+		const double Epsilon = 1e-6 * SegLength;
+		if (AlphaL < Epsilon || AlphaR < Epsilon)
+		{
+			AlphaL = AlphaR = SegLength / 3.0;
+		}
+
+		Bez.C1 = Bez.P0 + T1 * AlphaL;
+		Bez.C2 = Bez.P3 + T2 * AlphaR;
+		return Bez;
+	}
+
+	double ComputeMaxError(const FVector2D* Pts, int32 Num, const FCubic& Bez, const TArray<double>& U, int32& OutSplit)
+	{
+		double MaxDistSq = 0.0;
+		OutSplit = Num / 2;
+		for (int32 i = 1; i < Num - 1; ++i)
+		{
+			const double DistSq = FVector2D::DistSquared(Bez.Eval(U[i]), Pts[i]);
+			if (DistSq >= MaxDistSq)
+			{
+				MaxDistSq = DistSq;
+				OutSplit = i;
+			}
+		}
+		return MaxDistSq;
+	}
+
+	/** One Newton step per sample towards its closest point on the curve. */
+	void Reparameterize(const FVector2D* Pts, int32 Num, const FCubic& Bez, TArray<double>& U)
+	{
+		for (int32 i = 0; i < Num; ++i)
+		{
+			const FVector2D Q = Bez.Eval(U[i]) - Pts[i];
+			const FVector2D D1 = Bez.Derivative(U[i]);
+			const FVector2D D2 = Bez.SecondDerivative(U[i]);
+			const double Denominator = (D1 | D1) + (Q | D2);
+			if (FMath::Abs(Denominator) > UE_DOUBLE_SMALL_NUMBER)
+			{
+				U[i] = FMath::Clamp(U[i] - (Q | D1) / Denominator, 0.0, 1.0);
+			}
+		}
+	}
+
+	/**
+	 * Schneider's recursive fit. T1 points from the first sample into the run, T2 from the
+	 * last sample back into it.
+	 */
+	void FitCubics(const FVector2D* Pts, int32 Num, const FVector2D& T1, const FVector2D& T2, double ErrorSq, int32 Depth, TArray<FCubic>& Out)
+	{
+		if (Num == 2)
+		{
+			const double Third = FVector2D::Distance(Pts[0], Pts[1]) / 3.0;
+			Out.Add({ Pts[0], Pts[0] + T1 * Third, Pts[1] + T2 * Third, Pts[1] });
+			return;
+		}
+
+		TArray<double> U;
+		ChordLengthParameterize(Pts, Num, U);
+		FCubic Bez = GenerateBezier(Pts, Num, U, T1, T2);
+
+		int32 Split;
+		double MaxErrorSq = ComputeMaxError(Pts, Num, Bez, U, Split);
+		if (MaxErrorSq <= ErrorSq || Depth >= MaxSplitDepth)
+		{
+			Out.Add(Bez);
+			return;
+		}
+
+		// close misses usually only need a better parameterisation
+		if (MaxErrorSq <= ErrorSq * 4.0)
+		{
+			for (int32 Iteration = 0; Iteration < MaxReparameterizeIterations; ++Iteration)
+			{
+				Reparameterize(Pts, Num, Bez, U);
+				Bez = GenerateBezier(Pts, Num, U, T1, T2);
+				MaxErrorSq = ComputeMaxError(Pts, Num, Bez, U, Split);
+				if (MaxErrorSq <= ErrorSq)
+				{
+					Out.Add(Bez);
+					return;
+				}
+			}
+		}
+
+		// split at the worst sample, with a shared tangent so the halves join smoothly
+		FVector2D Centre = (Pts[Split - 1] - Pts[Split + 1]).GetSafeNormal();
+		if (Centre.IsNearlyZero())
+		{
+			Centre = (Pts[Split - 1] - Pts[Split]).GetSafeNormal();
+		}
+		FitCubics(Pts, Split + 1, T1, Centre, ErrorSq, Depth + 1, Out);
+		FitCubics(Pts + Split, Num - Split, -Centre, T2, ErrorSq, Depth + 1, Out);
+	}
+
+	bool IsStraight(const TArray<FVector2D>& Run, double ToleranceSq)
+	{
+		for (int32 i = 1; i < Run.Num() - 1; ++i)
+		{
+			if (DistanceToSegmentSquared(Run[i], Run[0], Run.Last()) > ToleranceSq)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Turning angle at a sample of a closed polyline, from its direct neighbours. */
+	double TurnAngle(const TArray<FVector2D>& Points, int32 Index)
+	{
+		const int32 Num = Points.Num();
+		const FVector2D In = (Points[Index] - Points[(Index + Num - 1) % Num]).GetSafeNormal();
+		const FVector2D Out = (Points[(Index + 1) % Num] - Points[Index]).GetSafeNormal();
+		return FMath::Acos(FMath::Clamp(In | Out, -1.0, 1.0));
+	}
+}
+
+
+void FPatternCurveFit::SampleOutline(
+	const FInterpCurve<FVector2D>& Shape,
+	const TArray<bool>& BezierFlags,
+	TArray<FVector2D>& OutPoints)
+{
+	OutPoints.Reset();
+	const int32 NumPts = Shape.Points.Num();
+	if (NumPts == 0)
+	{
+		return;
+	}
+
+	auto AddPoint = [&OutPoints](const FVector2D& P)
+	{
+		if (OutPoints.Num() == 0 || !OutPoints.Last().Equals(P, UE_KINDA_SMALL_NUMBER))
+		{
+			OutPoints.Add(P);
+		}
+	};
+
+	for (int32 Seg = 0; Seg < NumPts - 1; ++Seg)
+	{
+		AddPoint(Shape.Points[Seg].OutVal);
+
+		// segments between two N-points are straight, the ends describe them fully
+		const bool bCurved = (BezierFlags.IsValidIndex(Seg) && BezierFlags[Seg])
+			|| (BezierFlags.IsValidIndex(Seg + 1) && BezierFlags[Seg + 1]);
+		if (!bCurved)
+		{
+			continue;
+		}
+
+		const float AIn = Shape.Points[Seg].InVal;
+		const float BIn = Shape.Points[Seg + 1].InVal;
+		for (int32 i = 1; i < SamplesPerCurvedSegment; ++i)
+		{
+			AddPoint(Shape.Eval(FMath::Lerp(AIn, BIn, static_cast<float>(i) / SamplesPerCurvedSegment)));
+		}
+	}
+	AddPoint(Shape.Points.Last().OutVal);
+
+	// the closing edge is implicit
+	if (OutPoints.Num() > 1 && OutPoints.Last().Equals(OutPoints[0], UE_KINDA_SMALL_NUMBER))
+	{
+		OutPoints.Pop();
+	}
+}
+
+
+void FPatternCurveFit::SimplifyClosed(const TArray<FVector2D>& Points, double Tolerance, TArray<int32>& OutKept)
+{
+	OutKept.Reset();
+	const int32 Num = Points.Num();
+	if (Num < 3)
+	{
+		for (int32 i = 0; i < Num; ++i)
+		{
+			OutKept.Add(i);
+		}
+		return;
+	}
+
+	// a closed outline has no end points; split it at the sample farthest from the first
+	int32 Far = 1;
+	for (int32 i = 2; i < Num; ++i)
+	{
+		if (FVector2D::DistSquared(Points[i], Points[0]) > FVector2D::DistSquared(Points[Far], Points[0]))
+		{
+			Far = i;
+		}
+	}
+
+	TBitArray<> Keep(false, Num);
+	Keep[0] = true;
+	Keep[Far] = true;
+
+	const double ToleranceSq = Tolerance * Tolerance;
+	TArray<TPair<int32, int32>> Stack;
+	Stack.Add({ 0, Far });
+	Stack.Add({ Far, Num });   // Num stands for index 0 after wrapping around
+
+	while (Stack.Num() > 0)
+	{
+		const TPair<int32, int32> Range = Stack.Pop(EAllowShrinking::No);
+		const FVector2D& A = Points[Range.Key % Num];
+		const FVector2D& B = Points[Range.Value % Num];
+
+		int32 Worst = INDEX_NONE;
+		double WorstSq = ToleranceSq;
+		for (int32 i = Range.Key + 1; i < Range.Value; ++i)
+		{
+			const double DistSq = DistanceToSegmentSquared(Points[i], A, B);
+			if (DistSq > WorstSq)
+			{
+				WorstSq = DistSq;
+				Worst = i;
+			}
+		}
+
+		if (Worst != INDEX_NONE)
+		{
+			Keep[Worst] = true;
+			Stack.Add({ Range.Key, Worst });
+			Stack.Add({ Worst, Range.Value });
+		}
+	}
+
+	for (TConstSetBitIterator<> It(Keep); It; ++It)
+	{
+		OutKept.Add(It.GetIndex());
+	}
+}
+
+
+bool FPatternCurveFit::FitShape(
+	const FInterpCurve<FVector2D>& Shape,
+	const TArray<bool>& BezierFlags,
+	double Tolerance,
+	FInterpCurve<FVector2D>& OutShape,
+	TArray<bool>& OutBezierFlags,
+	double CornerAngleDegrees)
+{
+	TArray<FVector2D> Points;
+	SampleOutline(Shape, BezierFlags, Points);
+	const int32 Num = Points.Num();
+	if (Num < 4 || Tolerance <= 0.0)
+	{
+		return false;
+	}
+
+	// breakpoints: Douglas-Peucker candidates that turn sharply are corners
+	TArray<int32> Candidates;
+	SimplifyClosed(Points, Tolerance, Candidates);
+
+	const double CornerAngle = FMath::DegreesToRadians(CornerAngleDegrees);
+	TArray<int32> Breaks;
+	TBitArray<> IsCorner(false, Num);
+	for (const int32 Index : Candidates)
+	{
+		if (TurnAngle(Points, Index) > CornerAngle)
+		{
+			Breaks.Add(Index);
+			IsCorner[Index] = true;
+		}
+	}
+
+	// smooth outlines still need two breakpoints; they join with a shared tangent
+	if (Breaks.Num() < 2)
+	{
+		const int32 Anchor = Breaks.Num() == 1 ? Breaks[0] : 0;
+		int32 Far = (Anchor + 1) % Num;
+		for (int32 i = 0; i < Num; ++i)
+		{
+			if (FVector2D::DistSquared(Points[i], Points[Anchor]) > FVector2D::DistSquared(Points[Far], Points[Anchor]))
+			{
+				Far = i;
+			}
+		}
+		Breaks.AddUnique(Anchor);
+		Breaks.AddUnique(Far);
+		Breaks.Sort();
+	}
+
+	auto SmoothTangent = [&Points, Num](int32 Index)
+	{
+		return (Points[(Index + 1) % Num] - Points[(Index + Num - 1) % Num]).GetSafeNormal();
+	};
+
+	const double ToleranceSq = Tolerance * Tolerance;
+	TArray<FFittedEdge> Edges;
+	TArray<FVector2D> Run;
+	TArray<FCubic> Cubics;
+
+	for (int32 b = 0; b < Breaks.Num(); ++b)
+	{
+		const int32 Start = Breaks[b];
+		int32 End = Breaks[(b + 1) % Breaks.Num()];
+		if (End <= Start)
+		{
+			End += Num;
+		}
+
+		Run.Reset();
+		for (int32 i = Start; i <= End; ++i)
+		{
+			Run.Add(Points[i % Num]);
+		}
+
+		if (IsStraight(Run, ToleranceSq))
+		{
+			Edges.Add({ Run[0], FVector2D::ZeroVector, FVector2D::ZeroVector, false });
+			continue;
+		}
+
+		const FVector2D T1 = IsCorner[Start] ? (Run[1] - Run[0]).GetSafeNormal() : SmoothTangent(Start);
+		const FVector2D T2 = IsCorner[End % Num] ? (Run[Run.Num() - 2] - Run.Last()).GetSafeNormal() : -SmoothTangent(End % Num);
+
+		Cubics.Reset();
+		FitCubics(Run.GetData(), Run.Num(), T1, T2, ToleranceSq, 0, Cubics);
+		for (const FCubic& Cubic : Cubics)
+		{
+			Edges.Add({ Cubic.P0, Cubic.C1, Cubic.C2, true });
+		}
+	}
+
+	// start after a straight edge if there is one, so it becomes the implicit closing edge
+	const int32 LineIndex = Edges.IndexOfByPredicate([](const FFittedEdge& E) { return !E.bCurve; });
+	const bool bImplicitClose = LineIndex != INDEX_NONE;
+	const int32 First = bImplicitClose ? (LineIndex + 1) % Edges.Num() : 0;
+	const int32 NumAnchors = bImplicitClose ? Edges.Num() : Edges.Num() + 1;
+
+	if (NumAnchors < 3 || NumAnchors >= Shape.Points.Num())
+	{
+		return false;
+	}
+
+	OutShape.Points.Reset(NumAnchors);
+	OutBezierFlags.Reset(NumAnchors);
+	for (int32 i = 0; i < NumAnchors; ++i)
+	{
+		const FFittedEdge& Edge = Edges[(First + i) % Edges.Num()];
+		const FFittedEdge& Prev = Edges[(First + i + Edges.Num() - 1) % Edges.Num()];
+		const bool bHasIn = i > 0;
+		const bool bHasOut = i < NumAnchors - 1;   // the last anchor's edge is the implicit one or there is none
+
+		// Hermite tangents over a unit key step are three times the Bezier handle offsets
+		FInterpCurvePoint<FVector2D> Pt;
+		Pt.InVal         = i;
+		Pt.OutVal        = Edge.P0;
+		Pt.ArriveTangent = (bHasIn && Prev.bCurve) ? (Edge.P0 - Prev.C2) * 3.0 : FVector2D::ZeroVector;
+		Pt.LeaveTangent  = (bHasOut && Edge.bCurve) ? (Edge.C1 - Edge.P0) * 3.0 : FVector2D::ZeroVector;
+		Pt.InterpMode    = CIM_CurveAuto;
+
+		OutShape.Points.Add(Pt);
+		OutBezierFlags.Add((bHasIn && Prev.bCurve) || (bHasOut && Edge.bCurve));
+	}
+
+	FCanvasUtils::RecalculateNTangents(OutShape, OutBezierFlags);
+	return true;
+}
+
+
+int32 FPatternCurveFit::FitShapes(
+	TArray<FInterpCurve<FVector2D>>& Shapes,
+	TArray<TArray<bool>>& BezierFlags,
+	double Tolerance,
+	const TBitArray<>* ShapeMask)
+{
+	BezierFlags.SetNum(Shapes.Num());
+	std::atomic<int32> NumFitted { 0 };
+
+	// shapes are independent; each worker only writes its own entries
+	ParallelFor(Shapes.Num(), [&](int32 ShapeIndex)
+	{
+		if (ShapeMask && (!ShapeMask->IsValidIndex(ShapeIndex) || !(*ShapeMask)[ShapeIndex]))
+		{
+			return;
+		}
+
+		FInterpCurve<FVector2D> Fitted;
+		TArray<bool> FittedFlags;
+		if (FitShape(Shapes[ShapeIndex], BezierFlags[ShapeIndex], Tolerance, Fitted, FittedFlags))
+		{
+			Shapes[ShapeIndex] = MoveTemp(Fitted);
+			BezierFlags[ShapeIndex] = MoveTemp(FittedFlags);
+			++NumFitted;
+		}
+	});
+
+	return NumFitted.load();
+}
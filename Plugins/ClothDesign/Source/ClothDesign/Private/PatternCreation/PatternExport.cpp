@@ -0,0 +1,548 @@
+#include "PatternCreation/PatternExport.h"
+#include "DynamicMesh/DynamicMeshAttributeSet.h"
+#include "DynamicMesh/MeshNormals.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformTime.h"
+
+using UE::Geometry::FDynamicMesh3;
+using UE::Geometry::FDynamicMeshUVOverlay;
+using UE::Geometry::FIndex2i;
+using UE::Geometry::FIndex3i;
+
+
+namespace
+{
+	constexpr int32 WriteChunkSize = 64 * 1024;
+
+	constexpr uint32 GlbMagic = 0x46546C67;         // "glTF"
+	constexpr uint32 GlbChunkJson = 0x4E4F534A;     // "JSON"
+	constexpr uint32 GlbChunkBin = 0x004E4942;      // "BIN\0"
+
+	/** Collects small writes and hands them to an archive one chunk at a time. */
+	class FChunkedWriter
+	{
+	public:
+		explicit FChunkedWriter(FArchive& InAr)
+			: Ar(InAr)
+		{
+			Buffer.Reserve(WriteChunkSize);
+		}
+
+		~FChunkedWriter()
+		{
+			Flush();
+		}
+
+		void Write(const void* Data, int32 Num)
+		{
+			if (Buffer.Num() + Num > WriteChunkSize)
+			{
+				Flush();
+			}
+			Buffer.Append(static_cast<const uint8*>(Data), Num);
+		}
+
+		template <typename T>
+		void WriteValue(const T& Value)
+		{
+			Write(&Value, sizeof(T));
+		}
+
+		/** @brief Formats one short line of text; longer output is cut off. */
+		template <typename FmtType, typename... Types>
+		void Printf(const FmtType& Fmt, Types... Args)
+		{
+			ANSICHAR Line[192];
+			const int32 Len = FCStringAnsi::Snprintf(Line, UE_ARRAY_COUNT(Line), Fmt, Args...);
+			Write(Line, FMath::Clamp(Len, 0, static_cast<int32>(UE_ARRAY_COUNT(Line)) - 1));
+		}
+
+		void Flush()
+		{
+			if (Buffer.Num() > 0)
+			{
+				Ar.Serialize(Buffer.GetData(), Buffer.Num());
+				Buffer.Reset();
+			}
+		}
+
+	private:
+		FArchive& Ar;
+		TArray<uint8> Buffer;
+	};
+
+
+	FVector3f ToFilePoint(const FVector3d& P, const FPatternExportOptions& Options)
+	{
+		const FVector3d Scaled = P * Options.Scale;
+		return Options.bConvertToYUp
+			? FVector3f(Scaled.X, Scaled.Z, Scaled.Y)
+			: FVector3f(Scaled);
+	}
+
+
+	FVector3f ToFileNormal(const FVector3d& N, const FPatternExportOptions& Options)
+	{
+		return Options.bConvertToYUp ? FVector3f(N.X, N.Z, N.Y) : FVector3f(N);
+	}
+
+
+	FVector3d VertexNormal(const FDynamicMesh3& Mesh, int32 VID)
+	{
+		return Mesh.HasVertexNormals()
+			? FVector3d(Mesh.GetVertexNormal(VID))
+			: UE::Geometry::FMeshNormals::ComputeVertexNormal(Mesh, VID);
+	}
+
+
+	/** Swapping Y and Z mirrors the mesh, so the winding flips with it to keep faces outward. */
+	FIndex3i ToFileWinding(const FIndex3i& Tri, const FPatternExportOptions& Options)
+	{
+		return Options.bConvertToYUp ? FIndex3i(Tri.A, Tri.C, Tri.B) : Tri;
+	}
+
+
+	/** Pattern UVs are only written when every triangle has them. */
+	const FDynamicMeshUVOverlay* GetPatternUVs(const FDynamicMesh3& Mesh)
+	{
+		const FDynamicMeshUVOverlay* UVs = Mesh.HasAttributes() ? Mesh.Attributes()->PrimaryUV() : nullptr;
+		if (!UVs || UVs->ElementCount() == 0)
+		{
+			return nullptr;
+		}
+		for (const int32 TID : Mesh.TriangleIndicesItr())
+		{
+			if (!UVs->IsSetTriangle(TID))
+			{
+				return nullptr;
+			}
+		}
+		return UVs;
+	}
+
+
+	/**
+	 * How one mesh maps onto glTF vertices. With pattern UVs every UV element is a vertex,
+	 * otherwise every mesh vertex is; Compact turns either ID into a file index.
+	 */
+	struct FGlbMeshLayout
+	{
+		const FDynamicMesh3* Mesh = nullptr;
+		const FDynamicMeshUVOverlay* UVs = nullptr;
+		TArray<int32> Compact;
+		int32 NumVertices = 0;
+		int32 NumTriangles = 0;
+		int32 NumSeamEdges = 0;
+		FBox3f Bounds = FBox3f(ForceInit);
+
+		int32 ParentVertex(int32 ID) const
+		{
+			return UVs ? UVs->GetParentVertex(ID) : ID;
+		}
+
+		FIndex3i Triangle(int32 TID) const
+		{
+			return UVs ? UVs->GetTriangle(TID) : Mesh->GetTriangle(TID);
+		}
+
+		/** @brief IDs of the seam edge's end points as seen from its first triangle. */
+		FIndex2i SeamEdge(int32 EID) const
+		{
+			const FIndex2i EdgeV = Mesh->GetEdgeV(EID);
+			if (!UVs)
+			{
+				return EdgeV;
+			}
+			const int32 TID = Mesh->GetEdgeT(EID).A;
+			const FIndex3i TriV = Mesh->GetTriangle(TID);
+			const FIndex3i TriUV = UVs->GetTriangle(TID);
+			return FIndex2i(TriUV[TriV.IndexOf(EdgeV.A)], TriUV[TriV.IndexOf(EdgeV.B)]);
+		}
+
+		int64 BinaryBytes() const
+		{
+			const int64 PerVertex = sizeof(FVector3f) * 2 + (UVs ? sizeof(FVector2f) : 0);
+			return PerVertex * NumVertices + sizeof(uint32) * (3 * int64(NumTriangles) + 2 * int64(NumSeamEdges));
+		}
+	};
+
+
+	void PrepareGlbMesh(const FDynamicMesh3& Mesh, const FPatternExportOptions& Options, FGlbMeshLayout& Out)
+	{
+		Out.Mesh = &Mesh;
+		Out.UVs = GetPatternUVs(Mesh);
+		Out.Compact.Init(INDEX_NONE, Out.UVs ? Out.UVs->MaxElementID() : Mesh.MaxVertexID());
+
+		auto AddVertex = [&Out, &Mesh, &Options](int32 ID)
+		{
+			Out.Compact[ID] = Out.NumVertices++;
+			Out.Bounds += ToFilePoint(Mesh.GetVertex(Out.ParentVertex(ID)), Options);
+		};
+		if (Out.UVs)
+		{
+			for (const int32 ElementID : Out.UVs->ElementIndicesItr())
+			{
+				AddVertex(ElementID);
+			}
+		}
+		else
+		{
+			for (const int32 VID : Mesh.VertexIndicesItr())
+			{
+				AddVertex(VID);
+			}
+		}
+
+		Out.NumTriangles = Mesh.TriangleCount();
+		if (Options.bWriteSeams)
+		{
+			for (const int32 EID : Mesh.EdgeIndicesItr())
+			{
+				Out.NumSeamEdges += FPatternExport::IsSeamEdge(Mesh, EID) ? 1 : 0;
+			}
+		}
+	}
+
+
+	/** Appends one bufferView and its accessor to the glTF JSON; returns the accessor index. */
+	int32 AddGlbAccessor(
+		FString& BufferViews, FString& Accessors, int32& NumAccessors, int64& ByteOffset,
+		int64 ByteLength, int32 Target, int32 ComponentType, int32 Count, const TCHAR* Type, const FString& Extra = FString())
+	{
+		BufferViews.Appendf(TEXT("%s{\"buffer\":0,\"byteOffset\":%lld,\"byteLength\":%lld,\"target\":%d}"),
+			NumAccessors > 0 ? TEXT(",") : TEXT(""), ByteOffset, ByteLength, Target);
+		Accessors.Appendf(TEXT("%s{\"bufferView\":%d,\"componentType\":%d,\"count\":%d,\"type\":\"%s\"%s}"),
+			NumAccessors > 0 ? TEXT(",") : TEXT(""), NumAccessors, ComponentType, Count, Type, *Extra);
+		ByteOffset += ByteLength;
+		return NumAccessors++;
+	}
+}
+
+
+bool FPatternExport::IsSeamEdge(const FDynamicMesh3& Mesh, int32 EdgeID)
+{
+	if (!Mesh.HasTriangleGroups() || !Mesh.IsEdge(EdgeID))
+	{
+		return false;
+	}
+	const FIndex2i EdgeT = Mesh.GetEdgeT(EdgeID);
+	return EdgeT.B != FDynamicMesh3::InvalidID
+		&& Mesh.GetTriangleGroup(EdgeT.A) != Mesh.GetTriangleGroup(EdgeT.B);
+}
+
+
+bool FPatternExport::ExportFile(const FString& FilePath, const TArray<const FDynamicMesh3*>& Meshes, const FPatternExportOptions& Options, FString& OutError)
+{
+	const FString Extension = FPaths::GetExtension(FilePath);
+	const bool bGlb = Extension.Equals(TEXT("glb"), ESearchCase::IgnoreCase);
+	const bool bObj = Extension.Equals(TEXT("obj"), ESearchCase::IgnoreCase);
+	if (!bGlb && !bObj)
+	{
+		OutError = FString::Printf(TEXT("Unsupported export file type: .%s"), *Extension);
+		return false;
+	}
+
+	const bool bHasTriangles = Meshes.ContainsByPredicate([](const FDynamicMesh3* Mesh) { return Mesh && Mesh->TriangleCount() > 0; });
+	if (!bHasTriangles)
+	{
+		OutError = TEXT("Nothing to export");
+		return false;
+	}
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!Writer)
+	{
+		OutError = FString::Printf(TEXT("Could not open %s for writing"), *FilePath);
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const bool bWritten = bGlb
+		? WriteGlb(*Writer, Meshes, Options)
+		: WriteObj(*Writer, Meshes, Options);
+	const bool bClosed = Writer->Close();
+	Writer.Reset();
+
+	if (!bWritten || !bClosed)
+	{
+		IFileManager::Get().Delete(*FilePath);
+		OutError = FString::Printf(TEXT("Write error on %s"), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Exported %d meshes to %s in %.2f s"), Meshes.Num(), *FilePath, FPlatformTime::Seconds() - StartTime);
+	return true;
+}
+
+
+bool FPatternExport::WriteGlb(FArchive& Ar, const TArray<const FDynamicMesh3*>& Meshes, const FPatternExportOptions& Options)
+{
+	// first pass: counts and bounds, which the JSON chunk must state before any data
+	TArray<FGlbMeshLayout> Layouts;
+	for (const FDynamicMesh3* Mesh : Meshes)
+	{
+		if (Mesh && Mesh->TriangleCount() > 0)
+		{
+			PrepareGlbMesh(*Mesh, Options, Layouts.AddDefaulted_GetRef());
+		}
+	}
+	if (Layouts.Num() == 0)
+	{
+		return false;
+	}
+
+	constexpr int32 FloatType = 5126;
+	constexpr int32 UIntType = 5125;
+	constexpr int32 ArrayBuffer = 34962;
+	constexpr int32 ElementArrayBuffer = 34963;
+
+	FString Nodes, GltfMeshes, BufferViews, Accessors;
+	int32 NumAccessors = 0;
+	int64 ByteOffset = 0;
+	for (int32 MeshIndex = 0; MeshIndex < Layouts.Num(); ++MeshIndex)
+	{
+		const FGlbMeshLayout& Layout = Layouts[MeshIndex];
+		const TCHAR* Sep = MeshIndex > 0 ? TEXT(",") : TEXT("");
+
+		const FString PositionBounds = FString::Printf(TEXT(",\"min\":[%.9g,%.9g,%.9g],\"max\":[%.9g,%.9g,%.9g]"),
+			Layout.Bounds.Min.X, Layout.Bounds.Min.Y, Layout.Bounds.Min.Z,
+			Layout.Bounds.Max.X, Layout.Bounds.Max.Y, Layout.Bounds.Max.Z);
+		const int32 Position = AddGlbAccessor(BufferViews, Accessors, NumAccessors, ByteOffset,
+			sizeof(FVector3f) * Layout.NumVertices, ArrayBuffer, FloatType, Layout.NumVertices, TEXT("VEC3"), PositionBounds);
+		const int32 Normal = AddGlbAccessor(BufferViews, Accessors, NumAccessors, ByteOffset,
+			sizeof(FVector3f) * Layout.NumVertices, ArrayBuffer, FloatType, Layout.NumVertices, TEXT("VEC3"));
+
+		FString Attributes = FString::Printf(TEXT("\"POSITION\":%d,\"NORMAL\":%d"), Position, Normal);
+		if (Layout.UVs)
+		{
+			const int32 TexCoord = AddGlbAccessor(BufferViews, Accessors, NumAccessors, ByteOffset,
+				sizeof(FVector2f) * Layout.NumVertices, ArrayBuffer, FloatType, Layout.NumVertices, TEXT("VEC2"));
+			Attributes.Appendf(TEXT(",\"TEXCOORD_0\":%d"), TexCoord);
+		}
+
+		const int32 Indices = AddGlbAccessor(BufferViews, Accessors, NumAccessors, ByteOffset,
+			sizeof(uint32) * 3 * int64(Layout.NumTriangles), ElementArrayBuffer, UIntType, 3 * Layout.NumTriangles, TEXT("SCALAR"));
+		FString Primitives = FString::Printf(TEXT("{\"attributes\":{%s},\"indices\":%d,\"mode\":4}"), *Attributes, Indices);
+
+		if (Layout.NumSeamEdges > 0)
+		{
+			const int32 SeamIndices = AddGlbAccessor(BufferViews, Accessors, NumAccessors, ByteOffset,
+				sizeof(uint32) * 2 * int64(Layout.NumSeamEdges), ElementArrayBuffer, UIntType, 2 * Layout.NumSeamEdges, TEXT("SCALAR"));
+			Primitives.Appendf(TEXT(",{\"attributes\":{\"POSITION\":%d},\"indices\":%d,\"mode\":1,\"extras\":{\"clothDesign\":\"seams\"}}"),
+				Position, SeamIndices);
+		}
+
+		const int32 NumPieces = Layout.Mesh->HasTriangleGroups() ? Layout.Mesh->MaxGroupID() : 1;
+		GltfMeshes.Appendf(TEXT("%s{\"name\":\"Garment_%d\",\"primitives\":[%s],\"extras\":{\"pieceCount\":%d}}"),
+			Sep, MeshIndex, *Primitives, NumPieces);
+		Nodes.Appendf(TEXT("%s{\"name\":\"Garment_%d\",\"mesh\":%d}"), Sep, MeshIndex, MeshIndex);
+	}
+
+	FString SceneNodes;
+	for (int32 MeshIndex = 0; MeshIndex < Layouts.Num(); ++MeshIndex)
+	{
+		SceneNodes.Appendf(TEXT("%s%d"), MeshIndex > 0 ? TEXT(",") : TEXT(""), MeshIndex);
+	}
+
+	const int64 BinLength = ByteOffset;
+	const FString Json = FString::Printf(
+		TEXT("{\"asset\":{\"version\":\"2.0\",\"generator\":\"ClothDesign\"},\"scene\":0,\"scenes\":[{\"nodes\":[%s]}],")
+		TEXT("\"nodes\":[%s],\"meshes\":[%s],\"buffers\":[{\"byteLength\":%lld}],\"bufferViews\":[%s],\"accessors\":[%s]}"),
+		*SceneNodes, *Nodes, *GltfMeshes, BinLength, *BufferViews, *Accessors);
+
+	const FTCHARToUTF8 JsonUtf8(*Json);
+	const uint32 JsonLength = Align(JsonUtf8.Length(), 4);
+	const int64 TotalLength = 12 + 8 + int64(JsonLength) + 8 + BinLength;
+	if (TotalLength > MAX_uint32)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Export] glTF binary would exceed 4 GB"));
+		return false;
+	}
+
+	// second pass: stream the chunks straight from the mesh buffers
+	FChunkedWriter Out(Ar);
+	Out.WriteValue(GlbMagic);
+	Out.WriteValue(uint32(2));
+	Out.WriteValue(uint32(TotalLength));
+
+	Out.WriteValue(JsonLength);
+	Out.WriteValue(GlbChunkJson);
+	Out.Write(JsonUtf8.Get(), JsonUtf8.Length());
+	for (uint32 Pad = JsonUtf8.Length(); Pad < JsonLength; ++Pad)
+	{
+		Out.WriteValue(ANSICHAR(' '));
+	}
+
+	Out.WriteValue(uint32(BinLength));
+	Out.WriteValue(GlbChunkBin);
+	for (const FGlbMeshLayout& Layout : Layouts)
+	{
+		const FDynamicMesh3& Mesh = *Layout.Mesh;
+
+		// IDs were compacted in iteration order, so iterating again yields file order
+		auto ForEachVertex = [&Layout, &Mesh](auto&& Func)
+		{
+			if (Layout.UVs)
+			{
+				for (const int32 ElementID : Layout.UVs->ElementIndicesItr())
+				{
+					Func(ElementID);
+				}
+			}
+			else
+			{
+				for (const int32 VID : Mesh.VertexIndicesItr())
+				{
+					Func(VID);
+				}
+			}
+		};
+
+		ForEachVertex([&](int32 ID)
+		{
+			Out.WriteValue(ToFilePoint(Mesh.GetVertex(Layout.ParentVertex(ID)), Options));
+		});
+		ForEachVertex([&](int32 ID)
+		{
+			Out.WriteValue(ToFileNormal(VertexNormal(Mesh, Layout.ParentVertex(ID)), Options));
+		});
+		if (Layout.UVs)
+		{
+			ForEachVertex([&](int32 ID)
+			{
+				Out.WriteValue(Layout.UVs->GetElement(ID));
+			});
+		}
+
+		for (const int32 TID : Mesh.TriangleIndicesItr())
+		{
+			const FIndex3i Tri = ToFileWinding(Layout.Triangle(TID), Options);
+			for (int32 Corner = 0; Corner < 3; ++Corner)
+			{
+				Out.WriteValue(uint32(Layout.Compact[Tri[Corner]]));
+			}
+		}
+
+		if (Layout.NumSeamEdges > 0)
+		{
+			for (const int32 EID : Mesh.EdgeIndicesItr())
+			{
+				if (IsSeamEdge(Mesh, EID))
+				{
+					const FIndex2i Edge = Layout.SeamEdge(EID);
+					Out.WriteValue(uint32(Layout.Compact[Edge.A]));
+					Out.WriteValue(uint32(Layout.Compact[Edge.B]));
+				}
+			}
+		}
+	}
+	Out.Flush();
+
+	return !Ar.IsError();
+}
+
+
+bool FPatternExport::WriteObj(FArchive& Ar, const TArray<const FDynamicMesh3*>& Meshes, const FPatternExportOptions& Options)
+{
+	FChunkedWriter Out(Ar);
+	Out.Printf("# ClothDesign garment export\n");
+
+	// OBJ indices are 1-based and global across objects
+	int32 VertexBase = 1;
+	int32 UVBase = 1;
+	int32 NumWritten = 0;
+	TArray<int32> Compact, CompactUV;
+
+	for (const FDynamicMesh3* MeshPtr : Meshes)
+	{
+		if (!MeshPtr || MeshPtr->TriangleCount() == 0)
+		{
+			continue;
+		}
+		const FDynamicMesh3& Mesh = *MeshPtr;
+		const FDynamicMeshUVOverlay* UVs = GetPatternUVs(Mesh);
+
+		Out.Printf("o Garment_%d\n", NumWritten++);
+
+		// OBJ indexes positions and UVs separately, so UV seams need no extra vertices
+		Compact.Init(INDEX_NONE, Mesh.MaxVertexID());
+		int32 NumVertices = 0;
+		for (const int32 VID : Mesh.VertexIndicesItr())
+		{
+			const FVector3f P = ToFilePoint(Mesh.GetVertex(VID), Options);
+			Out.Printf("v %.6f %.6f %.6f\n", P.X, P.Y, P.Z);
+			Compact[VID] = VertexBase + NumVertices++;
+		}
+		for (const int32 VID : Mesh.VertexIndicesItr())
+		{
+			const FVector3f N = ToFileNormal(VertexNormal(Mesh, VID), Options);
+			Out.Printf("vn %.6f %.6f %.6f\n", N.X, N.Y, N.Z);
+		}
+
+		int32 NumUVs = 0;
+		if (UVs)
+		{
+			CompactUV.Init(INDEX_NONE, UVs->MaxElementID());
+			for (const int32 ElementID : UVs->ElementIndicesItr())
+			{
+				// OBJ texture space starts at the bottom, the pattern's at the top
+				const FVector2f UV = UVs->GetElement(ElementID);
+				Out.Printf("vt %.6f %.6f\n", UV.X, 1.0f - UV.Y);
+				CompactUV[ElementID] = UVBase + NumUVs++;
+			}
+		}
+
+		// welding keeps each piece's triangles in order, so a group line per change is enough
+		int32 CurrentGroup = INDEX_NONE;
+		for (const int32 TID : Mesh.TriangleIndicesItr())
+		{
+			const int32 Group = Mesh.HasTriangleGroups() ? Mesh.GetTriangleGroup(TID) : 0;
+			if (Group != CurrentGroup)
+			{
+				Out.Printf("g piece_%d\n", Group);
+				CurrentGroup = Group;
+			}
+
+			const FIndex3i Tri = ToFileWinding(Mesh.GetTriangle(TID), Options);
+			if (UVs)
+			{
+				const FIndex3i TriUV = ToFileWinding(UVs->GetTriangle(TID), Options);
+				Out.Printf("f %d/%d/%d %d/%d/%d %d/%d/%d\n",
+					Compact[Tri.A], CompactUV[TriUV.A], Compact[Tri.A],
+					Compact[Tri.B], CompactUV[TriUV.B], Compact[Tri.B],
+					Compact[Tri.C], CompactUV[TriUV.C], Compact[Tri.C]);
+			}
+			else
+			{
+				Out.Printf("f %d//%d %d//%d %d//%d\n",
+					Compact[Tri.A], Compact[Tri.A], Compact[Tri.B], Compact[Tri.B], Compact[Tri.C], Compact[Tri.C]);
+			}
+		}
+
+		if (Options.bWriteSeams)
+		{
+			bool bSeamGroup = false;
+			for (const int32 EID : Mesh.EdgeIndicesItr())
+			{
+				if (!IsSeamEdge(Mesh, EID))
+				{
+					continue;
+				}
+				if (!bSeamGroup)
+				{
+					Out.Printf("g seams\n");
+					bSeamGroup = true;
+				}
+				const FIndex2i Edge = Mesh.GetEdgeV(EID);
+				Out.Printf("l %d %d\n", Compact[Edge.A], Compact[Edge.B]);
+			}
+		}
+
+		VertexBase += NumVertices;
+		UVBase += NumUVs;
+	}
+	Out.Flush();
+
+	return NumWritten > 0 && !Ar.IsError();
+}
@@ -0,0 +1,1347 @@
+#include "PatternCreation/PatternImport.h"
+#include "Canvas/CanvasUtils.h"
+#include "PatternCreation/PatternCurveFit.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformTime.h"
+
+
+namespace
+{
+	constexpr int32 ReadChunkSize = 64 * 1024;
+
+	/** Hands out an archive's bytes one at a time while only ever holding one chunk. */
+	class FChunkedReader
+	{
+	public:
+		explicit FChunkedReader(FArchive& InAr)
+			: Ar(InAr)
+			, Remaining(InAr.TotalSize() - InAr.Tell())
+		{
+			Buffer.SetNumUninitialized(ReadChunkSize);
+		}
+
+		/** @return The next byte, or -1 at the end of the data. */
+		int32 Next()
+		{
+			if (Pos == Len && !Refill())
+			{
+				return -1;
+			}
+			return static_cast<uint8>(Buffer[Pos++]);
+		}
+
+		/** @brief Reads up to the next line break into a null-terminated buffer without the break. */
+		bool ReadLine(TArray<ANSICHAR>& Out)
+		{
+			Out.Reset();
+			int32 C = Next();
+			if (C < 0)
+			{
+				return false;
+			}
+			for (; C >= 0 && C != '\n'; C = Next())
+			{
+				if (C != '\r')
+				{
+					Out.Add(static_cast<ANSICHAR>(C));
+				}
+			}
+			Out.Add('\0');
+			return true;
+		}
+
+		/** @brief Consumes bytes up to and including Terminator (at most 7 characters). */
+		void SkipPast(const ANSICHAR* Terminator)
+		{
+			const int32 TermLen = FCStringAnsi::Strlen(Terminator);
+			check(TermLen > 0 && TermLen < 8);
+
+			// compare the last TermLen bytes read, so "--->" still ends a comment
+			ANSICHAR Window[8] = { 0 };
+			int32 NumRead = 0;
+			for (int32 C = Next(); C >= 0; C = Next())
+			{
+				FMemory::Memmove(Window, Window + 1, TermLen - 1);
+				Window[TermLen - 1] = static_cast<ANSICHAR>(C);
+				if (++NumRead >= TermLen && FMemory::Memcmp(Window, Terminator, TermLen) == 0)
+				{
+					return;
+				}
+			}
+		}
+
+		bool IsError() const { return Ar.IsError(); }
+
+	private:
+		bool Refill()
+		{
+			if (Remaining <= 0 || Ar.IsError())
+			{
+				return false;
+			}
+			Len = static_cast<int32>(FMath::Min<int64>(Remaining, ReadChunkSize));
+			Ar.Serialize(Buffer.GetData(), Len);
+			Remaining -= Len;
+			Pos = 0;
+			return !Ar.IsError();
+		}
+
+		FArchive& Ar;
+		TArray<ANSICHAR> Buffer;
+		int64 Remaining = 0;
+		int32 Pos = 0;
+		int32 Len = 0;
+	};
+
+
+	/** 2D affine map, (x, y) -> (A x + C y + E, B x + D y + F) as in SVG's matrix(a b c d e f). */
+	struct FAffine2
+	{
+		double A = 1.0, B = 0.0, C = 0.0, D = 1.0, E = 0.0, F = 0.0;
+
+		FVector2D Apply(const FVector2D& P) const
+		{
+			return FVector2D(A * P.X + C * P.Y + E, B * P.X + D * P.Y + F);
+		}
+
+		/** @return The map that applies Child first, then this. */
+		FAffine2 operator*(const FAffine2& Child) const
+		{
+			FAffine2 R;
+			R.A = A * Child.A + C * Child.B;
+			R.B = B * Child.A + D * Child.B;
+			R.C = A * Child.C + C * Child.D;
+			R.D = B * Child.C + D * Child.D;
+			R.E = A * Child.E + C * Child.F + E;
+			R.F = B * Child.E + D * Child.F + F;
+			return R;
+		}
+
+		static FAffine2 Translate(double X, double Y) { FAffine2 T; T.E = X; T.F = Y; return T; }
+		static FAffine2 Scale(double X, double Y)     { FAffine2 T; T.A = X; T.D = Y; return T; }
+		static FAffine2 Rotate(double Degrees)
+		{
+			double S, Co;
+			FMath::SinCos(&S, &Co, FMath::DegreesToRadians(Degrees));
+			FAffine2 T; T.A = Co; T.B = S; T.C = -S; T.D = Co;
+			return T;
+		}
+	};
+
+
+	/**
+	 * Collects one outline at a time as anchors joined by cubic segments (lines are stored as
+	 * cubics with their controls on the chord) and turns each finished outline into a shape.
+	 */
+	class FOutlineBuilder
+	{
+	public:
+		FOutlineBuilder(FLoadedShapeData& InOut, double InCloseTolerance)
+			: Out(InOut)
+			, CloseTolerance(InCloseTolerance)
+		{
+		}
+
+		FAffine2 Transform;   ///< Maps file coordinates to canvas space when an outline is flushed
+
+		bool HasOutline() const { return Anchors.Num() > 0; }
+		const FVector2D& Current() const { return Anchors.Last(); }
+		const FVector2D& Start() const { return Anchors[0]; }
+
+		void MoveTo(const FVector2D& P)
+		{
+			Flush(false);
+			Anchors.Add(P);
+		}
+
+		void LineTo(const FVector2D& P)
+		{
+			if (!HasOutline())
+			{
+				Anchors.Add(P);
+				return;
+			}
+			const FVector2D P0 = Current();
+			if (P.Equals(P0, UE_KINDA_SMALL_NUMBER))
+			{
+				return;
+			}
+			Segments.Add({ P0 + (P - P0) / 3.0, P0 + (P - P0) * (2.0 / 3.0), false });
+			Anchors.Add(P);
+		}
+
+		void CubicTo(const FVector2D& C1, const FVector2D& C2, const FVector2D& P)
+		{
+			if (!HasOutline())
+			{
+				Anchors.Add(P);
+				return;
+			}
+			Segments.Add({ C1, C2, true });
+			Anchors.Add(P);
+		}
+
+		/**
+		 * @brief Appends an elliptical arc as cubic segments of at most 90 degrees.
+		 * @param Centre Centre of the ellipse.
+		 * @param Radii Radii along the ellipse's own axes.
+		 * @param AxisRotation Rotation of the ellipse axes, radians.
+		 * @param Theta1 Start angle in the ellipse's unit-circle space, radians.
+		 * @param DeltaTheta Signed sweep, radians.
+		 * @param End Exact end point, so rounding never opens a gap.
+		 */
+		void ArcTo(const FVector2D& Centre, const FVector2D& Radii, double AxisRotation, double Theta1, double DeltaTheta, const FVector2D& End)
+		{
+			const int32 NumSegments = FMath::Max(1, FMath::CeilToInt(FMath::Abs(DeltaTheta) / UE_HALF_PI - UE_KINDA_SMALL_NUMBER));
+			const double Step = DeltaTheta / NumSegments;
+			const double K = 4.0 / 3.0 * FMath::Tan(Step / 4.0);
+
+			double SinRot, CosRot;
+			FMath::SinCos(&SinRot, &CosRot, AxisRotation);
+			auto Map = [&](const FVector2D& U)
+			{
+				return FVector2D(
+					Centre.X + CosRot * Radii.X * U.X - SinRot * Radii.Y * U.Y,
+					Centre.Y + SinRot * Radii.X * U.X + CosRot * Radii.Y * U.Y);
+			};
+
+			for (int32 i = 0; i < NumSegments; ++i)
+			{
+				const double T0 = Theta1 + i * Step;
+				const double T1 = T0 + Step;
+				const FVector2D Q0(FMath::Cos(T0), FMath::Sin(T0));
+				const FVector2D Q1(FMath::Cos(T1), FMath::Sin(T1));
+				const FVector2D D0(-Q0.Y, Q0.X);
+				const FVector2D D1(-Q1.Y, Q1.X);
+				CubicTo(Map(Q0 + D0 * K), Map(Q1 - D1 * K), i == NumSegments - 1 ? End : Map(Q1));
+			}
+		}
+
+		void Close()
+		{
+			if (HasOutline() && !Current().Equals(Start(), UE_KINDA_SMALL_NUMBER))
+			{
+				LineTo(Start());
+			}
+			Flush(true);
+		}
+
+		/**
+		 * @brief Ends the current outline and adds it as a shape if it is closed.
+		 * @param bClosed Whether the file closed the outline explicitly.
+		 */
+		void Flush(bool bClosed)
+		{
+			// the tolerance is in canvas units, so the ends are compared after the file-to-canvas transform
+			const bool bEndsMeet = Anchors.Num() >= 2
+				&& FVector2D::Distance(Transform.Apply(Anchors[0]), Transform.Apply(Anchors.Last())) <= CloseTolerance;
+			bClosed |= bEndsMeet;
+
+			// cut lines, notches and grain lines are open; only closed outlines are pieces
+			if (bClosed && bEndsMeet)
+			{
+				// the canvas closes shapes with a straight edge, so a straight return is implicit
+				if (!Segments.Last().bCurve)
+				{
+					Anchors.Pop();
+					Segments.Pop();
+				}
+				else
+				{
+					Anchors.Last() = Anchors[0];
+				}
+			}
+
+			if (bClosed && Anchors.Num() >= 3)
+			{
+				AddShape();
+			}
+
+			Anchors.Reset();
+			Segments.Reset();
+		}
+
+	private:
+		struct FSegment
+		{
+			FVector2D C1;
+			FVector2D C2;
+			bool bCurve;
+		};
+
+		void AddShape()
+		{
+			const int32 NumAnchors = Anchors.Num();
+			FInterpCurve<FVector2D>& Curve = Out.CompletedShapes.AddDefaulted_GetRef();
+			TArray<bool>& Flags = Out.CompletedBezierFlags.AddDefaulted_GetRef();
+			Curve.Points.Reserve(NumAnchors);
+			Flags.Reserve(NumAnchors);
+
+			for (int32 i = 0; i < NumAnchors; ++i)
+			{
+				const FVector2D P = Transform.Apply(Anchors[i]);
+				const bool bCurveIn  = i > 0 && Segments[i - 1].bCurve;
+				const bool bCurveOut = Segments.IsValidIndex(i) && Segments[i].bCurve;
+
+				// Hermite tangents over a unit key step are three times the Bezier handle offsets
+				FInterpCurvePoint<FVector2D> Pt;
+				Pt.InVal         = i;
+				Pt.OutVal        = P;
+				Pt.ArriveTangent = i > 0 ? (P - Transform.Apply(Segments[i - 1].C2)) * 3.0 : FVector2D::ZeroVector;
+				Pt.LeaveTangent  = Segments.IsValidIndex(i) ? (Transform.Apply(Segments[i].C1) - P) * 3.0 : FVector2D::ZeroVector;
+				Pt.InterpMode    = CIM_CurveAuto;
+
+				Curve.Points.Add(Pt);
+				Flags.Add(bCurveIn || bCurveOut);
+			}
+
+			// straight runs become N-points, with the same tangents the canvas gives drawn ones
+			FCanvasUtils::RecalculateNTangents(Curve, Flags);
+		}
+
+		FLoadedShapeData& Out;
+		double CloseTolerance;
+		TArray<FVector2D> Anchors;
+		TArray<FSegment> Segments;   ///< Segment i joins Anchors[i] and Anchors[i + 1]
+	};
+
+
+	bool FinishImport(const FPatternImportOptions& Options, FLoadedShapeData& OutData, FString& OutError)
+	{
+		if (OutData.CompletedShapes.Num() == 0)
+		{
+			OutError = TEXT("No closed outlines found");
+			return false;
+		}
+		if (Options.FitTolerance > 0.0)
+		{
+			FPatternCurveFit::FitShapes(OutData.CompletedShapes, OutData.CompletedBezierFlags, Options.FitTolerance);
+		}
+		OutData.CompletedShapeTransforms.SetNum(OutData.CompletedShapes.Num());
+		return true;
+	}
+
+
+	// ---------------------------------------------------------------- DXF
+
+	struct FDxfPolyline
+	{
+		TArray<FVector2D> Points;
+		TArray<double> Bulges;      ///< Tan of a quarter of the arc angle to the next point; 0 is straight
+		bool bClosed = false;
+		FString Layer;
+	};
+
+	struct FDxfInsert
+	{
+		FString Block;
+		FVector2D Position = FVector2D::ZeroVector;
+		FVector2D Scale = FVector2D(1.0, 1.0);
+		double RotationDegrees = 0.0;
+	};
+
+	struct FDxfBlock
+	{
+		FVector2D Base = FVector2D::ZeroVector;
+		TArray<FDxfPolyline> Polylines;
+		TArray<FDxfInsert> Inserts;     ///< Nested block references
+	};
+
+	enum class EDxfEntity : uint8
+	{
+		None,
+		Block,
+		Polyline,     ///< POLYLINE header; its points follow as VERTEX entities
+		Vertex,
+		LwPolyline,
+		Insert
+	};
+
+	/** Strips surrounding blanks in place and returns the start of the text. */
+	const ANSICHAR* TrimLine(TArray<ANSICHAR>& Line)
+	{
+		int32 End = Line.Num() - 1;   // index of the terminator
+		while (End > 0 && FCharAnsi::IsWhitespace(Line[End - 1]))
+		{
+			Line[--End] = '\0';
+		}
+		int32 Start = 0;
+		while (Start < End && FCharAnsi::IsWhitespace(Line[Start]))
+		{
+			++Start;
+		}
+		return Line.GetData() + Start;
+	}
+
+	/** Appends one polyline segment, as an arc when it has a bulge. */
+	void AppendDxfSegment(FOutlineBuilder& Builder, const FVector2D& P0, const FVector2D& P1, double Bulge)
+	{
+		const double Chord = FVector2D::Distance(P0, P1);
+		if (FMath::Abs(Bulge) <= UE_KINDA_SMALL_NUMBER || Chord <= UE_KINDA_SMALL_NUMBER)
+		{
+			Builder.LineTo(P1);
+			return;
+		}
+
+		// the centre lies on the chord's bisector; positive bulges run counter-clockwise
+		const FVector2D U = (P1 - P0) / Chord;
+		const FVector2D N(-U.Y, U.X);
+		const FVector2D Centre = (P0 + P1) * 0.5 + N * (Chord * 0.5 * (1.0 - Bulge * Bulge) / (2.0 * Bulge));
+		const double Radius = FVector2D::Distance(P0, Centre);
+		const double Theta1 = FMath::Atan2(P0.Y - Centre.Y, P0.X - Centre.X);
+		Builder.ArcTo(Centre, FVector2D(Radius, Radius), 0.0, Theta1, 4.0 * FMath::Atan(Bulge), P1);
+	}
+
+	void AppendDxfPolyline(FOutlineBuilder& Builder, const FDxfPolyline& Line)
+	{
+		const int32 Num = Line.Points.Num();
+		if (Num < 2)
+		{
+			return;
+		}
+		Builder.MoveTo(Line.Points[0]);
+		for (int32 i = 1; i < Num; ++i)
+		{
+			AppendDxfSegment(Builder, Line.Points[i - 1], Line.Points[i], Line.Bulges[i - 1]);
+		}
+		if (Line.bClosed)
+		{
+			AppendDxfSegment(Builder, Line.Points.Last(), Line.Points[0], Line.Bulges.Last());
+			Builder.Close();
+		}
+		else
+		{
+			Builder.Flush(false);
+		}
+	}
+
+	double DxfUnitsToCentimetres(int32 InsUnits)
+	{
+		switch (InsUnits)
+		{
+		case 1:  return 2.54;    // inches
+		case 2:  return 30.48;   // feet
+		case 4:  return 0.1;     // millimetres
+		case 5:  return 1.0;     // centimetres
+		case 6:  return 100.0;   // metres
+		default: return 1.0;     // unitless or unknown: take coordinates as they are
+		}
+	}
+
+
+	// ---------------------------------------------------------------- SVG
+
+	bool IsSeparator(ANSICHAR C)
+	{
+		return C == ',' || FCharAnsi::IsWhitespace(C);
+	}
+
+	void SkipSeparators(const ANSICHAR* Str, int32 Len, int32& Cursor)
+	{
+		while (Cursor < Len && IsSeparator(Str[Cursor]))
+		{
+			++Cursor;
+		}
+	}
+
+	/** Parses the next number; SVG allows "1.5.5" and "1-2" without separators. */
+	bool ParseNumber(const ANSICHAR* Str, int32 Len, int32& Cursor, double& Out)
+	{
+		SkipSeparators(Str, Len, Cursor);
+		const int32 Start = Cursor;
+		if (Cursor < Len && (Str[Cursor] == '+' || Str[Cursor] == '-'))
+		{
+			++Cursor;
+		}
+		bool bDigits = false;
+		bool bDot = false;
+		for (; Cursor < Len; ++Cursor)
+		{
+			if (FCharAnsi::IsDigit(Str[Cursor]))
+			{
+				bDigits = true;
+			}
+			else if (Str[Cursor] == '.' && !bDot)
+			{
+				bDot = true;
+			}
+			else
+			{
+				break;
+			}
+		}
+		if (!bDigits)
+		{
+			Cursor = Start;
+			return false;
+		}
+		if (Cursor < Len && (Str[Cursor] == 'e' || Str[Cursor] == 'E'))
+		{
+			int32 Exp = Cursor + 1;
+			if (Exp < Len && (Str[Exp] == '+' || Str[Exp] == '-'))
+			{
+				++Exp;
+			}
+			if (Exp < Len && FCharAnsi::IsDigit(Str[Exp]))
+			{
+				while (Exp < Len && FCharAnsi::IsDigit(Str[Exp]))
+				{
+					++Exp;
+				}
+				Cursor = Exp;
+			}
+		}
+
+		ANSICHAR Buffer[64];
+		const int32 NumChars = FMath::Min(Cursor - Start, 63);
+		FMemory::Memcpy(Buffer, Str + Start, NumChars);
+		Buffer[NumChars] = '\0';
+		Out = FCStringAnsi::Atod(Buffer);
+		return true;
+	}
+
+	/** Arc flags are single digits that may run into the next number ("a1 1 0 00 1 1"). */
+	bool ParseFlag(const ANSICHAR* Str, int32 Len, int32& Cursor, bool& Out)
+	{
+		SkipSeparators(Str, Len, Cursor);
+		if (Cursor < Len && (Str[Cursor] == '0' || Str[Cursor] == '1'))
+		{
+			Out = Str[Cursor++] == '1';
+			return true;
+		}
+		return false;
+	}
+
+	bool IsSvgCommand(ANSICHAR C)
+	{
+		switch (C)
+		{
+		case 'M': case 'm': case 'L': case 'l': case 'H': case 'h': case 'V': case 'v':
+		case 'C': case 'c': case 'S': case 's': case 'Q': case 'q': case 'T': case 't':
+		case 'A': case 'a': case 'Z': case 'z':
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	double VectorAngle(const FVector2D& U, const FVector2D& V)
+	{
+		return FMath::Atan2(U.X * V.Y - U.Y * V.X, U.X * V.X + U.Y * V.Y);
+	}
+
+	/** Endpoint-to-centre conversion from the SVG specification (implementation notes, F.6.5). */
+	void AppendSvgArc(FOutlineBuilder& Builder, const FVector2D& P0, double Rx, double Ry, double AxisDegrees, bool bLargeArc, bool bSweep, const FVector2D& P1)
+	{
+		if (P0.Equals(P1, UE_KINDA_SMALL_NUMBER))
+		{
+			return;
+		}
+		Rx = FMath::Abs(Rx);
+		Ry = FMath::Abs(Ry);
+		if (Rx <= UE_KINDA_SMALL_NUMBER || Ry <= UE_KINDA_SMALL_NUMBER)
+		{
+			Builder.LineTo(P1);
+			return;
+		}
+
+		const double Phi = FMath::DegreesToRadians(AxisDegrees);
+		double S, C;
+		FMath::SinCos(&S, &C, Phi);
+
+		const FVector2D Half = (P0 - P1) * 0.5;
+		const double X1 =  C * Half.X + S * Half.Y;
+		const double Y1 = -S * Half.X + C * Half.Y;
+
+		// radii too small to reach the end point are scaled up just enough
+		const double Lambda = (X1 * X1) / (Rx * Rx) + (Y1 * Y1) / (Ry * Ry);
+		if (Lambda > 1.0)
+		{
+			Rx *= FMath::Sqrt(Lambda);
+			Ry *= FMath::Sqrt(Lambda);
+		}
+
+		const double Num = Rx * Rx * Ry * Ry - Rx * Rx * Y1 * Y1 - Ry * Ry * X1 * X1;
+		const double Den = Rx * Rx * Y1 * Y1 + Ry * Ry * X1 * X1;
+		const double Coef = (bLargeArc == bSweep ? -1.0 : 1.0) * FMath::Sqrt(FMath::Max(0.0, Num / Den));
+		const double Cx1 =  Coef * Rx * Y1 / Ry;
+		const double Cy1 = -Coef * Ry * X1 / Rx;
+
+		const FVector2D Centre(
+			C * Cx1 - S * Cy1 + (P0.X + P1.X) * 0.5,
+			S * Cx1 + C * Cy1 + (P0.Y + P1.Y) * 0.5);
+
+		const FVector2D U((X1 - Cx1) / Rx, (Y1 - Cy1) / Ry);
+		const FVector2D V((-X1 - Cx1) / Rx, (-Y1 - Cy1) / Ry);
+		const double Theta1 = VectorAngle(FVector2D(1.0, 0.0), U);
+		double Delta = VectorAngle(U, V);
+		if (!bSweep && Delta > 0.0)
+		{
+			Delta -= UE_TWO_PI;
+		}
+		else if (bSweep && Delta < 0.0)
+		{
+			Delta += UE_TWO_PI;
+		}
+
+		Builder.ArcTo(Centre, FVector2D(Rx, Ry), Phi, Theta1, Delta, P1);
+	}
+
+	/** Feeds a path's d attribute to the builder; stops at the first malformed command, as renderers do. */
+	void ParseSvgPath(const ANSICHAR* Str, int32 Len, FOutlineBuilder& Builder)
+	{
+		int32 Cursor = 0;
+		ANSICHAR Command = 0;
+		ANSICHAR PrevCommand = 0;
+		FVector2D Cur = FVector2D::ZeroVector;
+		FVector2D SubpathStart = FVector2D::ZeroVector;
+		FVector2D LastCubicC2 = FVector2D::ZeroVector;
+		FVector2D LastQuadC = FVector2D::ZeroVector;
+
+		auto Num = [&](double& V) { return ParseNumber(Str, Len, Cursor, V); };
+
+		while (true)
+		{
+			SkipSeparators(Str, Len, Cursor);
+			if (Cursor >= Len)
+			{
+				break;
+			}
+
+			if (IsSvgCommand(Str[Cursor]))
+			{
+				Command = Str[Cursor++];
+				if (Command == 'Z' || Command == 'z')
+				{
+					// a drawing command after Z starts a new subpath at the closed one's start
+					Builder.Close();
+					Cur = SubpathStart;
+					Builder.MoveTo(Cur);
+					PrevCommand = Command;
+					continue;
+				}
+			}
+			else if (Command == 0 || Command == 'Z' || Command == 'z')
+			{
+				break;
+			}
+
+			const bool bRel = FCharAnsi::IsLower(Command);
+			const FVector2D Origin = bRel ? Cur : FVector2D::ZeroVector;
+			double X, Y, X1, Y1, X2, Y2;
+
+			switch (FCharAnsi::ToUpper(Command))
+			{
+			case 'M':
+				if (!Num(X) || !Num(Y)) return;
+				Cur = Origin + FVector2D(X, Y);
+				Builder.MoveTo(Cur);
+				SubpathStart = Cur;
+				Command = bRel ? 'l' : 'L';   // further pairs are implicit line-tos
+				break;
+
+			case 'L':
+				if (!Num(X) || !Num(Y)) return;
+				Cur = Origin + FVector2D(X, Y);
+				Builder.LineTo(Cur);
+				break;
+
+			case 'H':
+				if (!Num(X)) return;
+				Cur.X = (bRel ? Cur.X : 0.0) + X;
+				Builder.LineTo(Cur);
+				break;
+
+			case 'V':
+				if (!Num(Y)) return;
+				Cur.Y = (bRel ? Cur.Y : 0.0) + Y;
+				Builder.LineTo(Cur);
+				break;
+
+			case 'C':
+			{
+				if (!Num(X1) || !Num(Y1) || !Num(X2) || !Num(Y2) || !Num(X) || !Num(Y)) return;
+				const FVector2D C1 = Origin + FVector2D(X1, Y1);
+				LastCubicC2 = Origin + FVector2D(X2, Y2);
+				Cur = Origin + FVector2D(X, Y);
+				Builder.CubicTo(C1, LastCubicC2, Cur);
+				break;
+			}
+
+			case 'S':
+			{
+				if (!Num(X2) || !Num(Y2) || !Num(X) || !Num(Y)) return;
+				const ANSICHAR Prev = FCharAnsi::ToUpper(PrevCommand);
+				const FVector2D C1 = (Prev == 'C' || Prev == 'S') ? Cur * 2.0 - LastCubicC2 : Cur;
+				LastCubicC2 = Origin + FVector2D(X2, Y2);
+				Cur = Origin + FVector2D(X, Y);
+				Builder.CubicTo(C1, LastCubicC2, Cur);
+				break;
+			}
+
+			case 'Q':
+			case 'T':
+			{
+				const bool bSmooth = FCharAnsi::ToUpper(Command) == 'T';
+				if (!bSmooth && (!Num(X1) || !Num(Y1))) return;
+				if (!Num(X) || !Num(Y)) return;
+				const ANSICHAR Prev = FCharAnsi::ToUpper(PrevCommand);
+				const FVector2D Q = !bSmooth ? Origin + FVector2D(X1, Y1)
+					: ((Prev == 'Q' || Prev == 'T') ? Cur * 2.0 - LastQuadC : Cur);
+				const FVector2D P = Origin + FVector2D(X, Y);
+
+				// degree elevation: a quadratic is a cubic with controls two thirds towards Q
+				Builder.CubicTo(Cur + (Q - Cur) * (2.0 / 3.0), P + (Q - P) * (2.0 / 3.0), P);
+				LastQuadC = Q;
+				Cur = P;
+				break;
+			}
+
+			case 'A':
+			{
+				double Rx, Ry, AxisDegrees;
+				bool bLargeArc, bSweep;
+				if (!Num(Rx) || !Num(Ry) || !Num(AxisDegrees) ||
+					!ParseFlag(Str, Len, Cursor, bLargeArc) || !ParseFlag(Str, Len, Cursor, bSweep) ||
+					!Num(X) || !Num(Y)) return;
+				const FVector2D P = Origin + FVector2D(X, Y);
+				AppendSvgArc(Builder, Cur, Rx, Ry, AxisDegrees, bLargeArc, bSweep, P);
+				Cur = P;
+				break;
+			}
+
+			default:
+				return;
+			}
+
+			PrevCommand = Command;
+		}
+	}
+
+	bool NameIs(const ANSICHAR* Name, int32 NameLen, const ANSICHAR* Literal)
+	{
+		return FCStringAnsi::Strlen(Literal) == NameLen && FCStringAnsi::Strncmp(Name, Literal, NameLen) == 0;
+	}
+
+	/** Applies a transform attribute ("translate(..) rotate(..) ...") on top of Parent. */
+	FAffine2 ParseSvgTransform(const ANSICHAR* Str, int32 Len, const FAffine2& Parent)
+	{
+		FAffine2 Result = Parent;
+		int32 Cursor = 0;
+		while (true)
+		{
+			SkipSeparators(Str, Len, Cursor);
+			const int32 NameStart = Cursor;
+			while (Cursor < Len && FCharAnsi::IsAlpha(Str[Cursor]))
+			{
+				++Cursor;
+			}
+			const int32 NameLen = Cursor - NameStart;
+			SkipSeparators(Str, Len, Cursor);
+			if (NameLen == 0 || Cursor >= Len || Str[Cursor] != '(')
+			{
+				return Result;
+			}
+			++Cursor;
+
+			double Args[6] = { 0.0 };
+			int32 NumArgs = 0;
+			while (NumArgs < 6 && ParseNumber(Str, Len, Cursor, Args[NumArgs]))
+			{
+				++NumArgs;
+			}
+			while (Cursor < Len && Str[Cursor] != ')')
+			{
+				++Cursor;
+			}
+			++Cursor;
+
+			const ANSICHAR* Name = Str + NameStart;
+			FAffine2 T;
+			if (NameIs(Name, NameLen, "matrix") && NumArgs == 6)
+			{
+				T.A = Args[0]; T.B = Args[1]; T.C = Args[2]; T.D = Args[3]; T.E = Args[4]; T.F = Args[5];
+			}
+			else if (NameIs(Name, NameLen, "translate") && NumArgs >= 1)
+			{
+				T = FAffine2::Translate(Args[0], NumArgs > 1 ? Args[1] : 0.0);
+			}
+			else if (NameIs(Name, NameLen, "scale") && NumArgs >= 1)
+			{
+				T = FAffine2::Scale(Args[0], NumArgs > 1 ? Args[1] : Args[0]);
+			}
+			else if (NameIs(Name, NameLen, "rotate") && NumArgs >= 1)
+			{
+				T = FAffine2::Rotate(Args[0]);
+				if (NumArgs >= 3)
+				{
+					T = FAffine2::Translate(Args[1], Args[2]) * T * FAffine2::Translate(-Args[1], -Args[2]);
+				}
+			}
+			else if (NameIs(Name, NameLen, "skewX") && NumArgs >= 1)
+			{
+				T.C = FMath::Tan(FMath::DegreesToRadians(Args[0]));
+			}
+			else if (NameIs(Name, NameLen, "skewY") && NumArgs >= 1)
+			{
+				T.B = FMath::Tan(FMath::DegreesToRadians(Args[0]));
+			}
+			Result = Result * T;
+		}
+	}
+
+	/** Calls Visit(Name, NameLen, Value, ValueLen) for each quoted attribute of a tag. */
+	template <typename FVisitor>
+	void ForEachAttribute(const ANSICHAR* Tag, int32 Len, int32 Cursor, FVisitor&& Visit)
+	{
+		while (Cursor < Len)
+		{
+			while (Cursor < Len && (FCharAnsi::IsWhitespace(Tag[Cursor]) || Tag[Cursor] == '/'))
+			{
+				++Cursor;
+			}
+			const int32 NameStart = Cursor;
+			while (Cursor < Len && Tag[Cursor] != '=' && !FCharAnsi::IsWhitespace(Tag[Cursor]))
+			{
+				++Cursor;
+			}
+			const int32 NameLen = Cursor - NameStart;
+			while (Cursor < Len && FCharAnsi::IsWhitespace(Tag[Cursor]))
+			{
+				++Cursor;
+			}
+			if (Cursor >= Len || Tag[Cursor] != '=')
+			{
+				continue;
+			}
+			++Cursor;
+			while (Cursor < Len && FCharAnsi::IsWhitespace(Tag[Cursor]))
+			{
+				++Cursor;
+			}
+			if (Cursor >= Len || (Tag[Cursor] != '"' && Tag[Cursor] != '\''))
+			{
+				return;
+			}
+			const ANSICHAR Quote = Tag[Cursor++];
+			const int32 ValueStart = Cursor;
+			while (Cursor < Len && Tag[Cursor] != Quote)
+			{
+				++Cursor;
+			}
+			Visit(Tag + NameStart, NameLen, Tag + ValueStart, Cursor - ValueStart);
+			++Cursor;
+		}
+	}
+
+	/** Reads the next tag's text (without the angle brackets); comments, CDATA and declarations come back empty. */
+	bool ReadSvgTag(FChunkedReader& Reader, TArray<ANSICHAR>& OutTag)
+	{
+		OutTag.Reset();
+		int32 C = Reader.Next();
+		while (C >= 0 && C != '<')
+		{
+			C = Reader.Next();
+		}
+		if (C < 0)
+		{
+			return false;
+		}
+
+		C = Reader.Next();
+		if (C == '?')
+		{
+			Reader.SkipPast("?>");
+			return true;
+		}
+		if (C == '!')
+		{
+			const int32 C1 = Reader.Next();
+			const int32 C2 = Reader.Next();
+			if (C1 == '-' && C2 == '-')
+			{
+				Reader.SkipPast("-->");
+			}
+			else if (C1 == '[')
+			{
+				Reader.SkipPast("]]>");
+			}
+			else if (C1 != '>' && C2 != '>')
+			{
+				Reader.SkipPast(">");
+			}
+			return true;
+		}
+
+		ANSICHAR Quote = 0;
+		for (; C >= 0; C = Reader.Next())
+		{
+			if (Quote)
+			{
+				Quote = (C == Quote) ? 0 : Quote;
+			}
+			else if (C == '"' || C == '\'')
+			{
+				Quote = static_cast<ANSICHAR>(C);
+			}
+			else if (C == '>')
+			{
+				break;
+			}
+			OutTag.Add(static_cast<ANSICHAR>(C));
+		}
+		OutTag.Add('\0');
+		return true;
+	}
+}
+
+
+bool FPatternImport::ImportFile(const FString& FilePath, const FPatternImportOptions& Options, FLoadedShapeData& OutData, FString& OutError)
+{
+	const FString Extension = FPaths::GetExtension(FilePath);
+	const bool bSvg = Extension.Equals(TEXT("svg"), ESearchCase::IgnoreCase);
+	const bool bDxf = Extension.Equals(TEXT("dxf"), ESearchCase::IgnoreCase);
+	if (!bSvg && !bDxf)
+	{
+		OutError = FString::Printf(TEXT("Unsupported pattern file type: .%s"), *Extension);
+		return false;
+	}
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!Reader)
+	{
+		OutError = FString::Printf(TEXT("Could not open %s"), *FilePath);
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const bool bImported = bSvg
+		? ParseSvg(*Reader, Options, OutData, OutError)
+		: ParseDxf(*Reader, Options, OutData, OutError);
+
+	if (bImported)
+	{
+		UE_LOG(LogTemp, Log, TEXT("Imported %d pieces from %s in %.2f s"),
+			OutData.CompletedShapes.Num(), *FilePath, FPlatformTime::Seconds() - StartTime);
+	}
+	return bImported;
+}
+
+
+UE::Tasks::TTask<FPatternImportResult> FPatternImport::ImportFileAsync(const FString& FilePath, const FPatternImportOptions& Options)
+{
+	return UE::Tasks::Launch(UE_SOURCE_LOCATION, [FilePath, Options]()
+	{
+		FPatternImportResult Result;
+		Result.FilePath = FilePath;
+		Result.bSucceeded = ImportFile(FilePath, Options, Result.Data, Result.Error);
+		return Result;
+	});
+}
+
+
+bool FPatternImport::ParseDxf(FArchive& Ar, const FPatternImportOptions& Options, FLoadedShapeData& OutData, FString& OutError)
+{
+	OutData = FLoadedShapeData();
+
+	FChunkedReader Reader(Ar);
+	TArray<ANSICHAR> CodeLine;
+	TArray<ANSICHAR> ValueLine;
+
+	TArray<FDxfPolyline> EntityPolylines;
+	TMap<FString, FDxfBlock> Blocks;
+	TArray<FDxfInsert> Inserts;
+
+	FString Section;
+	FString HeaderVariable;
+	int32 InsUnits = 0;
+	bool bExpectSectionName = false;
+
+	EDxfEntity Entity = EDxfEntity::None;
+	bool bInPolyline = false;       // between POLYLINE and SEQEND
+	bool bInBlock = false;
+	FString BlockName;
+	FDxfBlock CurrentBlock;
+	FDxfPolyline Pending;
+	FDxfInsert PendingInsert;
+
+	auto CommitPolyline = [&]()
+	{
+		if (Pending.Points.Num() >= 2)
+		{
+			(bInBlock ? CurrentBlock.Polylines : EntityPolylines).Add(MoveTemp(Pending));
+		}
+		Pending = FDxfPolyline();
+	};
+
+	bool bFirstPair = true;
+	while (Reader.ReadLine(CodeLine))
+	{
+		if (!Reader.ReadLine(ValueLine))
+		{
+			break;
+		}
+		const ANSICHAR* CodeText = TrimLine(CodeLine);
+		const ANSICHAR* Value = TrimLine(ValueLine);
+
+		if (bFirstPair)
+		{
+			bFirstPair = false;
+			if (FCStringAnsi::Strncmp(CodeText, "AutoCAD Binary DXF", 18) == 0)
+			{
+				OutError = TEXT("Binary DXF is not supported; export as ASCII DXF");
+				return false;
+			}
+		}
+
+		const int32 Code = FCStringAnsi::Atoi(CodeText);
+
+		if (Code == 0)
+		{
+			// the entity read so far is complete
+			if (Entity == EDxfEntity::LwPolyline)
+			{
+				CommitPolyline();
+			}
+			else if (Entity == EDxfEntity::Insert)
+			{
+				(bInBlock ? CurrentBlock.Inserts : Inserts).Add(MoveTemp(PendingInsert));
+			}
+
+			if (bInPolyline)
+			{
+				if (FCStringAnsi::Strcmp(Value, "VERTEX") == 0)
+				{
+					Pending.Points.Add(FVector2D::ZeroVector);
+					Pending.Bulges.Add(0.0);
+					Entity = EDxfEntity::Vertex;
+					continue;
+				}
+				CommitPolyline();
+				bInPolyline = false;
+			}
+
+			Entity = EDxfEntity::None;
+			if (FCStringAnsi::Strcmp(Value, "SECTION") == 0)
+			{
+				bExpectSectionName = true;
+			}
+			else if (FCStringAnsi::Strcmp(Value, "ENDSEC") == 0)
+			{
+				Section.Reset();
+			}
+			else if (FCStringAnsi::Strcmp(Value, "BLOCK") == 0)
+			{
+				bInBlock = true;
+				BlockName.Reset();
+				CurrentBlock = FDxfBlock();
+				Entity = EDxfEntity::Block;
+			}
+			else if (FCStringAnsi::Strcmp(Value, "ENDBLK") == 0)
+			{
+				if (bInBlock && (CurrentBlock.Polylines.Num() > 0 || CurrentBlock.Inserts.Num() > 0))
+				{
+					Blocks.Add(BlockName, MoveTemp(CurrentBlock));
+				}
+				bInBlock = false;
+			}
+			else if (FCStringAnsi::Strcmp(Value, "POLYLINE") == 0)
+			{
+				Pending = FDxfPolyline();
+				bInPolyline = true;
+				Entity = EDxfEntity::Polyline;
+			}
+			else if (FCStringAnsi::Strcmp(Value, "LWPOLYLINE") == 0)
+			{
+				Pending = FDxfPolyline();
+				Entity = EDxfEntity::LwPolyline;
+			}
+			else if (FCStringAnsi::Strcmp(Value, "INSERT") == 0)
+			{
+				PendingInsert = FDxfInsert();
+				Entity = EDxfEntity::Insert;
+			}
+			continue;
+		}
+
+		if (bExpectSectionName && Code == 2)
+		{
+			Section = ANSI_TO_TCHAR(Value);
+			bExpectSectionName = false;
+			continue;
+		}
+		if (Section == TEXT("HEADER"))
+		{
+			if (Code == 9)
+			{
+				HeaderVariable = ANSI_TO_TCHAR(Value);
+			}
+			else if (Code == 70 && HeaderVariable == TEXT("$INSUNITS"))
+			{
+				InsUnits = FCStringAnsi::Atoi(Value);
+			}
+			continue;
+		}
+
+		switch (Entity)
+		{
+		case EDxfEntity::Block:
+			if (Code == 2)       BlockName = ANSI_TO_TCHAR(Value);
+			else if (Code == 10) CurrentBlock.Base.X = FCStringAnsi::Atod(Value);
+			else if (Code == 20) CurrentBlock.Base.Y = FCStringAnsi::Atod(Value);
+			break;
+
+		case EDxfEntity::Polyline:
+			// the header's own 10/20 is a dummy point
+			if (Code == 8)       Pending.Layer = ANSI_TO_TCHAR(Value);
+			else if (Code == 70) Pending.bClosed = (FCStringAnsi::Atoi(Value) & 1) != 0;
+			break;
+
+		case EDxfEntity::Vertex:
+			if (Code == 10)      Pending.Points.Last().X = FCStringAnsi::Atod(Value);
+			else if (Code == 20) Pending.Points.Last().Y = FCStringAnsi::Atod(Value);
+			else if (Code == 42) Pending.Bulges.Last() = FCStringAnsi::Atod(Value);
+			break;
+
+		case EDxfEntity::LwPolyline:
+			if (Code == 8)       Pending.Layer = ANSI_TO_TCHAR(Value);
+			else if (Code == 70) Pending.bClosed = (FCStringAnsi::Atoi(Value) & 1) != 0;
+			else if (Code == 10)
+			{
+				Pending.Points.Add(FVector2D(FCStringAnsi::Atod(Value), 0.0));
+				Pending.Bulges.Add(0.0);
+			}
+			else if (Code == 20 && Pending.Points.Num() > 0) Pending.Points.Last().Y = FCStringAnsi::Atod(Value);
+			else if (Code == 42 && Pending.Bulges.Num() > 0) Pending.Bulges.Last() = FCStringAnsi::Atod(Value);
+			break;
+
+		case EDxfEntity::Insert:
+			if (Code == 2)       PendingInsert.Block = ANSI_TO_TCHAR(Value);
+			else if (Code == 10) PendingInsert.Position.X = FCStringAnsi::Atod(Value);
+			else if (Code == 20) PendingInsert.Position.Y = FCStringAnsi::Atod(Value);
+			else if (Code == 41) PendingInsert.Scale.X = FCStringAnsi::Atod(Value);
+			else if (Code == 42) PendingInsert.Scale.Y = FCStringAnsi::Atod(Value);
+			else if (Code == 50) PendingInsert.RotationDegrees = FCStringAnsi::Atod(Value);
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	if (Reader.IsError())
+	{
+		OutError = TEXT("Read error");
+		return false;
+	}
+
+	// every piece gets its placement: entities as drawn, block contents through their inserts
+	struct FPlaced
+	{
+		const FDxfPolyline* Line;
+		FAffine2 Transform;
+	};
+	TArray<FPlaced> Placed;
+	for (const FDxfPolyline& Line : EntityPolylines)
+	{
+		Placed.Add({ &Line, FAffine2() });
+	}
+
+	// only blocks reached through an INSERT are drawn; *Model_Space, *Paper_Space and unused
+	// definitions never are. The depth limit guards against blocks that insert themselves.
+	constexpr int32 MaxInsertDepth = 16;
+	TFunction<void(const FDxfInsert&, const FAffine2&, int32)> PlaceInsert;
+	PlaceInsert = [&](const FDxfInsert& Insert, const FAffine2& Parent, int32 Depth)
+	{
+		const FDxfBlock* Block = Blocks.Find(Insert.Block);
+		if (!Block || Depth > MaxInsertDepth)
+		{
+			return;
+		}
+		const FAffine2 Transform = Parent
+			* FAffine2::Translate(Insert.Position.X, Insert.Position.Y)
+			* FAffine2::Rotate(Insert.RotationDegrees)
+			* FAffine2::Scale(Insert.Scale.X, Insert.Scale.Y)
+			* FAffine2::Translate(-Block->Base.X, -Block->Base.Y);
+		for (const FDxfPolyline& Line : Block->Polylines)
+		{
+			Placed.Add({ &Line, Transform });
+		}
+		for (const FDxfInsert& Nested : Block->Inserts)
+		{
+			PlaceInsert(Nested, Transform, Depth + 1);
+		}
+	};
+	for (const FDxfInsert& Insert : Inserts)
+	{
+		PlaceInsert(Insert, FAffine2(), 0);
+	}
+
+	// AAMA/ASTM put the cut line of each piece on layer 1; other layers hold internal lines and text
+	const bool bHasBoundaryLayer = Options.bBoundaryLayerOnly
+		&& Placed.ContainsByPredicate([](const FPlaced& P) { return P.Line->Layer == TEXT("1"); });
+
+	// canvas Y points down, DXF Y points up
+	const double UnitScale = Options.bConvertDxfUnits ? DxfUnitsToCentimetres(InsUnits) : 1.0;
+	const FAffine2 ToCanvas = FAffine2::Scale(UnitScale * Options.Scale, -UnitScale * Options.Scale);
+
+	FOutlineBuilder Builder(OutData, Options.CloseTolerance);
+	for (const FPlaced& P : Placed)
+	{
+		if (bHasBoundaryLayer && P.Line->Layer != TEXT("1"))
+		{
+			continue;
+		}
+		// arcs are built in file space, so the whole insert transform applies at flush time
+		Builder.Transform = ToCanvas * P.Transform;
+		AppendDxfPolyline(Builder, *P.Line);
+	}
+
+	return FinishImport(Options, OutData, OutError);
+}
+
+
+bool FPatternImport::ParseSvg(FArchive& Ar, const FPatternImportOptions& Options, FLoadedShapeData& OutData, FString& OutError)
+{
+	OutData = FLoadedShapeData();
+
+	FChunkedReader Reader(Ar);
+	TArray<ANSICHAR> Tag;
+
+	/** Open container element: its accumulated transform, and whether its content is drawn at all. */
+	struct FFrame
+	{
+		FAffine2 Transform;
+		bool bSkip = false;
+	};
+	TArray<FFrame> Frames;
+	Frames.Add({ FAffine2::Scale(Options.Scale, Options.Scale), false });
+
+	FOutlineBuilder Builder(OutData, Options.CloseTolerance);
+	bool bSawSvg = false;
+
+	while (ReadSvgTag(Reader, Tag))
+	{
+		const int32 Len = Tag.Num() - 1;
+		if (Len <= 0)
+		{
+			continue;
+		}
+
+		const ANSICHAR* Str = Tag.GetData();
+		const bool bClosing = Str[0] == '/';
+		const bool bSelfClosing = Str[Len - 1] == '/';
+
+		int32 NameStart = bClosing ? 1 : 0;
+		int32 NameEnd = NameStart;
+		while (NameEnd < Len && !FCharAnsi::IsWhitespace(Str[NameEnd]) && Str[NameEnd] != '/')
+		{
+			if (Str[NameEnd] == ':')
+			{
+				NameStart = NameEnd + 1;   // drop namespace prefixes such as svg:path
+			}
+			++NameEnd;
+		}
+		const ANSICHAR* Name = Str + NameStart;
+		const int32 NameLen = NameEnd - NameStart;
+
+		// definitions, clip paths and the like are referenced, not drawn
+		const bool bHiddenContainer = NameIs(Name, NameLen, "defs") || NameIs(Name, NameLen, "clipPath")
+			|| NameIs(Name, NameLen, "mask") || NameIs(Name, NameLen, "pattern")
+			|| NameIs(Name, NameLen, "symbol") || NameIs(Name, NameLen, "marker");
+		const bool bGroup = NameIs(Name, NameLen, "g") || NameIs(Name, NameLen, "a")
+			|| NameIs(Name, NameLen, "svg") || NameIs(Name, NameLen, "switch");
+		bSawSvg |= NameIs(Name, NameLen, "svg");
+
+		if (bClosing)
+		{
+			if ((bGroup || bHiddenContainer) && Frames.Num() > 1)
+			{
+				Frames.Pop();
+			}
+			continue;
+		}
+
+		const FFrame& Parent = Frames.Last();
+
+		const ANSICHAR* PathData = nullptr;    int32 PathLen = 0;
+		const ANSICHAR* PointsData = nullptr;  int32 PointsLen = 0;
+		const ANSICHAR* TransformData = nullptr; int32 TransformLen = 0;
+		double RectX = 0.0, RectY = 0.0, RectW = 0.0, RectH = 0.0;
+
+		ForEachAttribute(Str, Len, NameEnd, [&](const ANSICHAR* AttrName, int32 AttrLen, const ANSICHAR* Value, int32 ValueLen)
+		{
+			int32 Cursor = 0;
+			if (NameIs(AttrName, AttrLen, "d"))              { PathData = Value; PathLen = ValueLen; }
+			else if (NameIs(AttrName, AttrLen, "points"))    { PointsData = Value; PointsLen = ValueLen; }
+			else if (NameIs(AttrName, AttrLen, "transform")) { TransformData = Value; TransformLen = ValueLen; }
+			else if (NameIs(AttrName, AttrLen, "x"))         { ParseNumber(Value, ValueLen, Cursor, RectX); }
+			else if (NameIs(AttrName, AttrLen, "y"))         { ParseNumber(Value, ValueLen, Cursor, RectY); }
+			else if (NameIs(AttrName, AttrLen, "width"))     { ParseNumber(Value, ValueLen, Cursor, RectW); }
+			else if (NameIs(AttrName, AttrLen, "height"))    { ParseNumber(Value, ValueLen, Cursor, RectH); }
+		});
+
+		// the root svg element's size attributes are not a transform
+		const FAffine2 Transform = TransformData ? ParseSvgTransform(TransformData, TransformLen, Parent.Transform) : Parent.Transform;
+
+		if (bGroup || bHiddenContainer)
+		{
+			if (!bSelfClosing)
+			{
+				Frames.Add({ Transform, Parent.bSkip || bHiddenContainer });
+			}
+			continue;
+		}
+		if (Parent.bSkip)
+		{
+			continue;
+		}
+
+		Builder.Transform = Transform;
+
+		if (NameIs(Name, NameLen, "path") && PathData)
+		{
+			ParseSvgPath(PathData, PathLen, Builder);
+			Builder.Flush(false);
+		}
+		else if ((NameIs(Name, NameLen, "polygon") || NameIs(Name, NameLen, "polyline")) && PointsData)
+		{
+			int32 Cursor = 0;
+			double X, Y;
+			while (ParseNumber(PointsData, PointsLen, Cursor, X) && ParseNumber(PointsData, PointsLen, Cursor, Y))
+			{
+				Builder.LineTo(FVector2D(X, Y));
+			}
+			if (NameIs(Name, NameLen, "polygon"))
+			{
+				Builder.Close();
+			}
+			else
+			{
+				Builder.Flush(false);
+			}
+		}
+		else if (NameIs(Name, NameLen, "rect") && RectW > 0.0 && RectH > 0.0)
+		{
+			Builder.MoveTo(FVector2D(RectX, RectY));
+			Builder.LineTo(FVector2D(RectX + RectW, RectY));
+			Builder.LineTo(FVector2D(RectX + RectW, RectY + RectH));
+			Builder.LineTo(FVector2D(RectX, RectY + RectH));
+			Builder.Close();
+		}
+	}
+
+	if (Reader.IsError())
+	{
+		OutError = TEXT("Read error");
+		return false;
+	}
+	if (!bSawSvg)
+	{
+		OutError = TEXT("Not an SVG file");
+		return false;
+	}
+
+	return FinishImport(Options, OutData, OutError);
+}
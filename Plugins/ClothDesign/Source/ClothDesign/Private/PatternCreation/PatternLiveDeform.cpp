@@ -0,0 +1,169 @@
+#include "PatternCreation/PatternLiveDeform.h"
+#include "PatternMesh.h"
+
+
+void FPatternLiveDeform::ComputeMeanValueWeights(
+	const FVector2f& P,
+	const TArray<FVector2f>& Poly,
+	TArray<float>& OutWeights)
+{
+	FMeanValueScratch Scratch;
+	ComputeMeanValueWeights(P, Poly, OutWeights, Scratch);
+}
+
+
+void FPatternLiveDeform::ComputeMeanValueWeights(
+	const FVector2f& P,
+	const TArray<FVector2f>& Poly,
+	TArray<float>& OutWeights,
+	FMeanValueScratch& Scratch)
+{
+	const int32 N = Poly.Num();
+	OutWeights.SetNumZeroed(N);
+	if (N == 0)
+	{
+		return;
+	}
+
+	// SetNum keeps the allocation when shrinking, so repeated calls do not reallocate
+	TArray<FVector2f>& D = Scratch.D;  D.SetNumUninitialized(N, EAllowShrinking::No);
+	TArray<float>&     R = Scratch.R;  R.SetNumUninitialized(N, EAllowShrinking::No);
+
+	for (int32 i = 0; i < N; ++i)
+	{
+		D[i] = Poly[i] - P;
+		R[i] = D[i].Size();
+
+		// on a vertex: interpolate that vertex exactly
+		if (R[i] <= UE_KINDA_SMALL_NUMBER)
+		{
+			OutWeights[i] = 1.f;
+			return;
+		}
+	}
+
+	// tan(alpha_i / 2) for the angle subtended by each edge, signed so concave outlines work
+	TArray<float>& TanHalf = Scratch.TanHalf; TanHalf.SetNumUninitialized(N, EAllowShrinking::No);
+	for (int32 i = 0; i < N; ++i)
+	{
+		const int32 j = (i + 1) % N;
+		const float Cross = FVector2f::CrossProduct(D[i], D[j]);
+		const float Dot = FVector2f::DotProduct(D[i], D[j]);
+
+		// on an edge: interpolate linearly between its two ends
+		if (FMath::Abs(Cross) <= UE_KINDA_SMALL_NUMBER * R[i] * R[j] && Dot < 0.f)
+		{
+			const float T = R[i] / (R[i] + R[j]);
+			OutWeights[i] = 1.f - T;
+			OutWeights[j] = T;
+			return;
+		}
+
+		TanHalf[i] = Cross / (R[i] * R[j] + Dot);
+	}
+
+	float Sum = 0.f;
+	for (int32 i = 0; i < N; ++i)
+	{
+		const int32 Prev = (i + N - 1) % N;
+		OutWeights[i] = (TanHalf[Prev] + TanHalf[i]) / R[i];
+		Sum += OutWeights[i];
+	}
+
+	if (FMath::Abs(Sum) <= UE_SMALL_NUMBER)
+	{
+		// degenerate outline; fall back to the nearest sample
+		int32 Nearest = 0;
+		for (int32 i = 1; i < N; ++i)
+		{
+			if (R[i] < R[Nearest]) Nearest = i;
+		}
+		FMemory::Memzero(OutWeights.GetData(), N * sizeof(float));
+		OutWeights[Nearest] = 1.f;
+		return;
+	}
+
+	for (float& W : OutWeights)
+	{
+		W /= Sum;
+	}
+}
+
+
+bool FPatternLiveDeform::Bind(const APatternMesh& Actor)
+{
+	Reset();
+
+	const TArray<FVector2f>& Boundary = Actor.BoundarySamplePoints2D;
+	const UE::Geometry::FDynamicMesh3& Mesh = Actor.DynamicMesh;
+	if (Boundary.Num() < 3 || Mesh.VertexCount() == 0)
+	{
+		return false;
+	}
+
+	// the procedural section must still match the dynamic mesh it was built from
+	const FProcMeshSection* Section = Actor.MeshComponent ? Actor.MeshComponent->GetProcMeshSection(0) : nullptr;
+	if (!Section || Section->ProcVertexBuffer.Num() != Mesh.VertexCount())
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("[LiveDeform] Mesh section does not match dynamic mesh; skipping bind"));
+		return false;
+	}
+
+	const int32 NumVerts = Mesh.VertexCount();
+	NumBoundary = Boundary.Num();
+	Pivot = Actor.PatternPivot2D;
+	Weights.SetNumUninitialized(NumVerts * NumBoundary);
+	RestZ.SetNumUninitialized(NumVerts);
+
+	// same vertex order as ExtractVerticesAndIndices used for the section
+	TArray<float> Row;
+	FMeanValueScratch Scratch;
+	int32 Idx = 0;
+	for (int32 VID : Mesh.VertexIndicesItr())
+	{
+		const FVector3d Local = Mesh.GetVertex(VID);
+		const FVector2f Rest(Local.X + Pivot.X, Local.Y + Pivot.Y);
+
+		ComputeMeanValueWeights(Rest, Boundary, Row, Scratch);
+		FMemory::Memcpy(&Weights[Idx * NumBoundary], Row.GetData(), NumBoundary * sizeof(float));
+		RestZ[Idx] = Local.Z;
+		++Idx;
+	}
+
+	BoundActor = const_cast<APatternMesh*>(&Actor);
+	return true;
+}
+
+
+bool FPatternLiveDeform::Deform(const TArray<FVector2f>& NewBoundary, TArray<FVector>& OutLocalPositions) const
+{
+	if (!IsBound() || NewBoundary.Num() != NumBoundary)
+	{
+		return false;
+	}
+
+	const int32 NumVerts = RestZ.Num();
+	OutLocalPositions.SetNumUninitialized(NumVerts);
+
+	for (int32 v = 0; v < NumVerts; ++v)
+	{
+		const float* Row = &Weights[v * NumBoundary];
+		FVector2f P = FVector2f::ZeroVector;
+		for (int32 b = 0; b < NumBoundary; ++b)
+		{
+			P += NewBoundary[b] * Row[b];
+		}
+		OutLocalPositions[v] = FVector(P.X - Pivot.X, P.Y - Pivot.Y, RestZ[v]);
+	}
+	return true;
+}
+
+
+void FPatternLiveDeform::Reset()
+{
+	BoundActor.Reset();
+	Pivot = FVector2D::ZeroVector;
+	RestZ.Reset();
+	Weights.Reset();
+	NumBoundary = 0;
+}
@@ -8,9 +8,12 @@
 #include "Editor.h" 
 #include "Containers/Set.h"
 #include "Canvas/CanvasUtils.h"
+#include "PatternCreation/PatternSkinning.h"
 #include "DynamicMesh/Operations/MergeCoincidentMeshEdges.h"
 #include "DynamicMesh/MeshNormals.h"
+#include "Async/ParallelFor.h"
 #include "Misc/MessageDialog.h"
+#include "DynamicMesh/DynamicMeshAttributeSet.h"
 
 #if WITH_EDITOR
 #include "CoreMinimal.h"
@@ -19,8 +22,15 @@
 #include "GeometryScript/GeometryScriptTypes.h"
 #include "Editor.h"
 #include "Animation/SkeletalMeshActor.h"
-#include "GeometryScript/MeshBoneWeightFunctions.h"
 #include "Subsystems/AssetEditorSubsystem.h"
+#include "DynamicMesh/DynamicMeshAttributeSet.h"
+#include "DynamicMesh/DynamicVertexSkinWeightsAttribute.h"
+#include "BoneWeights.h"
+#include "Engine/SkeletalMesh.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "DynamicMesh/MeshTransforms.h"
+#include "UObject/SavePackage.h"
+#include "Misc/PackageName.h"
 
 #endif
 
@@ -134,26 +144,83 @@ bool FPatternMerge::MergeComponentToDynamicMesh(
     const TArray<APatternMesh*>& Actors,
     UE::Geometry::FDynamicMesh3& OutMerged)
 {
-    OutMerged = UE::Geometry::FDynamicMesh3();
+    FMergeJob Job;
+    GatherMergeSources(Component, Actors, Job);
+    return MergeSourcesToDynamicMesh(Job.SourceMeshes, Job.SourceTransforms, Job.SourcePivots, OutMerged);
+}
+
+bool FPatternMerge::MergeActorsToDynamicMesh(
+    const TArray<APatternMesh*>& Actors,
+    UE::Geometry::FDynamicMesh3& OutMerged)
+{
+    TArray<int32> Component;
+    Component.Reserve(Actors.Num());
+    for (int32 i = 0; i < Actors.Num(); ++i) Component.Add(i);
+    return MergeComponentToDynamicMesh(Component, Actors, OutMerged);
+}
+
+void FPatternMerge::GatherMergeSources(
+    const TArray<int32>& Component,
+    const TArray<APatternMesh*>& Actors,
+    FMergeJob& OutJob)
+{
+    OutJob.Component = Component;
+    OutJob.SourceMeshes.Reset(Component.Num());
+    OutJob.SourceTransforms.Reset(Component.Num());
+    OutJob.SourcePivots.Reset(Component.Num());
     for (int idx : Component)
     {
         APatternMesh* Src = Actors.IsValidIndex(idx) ? Actors[idx] : nullptr;
         if (!Src) continue;
 
-        TMap<int32,int32> Remap;
-        for (int vid : Src->DynamicMesh.VertexIndicesItr())
+        OutJob.SourceMeshes.Add(&Src->DynamicMesh);
+        OutJob.SourceTransforms.Add(Src->GetActorTransform());
+        OutJob.SourcePivots.Add(Src->PatternPivot2D);
+    }
+}
+
+bool FPatternMerge::MergeSourcesToDynamicMesh(
+    const TArray<const UE::Geometry::FDynamicMesh3*>& SourceMeshes,
+    const TArray<FTransform>& SourceTransforms,
+    const TArray<FVector2D>& SourcePivots,
+    UE::Geometry::FDynamicMesh3& OutMerged)
+{
+    OutMerged = UE::Geometry::FDynamicMesh3();
+    OutMerged.EnableTriangleGroups();
+    OutMerged.EnableAttributes();
+    UE::Geometry::FDynamicMeshUVOverlay* PatternUVs = OutMerged.Attributes()->PrimaryUV();
+
+    for (int32 SrcIdx = 0; SrcIdx < SourceMeshes.Num(); ++SrcIdx)
+    {
+        const UE::Geometry::FDynamicMesh3* Src = SourceMeshes[SrcIdx];
+        if (!Src) continue;
+        const FTransform& SrcTransform = SourceTransforms[SrcIdx];
+        const FVector2D Pivot = SourcePivots.IsValidIndex(SrcIdx) ? SourcePivots[SrcIdx] : FVector2D::ZeroVector;
+
+        // one UV element per source vertex: pieces keep their own pattern coordinates
+        // where they are welded, so seams become UV seams
+        TArray<int32> Remap, UVRemap;
+        Remap.Init(INDEX_NONE, Src->MaxVertexID());
+        UVRemap.Init(INDEX_NONE, Src->MaxVertexID());
+        for (int vid : Src->VertexIndicesItr())
         {
-            FVector3d p = Src->DynamicMesh.GetVertex(vid);
-            FVector world = Src->GetActorTransform().TransformPosition(FVector(p.X,p.Y,p.Z));
-            int newVid = OutMerged.AppendVertex(FVector3d(world));
-            Remap.Add(vid, newVid);
+            FVector3d p = Src->GetVertex(vid);
+            FVector world = SrcTransform.TransformPosition(FVector(p.X,p.Y,p.Z));
+            Remap[vid] = OutMerged.AppendVertex(FVector3d(world));
+
+            const FVector2D Pattern = (FVector2D(p.X, p.Y) + Pivot) * PatternUVScale;
+            UVRemap[vid] = PatternUVs->AppendElement(FVector2f(Pattern), Remap[vid]);
         }
 
-        for (int tid : Src->DynamicMesh.TriangleIndicesItr())
+        for (int tid : Src->TriangleIndicesItr())
         {
-            UE::Geometry::FIndex3i T = Src->DynamicMesh.GetTriangle(tid);
-            if (!Remap.Contains(T.C) || !Remap.Contains(T.B) || !Remap.Contains(T.A)) continue;
-            OutMerged.AppendTriangle(Remap[T.C], Remap[T.B], Remap[T.A]);
+            UE::Geometry::FIndex3i T = Src->GetTriangle(tid);
+            if (Remap[T.C] == INDEX_NONE || Remap[T.B] == INDEX_NONE || Remap[T.A] == INDEX_NONE) continue;
+            const int NewTid = OutMerged.AppendTriangle(Remap[T.C], Remap[T.B], Remap[T.A], SrcIdx);
+            if (NewTid >= 0)
+            {
+                PatternUVs->SetTriangle(NewTid, UE::Geometry::FIndex3i(UVRemap[T.C], UVRemap[T.B], UVRemap[T.A]));
+            }
         }
         
     }
@@ -180,120 +247,138 @@ bool FPatternMerge::MergeComponentToDynamicMesh(
     // Step 3: Recompute normals
     UE::Geometry::FMeshNormals Normals(&OutMerged);
     Normals.ComputeVertexNormals();
+    UE::Geometry::FMeshNormals::InitializeOverlayToPerVertexNormals(OutMerged.Attributes()->PrimaryNormals(), false);
 
     return OutMerged.TriangleCount() > 0;
 }
 
-APatternMesh* FPatternMerge::SpawnMergedActorFromDynamicMesh(
-    UE::Geometry::FDynamicMesh3&& MergedMesh)
+const FName FPatternMergePreview::PreviewActorTag(TEXT("ClothDesignMergePreview"));
+
+bool FPatternMergePreview::IsPreviewActor(const AActor* Actor)
 {
-    // compute centroid in world space (MergedMesh currently stores world positions)
-    FVector3d Centroid3d = FCanvasUtils::ComputeAreaWeightedCentroid(MergedMesh);
-    FVector CentroidF(Centroid3d.X, Centroid3d.Y, Centroid3d.Z);
+    return Actor && Actor->ActorHasTag(PreviewActorTag);
+}
 
-    // Translate the dynamic mesh so centroid moves to origin (local coords)
-    FCanvasUtils::TranslateDynamicMeshBy(MergedMesh, Centroid3d);
+void FPatternMergePreview::Clear()
+{
+    // the world may already be gone when the canvas closes with the editor
+    APatternMesh* Preview = PreviewActor.Get();
+    if (Preview && Preview->GetWorld() && !Preview->GetWorld()->bIsTearingDown)
+    {
+        Preview->Destroy();
+    }
+    PreviewActor.Reset();
 
-    
-    static int32 MeshCounter = 0;
-    FString UniqueLabel = FString::Printf(TEXT("MergedPatternMesh_%d"), MeshCounter++);
-    
-    UWorld* World = GEditor->GetEditorWorldContext().World();
-    if (!World) return nullptr;
+#if WITH_EDITOR
+    for (const FResult& Result : Results)
+    {
+        for (const TWeakObjectPtr<APatternMesh>& W : Result.SourceActors)
+        {
+            if (APatternMesh* Src = W.Get()) Src->SetIsTemporarilyHiddenInEditor(false);
+        }
+    }
+#endif
+    Results.Reset();
+}
 
-    FActorSpawnParameters Params;
-    FTransform SpawnTransform;
-    SpawnTransform.SetLocation(CentroidF);
+void FPatternMerge::ExtractSectionArrays(
+    const UE::Geometry::FDynamicMesh3& Mesh,
+    int32 VertexOffset,
+    TArray<FVector>& OutVerts,
+    TArray<int32>& OutInds)
+{
+    // Map vertex IDs to section indices; merged meshes are not compact after welding.
+    TArray<int32> Compact;
+    Compact.Init(INDEX_NONE, Mesh.MaxVertexID());
 
-    APatternMesh* MergedActor = World->SpawnActor<APatternMesh>(APatternMesh::StaticClass(), SpawnTransform, Params);
+    OutVerts.Reserve(OutVerts.Num() + Mesh.VertexCount());
+    for (int vid : Mesh.VertexIndicesItr())
+    {
+        FVector3d p = Mesh.GetVertex(vid);
+        Compact[vid] = VertexOffset + OutVerts.Num();
+        OutVerts.Add(FVector(p.X,p.Y,p.Z));
+    }
 
-    if (!MergedActor) return nullptr;
+    OutInds.Reserve(OutInds.Num() + Mesh.TriangleCount()*3);
+    for (int tid : Mesh.TriangleIndicesItr())
+    {
+        UE::Geometry::FIndex3i Tri = Mesh.GetTriangle(tid);
+        OutInds.Add(Compact[Tri.C]); OutInds.Add(Compact[Tri.B]); OutInds.Add(Compact[Tri.A]);
+    }
+}
 
-    MergedActor->SetFolderPath(FName(TEXT("ClothDesignActors")));
-#if WITH_EDITOR
+APatternMesh* FPatternMerge::SpawnPreviewActor(const FPatternMergePreview& Preview)
+{
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    if (!World) return nullptr;
 
-    MergedActor->SetActorLabel(UniqueLabel);
+    // Transient and hidden from the outliner: it only exists to draw the preview.
+    FActorSpawnParameters Params;
+    Params.ObjectFlags |= RF_Transient;
+#if WITH_EDITOR
+    Params.bHideFromSceneOutliner = true;
 #endif
 
-    MergedActor->DynamicMesh = MoveTemp(MergedMesh);
+    APatternMesh* PreviewActor = World->SpawnActor<APatternMesh>(APatternMesh::StaticClass(), FTransform::Identity, Params);
+    if (!PreviewActor) return nullptr;
+    PreviewActor->Tags.Add(FPatternMergePreview::PreviewActorTag);
 
-    // Extract arrays
-    TArray<FVector> Verts; Verts.Reserve(MergedActor->DynamicMesh.VertexCount());
-    TArray<int32> Inds; Inds.Reserve(MergedActor->DynamicMesh.TriangleCount()*3);
-    for (int vid : MergedActor->DynamicMesh.VertexIndicesItr())
-    {
-        FVector3d p = MergedActor->DynamicMesh.GetVertex(vid);
-        Verts.Add(FVector(p.X,p.Y,p.Z));
-    }
-    for (int tid : MergedActor->DynamicMesh.TriangleIndicesItr())
+    // One section per merged component on the single preview component.
+    // The merged meshes are already in world space, so the actor stays at the origin.
+    for (int32 i = 0; i < Preview.Results.Num(); ++i)
     {
-        UE::Geometry::FIndex3i Tri = MergedActor->DynamicMesh.GetTriangle(tid);
-        Inds.Add(Tri.C); Inds.Add(Tri.B); Inds.Add(Tri.A);
-    }
+        TArray<FVector> Verts;
+        TArray<int32> Inds;
+        ExtractSectionArrays(Preview.Results[i].Mesh, 0, Verts, Inds);
 
-    TArray<FVector> Normals; Normals.Init(FVector::UpVector, Verts.Num());
-    TArray<FVector2D> UV0; UV0.Init(FVector2D::ZeroVector, Verts.Num());
-    TArray<FLinearColor> VertexColors; VertexColors.Init(FLinearColor::White, Verts.Num());
-    TArray<FProcMeshTangent> Tangents; Tangents.Init(FProcMeshTangent(1,0,0), Verts.Num());
+        TArray<FVector> Normals; Normals.Init(FVector::UpVector, Verts.Num());
+        TArray<FVector2D> UV0; UV0.Init(FVector2D::ZeroVector, Verts.Num());
+        TArray<FLinearColor> VertexColors; VertexColors.Init(FLinearColor::White, Verts.Num());
+        TArray<FProcMeshTangent> Tangents; Tangents.Init(FProcMeshTangent(1,0,0), Verts.Num());
 
-    MergedActor->MeshComponent->CreateMeshSection_LinearColor(0, Verts, Inds, Normals, UV0, VertexColors, Tangents, true);
+        PreviewActor->MeshComponent->CreateMeshSection_LinearColor(i, Verts, Inds, Normals, UV0, VertexColors, Tangents, false);
+    }
 
-    return MergedActor;
+    return PreviewActor;
 }
 
-void FPatternMerge::ReplaceActorsWithMerged(
-    const TArray<int32>& Component,
-    const TArray<APatternMesh*>& Actors,
-    APatternMesh* MergedActor) const
+void FPatternMerge::RemoveMergedSources(const TSet<APatternMesh*>& Sources) const
 {
-    if (!MergedActor) return;
-    TSet<APatternMesh*> ToRemove;
-    for (int idx : Component) if (Actors.IsValidIndex(idx) && Actors[idx]) ToRemove.Add(Actors[idx]);
-
     TArray<TWeakObjectPtr<APatternMesh>> NewList;
     NewList.Reserve(SpawnedActorsRef.Num());
     for (const TWeakObjectPtr<APatternMesh>& W : SpawnedActorsRef)
     {
         APatternMesh* A = W.Get();
         if (!A) continue;
-        if (ToRemove.Contains(A))
+        if (Sources.Contains(A))
         {
             A->Destroy();
             continue;
         }
         NewList.Add(W);
     }
-    NewList.Add(TWeakObjectPtr<APatternMesh>(MergedActor));
     SpawnedActorsRef = MoveTemp(NewList);
 }
 
-void FPatternMerge::RemoveInternalSeams(
-    const TArray<int32>& Component,
-    const TMap<APatternMesh*,int32>& ActorToIndex) const
+void FPatternMerge::RemoveSeamsWithin(const TSet<APatternMesh*>& Sources) const
 {
-    TSet<int32> CompSet; for (int idx : Component) CompSet.Add(idx);
+    TSet<const UProceduralMeshComponent*> Components;
+    for (const APatternMesh* Src : Sources) if (Src) Components.Add(Src->MeshComponent);
 
     TArray<FPatternSewingConstraint> Kept;
     Kept.Reserve(AllSeamsRef.Num());
     for (const FPatternSewingConstraint& Seam : AllSeamsRef)
     {
-        if (!Seam.MeshA || !Seam.MeshB) { Kept.Add(Seam); continue; }
-        int idxA = INDEX_NONE, idxB = INDEX_NONE;
-        for (const TPair<APatternMesh*, int32>& Pair : ActorToIndex)
-        {
-            if (Pair.Key && Pair.Key->MeshComponent == Seam.MeshA) idxA = Pair.Value;
-            if (Pair.Key && Pair.Key->MeshComponent == Seam.MeshB) idxB = Pair.Value;
-        }
-        bool aIn = (idxA != INDEX_NONE) && CompSet.Contains(idxA);
-        bool bIn = (idxB != INDEX_NONE) && CompSet.Contains(idxB);
-        if (aIn && bIn) continue; // drop
+        if (Seam.MeshA && Seam.MeshB && Components.Contains(Seam.MeshA) && Components.Contains(Seam.MeshB)) continue; // drop
         Kept.Add(Seam);
     }
     AllSeamsRef = MoveTemp(Kept);
 }
 
-void FPatternMerge::MergeSewnGroups() const
+bool FPatternMerge::BuildMergePreview(FPatternMergePreview& OutPreview, bool bShowPreview) const
 {
+    OutPreview.Clear();
+
     TArray<APatternMesh*> Actors;
     TMap<APatternMesh*,int32> ActorToIndex;
     BuildActorListAndIndexMap(Actors, ActorToIndex);
@@ -304,6 +389,10 @@ void FPatternMerge::MergeSewnGroups() const
     TArray<TArray<int32>> Components;
     FindConnectedComponents(Adj, Components);
 
+    // Components are disjoint, so the eligibility checks can all run up front:
+    // removing the internal seams of one component never changes whether
+    // another component has external seams.
+    TArray<FMergeJob> Jobs;
     for (const TArray<int32>& Comp : Components)
     {
         if (Comp.Num() < 2) continue;
@@ -313,101 +402,139 @@ void FPatternMerge::MergeSewnGroups() const
             continue;
         }
 
-        UE::Geometry::FDynamicMesh3 Merged;
-        if (!MergeComponentToDynamicMesh(Comp, Actors, Merged)) { UE_LOG(LogTemp, Warning, TEXT("[Merge] merged had no triangles")); continue; }
-        
-        APatternMesh* MergedActor = SpawnMergedActorFromDynamicMesh(MoveTemp(Merged));
-        if (!MergedActor) { UE_LOG(LogTemp, Warning, TEXT("[Merge] spawn failed")); continue; }
+        // Actor transforms are read here on the game thread; the workers below only see plain mesh data.
+        GatherMergeSources(Comp, Actors, Jobs.AddDefaulted_GetRef());
+    }
 
-        ReplaceActorsWithMerged(Comp, Actors, MergedActor);
-        RemoveInternalSeams(Comp, ActorToIndex);
-        
-        // after MergedActor is created and has .DynamicMesh populated
-#if WITH_EDITOR
-        UDynamicMesh* TempDyn = NewObject<UDynamicMesh>(GetTransientPackage(), NAME_None);
-        if (TempDyn)
-        {
-            TempDyn->SetMesh(MergedActor->DynamicMesh); // copy FDynamicMesh3 into UDynamicMesh
+    // Append, weld and normals are independent per component, so they run in parallel.
+    // ParallelFor blocks until every job is done, so the source meshes stay untouched meanwhile.
+    ParallelFor(Jobs.Num(), [&Jobs](int32 JobIndex)
+    {
+        FMergeJob& Job = Jobs[JobIndex];
+        Job.bSucceeded = MergeSourcesToDynamicMesh(Job.SourceMeshes, Job.SourceTransforms, Job.SourcePivots, Job.Merged);
+    });
 
-            FString SafeLabel = MergedActor->GetActorLabel();
-            SafeLabel.ReplaceInline(TEXT(" "), TEXT("_"));
-            FString Guid = FGuid::NewGuid().ToString(EGuidFormats::Digits);
-            FString AssetPathAndName = FString::Printf(TEXT("/Game/ClothDesignAssets/MergedClothPattern/%s"), *SafeLabel);
+    for (FMergeJob& Job : Jobs)
+    {
+        if (!Job.bSucceeded) { UE_LOG(LogTemp, Warning, TEXT("[Merge] merged had no triangles")); continue; }
 
-            // Use the static helper that creates bone weights then the skeletal asset
-            USkeletalMesh* NewSkel = CreateSkeletalFromFDynamicMesh(TempDyn, AssetPathAndName);
-            if (NewSkel)
-            {
-                UWorld* World = GEditor->GetEditorWorldContext().World();
-                if (World)
-                {
-                    FActorSpawnParameters SpawnParams;
-                    FTransform SpawnTransform = MergedActor->GetActorTransform();
-                    ASkeletalMeshActor* SkelActor = World->SpawnActor<ASkeletalMeshActor>(ASkeletalMeshActor::StaticClass(), SpawnTransform, SpawnParams);
-                    if (SkelActor && SkelActor->GetSkeletalMeshComponent())
-                    {
-                        SkelActor->GetSkeletalMeshComponent()->SetSkeletalMesh(NewSkel);
+        FPatternMergePreview::FResult& Result = OutPreview.Results.AddDefaulted_GetRef();
+        Result.Mesh = MoveTemp(Job.Merged);
+        for (int idx : Job.Component)
+        {
+            if (Actors.IsValidIndex(idx) && Actors[idx]) Result.SourceActors.Add(Actors[idx]);
+        }
+    }
+
+    if (bShowPreview && OutPreview.IsActive())
+    {
+        OutPreview.PreviewActor = SpawnPreviewActor(OutPreview);
 #if WITH_EDITOR
-                        SkelActor->SetFolderPath(FName(TEXT("ClothDesignActors")));
-                        SkelActor->SetActorLabel(FString::Printf(TEXT("%s"), *SafeLabel));
-#endif
-                        // remove the merged APatternMesh:
-                        MergedActor->Destroy();
-                        MergedActor = nullptr;
-                    }
-                }
-                
-            }
-            else
+        // Hide the pieces being merged so the preview reads as the final garment.
+        for (const FPatternMergePreview::FResult& Result : OutPreview.Results)
+        {
+            for (const TWeakObjectPtr<APatternMesh>& W : Result.SourceActors)
             {
-                UE_LOG(LogTemp, Warning, TEXT("[Merge] CreateSkeletalFromFDynamicMesh failed for %s"), *AssetPathAndName);
+                if (APatternMesh* Src = W.Get()) Src->SetIsTemporarilyHiddenInEditor(true);
             }
         }
 #endif
+    }
 
-
-     ReplaceActorsWithMerged(Comp, Actors, MergedActor);
-     RemoveInternalSeams(Comp, ActorToIndex);
-     }
+    return OutPreview.IsActive();
 }
 
-
-
-USkeletalMesh* FPatternMerge::CreateSkeletalFromFDynamicMesh(UDynamicMesh* DynMesh, const FString& AssetPathAndName)
+void FPatternMerge::CommitMergePreview(FPatternMergePreview& Preview) const
 {
 #if WITH_EDITOR
-    if (!IsValid(DynMesh))
+    static int32 MeshCounter = 0;
+
+    TArray<FSkeletalAssetRequest> AssetRequests;
+    for (int32 ResultIndex = 0; ResultIndex < Preview.Results.Num(); ++ResultIndex)
     {
-        UE_LOG(LogTemp, Warning, TEXT("CreateSkeletalFromFDynamicMesh_Static: DynMesh null"));
-        return nullptr;
+        FPatternMergePreview::FResult& Result = Preview.Results[ResultIndex];
+
+        // The scene may have changed since the preview was built.
+        bool bSourcesAlive = Result.SourceActors.Num() > 0;
+        for (const TWeakObjectPtr<APatternMesh>& W : Result.SourceActors) bSourcesAlive &= W.IsValid();
+        if (!bSourcesAlive)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[Merge] Skipping preview %d: source pieces no longer exist."), ResultIndex);
+            continue;
+        }
+
+        // compute centroid in world space (merged mesh currently stores world positions)
+        FVector3d Centroid3d = FCanvasUtils::ComputeAreaWeightedCentroid(Result.Mesh);
+
+        // Translate the dynamic mesh so centroid moves to origin (local coords)
+        FCanvasUtils::TranslateDynamicMeshBy(Result.Mesh, Centroid3d);
+
+        FString SafeLabel = FString::Printf(TEXT("MergedPatternMesh_%d"), MeshCounter++);
+
+        FSkeletalAssetRequest& Request = AssetRequests.AddDefaulted_GetRef();
+        Request.Mesh = MoveTemp(Result.Mesh);
+        Request.AssetPathAndName = FString::Printf(TEXT("/Game/ClothDesignAssets/MergedClothPattern/%s"), *SafeLabel);
+        Request.Label = SafeLabel;
+        Request.Transform = FTransform(FVector(Centroid3d.X, Centroid3d.Y, Centroid3d.Z));
+        Request.PreviewResultIndex = ResultIndex;
     }
 
-    UGeometryScriptDebug* DebugObj = NewObject<UGeometryScriptDebug>(GetTransientPackage(), NAME_None);
+    // One batch for every merged component: skeleton loaded once, packages saved together.
+    CreateSkeletalAssetsBatched(AssetRequests, SkinningBodyMesh.Get());
 
-    bool bReplaceExistingProfile = true;
-    FGeometryScriptBoneWeightProfile Profile;
-    Profile.ProfileName = FName(TEXT("Default"));
+    UWorld* World = GEditor->GetEditorWorldContext().World();
+    TSet<APatternMesh*> MergedSources;
+    for (const FSkeletalAssetRequest& Request : AssetRequests)
+    {
+        if (!Request.Result)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[Merge] CreateSkeletalFromFDynamicMesh failed for %s"), *Request.AssetPathAndName);
+            continue;
+        }
+        if (!World) continue;
 
-    bool bProfileExisted = UGeometryScriptLibrary_MeshBoneWeightFunctions::MeshCreateBoneWeights(
-        DynMesh,
-        bReplaceExistingProfile,
-        DebugObj,
-        Profile
-    );
+        FActorSpawnParameters SpawnParams;
+        ASkeletalMeshActor* SkelActor = World->SpawnActor<ASkeletalMeshActor>(ASkeletalMeshActor::StaticClass(), Request.Transform, SpawnParams);
+        if (SkelActor && SkelActor->GetSkeletalMeshComponent())
+        {
+            SkelActor->GetSkeletalMeshComponent()->SetSkeletalMesh(Request.Result);
+            SkelActor->SetFolderPath(FName(TEXT("ClothDesignActors")));
+            SkelActor->SetActorLabel(FString::Printf(TEXT("%s"), *Request.Label));
 
-    FGeometryScriptBoneWeight SingleBW;
-    SingleBW.BoneIndex = 0;
-    SingleBW.Weight = 1.0f;
-    TArray<FGeometryScriptBoneWeight> AllWeights;
-    AllWeights.Add(SingleBW);
+            // Only pieces that made it into a skeletal actor are retired.
+            for (const TWeakObjectPtr<APatternMesh>& W : Preview.Results[Request.PreviewResultIndex].SourceActors)
+            {
+                MergedSources.Add(W.Get());
+            }
+        }
+    }
+
+    // Retire the sources once for the whole commit, then drop the preview.
+    RemoveSeamsWithin(MergedSources);
+    RemoveMergedSources(MergedSources);
+#endif
+    Preview.Clear();
+}
+
+void FPatternMerge::MergeSewnGroups() const
+{
+    FPatternMergePreview Preview;
+    if (BuildMergePreview(Preview, false))
+    {
+        CommitMergePreview(Preview);
+    }
+}
+
+
+USkeleton* FPatternMerge::LoadMergeSkeleton()
+{
+    // Cached across merges so the asset is only resolved once per editor session.
+    static TWeakObjectPtr<USkeleton> CachedSkeleton;
+    if (CachedSkeleton.IsValid())
+    {
+        return CachedSkeleton.Get();
+    }
 
-    UGeometryScriptLibrary_MeshBoneWeightFunctions::SetAllVertexBoneWeights(
-        DynMesh,
-        AllWeights,
-        Profile,
-        DebugObj
-    );
-    
     USkeleton* SkeletonAsset = LoadObject<USkeleton>(nullptr, TEXT("/Game/ClothDesignAssets/SkelAsset/SK_ProcMesh.SK_ProcMesh"));
     if (!SkeletonAsset)
     {
@@ -418,13 +545,142 @@ USkeletalMesh* FPatternMerge::CreateSkeletalFromFDynamicMesh(UDynamicMesh* DynMe
             "Could not load the skeleton asset.\n"
             "Please ensure the skeleton was copied into the project's Content folder during installation.");
           
-        
         FMessageDialog::Open(EAppMsgType::Ok, DialogText);
-        
+        return nullptr;
+    }
+
+    CachedSkeleton = SkeletonAsset;
+    return SkeletonAsset;
+}
+
+void FPatternMerge::AssignRigidBoneWeights(UE::Geometry::FDynamicMesh3& Mesh)
+{
+    using namespace UE::AnimationCore;
+
+    if (!Mesh.HasAttributes())
+    {
+        Mesh.EnableAttributes();
+    }
+
+    // Written straight into the mesh attribute set instead of going through
+    // the GeometryScript bone weight helpers, which need a UDynamicMesh per call.
+    UE::Geometry::FDynamicMeshVertexSkinWeightsAttribute* SkinWeights =
+        new UE::Geometry::FDynamicMeshVertexSkinWeightsAttribute(&Mesh);
+
+    FBoneWeights RootWeight;
+    RootWeight.SetBoneWeight(FBoneWeight(0, 1.0f), FBoneWeightsSettings());
+    for (int vid : Mesh.VertexIndicesItr())
+    {
+        SkinWeights->SetValue(vid, RootWeight);
+    }
+
+    Mesh.Attributes()->AttachSkinWeightsAttribute(FName(TEXT("Default")), SkinWeights);
+}
+
+void FPatternMerge::CreateSkeletalAssetsBatched(TArray<FSkeletalAssetRequest>& Requests, USkeletalMesh* BodyMesh)
+{
+#if WITH_EDITOR
+    if (Requests.Num() == 0) return;
+
+    // With a body chosen, garments are bound to its skeleton by proximity;
+    // otherwise they fall back to the single-bone placeholder skeleton.
+    UE::Geometry::FDynamicMesh3 BodySkinMesh;
+    const bool bSkinToBody = IsValid(BodyMesh) && BodyMesh->GetSkeleton()
+        && FPatternSkinning::BuildBodySkinMesh(BodyMesh, BodySkinMesh);
+
+    USkeleton* SkeletonAsset = bSkinToBody ? BodyMesh->GetSkeleton() : LoadMergeSkeleton();
+    if (!SkeletonAsset) return;
 
+    // Skinned garments are built in the body component's space, so their bind pose lines
+    // up with the body's reference pose wherever the body is placed in the level.
+    FTransform BodyTransform = FTransform::Identity;
+    if (bSkinToBody)
+    {
+        UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+        if (const USkeletalMeshComponent* BodyComponent = FPatternSkinning::FindBodyComponent(World, BodyMesh))
+        {
+            BodyTransform = BodyComponent->GetComponentTransform();
+        }
+        else
+        {
+            UE_LOG(LogTemp, Log, TEXT("[Merge] No actor in the level uses %s; binding as if the body were at the origin."), *BodyMesh->GetName());
+        }
+    }
+
+    TArray<UPackage*> PackagesToSave;
+    PackagesToSave.Reserve(Requests.Num());
+
+    UDynamicMesh* TempDyn = NewObject<UDynamicMesh>(GetTransientPackage(), NAME_None);
+    for (FSkeletalAssetRequest& Request : Requests)
+    {
+        if (bSkinToBody)
+        {
+            const FTransform GarmentToBody = Request.Transform.GetRelativeTransform(BodyTransform);
+            UE::Geometry::MeshTransforms::ApplyTransform(Request.Mesh, UE::Geometry::FTransformSRT3d(GarmentToBody), true);
+            Request.Transform = BodyTransform;
+        }
+
+        if (!bSkinToBody || !FPatternSkinning::TransferProximityWeights(BodySkinMesh, FTransform::Identity, Request.Mesh))
+        {
+            AssignRigidBoneWeights(Request.Mesh);
+        }
+
+        TempDyn->SetMesh(MoveTemp(Request.Mesh));
+        Request.Result = CreateSkeletalFromFDynamicMesh(TempDyn, Request.AssetPathAndName, SkeletonAsset);
+        if (Request.Result)
+        {
+            PackagesToSave.AddUnique(Request.Result->GetPackage());
+        }
+    }
+
+    SavePackagesAsync(PackagesToSave);
+#endif
+}
+
+void FPatternMerge::SavePackagesAsync(const TArray<UPackage*>& Packages)
+{
+#if WITH_EDITOR
+    FSavePackageArgs SaveArgs;
+    SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+    // Serialise to memory here and let the async writer flush to disk,
+    // so the editor does not stall on file I/O for every merged asset.
+    SaveArgs.SaveFlags = SAVE_NoError | SAVE_Async;
+
+    for (UPackage* Package : Packages)
+    {
+        if (!Package) continue;
+
+        const FString FileName = FPackageName::LongPackageNameToFilename(
+            Package->GetName(), FPackageName::GetAssetPackageExtension());
+
+        if (!UPackage::SavePackage(Package, nullptr, *FileName, SaveArgs))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[Merge] Failed to save package %s"), *Package->GetName());
+        }
+    }
+#endif
+}
+
+
+USkeletalMesh* FPatternMerge::CreateSkeletalFromFDynamicMesh(
+    UDynamicMesh* DynMesh,
+    const FString& AssetPathAndName,
+    USkeleton* SkeletonAsset)
+{
+#if WITH_EDITOR
+    if (!IsValid(DynMesh))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CreateSkeletalFromFDynamicMesh_Static: DynMesh null"));
+        return nullptr;
+    }
+    if (!SkeletonAsset)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CreateSkeletalFromFDynamicMesh_Static: Skeleton null"));
         return nullptr;
     }
 
+    UGeometryScriptDebug* DebugObj = NewObject<UGeometryScriptDebug>(GetTransientPackage(), NAME_None);
+
     FGeometryScriptCreateNewSkeletalMeshAssetOptions Options;
     Options.bEnableRecomputeNormals = false;
     Options.bEnableRecomputeTangents = false;
@@ -453,7 +709,3 @@ USkeletalMesh* FPatternMerge::CreateSkeletalFromFDynamicMesh(UDynamicMesh* DynMe
     return nullptr;
 #endif
 }
-
-
-
-
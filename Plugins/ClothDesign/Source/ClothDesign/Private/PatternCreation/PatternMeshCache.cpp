@@ -0,0 +1,103 @@
+#include "PatternCreation/PatternMeshCache.h"
+#include "DerivedDataCacheInterface.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+
+// change whenever triangulation or the cached layout changes, so stale entries are not read
+#define CLOTHPATTERNMESH_DERIVEDDATA_VER TEXT("8E2C5A71D40B4F0E9C3B16A2F7D85E04")
+
+
+bool FPatternMeshCache::LoadOrBuild(
+	const FInterpCurve<FVector2D>& Shape,
+	bool bRecordSeam,
+	int32 StartPointIdx2D,
+	int32 EndPointIdx2D,
+	FPatternMeshData& OutData)
+{
+	const FString Key = MakeCacheKey(Shape, bRecordSeam, StartPointIdx2D, EndPointIdx2D);
+	FDerivedDataCacheInterface& DDC = GetDerivedDataCacheRef();
+
+	TArray<uint8> Bytes;
+	if (DDC.GetSynchronous(*Key, Bytes, TEXT("ClothPatternMesh")))
+	{
+		FMemoryReader Reader(Bytes, true);
+		FPatternMeshData Cached;
+		SerializeMeshData(Reader, Cached);
+		if (!Reader.IsError())
+		{
+			UE_LOG(LogTemp, Verbose, TEXT("[MeshCache] Hit %s"), *Key);
+			OutData = MoveTemp(Cached);
+			return true;
+		}
+		UE_LOG(LogTemp, Warning, TEXT("[MeshCache] Discarding unreadable entry %s"), *Key);
+	}
+
+	if (!FMeshTriangulation::BuildPatternMeshData(Shape, bRecordSeam, StartPointIdx2D, EndPointIdx2D, OutData))
+	{
+		return false;
+	}
+
+	Bytes.Reset();
+	FMemoryWriter Writer(Bytes, true);
+	SerializeMeshData(Writer, OutData);
+	DDC.Put(*Key, Bytes, TEXT("ClothPatternMesh"));
+
+	UE_LOG(LogTemp, Verbose, TEXT("[MeshCache] Stored %s (%d bytes)"), *Key, Bytes.Num());
+	return true;
+}
+
+
+FString FPatternMeshCache::MakeCacheKey(
+	const FInterpCurve<FVector2D>& Shape,
+	bool bRecordSeam,
+	int32 StartPointIdx2D,
+	int32 EndPointIdx2D)
+{
+	FSHA1 Hash;
+
+	// meshing settings that shape the result
+	int32 Settings[] = { FMeshTriangulation::BoundarySamplesPerSegment, FMeshTriangulation::GridInteriorResolution };
+	Hash.Update(reinterpret_cast<const uint8*>(Settings), sizeof(Settings));
+
+	const uint8 RecordSeam = bRecordSeam ? 1 : 0;
+	Hash.Update(&RecordSeam, sizeof(RecordSeam));
+	if (bRecordSeam)
+	{
+		Hash.Update(reinterpret_cast<const uint8*>(&StartPointIdx2D), sizeof(StartPointIdx2D));
+		Hash.Update(reinterpret_cast<const uint8*>(&EndPointIdx2D), sizeof(EndPointIdx2D));
+	}
+
+	// hashed field by field; the point struct has padding
+	for (const FInterpCurvePoint<FVector2D>& Pt : Shape.Points)
+	{
+		const double Values[] = {
+			Pt.OutVal.X, Pt.OutVal.Y,
+			Pt.ArriveTangent.X, Pt.ArriveTangent.Y,
+			Pt.LeaveTangent.X, Pt.LeaveTangent.Y };
+		Hash.Update(reinterpret_cast<const uint8*>(&Pt.InVal), sizeof(Pt.InVal));
+		Hash.Update(reinterpret_cast<const uint8*>(Values), sizeof(Values));
+		const uint8 Mode = static_cast<uint8>(Pt.InterpMode);
+		Hash.Update(&Mode, sizeof(Mode));
+	}
+	Hash.Final();
+
+	FSHAHash Digest;
+	Hash.GetHash(Digest.Hash);
+
+	return FDerivedDataCacheInterface::BuildCacheKey(TEXT("CLOTHPATTERNMESH"), CLOTHPATTERNMESH_DERIVEDDATA_VER, *Digest.ToString());
+}
+
+
+void FPatternMeshCache::SerializeMeshData(FArchive& Ar, FPatternMeshData& Data)
+{
+	Data.Vertices.BulkSerialize(Ar);
+	Data.Indices.BulkSerialize(Ar);
+	Ar << Data.DynamicMesh;
+	Data.PolyIndexToVID.BulkSerialize(Ar);
+	Data.SeamVertexIDs.BulkSerialize(Ar);
+	Data.BoundarySamples2D.BulkSerialize(Ar);
+	Data.BoundarySampleVIDs.BulkSerialize(Ar);
+	Ar << Data.Centroid;
+}
@@ -0,0 +1,163 @@
+#include "PatternCreation/PatternRetriangulation.h"
+#include "PatternMesh.h"
+#include "Tasks/Task.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+
+bool FPatternRetriangulationQueue::FShared::IsSuperseded(int32 ShapeIndex, uint32 Generation)
+{
+	if (bShutdown.load(std::memory_order_relaxed))
+	{
+		return true;
+	}
+	FScopeLock Lock(&GenerationLock);
+	const uint32* Latest = LatestGeneration.Find(ShapeIndex);
+	return !Latest || *Latest != Generation;
+}
+
+
+FPatternRetriangulationQueue::FPatternRetriangulationQueue()
+	: Shared(MakeShared<FShared, ESPMode::ThreadSafe>())
+{
+}
+
+
+FPatternRetriangulationQueue::~FPatternRetriangulationQueue()
+{
+	// running workers hold their own reference and stop at the next stage boundary
+	Shared->bShutdown = true;
+}
+
+
+void FPatternRetriangulationQueue::Request(int32 ShapeIndex, const FInterpCurve<FVector2D>& Shape, TWeakObjectPtr<APatternMesh> Actor)
+{
+	const uint32 Generation = NextGeneration++;
+	{
+		FScopeLock Lock(&Shared->GenerationLock);
+		Shared->LatestGeneration.Add(ShapeIndex, Generation);
+	}
+
+	// an older result for this shape would be overwritten anyway
+	Ready.Remove(ShapeIndex);
+
+	FShapeJob& Job = Jobs.FindOrAdd(ShapeIndex);
+	Job.Pending = Shape;
+	Job.PendingGeneration = Generation;
+	Job.Actor = Actor;
+
+	if (!Job.bInFlight)
+	{
+		Launch(ShapeIndex, Job);
+	}
+}
+
+
+void FPatternRetriangulationQueue::Launch(int32 ShapeIndex, FShapeJob& Job)
+{
+	check(Job.Pending.IsSet());
+
+	FInterpCurve<FVector2D> Snapshot = MoveTemp(Job.Pending.GetValue());
+	const uint32 Generation = Job.PendingGeneration;
+	Job.Pending.Reset();
+	Job.bInFlight = true;
+	Job.InFlightGeneration = Generation;
+
+	TSharedRef<FShared, ESPMode::ThreadSafe> SharedRef = Shared;
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [SharedRef, ShapeIndex, Generation, Snapshot = MoveTemp(Snapshot)]()
+	{
+		FResult Result;
+		Result.ShapeIndex = ShapeIndex;
+		Result.Generation = Generation;
+
+		if (!SharedRef->IsSuperseded(ShapeIndex, Generation))
+		{
+			Result.bSucceeded = FMeshTriangulation::BuildPatternMeshData(
+				Snapshot, false, 0, 0, Result.Data,
+				[&SharedRef, ShapeIndex, Generation]() { return SharedRef->IsSuperseded(ShapeIndex, Generation); });
+		}
+
+		// always report back so the shape is no longer considered in flight
+		SharedRef->Results.Enqueue(MoveTemp(Result));
+	});
+}
+
+
+int32 FPatternRetriangulationQueue::Tick(double BudgetSeconds, TArray<APatternMesh*>* OutAppliedActors)
+{
+	// collect finished builds and start the snapshots that waited for them
+	FResult Finished;
+	while (Shared->Results.Dequeue(Finished))
+	{
+		const int32 ShapeIndex = Finished.ShapeIndex;
+		FShapeJob* Job = Jobs.Find(ShapeIndex);
+		if (!Job || !Job->bInFlight || Job->InFlightGeneration != Finished.Generation)
+		{
+			continue; // from before CancelAll
+		}
+		Job->bInFlight = false;
+
+		if (Finished.bSucceeded && !Shared->IsSuperseded(ShapeIndex, Finished.Generation))
+		{
+			Ready.Add(ShapeIndex, MoveTemp(Finished));
+		}
+
+		if (Job->Pending.IsSet())
+		{
+			Launch(ShapeIndex, *Job);
+		}
+		else if (!Ready.Contains(ShapeIndex))
+		{
+			Jobs.Remove(ShapeIndex);
+		}
+	}
+
+	// swap results in until the frame budget is spent
+	const double StartTime = FPlatformTime::Seconds();
+	int32 NumApplied = 0;
+	for (auto It = Ready.CreateIterator(); It; ++It)
+	{
+		if (NumApplied > 0 && FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+		{
+			break;
+		}
+
+		const int32 ShapeIndex = It.Key();
+		FShapeJob* Job = Jobs.Find(ShapeIndex);
+		APatternMesh* Actor = Job ? Job->Actor.Get() : nullptr;
+
+		if (Actor && FMeshTriangulation::ApplyRebuiltMesh(Actor, MoveTemp(It.Value().Data)))
+		{
+			++NumApplied;
+			if (OutAppliedActors)
+			{
+				OutAppliedActors->Add(Actor);
+			}
+		}
+		It.RemoveCurrent();
+
+		if (Job && !Job->bInFlight && !Job->Pending.IsSet())
+		{
+			Jobs.Remove(ShapeIndex);
+		}
+	}
+
+	return NumApplied;
+}
+
+
+void FPatternRetriangulationQueue::CancelAll()
+{
+	{
+		FScopeLock Lock(&Shared->GenerationLock);
+		Shared->LatestGeneration.Reset();
+	}
+	Jobs.Reset();
+	Ready.Reset();
+}
+
+
+bool FPatternRetriangulationQueue::IsBusy() const
+{
+	return Jobs.Num() > 0 || Ready.Num() > 0;
+}
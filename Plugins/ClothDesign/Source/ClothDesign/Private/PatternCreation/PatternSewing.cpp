@@ -3,6 +3,53 @@
 #include "PatternCreation/PatternMerge.h"
 #include "Misc/MessageDialog.h"
 
+
+FPatternSewing::~FPatternSewing()
+{
+	MergePreview.Clear();
+}
+
+
+// fills a constraint from the seam's endpoint positions and the meshes of both shapes
+static void FillSeamConstraint(
+	const FVector2D& A1, const FVector2D& A2,
+	const FVector2D& B1, const FVector2D& B2,
+	APatternMesh* MeshA, int32 StartPointA,
+	APatternMesh* MeshB, int32 StartPointB,
+	FPatternSewingConstraint& OutSeam)
+{
+	constexpr int32 NumSeamPoints = 10;
+
+	OutSeam.ScreenPointsA.Reset(NumSeamPoints);
+	OutSeam.ScreenPointsB.Reset(NumSeamPoints);
+	for (int32 i = 0; i < NumSeamPoints; ++i)
+	{
+		float Alpha = static_cast<float>(i) / (NumSeamPoints - 1);
+		OutSeam.ScreenPointsA.Add(FMath::Lerp(A1, A2, Alpha));
+		OutSeam.ScreenPointsB.Add(FMath::Lerp(B1, B2, Alpha));
+	}
+
+	OutSeam.MeshA = MeshA ? MeshA->MeshComponent : nullptr;
+	OutSeam.MeshB = MeshB ? MeshB->MeshComponent : nullptr;
+
+	OutSeam.VertexIndexA = -1;
+	OutSeam.VertexIndexB = -1;
+
+	if (MeshA)
+	{
+		const TArray<int32>& Mapping = MeshA->GetPolyIndexToVID();
+		if (Mapping.IsValidIndex(StartPointA))
+			OutSeam.VertexIndexA = Mapping[StartPointA];
+	}
+
+	if (MeshB)
+	{
+		const TArray<int32>& Mapping = MeshB->GetPolyIndexToVID();
+		if (Mapping.IsValidIndex(StartPointB))
+			OutSeam.VertexIndexB = Mapping[StartPointB];
+	}
+}
+
 // Returns true if the shape index maps to a valid spawned pattern actor
 bool FPatternSewing::ValidateMeshForShape(
     int32 ShapeIndex,
@@ -92,10 +139,6 @@ void FPatternSewing::FinaliseSeamDefinitionByTargets(
 	const TArray<FInterpCurve<FVector2D>>& CompletedShapes,
 	const TArray<TWeakObjectPtr<APatternMesh>>& SpawnedPatternActors)
 {
-	constexpr int32 NumSeamPoints = 10;
-	TArray<FVector2D> PointsA, PointsB;
-	
-
 	auto GetPt = [&](const FClickTarget& T) {
 		if (T.ShapeIndex == INDEX_NONE)
 			return CurvePoints.Points[T.PointIndex].OutVal;
@@ -105,13 +148,6 @@ void FPatternSewing::FinaliseSeamDefinitionByTargets(
 
 	FVector2D A1 = GetPt(AStart), A2 = GetPt(AEnd);
 	FVector2D B1 = GetPt(BStart), B2 = GetPt(BEnd);
-
-	for (int32 i = 0; i < NumSeamPoints; ++i)
-	{
-		float Alpha = static_cast<float>(i) / (NumSeamPoints - 1);
-		PointsA.Add(FMath::Lerp(A1, A2, Alpha));
-		PointsB.Add(FMath::Lerp(B1, B2, Alpha));
-	}
 	
 	FSeamDefinition NewSeamDef;
 	NewSeamDef.ShapeA = AStart.ShapeIndex;
@@ -149,28 +185,7 @@ void FPatternSewing::FinaliseSeamDefinitionByTargets(
 	UE_LOG(LogTemp, Warning, TEXT("MeshA->MeshComponent ptr: %s"), MeshA && MeshA->MeshComponent ? *MeshA->MeshComponent->GetName() : TEXT("NULL"));
 
 	
-	NewSeam.MeshA = MeshA ? MeshA->MeshComponent : nullptr;
-	NewSeam.MeshB = MeshB ? MeshB->MeshComponent : nullptr;
-
-	NewSeam.VertexIndexA = -1;
-	NewSeam.VertexIndexB = -1;
-
-	if (MeshA)
-	{
-		const TArray<int32>& Mapping = MeshA->GetPolyIndexToVID();
-		if (Mapping.IsValidIndex(AStart.PointIndex))
-			NewSeam.VertexIndexA = Mapping[AStart.PointIndex];
-	}
-
-	if (MeshB)
-	{
-		const TArray<int32>& Mapping = MeshB->GetPolyIndexToVID();
-		if (Mapping.IsValidIndex(BStart.PointIndex))
-			NewSeam.VertexIndexB = Mapping[BStart.PointIndex];
-	}
-
-	NewSeam.ScreenPointsA = PointsA;
-	NewSeam.ScreenPointsB = PointsB;
+	FillSeamConstraint(A1, A2, B1, B2, MeshA, AStart.PointIndex, MeshB, BStart.PointIndex, NewSeam);
 
 	AllDefinedSeams.Add(NewSeam);
 	UE_LOG(LogTemp, Warning, TEXT("AStart.ShapeIndex=%d, BStart.ShapeIndex=%d"), AStart.ShapeIndex, BStart.ShapeIndex);
@@ -585,10 +600,58 @@ void FPatternSewing::BuildAndAlignAllSeams()
 	}
 }
 
+int32 FPatternSewing::RebindSeamConstraints(const TArray<FInterpCurve<FVector2D>>& CompletedShapes)
+{
+	auto GetActor = [this](int32 ShapeIndex) -> APatternMesh*
+	{
+		return SpawnedPatternActors.IsValidIndex(ShapeIndex) ? SpawnedPatternActors[ShapeIndex].Get() : nullptr;
+	};
+	auto GetPt = [&CompletedShapes](int32 ShapeIndex, int32 PointIndex, FVector2D& OutPt)
+	{
+		if (!CompletedShapes.IsValidIndex(ShapeIndex) || !CompletedShapes[ShapeIndex].Points.IsValidIndex(PointIndex))
+		{
+			return false;
+		}
+		OutPt = CompletedShapes[ShapeIndex].Points[PointIndex].OutVal;
+		return true;
+	};
+
+	// one constraint per definition, in the same order, so deleting by index stays in sync
+	AllDefinedSeams.Reset(SeamDefinitions.Num());
+	int32 NumBound = 0;
+
+	for (const FSeamDefinition& Def : SeamDefinitions)
+	{
+		FPatternSewingConstraint& Seam = AllDefinedSeams.AddDefaulted_GetRef();
+
+		FVector2D A1, A2, B1, B2;
+		if (!GetPt(Def.ShapeA, Def.EdgeA.Start, A1) || !GetPt(Def.ShapeA, Def.EdgeA.End, A2) ||
+			!GetPt(Def.ShapeB, Def.EdgeB.Start, B1) || !GetPt(Def.ShapeB, Def.EdgeB.End, B2))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Seam between shapes %d and %d refers to missing points; left unbound"), Def.ShapeA, Def.ShapeB);
+			continue;
+		}
+
+		APatternMesh* MeshA = GetActor(Def.ShapeA);
+		APatternMesh* MeshB = GetActor(Def.ShapeB);
+		FillSeamConstraint(A1, A2, B1, B2, MeshA, Def.EdgeA.Start, MeshB, Def.EdgeB.Start, Seam);
+
+		if (MeshA && MeshB)
+		{
+			++NumBound;
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Rebound %d of %d seams to the current pattern meshes"), NumBound, SeamDefinitions.Num());
+	return NumBound;
+}
+
+
 void FPatternSewing::ClearAllSeams()
 {
 	SeamDefinitions.Empty();
 	AllDefinedSeams.Empty();
+	MergePreview.Clear();
 	SeamClickState = ESeamClickState::None;
 	AStartTarget = FClickTarget();
 	AEndTarget = FClickTarget();
@@ -600,7 +663,20 @@ void FPatternSewing::ClearAllSeams()
 void FPatternSewing::MergeSewnPatternPieces()
 {
 	FPatternMerge Merge(SpawnedPatternActors, AllDefinedSeams);
-	Merge.MergeSewnGroups();
+	Merge.BuildMergePreview(MergePreview);
+}
+
+void FPatternSewing::CommitMergedPatternPieces()
+{
+	if (!MergePreview.IsActive())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Merge] Nothing to commit, preview a merge first."));
+		return;
+	}
+
+	FPatternMerge Merge(SpawnedPatternActors, AllDefinedSeams);
+	Merge.SkinningBodyMesh = SkinningBodyMesh;
+	Merge.CommitMergePreview(MergePreview);
 }
 
 
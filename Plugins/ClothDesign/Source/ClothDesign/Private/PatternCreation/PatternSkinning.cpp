@@ -0,0 +1,197 @@
+#include "PatternCreation/PatternSkinning.h"
+
+#include "Async/ParallelFor.h"
+#include "BoneWeights.h"
+#include "DynamicMesh/DynamicMeshAABBTree3.h"
+#include "DynamicMesh/DynamicMeshAttributeSet.h"
+#include "DynamicMesh/DynamicVertexSkinWeightsAttribute.h"
+#include "MeshQueries.h"
+#include "UDynamicMesh.h"
+#include "Engine/SkeletalMesh.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Animation/Skeleton.h"
+#include "EngineUtils.h"
+#include "GeometryScript/GeometryScriptTypes.h"
+#include "GeometryScript/MeshAssetFunctions.h"
+
+namespace
+{
+	const FName SkinProfileName(TEXT("Default"));
+}
+
+bool FPatternSkinning::BuildBodySkinMesh(USkeletalMesh* BodyMesh, UE::Geometry::FDynamicMesh3& OutBodyMesh)
+{
+	if (!IsValid(BodyMesh))
+	{
+		return false;
+	}
+
+	UDynamicMesh* TempDyn = NewObject<UDynamicMesh>(GetTransientPackage(), NAME_None);
+	UGeometryScriptDebug* DebugObj = NewObject<UGeometryScriptDebug>(GetTransientPackage(), NAME_None);
+
+	FGeometryScriptCopyMeshFromAssetOptions AssetOptions;
+	FGeometryScriptMeshReadLOD RequestedLOD;
+	EGeometryScriptOutcomePins Outcome = EGeometryScriptOutcomePins::Failure;
+
+	UGeometryScriptLibrary_StaticMeshFunctions::CopyMeshFromSkeletalMesh(
+		BodyMesh, TempDyn, AssetOptions, RequestedLOD, Outcome, DebugObj);
+
+	if (Outcome != EGeometryScriptOutcomePins::Success)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Skinning] Could not copy mesh from %s"), *BodyMesh->GetName());
+		return false;
+	}
+
+	TempDyn->ProcessMesh([&OutBodyMesh](const UE::Geometry::FDynamicMesh3& Mesh)
+	{
+		OutBodyMesh = Mesh;
+	});
+
+	if (OutBodyMesh.TriangleCount() == 0
+		|| !OutBodyMesh.HasAttributes()
+		|| !OutBodyMesh.Attributes()->GetSkinWeightsAttribute(SkinProfileName))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Skinning] %s has no skin weights to transfer"), *BodyMesh->GetName());
+		return false;
+	}
+
+	// the copied weights index the mesh's reference skeleton; garments are built against the skeleton asset
+	if (const USkeleton* Skeleton = BodyMesh->GetSkeleton())
+	{
+		const FReferenceSkeleton& MeshBones = BodyMesh->GetRefSkeleton();
+		const FReferenceSkeleton& SkeletonBones = Skeleton->GetReferenceSkeleton();
+
+		TArray<int32> BoneIndexMap;
+		BoneIndexMap.SetNumUninitialized(MeshBones.GetNum());
+		bool bIdentity = true;
+		for (int32 BoneIndex = 0; BoneIndex < MeshBones.GetNum(); ++BoneIndex)
+		{
+			BoneIndexMap[BoneIndex] = SkeletonBones.FindBoneIndex(MeshBones.GetBoneName(BoneIndex));
+			bIdentity &= BoneIndexMap[BoneIndex] == BoneIndex;
+		}
+		if (!bIdentity)
+		{
+			RemapBoneIndices(BoneIndexMap, OutBodyMesh);
+		}
+	}
+	return true;
+}
+
+void FPatternSkinning::RemapBoneIndices(const TArray<int32>& BoneIndexMap, UE::Geometry::FDynamicMesh3& Mesh)
+{
+	using namespace UE::AnimationCore;
+
+	UE::Geometry::FDynamicMeshVertexSkinWeightsAttribute* Weights =
+		Mesh.HasAttributes() ? Mesh.Attributes()->GetSkinWeightsAttribute(SkinProfileName) : nullptr;
+	if (!Weights)
+	{
+		return;
+	}
+
+	for (const int32 VertexID : Mesh.VertexIndicesItr())
+	{
+		FBoneWeights Old;
+		Weights->GetValue(VertexID, Old);
+
+		FBoneWeights Remapped;
+		for (int32 i = 0; i < Old.Num(); ++i)
+		{
+			const int32 OldIndex = Old[i].GetBoneIndex();
+			const int32 NewIndex = BoneIndexMap.IsValidIndex(OldIndex) ? BoneIndexMap[OldIndex] : INDEX_NONE;
+			if (NewIndex != INDEX_NONE)
+			{
+				Remapped.SetBoneWeight(FBoneWeight(static_cast<FBoneIndexType>(NewIndex), Old[i].GetWeight()), FBoneWeightsSettings());
+			}
+		}
+		Remapped.Renormalize();
+		Weights->SetValue(VertexID, Remapped);
+	}
+}
+
+const USkeletalMeshComponent* FPatternSkinning::FindBodyComponent(UWorld* World, const USkeletalMesh* BodyMesh)
+{
+	if (!World || !BodyMesh)
+	{
+		return nullptr;
+	}
+
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		TArray<USkeletalMeshComponent*> Components;
+		It->GetComponents<USkeletalMeshComponent>(Components);
+		for (const USkeletalMeshComponent* Component : Components)
+		{
+			if (Component && Component->GetSkeletalMeshAsset() == BodyMesh)
+			{
+				return Component;
+			}
+		}
+	}
+	return nullptr;
+}
+
+bool FPatternSkinning::TransferProximityWeights(
+	const UE::Geometry::FDynamicMesh3& BodyMesh,
+	const FTransform& GarmentToBody,
+	UE::Geometry::FDynamicMesh3& Garment)
+{
+	using namespace UE::Geometry;
+	using namespace UE::AnimationCore;
+
+	const FDynamicMeshVertexSkinWeightsAttribute* BodyWeights =
+		BodyMesh.HasAttributes() ? BodyMesh.Attributes()->GetSkinWeightsAttribute(SkinProfileName) : nullptr;
+	if (!BodyWeights || BodyMesh.TriangleCount() == 0)
+	{
+		return false;
+	}
+
+	// Built once; queries on a finished tree are read-only and safe to share between workers.
+	FDynamicMeshAABBTree3 BodyTree(&BodyMesh, true);
+
+	TArray<FBoneWeights> VertexWeights;
+	VertexWeights.SetNum(Garment.MaxVertexID());
+
+	ParallelFor(Garment.MaxVertexID(), [&](int32 VertexID)
+	{
+		if (!Garment.IsVertex(VertexID))
+		{
+			return;
+		}
+
+		const FVector3d Pos = GarmentToBody.TransformPosition(Garment.GetVertex(VertexID));
+
+		double NearestDistSq = 0.0;
+		const int32 NearestTri = BodyTree.FindNearestTriangle(Pos, NearestDistSq);
+		if (NearestTri == IndexConstants::InvalidID)
+		{
+			return;
+		}
+
+		// Blend the three corner weights so vertices do not snap between body vertices.
+		const FDistPoint3Triangle3d Query = TMeshQueries<FDynamicMesh3>::TriangleDistance(BodyMesh, NearestTri, Pos);
+		const FVector3d& Bary = Query.TriangleBaryCoords;
+		const FIndex3i Tri = BodyMesh.GetTriangle(NearestTri);
+
+		FBoneWeights A, B, C;
+		BodyWeights->GetValue(Tri.A, A);
+		BodyWeights->GetValue(Tri.B, B);
+		BodyWeights->GetValue(Tri.C, C);
+
+		VertexWeights[VertexID] = FBoneWeights::Blend(A, B, C, (float)Bary.X, (float)Bary.Y, (float)Bary.Z);
+	});
+
+	if (!Garment.HasAttributes())
+	{
+		Garment.EnableAttributes();
+	}
+
+	FDynamicMeshVertexSkinWeightsAttribute* GarmentWeights = new FDynamicMeshVertexSkinWeightsAttribute(&Garment);
+	for (int32 VertexID : Garment.VertexIndicesItr())
+	{
+		GarmentWeights->SetValue(VertexID, VertexWeights[VertexID]);
+	}
+	Garment.Attributes()->AttachSkinWeightsAttribute(SkinProfileName, GarmentWeights);
+
+	UE_LOG(LogTemp, Log, TEXT("[Skinning] Transferred weights to %d vertices"), Garment.VertexCount());
+	return true;
+}
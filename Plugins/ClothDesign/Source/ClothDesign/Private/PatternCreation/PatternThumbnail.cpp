@@ -0,0 +1,234 @@
+#include "PatternCreation/PatternThumbnail.h"
+#include "PatternCreation/PatternCurveFit.h"
+#include "Misc/ObjectThumbnail.h"
+#include "ObjectTools.h"
+
+
+namespace
+{
+	constexpr int32 SubScanlines = 4;        // vertical samples per pixel row
+	constexpr float MarginFraction = 0.08f;  // empty border around the pieces
+	constexpr float FillOpacity = 0.6f;
+
+	// the canvas palette, so a thumbnail looks like the pattern on the canvas
+	const FLinearColor BackgroundColour(0.02f, 0.02f, 0.02f, 1.f);
+	const FLinearColor FillColour(0.26304559f, 0.3405508f, 0.05165f, 1.f);
+	const FLinearColor OutlineColour(0.6059f, 1.f, 0.0f, 1.f);
+
+
+	/** @brief Adds Weight times the covered width of [X0, X1) to each pixel of a row. */
+	void AccumulateSpan(TArray<float>& Row, float X0, float X1, float Weight)
+	{
+		const float Width = static_cast<float>(Row.Num());
+		X0 = FMath::Clamp(X0, 0.f, Width);
+		X1 = FMath::Clamp(X1, 0.f, Width);
+		if (X1 <= X0)
+		{
+			return;
+		}
+
+		const int32 First = FMath::FloorToInt32(X0);
+		const int32 Last = FMath::Min(FMath::FloorToInt32(X1), Row.Num() - 1);
+		if (First == Last)
+		{
+			Row[First] += (X1 - X0) * Weight;
+			return;
+		}
+
+		Row[First] += (First + 1 - X0) * Weight;
+		for (int32 X = First + 1; X < Last; ++X)
+		{
+			Row[X] += Weight;
+		}
+		Row[Last] += (X1 - Last) * Weight;
+	}
+
+
+	/** @brief Even-odd fill of one closed outline; coverage of overlapping pieces is merged with max. */
+	void FillOutline(const TArray<FVector2f>& Outline, int32 Size, TArray<float>& Coverage)
+	{
+		float MinY = TNumericLimits<float>::Max();
+		float MaxY = TNumericLimits<float>::Lowest();
+		for (const FVector2f& P : Outline)
+		{
+			MinY = FMath::Min(MinY, P.Y);
+			MaxY = FMath::Max(MaxY, P.Y);
+		}
+
+		const int32 FirstRow = FMath::Max(0, FMath::FloorToInt32(MinY));
+		const int32 LastRow = FMath::Min(Size - 1, FMath::FloorToInt32(MaxY));
+		const int32 Num = Outline.Num();
+
+		TArray<float> Row;
+		Row.SetNumZeroed(Size);
+		TArray<float> Crossings;
+
+		for (int32 Y = FirstRow; Y <= LastRow; ++Y)
+		{
+			FMemory::Memzero(Row.GetData(), Size * sizeof(float));
+
+			for (int32 Sub = 0; Sub < SubScanlines; ++Sub)
+			{
+				const float SampleY = Y + (Sub + 0.5f) / SubScanlines;
+
+				Crossings.Reset();
+				for (int32 i = 0; i < Num; ++i)
+				{
+					const FVector2f& A = Outline[i];
+					const FVector2f& B = Outline[(i + 1) % Num];
+					if ((A.Y <= SampleY) != (B.Y <= SampleY))
+					{
+						Crossings.Add(A.X + (SampleY - A.Y) / (B.Y - A.Y) * (B.X - A.X));
+					}
+				}
+				Crossings.Sort();
+
+				for (int32 c = 0; c + 1 < Crossings.Num(); c += 2)
+				{
+					AccumulateSpan(Row, Crossings[c], Crossings[c + 1], 1.f / SubScanlines);
+				}
+			}
+
+			float* Dest = &Coverage[Y * Size];
+			for (int32 X = 0; X < Size; ++X)
+			{
+				Dest[X] = FMath::Max(Dest[X], FMath::Min(Row[X], 1.f));
+			}
+		}
+	}
+
+
+	/** @brief Anti-aliased one-pixel line, splatting each step bilinearly onto the pixel centres. */
+	void DrawLine(const FVector2f& A, const FVector2f& B, int32 Size, TArray<float>& Coverage)
+	{
+		const FVector2f Delta = B - A;
+		const int32 Steps = FMath::Max(1, FMath::CeilToInt32(FMath::Max(FMath::Abs(Delta.X), FMath::Abs(Delta.Y))));
+
+		for (int32 Step = 0; Step <= Steps; ++Step)
+		{
+			const FVector2f P = A + Delta * (static_cast<float>(Step) / Steps) - FVector2f(0.5f, 0.5f);
+			const int32 X0 = FMath::FloorToInt32(P.X);
+			const int32 Y0 = FMath::FloorToInt32(P.Y);
+			const float TX = P.X - X0;
+			const float TY = P.Y - Y0;
+
+			const float Weights[2][2] = { { (1 - TX) * (1 - TY), TX * (1 - TY) }, { (1 - TX) * TY, TX * TY } };
+			for (int32 DY = 0; DY < 2; ++DY)
+			{
+				for (int32 DX = 0; DX < 2; ++DX)
+				{
+					const int32 X = X0 + DX;
+					const int32 Y = Y0 + DY;
+					if (X >= 0 && X < Size && Y >= 0 && Y < Size)
+					{
+						// a single step should read as a full-strength line
+						float& C = Coverage[Y * Size + X];
+						C = FMath::Max(C, FMath::Min(1.f, Weights[DY][DX] * 1.6f));
+					}
+				}
+			}
+		}
+	}
+}
+
+
+void FPatternThumbnail::Rasterize(const FLoadedShapeData& Data, int32 Size, TArray<FColor>& OutPixels)
+{
+	OutPixels.Reset();
+	if (Size <= 0)
+	{
+		return;
+	}
+	OutPixels.Init(BackgroundColour.ToFColor(true), Size * Size);
+
+	// sample every piece at its canvas placement
+	TArray<TArray<FVector2f>> Outlines;
+	Outlines.Reserve(Data.CompletedShapes.Num());
+	FBox2D Bounds(ForceInit);
+	TArray<FVector2D> Samples;
+	static const TArray<bool> NoFlags;
+
+	for (int32 ShapeIndex = 0; ShapeIndex < Data.CompletedShapes.Num(); ++ShapeIndex)
+	{
+		const TArray<bool>& Flags = Data.CompletedBezierFlags.IsValidIndex(ShapeIndex) ? Data.CompletedBezierFlags[ShapeIndex] : NoFlags;
+		FPatternCurveFit::SampleOutline(Data.CompletedShapes[ShapeIndex], Flags, Samples);
+		if (Samples.Num() < 3)
+		{
+			continue;
+		}
+
+		const FShapeTransform2D& Transform = FShapeTransform2D::Get(Data.CompletedShapeTransforms, ShapeIndex);
+		TArray<FVector2f>& Outline = Outlines.AddDefaulted_GetRef();
+		Outline.Reserve(Samples.Num());
+		for (const FVector2D& Local : Samples)
+		{
+			const FVector2D Canvas = Transform.TransformPoint(Local);
+			Bounds += Canvas;
+			Outline.Add(FVector2f(Canvas));
+		}
+	}
+
+	const FVector2D Extent = Bounds.bIsValid ? Bounds.GetSize() : FVector2D::ZeroVector;
+	const double LongestSide = FMath::Max(Extent.X, Extent.Y);
+	if (Outlines.Num() == 0 || LongestSide <= UE_KINDA_SMALL_NUMBER)
+	{
+		return;
+	}
+
+	// fit the pieces into the image, centred; canvas and image both have Y pointing down
+	const float Scale = static_cast<float>(Size * (1.0 - 2.0 * MarginFraction) / LongestSide);
+	const FVector2f Centre(Bounds.GetCenter());
+	const FVector2f ImageCentre(Size * 0.5f, Size * 0.5f);
+	for (TArray<FVector2f>& Outline : Outlines)
+	{
+		for (FVector2f& P : Outline)
+		{
+			P = (P - Centre) * Scale + ImageCentre;
+		}
+	}
+
+	TArray<float> Fill;
+	TArray<float> Lines;
+	Fill.SetNumZeroed(Size * Size);
+	Lines.SetNumZeroed(Size * Size);
+	for (const TArray<FVector2f>& Outline : Outlines)
+	{
+		FillOutline(Outline, Size, Fill);
+		for (int32 i = 0; i < Outline.Num(); ++i)
+		{
+			DrawLine(Outline[i], Outline[(i + 1) % Outline.Num()], Size, Lines);
+		}
+	}
+
+	for (int32 i = 0; i < OutPixels.Num(); ++i)
+	{
+		if (Fill[i] <= 0.f && Lines[i] <= 0.f)
+		{
+			continue;
+		}
+		FLinearColor Colour = FMath::Lerp(BackgroundColour, FillColour, Fill[i] * FillOpacity);
+		Colour = FMath::Lerp(Colour, OutlineColour, Lines[i]);
+		Colour.A = 1.f;
+		OutPixels[i] = Colour.ToFColor(true);
+	}
+}
+
+
+void FPatternThumbnail::CacheInPackage(UObject* Asset, const TArray<FColor>& Pixels, int32 Size)
+{
+	check(IsInGameThread());
+	if (!Asset || Size <= 0 || Pixels.Num() != Size * Size)
+	{
+		return;
+	}
+
+	// FObjectThumbnail keeps raw pixels in FColor byte order
+	FObjectThumbnail Thumbnail;
+	Thumbnail.SetImageSize(Size, Size);
+	TArray<uint8>& Bytes = Thumbnail.AccessImageData();
+	Bytes.SetNumUninitialized(Pixels.Num() * sizeof(FColor));
+	FMemory::Memcpy(Bytes.GetData(), Pixels.GetData(), Bytes.Num());
+	Thumbnail.SetCreatedAfterCustomThumbsEnabled();
+
+	ThumbnailTools::CacheThumbnail(Asset->GetFullName(), &Thumbnail, Asset->GetOutermost());
+}
@@ -1,4 +1,5 @@
 #include "PatternMesh.h"
+#include "Serialization/CustomVersion.h"
 
 
 APatternMesh::APatternMesh()
@@ -16,3 +17,263 @@ APatternMesh::APatternMesh()
 	
 }
 
+
+
+/** Versions of the APatternMesh on-disk layout. */
+struct FPatternMeshCustomVersion
+{
+	enum Type
+	{
+		BeforeCustomVersionWasAdded = 0,
+
+		// DynamicMesh is written after the tagged properties
+		PackedDynamicMesh,
+
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	static const FGuid GUID;
+};
+
+const FGuid FPatternMeshCustomVersion::GUID(0x2B7F93C1, 0x6D0A4E25, 0x8F14B3D9, 0xC560A71E);
+
+static FCustomVersionRegistration GRegisterPatternMeshCustomVersion(
+	FPatternMeshCustomVersion::GUID,
+	FPatternMeshCustomVersion::LatestVersion,
+	TEXT("PatternMeshVer"));
+
+
+namespace
+{
+	enum EPackedMeshFlags : uint8
+	{
+		PackedMesh_Quantized      = 1 << 0,
+		PackedMesh_Full           = 1 << 1,   // engine serialisation, for meshes the packed layout cannot hold
+		PackedMesh_TriangleGroups = 1 << 2,
+	};
+
+	constexpr float QuantizeSteps = 65535.f;
+
+	void WriteVarUInt(TArray<uint8>& Out, uint32 Value)
+	{
+		while (Value >= 0x80)
+		{
+			Out.Add(static_cast<uint8>(Value) | 0x80);
+			Value >>= 7;
+		}
+		Out.Add(static_cast<uint8>(Value));
+	}
+
+	bool ReadVarUInt(const TArray<uint8>& In, int32& Cursor, uint32& OutValue)
+	{
+		OutValue = 0;
+		for (int32 Shift = 0; Shift < 35; Shift += 7)
+		{
+			if (!In.IsValidIndex(Cursor))
+			{
+				return false;
+			}
+			const uint8 Byte = In[Cursor++];
+			OutValue |= static_cast<uint32>(Byte & 0x7F) << Shift;
+			if ((Byte & 0x80) == 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// small negative deltas stay small: 0, -1, 1, -2 ... -> 0, 1, 2, 3 ...
+	uint32 ZigZag(int32 Value)   { return (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31); }
+	int32 UnZigZag(uint32 Value) { return static_cast<int32>(Value >> 1) ^ -static_cast<int32>(Value & 1); }
+}
+
+
+void APatternMesh::Serialize(FArchive& Ar)
+{
+	Ar.UsingCustomVersion(FPatternMeshCustomVersion::GUID);
+
+	Super::Serialize(Ar);
+
+	// undo buffers and duplication keep the previous behaviour, only packages carry the mesh
+	if (!Ar.IsPersistent() || Ar.IsTransacting() || Ar.IsObjectReferenceCollector() || Ar.IsCountingMemory())
+	{
+		return;
+	}
+	if (Ar.IsLoading() && Ar.CustomVer(FPatternMeshCustomVersion::GUID) < FPatternMeshCustomVersion::PackedDynamicMesh)
+	{
+		return;
+	}
+
+	SerializePackedMesh(Ar, DynamicMesh, true);
+}
+
+
+void APatternMesh::SerializePackedMesh(FArchive& Ar, UE::Geometry::FDynamicMesh3& Mesh, bool bQuantize)
+{
+	uint8 Flags = 0;
+	if (Ar.IsSaving())
+	{
+		const bool bPackable = Mesh.IsCompact() && !Mesh.HasAttributes()
+			&& !Mesh.HasVertexNormals() && !Mesh.HasVertexColors() && !Mesh.HasVertexUVs();
+		Flags = bPackable ? (bQuantize ? PackedMesh_Quantized : 0) : PackedMesh_Full;
+		if (bPackable && Mesh.HasTriangleGroups())
+		{
+			Flags |= PackedMesh_TriangleGroups;
+		}
+	}
+	Ar << Flags;
+
+	if (Flags & PackedMesh_Full)
+	{
+		Ar << Mesh;
+		return;
+	}
+
+	// positions: float triplets, or 16-bit steps across the bounds
+	int32 NumVerts = Ar.IsSaving() ? Mesh.VertexCount() : 0;
+	Ar << NumVerts;
+
+	FVector3f BoundsMin(0.f), BoundsMax(0.f);
+	TArray<FVector3f> FloatPositions;
+	TArray<uint16> QuantizedPositions;
+
+	if (Ar.IsSaving())
+	{
+		FloatPositions.SetNumUninitialized(NumVerts);
+		for (int32 VID = 0; VID < NumVerts; ++VID)
+		{
+			FloatPositions[VID] = FVector3f(Mesh.GetVertex(VID));
+		}
+		if (Flags & PackedMesh_Quantized)
+		{
+			const FBox3f Bounds(FloatPositions);
+			BoundsMin = Bounds.Min;
+			BoundsMax = Bounds.Max;
+		}
+	}
+
+	if (Flags & PackedMesh_Quantized)
+	{
+		Ar << BoundsMin << BoundsMax;
+		const FVector3f Range = BoundsMax - BoundsMin;
+
+		if (Ar.IsSaving())
+		{
+			QuantizedPositions.SetNumUninitialized(NumVerts * 3);
+			for (int32 VID = 0; VID < NumVerts; ++VID)
+			{
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					const float T = Range[Axis] > 0.f ? (FloatPositions[VID][Axis] - BoundsMin[Axis]) / Range[Axis] : 0.f;
+					QuantizedPositions[VID * 3 + Axis] = static_cast<uint16>(FMath::RoundToInt(FMath::Clamp(T, 0.f, 1.f) * QuantizeSteps));
+				}
+			}
+		}
+
+		QuantizedPositions.BulkSerialize(Ar);
+
+		if (Ar.IsLoading())
+		{
+			if (QuantizedPositions.Num() != NumVerts * 3)
+			{
+				Ar.SetError();
+				return;
+			}
+			FloatPositions.SetNumUninitialized(NumVerts);
+			for (int32 VID = 0; VID < NumVerts; ++VID)
+			{
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					FloatPositions[VID][Axis] = BoundsMin[Axis] + QuantizedPositions[VID * 3 + Axis] / QuantizeSteps * Range[Axis];
+				}
+			}
+		}
+	}
+	else
+	{
+		FloatPositions.BulkSerialize(Ar);
+		if (Ar.IsLoading() && FloatPositions.Num() != NumVerts)
+		{
+			Ar.SetError();
+			return;
+		}
+	}
+
+	// triangles: each index as the zig-zag varint delta from the previous one
+	int32 NumTris = Ar.IsSaving() ? Mesh.TriangleCount() : 0;
+	Ar << NumTris;
+
+	TArray<uint8> EncodedTris;
+	if (Ar.IsSaving())
+	{
+		EncodedTris.Reserve(NumTris * 4);
+		int32 Prev = 0;
+		for (int32 TID = 0; TID < NumTris; ++TID)
+		{
+			const UE::Geometry::FIndex3i Tri = Mesh.GetTriangle(TID);
+			for (int32 j = 0; j < 3; ++j)
+			{
+				WriteVarUInt(EncodedTris, ZigZag(Tri[j] - Prev));
+				Prev = Tri[j];
+			}
+			if (Flags & PackedMesh_TriangleGroups)
+			{
+				WriteVarUInt(EncodedTris, ZigZag(Mesh.GetTriangleGroup(TID)));
+			}
+		}
+	}
+	EncodedTris.BulkSerialize(Ar);
+
+	if (!Ar.IsLoading())
+	{
+		return;
+	}
+
+	UE::Geometry::FDynamicMesh3 Loaded;
+	if (Flags & PackedMesh_TriangleGroups)
+	{
+		Loaded.EnableTriangleGroups();
+	}
+	for (const FVector3f& P : FloatPositions)
+	{
+		Loaded.AppendVertex(FVector3d(P));
+	}
+
+	int32 Cursor = 0;
+	int32 Prev = 0;
+	for (int32 TID = 0; TID < NumTris; ++TID)
+	{
+		UE::Geometry::FIndex3i Tri;
+		int32 Group = 0;
+		uint32 Raw = 0;
+		for (int32 j = 0; j < 3; ++j)
+		{
+			if (!ReadVarUInt(EncodedTris, Cursor, Raw))
+			{
+				Ar.SetError();
+				return;
+			}
+			Tri[j] = Prev + UnZigZag(Raw);
+			Prev = Tri[j];
+		}
+		if (Flags & PackedMesh_TriangleGroups)
+		{
+			if (!ReadVarUInt(EncodedTris, Cursor, Raw))
+			{
+				Ar.SetError();
+				return;
+			}
+			Group = UnZigZag(Raw);
+		}
+		if (!Loaded.IsVertex(Tri.A) || !Loaded.IsVertex(Tri.B) || !Loaded.IsVertex(Tri.C))
+		{
+			Ar.SetError();
+			return;
+		}
+		Loaded.AppendTriangle(Tri, Group);
+	}
+
+	Mesh = MoveTemp(Loaded);
+}
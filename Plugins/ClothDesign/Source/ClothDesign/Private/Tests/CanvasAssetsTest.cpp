@@ -2,6 +2,9 @@
 #include "Misc/AutomationTest.h"
 #include "PatternCreation/PatternAssets.h"
 #include "ClothShapeAsset.h"
+#include "PatternCreation/PatternImport.h"
+#include "PatternCreation/PatternThumbnail.h"
+#include "Serialization/MemoryReader.h"
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveShapeAsset_BadPackage, 
     "CanvasAssets.SaveShapeAsset.BadPackage", 
@@ -111,3 +114,312 @@ bool FAssetManager_Selection::RunTest(const FString& Parameters)
 
     return true;
 }
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBuildAssetArrays_Snapshot, 
+    "CanvasAssets.BuildAssetArrays.Snapshot", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FBuildAssetArrays_Snapshot::RunTest(const FString& Parameters)
+{
+    // the conversion the background saver runs on a worker
+    FLoadedShapeData Snapshot;
+    {
+        FInterpCurve<FVector2D> Shape;
+        Shape.AddPoint(0.f, FVector2D(1, 2));
+        Shape.AddPoint(1.f, FVector2D(3, 4));
+        Snapshot.CompletedShapes.Add(Shape);
+        Snapshot.CompletedShapes.Add(Shape);
+
+        // only the first shape has flags; the second falls back to Bezier
+        TArray<bool> ShapeFlags;
+        ShapeFlags.Add(false);
+        ShapeFlags.Add(false);
+        Snapshot.CompletedBezierFlags.Add(ShapeFlags);
+
+        FShapeTransform2D Moved;
+        Moved.Translation = FVector2D(50, 60);
+        Moved.RotationDegrees = 45.0;
+        Snapshot.CompletedShapeTransforms.Add(FShapeTransform2D());
+        Snapshot.CompletedShapeTransforms.Add(Moved);
+    }
+    Snapshot.CurvePoints.AddPoint(0.f, FVector2D(7, 8));
+
+    TArray<FShapeData> Shapes;
+    TArray<FCurvePointData> CurvePoints;
+    TArray<FSeamData> Seams;
+    FPatternAssets::BuildAssetArrays(Snapshot, Shapes, CurvePoints, Seams);
+
+    TestEqual("Every shape is converted", Shapes.Num(), 2);
+    TestEqual("Working curve is converted", CurvePoints.Num(), 1);
+    if (Shapes.Num() != 2 || CurvePoints.Num() != 1)
+    {
+        return false;
+    }
+
+    TestTrue("Points are copied", Shapes[0].CompletedClothShape[1].Position == FVector2D(3, 4));
+    TestFalse("Recorded flags are kept", Shapes[0].CompletedClothShape[0].bUseBezier);
+    TestTrue("Missing flags default to Bezier", Shapes[1].CompletedClothShape[0].bUseBezier);
+    TestTrue("Translation is kept", Shapes[1].Translation == FVector2D(50, 60));
+    TestEqual("Rotation is kept", Shapes[1].RotationDegrees, 45.0);
+    TestTrue("Working curve flags default to Bezier", CurvePoints[0].bUseBezier);
+
+    return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLoadCanvasState_Seams, 
+    "CanvasAssets.LoadCanvasState.Seams", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FLoadCanvasState_Seams::RunTest(const FString& Parameters)
+{
+    UClothShapeAsset* Asset = NewObject<UClothShapeAsset>();
+
+    // shape 1 is empty and gets dropped on load, so shape 2 becomes shape 1
+    for (int32 s = 0; s < 3; ++s)
+    {
+        FShapeData& Shape = Asset->ClothShapes.AddDefaulted_GetRef();
+        if (s == 1)
+        {
+            continue;
+        }
+        for (int32 i = 0; i < 3; ++i)
+        {
+            FCurvePointData Point;
+            Point.InputKey = i;
+            Point.Position = FVector2D(s * 100 + i, i);
+            Shape.CompletedClothShape.Add(Point);
+        }
+    }
+
+    FSeamData Valid;
+    Valid.ShapeA = 0; Valid.EdgeA = FIntPoint(0, 1);
+    Valid.ShapeB = 2; Valid.EdgeB = FIntPoint(1, 2);
+    Asset->Seams.Add(Valid);
+
+    FSeamData ToEmptyShape = Valid;
+    ToEmptyShape.ShapeB = 1;
+    Asset->Seams.Add(ToEmptyShape);
+
+    FSeamData BadPoint = Valid;
+    BadPoint.EdgeA = FIntPoint(0, 7);
+    Asset->Seams.Add(BadPoint);
+
+    FCanvasState State;
+    TestTrue("Should load state", FPatternAssets::LoadCanvasState(Asset, State));
+    TestEqual("Empty shape is dropped", State.CompletedShapes.Num(), 2);
+    TestEqual("Only the valid seam is loaded", State.SeamDefinitions.Num(), 1);
+    if (State.SeamDefinitions.Num() == 1)
+    {
+        const FSeamDefinition& Def = State.SeamDefinitions[0];
+        TestEqual("Seam keeps its first shape", Def.ShapeA, 0);
+        TestEqual("Seam follows the shifted shape", Def.ShapeB, 1);
+        TestEqual("Edge A start", Def.EdgeA.Start, 0);
+        TestEqual("Edge B end", Def.EdgeB.End, 2);
+    }
+
+    // and the seam survives the conversion back
+    FLoadedShapeData Data;
+    Data.CompletedShapes = State.CompletedShapes;
+    Data.SeamDefinitions = State.SeamDefinitions;
+    TArray<FShapeData> Shapes;
+    TArray<FCurvePointData> CurvePoints;
+    TArray<FSeamData> Seams;
+    FPatternAssets::BuildAssetArrays(Data, Shapes, CurvePoints, Seams);
+    TestEqual("Seam is saved", Seams.Num(), 1);
+    if (Seams.Num() == 1)
+    {
+        TestTrue("Saved edge matches", Seams[0].EdgeB == FIntPoint(1, 2));
+    }
+
+    return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImportPattern_Svg, 
+    "CanvasAssets.ImportPattern.Svg", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FImportPattern_Svg::RunTest(const FString& Parameters)
+{
+    const char* Svg =
+        "<?xml version=\"1.0\"?>\n"
+        "<!-- marker export -->\n"
+        "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"200\" height=\"200\">\n"
+        "  <defs><path d=\"M0 0 L5 0 L5 5 Z\"/></defs>\n"
+        "  <path d=\"M0 0 L100 0 L100 50 C 80 80 20 80 0 50 Z\"/>\n"
+        "  <g transform=\"translate(10 20)\">\n"
+        "    <polygon points=\"0,0 10,0 10,10\"/>\n"
+        "    <polyline points=\"0,0 50,50 60,0\"/>\n"
+        "  </g>\n"
+        "</svg>\n";
+
+    TArray<uint8> Bytes;
+    Bytes.Append(reinterpret_cast<const uint8*>(Svg), FCStringAnsi::Strlen(Svg));
+    FMemoryReader Reader(Bytes);
+
+    FLoadedShapeData Data;
+    FString Error;
+    TestTrue("SVG should import", FPatternImport::ParseSvg(Reader, FPatternImportOptions(), Data, Error));
+    TestEqual("Defs and open polylines are skipped", Data.CompletedShapes.Num(), 2);
+    TestEqual("Every shape gets a placement", Data.CompletedShapeTransforms.Num(), Data.CompletedShapes.Num());
+    if (Data.CompletedShapes.Num() != 2)
+    {
+        return true;
+    }
+
+    // the straight return to the start is the canvas's implicit closing edge
+    const FInterpCurve<FVector2D>& Path = Data.CompletedShapes[0];
+    TestEqual("Closing line is not duplicated", Path.Points.Num(), 4);
+    TestTrue("Line-only points are N-points", !Data.CompletedBezierFlags[0][0] && !Data.CompletedBezierFlags[0][1]);
+    TestTrue("Points on the curve are Bezier points", Data.CompletedBezierFlags[0][2] && Data.CompletedBezierFlags[0][3]);
+    TestTrue("Cubic midpoint is reproduced", Path.Eval(2.5f).Equals(FVector2D(50.0, 72.5), 1e-3));
+    TestTrue("Straight segments stay straight", FMath::IsNearlyEqual(Path.Eval(0.5f).Y, 0.0, 1e-3));
+
+    const FInterpCurve<FVector2D>& Polygon = Data.CompletedShapes[1];
+    TestEqual("Polygon keeps its points", Polygon.Points.Num(), 3);
+    if (Polygon.Points.Num() == 3)
+    {
+        TestTrue("Group transform is applied", Polygon.Points[2].OutVal.Equals(FVector2D(20.0, 30.0)));
+    }
+
+    // after Z, a line-to starts the next subpath at the closed one's start
+    const char* Compound = "<svg><path d=\"M0 0 L10 0 L10 10 Z L-10 10 L-10 0 Z\"/></svg>";
+    TArray<uint8> CompoundBytes;
+    CompoundBytes.Append(reinterpret_cast<const uint8*>(Compound), FCStringAnsi::Strlen(Compound));
+    FMemoryReader CompoundReader(CompoundBytes);
+    FLoadedShapeData CompoundData;
+    TestTrue("Compound path should import", FPatternImport::ParseSvg(CompoundReader, FPatternImportOptions(), CompoundData, Error));
+    TestEqual("Both subpaths become pieces", CompoundData.CompletedShapes.Num(), 2);
+    if (CompoundData.CompletedShapes.Num() == 2)
+    {
+        TestTrue("Second subpath starts at the first one's start", CompoundData.CompletedShapes[1].Points[0].OutVal.Equals(FVector2D::ZeroVector));
+    }
+
+    // the close tolerance is in canvas units: a 0.01 gap closes at scale 1 but not at scale 100
+    const char* Gap = "<svg><polyline points=\"0,0 10,0 10,10 0.01,0\"/></svg>";
+    TArray<uint8> GapBytes;
+    GapBytes.Append(reinterpret_cast<const uint8*>(Gap), FCStringAnsi::Strlen(Gap));
+    FPatternImportOptions GapOptions;
+    GapOptions.CloseTolerance = 0.5;
+    for (const double Scale : { 1.0, 100.0 })
+    {
+        GapOptions.Scale = Scale;
+        FMemoryReader GapReader(GapBytes);
+        FLoadedShapeData GapData;
+        FPatternImport::ParseSvg(GapReader, GapOptions, GapData, Error);
+        TestEqual(*FString::Printf(TEXT("Gap closes only within tolerance at scale %g"), Scale), GapData.CompletedShapes.Num(), Scale == 1.0 ? 1 : 0);
+    }
+
+    return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImportPattern_Dxf, 
+    "CanvasAssets.ImportPattern.Dxf", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FImportPattern_Dxf::RunTest(const FString& Parameters)
+{
+    // millimetres; one piece as a block with an R12 polyline, one drawn directly
+    const char* Dxf =
+        "0\nSECTION\n2\nHEADER\n9\n$INSUNITS\n70\n4\n0\nENDSEC\n"
+        "0\nSECTION\n2\nBLOCKS\n"
+        "0\nBLOCK\n2\nFRONT\n10\n0.0\n20\n0.0\n"
+        "0\nPOLYLINE\n8\n1\n66\n1\n10\n0.0\n20\n0.0\n70\n1\n"
+        "0\nVERTEX\n8\n1\n10\n0.0\n20\n0.0\n"
+        "0\nVERTEX\n8\n1\n10\n100.0\n20\n0.0\n"
+        "0\nVERTEX\n8\n1\n10\n100.0\n20\n200.0\n"
+        "0\nSEQEND\n"
+        "0\nLWPOLYLINE\n8\n8\n90\n2\n70\n0\n10\n10.0\n20\n10.0\n10\n20.0\n20\n20.0\n"
+        "0\nENDBLK\n"
+        "0\nBLOCK\n2\n*Paper_Space\n10\n0.0\n20\n0.0\n"
+        "0\nLWPOLYLINE\n8\n1\n90\n3\n70\n1\n10\n0.0\n20\n0.0\n10\n30.0\n20\n0.0\n10\n30.0\n20\n30.0\n"
+        "0\nENDBLK\n0\nENDSEC\n"
+        "0\nSECTION\n2\nENTITIES\n"
+        "0\nINSERT\n8\n1\n2\nFRONT\n10\n500.0\n20\n0.0\n"
+        "0\nLWPOLYLINE\n8\n1\n90\n4\n70\n1\n"
+        "10\n0.0\n20\n0.0\n10\n50.0\n20\n0.0\n42\n1.0\n10\n50.0\n20\n50.0\n10\n0.0\n20\n50.0\n"
+        "0\nENDSEC\n0\nEOF\n";
+
+    TArray<uint8> Bytes;
+    Bytes.Append(reinterpret_cast<const uint8*>(Dxf), FCStringAnsi::Strlen(Dxf));
+    FMemoryReader Reader(Bytes);
+
+    FLoadedShapeData Data;
+    FString Error;
+    TestTrue("DXF should import", FPatternImport::ParseDxf(Reader, FPatternImportOptions(), Data, Error));
+    TestEqual("Only boundary layer pieces of inserted blocks are imported", Data.CompletedShapes.Num(), 2);
+    if (Data.CompletedShapes.Num() != 2)
+    {
+        return true;
+    }
+
+    // entities come first, then the inserted blocks; millimetres become centimetres, Y flips
+    const FInterpCurve<FVector2D>& Direct = Data.CompletedShapes[0];
+    TestTrue("Direct piece is scaled and flipped", Direct.Points.Last().OutVal.Equals(FVector2D(0.0, -5.0)));
+    TestTrue("Bulged edge becomes Bezier points", Data.CompletedBezierFlags[0].Contains(true));
+
+    // a bulge of 1 is a half circle over the 5 cm edge, reaching 2.5 cm beyond it
+    double MaxX = 0.0;
+    for (int32 i = 0; i < 40; ++i)
+    {
+        MaxX = FMath::Max(MaxX, Direct.Eval(Direct.Points[0].InVal + (Direct.Points.Last().InVal - Direct.Points[0].InVal) * i / 39.f).X);
+    }
+    TestTrue("Arc bulges outwards", FMath::IsNearlyEqual(MaxX, 7.5, 0.05));
+
+    const FInterpCurve<FVector2D>& Inserted = Data.CompletedShapes[1];
+    TestEqual("Block polyline keeps its vertices", Inserted.Points.Num(), 3);
+    if (Inserted.Points.Num() == 3)
+    {
+        TestTrue("Insert offset is applied", Inserted.Points[2].OutVal.Equals(FVector2D(60.0, -20.0)));
+    }
+
+    return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPatternThumbnail_Rasterize, 
+    "CanvasAssets.Thumbnail.Rasterize", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPatternThumbnail_Rasterize::RunTest(const FString& Parameters)
+{
+    const int32 Size = 64;
+
+    // nothing to draw: plain background
+    TArray<FColor> Empty;
+    FPatternThumbnail::Rasterize(FLoadedShapeData(), Size, Empty);
+    TestEqual("Empty image has every pixel", Empty.Num(), Size * Size);
+    TestTrue("Empty image is uniform", !Empty.ContainsByPredicate([&Empty](const FColor& C) { return C != Empty[0]; }));
+
+    // one wide rectangle, moved far from the origin; the thumbnail fits it regardless
+    FLoadedShapeData Data;
+    FInterpCurve<FVector2D>& Shape = Data.CompletedShapes.AddDefaulted_GetRef();
+    const FVector2D Corners[] = { FVector2D(0, 0), FVector2D(200, 0), FVector2D(200, 100), FVector2D(0, 100) };
+    for (const FVector2D& Corner : Corners)
+    {
+        Shape.Points.Add(FInterpCurvePoint<FVector2D>(Shape.Points.Num(), Corner));
+        Shape.Points.Last().InterpMode = CIM_CurveAuto;
+    }
+    Data.CompletedBezierFlags.Add({ false, false, false, false });
+    FShapeTransform2D Transform;
+    Transform.Translation = FVector2D(5000, -3000);
+    Data.CompletedShapeTransforms.Add(Transform);
+
+    TArray<FColor> Pixels;
+    FPatternThumbnail::Rasterize(Data, Size, Pixels);
+    if (!TestEqual("Image has every pixel", Pixels.Num(), Size * Size))
+    {
+        return false;
+    }
+
+    const FColor Background = Empty[0];
+    TestTrue("Centre is inside the piece", Pixels[(Size / 2) * Size + Size / 2] != Background);
+    TestTrue("Top-left corner is outside", Pixels[0] == Background);
+    TestTrue("Above the wide piece is outside", Pixels[4 * Size + Size / 2] == Background);
+    TestTrue("Pixels are opaque", !Pixels.ContainsByPredicate([](const FColor& C) { return C.A != 255; }));
+
+    return true;
+}
@@ -1,6 +1,9 @@
 #include "Misc/AutomationTest.h"
 #include "Canvas/CanvasInputHandler.h"
 #include "ClothDesignCanvas.h"
+#include "Canvas/CanvasSpatialIndex.h"
+#include "PatternCreation/PatternSewing.h"
+#include "PatternMesh.h"
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInputHandler_PanSetsFlag,
     "CanvasInputHandler.PanSetsFlag",
@@ -113,3 +116,145 @@ bool FInputHandler_SelectPoint::RunTest(const FString& Parameters)
     return true;
 }
 
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInputHandler_SelectCompletedViaIndex,
+    "CanvasInputHandler.SelectCompletedViaIndex",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FInputHandler_SelectCompletedViaIndex::RunTest(const FString& Parameters)
+{
+    SClothDesignCanvas TestCanvas;
+    TestCanvas.ZoomFactor = 1.f;
+
+    // two shapes far apart; only the second has a Bezier point with a handle
+    for (int32 s = 0; s < 2; ++s)
+    {
+        FInterpCurve<FVector2D> Shape;
+        Shape.Points.Add(FInterpCurvePoint<FVector2D>(0.f, FVector2D(s * 1000.0, 0.0)));
+        Shape.Points.Add(FInterpCurvePoint<FVector2D>(1.f, FVector2D(s * 1000.0 + 100.0, 0.0)));
+        TestCanvas.CompletedShapes.Add(Shape);
+        TestCanvas.CompletedBezierFlags.Add({ false, s == 1 });
+    }
+    TestCanvas.CompletedShapes[1].Points[1].LeaveTangent = FVector2D(0.0, 200.0);
+
+    FCanvasInputHandler Handler(&TestCanvas);
+
+    Handler.HandleSelect(FVector2D(1102, 1));
+    TestEqual("Nearest completed point is selected", TestCanvas.SelectedShapeIndex, 1);
+    TestEqual("Point index comes from the index", TestCanvas.SelectedPointIndex, 1);
+
+    // moving a point is only seen by the index once the shape is marked dirty
+    TestCanvas.bIsDraggingPoint = false;
+    TestCanvas.CompletedShapes[0].Points[0].OutVal = FVector2D(500.0, 500.0);
+    TestCanvas.HitIndex.MarkShapeDirty(0);
+    Handler.HandleSelect(FVector2D(501, 499));
+    TestEqual("Moved point is found at its new position", TestCanvas.SelectedShapeIndex, 0);
+    TestEqual("Moved point index", TestCanvas.SelectedPointIndex, 0);
+
+    TestCanvas.bIsDraggingPoint = false;
+    Handler.HandleSelect(FVector2D(1100, 195));
+    TestTrue("Handle end starts a tangent drag", TestCanvas.bIsDraggingTangent);
+    TestTrue("Leave handle is picked", TestCanvas.SelectedTangentHandle == SClothDesignCanvas::ETangentHandle::Leave);
+    return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInputHandler_SpatialIndexSeams,
+    "CanvasInputHandler.SpatialIndexSeams",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FInputHandler_SpatialIndexSeams::RunTest(const FString& Parameters)
+{
+    TArray<FInterpCurve<FVector2D>> Shapes;
+    Shapes.AddDefaulted(2);
+    Shapes[0].Points.Add(FInterpCurvePoint<FVector2D>(0.f, FVector2D(0, 0)));
+    Shapes[0].Points.Add(FInterpCurvePoint<FVector2D>(1.f, FVector2D(0, 100)));
+    Shapes[1].Points.Add(FInterpCurvePoint<FVector2D>(0.f, FVector2D(200, 0)));
+    Shapes[1].Points.Add(FInterpCurvePoint<FVector2D>(1.f, FVector2D(200, 100)));
+    TArray<TArray<bool>> Flags = { { false, false }, { false, false } };
+
+    TArray<FSeamDefinition> Seams;
+    Seams.Add({ 0, { 0, 1 }, 1, { 0, 1 } });
+
+    FCanvasSpatialIndex Index;
+    Index.Sync(Shapes, Flags, Seams);
+
+    FCanvasHitItem Hit;
+    float DistSq = 25.f;
+    TestTrue("Click on the start-start line hits the seam", Index.FindNearest(FVector2D(100, 3), { ECanvasHitType::SeamLine }, DistSq, Hit));
+    TestEqual("Seam index", Hit.Index, 0);
+    TestEqual("Start-start line", Hit.SubIndex, 0);
+
+    // moving a sewn shape re-buckets its seam lines as well
+    Shapes[1].Points[1].OutVal = FVector2D(200, 300);
+    Index.MarkShapeDirty(1);
+    Index.Sync(Shapes, Flags, Seams);
+    DistSq = 25.f;
+    TestTrue("End-end line follows the moved point", Index.FindNearest(FVector2D(100, 200), { ECanvasHitType::SeamLine }, DistSq, Hit));
+    TestEqual("End-end line", Hit.SubIndex, 1);
+
+    DistSq = 25.f;
+    TestFalse("Seam queries ignore points and empty cells", Index.FindNearest(FVector2D(0, 150), { ECanvasHitType::SeamLine }, DistSq, Hit));
+    return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInputHandler_DragShape,
+    "CanvasInputHandler.DragShape",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FInputHandler_DragShape::RunTest(const FString& Parameters)
+{
+    SClothDesignCanvas TestCanvas;
+    TestCanvas.ZoomFactor = 1.f;
+    TestCanvas.CurrentMode = SClothDesignCanvas::EClothEditorMode::Select;
+
+    // one closed square, 0..100 on both axes
+    FInterpCurve<FVector2D> Square;
+    const FVector2D Corners[] = { {0, 0}, {100, 0}, {100, 100}, {0, 100} };
+    for (int32 i = 0; i < 4; ++i)
+    {
+        Square.Points.Add(FInterpCurvePoint<FVector2D>(float(i), Corners[i]));
+    }
+    TestCanvas.CompletedShapes.Add(Square);
+    TestCanvas.CompletedBezierFlags.Add({ false, false, false, false });
+
+    FCanvasInputHandler Handler(&TestCanvas);
+    const int32 UndoStepsBefore = TestCanvas.UndoHistory.NumUndoSteps();
+
+    // a click inside the piece picks it up without recording anything
+    Handler.HandleSelect(FVector2D(50, 50));
+    TestTrue("Click inside starts a shape drag", TestCanvas.bIsDraggingShape);
+    TestEqual("Selecting adds no undo step", TestCanvas.UndoHistory.NumUndoSteps(), UndoStepsBefore);
+
+    const FGeometry Geo = FGeometry::MakeRoot(FVector2D(400, 400), FSlateLayoutTransform());
+    TSet<FKey> PressedButtons;
+    PressedButtons.Add(EKeys::LeftMouseButton);
+    const FPointerEvent Move(0, 0, FVector2D(80, 70), FVector2D(50, 50), PressedButtons, EKeys::Invalid, 0.0f, FModifierKeysState());
+
+    TestTrue("Shape drag is handled", TestCanvas.OnMouseMove(Geo, Move).IsEventHandled());
+    TestTrue("Move is coalesced until the next tick", TestCanvas.PendingDragPos.IsSet());
+
+    TestCanvas.ApplyPendingDrag();
+    const FShapeTransform2D& Moved = FShapeTransform2D::Get(TestCanvas.CompletedShapeTransforms, 0);
+    TestEqual("Piece follows the mouse", Moved.Translation, FVector2D(30, 20));
+    TestEqual("Points stay in local space", TestCanvas.CompletedShapes[0].Points[2].OutVal, FVector2D(100, 100));
+    TestEqual("First real move records one undo step", TestCanvas.UndoHistory.NumUndoSteps(), UndoStepsBefore + 1);
+
+    // later moves of the same drag are part of the same step
+    const FPointerEvent SecondMove(0, 0, FVector2D(90, 90), FVector2D(80, 70), PressedButtons, EKeys::Invalid, 0.0f, FModifierKeysState());
+    TestCanvas.OnMouseMove(Geo, SecondMove);
+    TestCanvas.ApplyPendingDrag();
+    TestEqual("One undo step per drag", TestCanvas.UndoHistory.NumUndoSteps(), UndoStepsBefore + 1);
+
+    // an actor that was not built from this shape (here a merged one) stays where it is
+    APatternMesh* Merged = NewObject<APatternMesh>();
+    TestCanvas.SewingManager.SpawnedPatternActors.Add(Merged);
+    const FVector MergedLocation = Merged->GetActorLocation();
+
+    TestTrue("Undo restores the start placement", TestCanvas.UndoLastEdit());
+    TestEqual("Back at the start", FShapeTransform2D::Get(TestCanvas.CompletedShapeTransforms, 0).Translation, FVector2D::ZeroVector);
+    TestTrue("Undo leaves other shapes' actors alone", Merged->GetActorLocation().Equals(MergedLocation));
+    return true;
+}
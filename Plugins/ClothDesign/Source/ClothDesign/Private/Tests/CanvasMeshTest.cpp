@@ -1,5 +1,10 @@
 #include "Misc/AutomationTest.h"
 #include "PatternCreation/MeshTriangulation.h"
+#include "PatternCreation/PatternLiveDeform.h"
+#include "PatternCreation/PatternRetriangulation.h"
+#include "PatternCreation/PatternMeshCache.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
 #include "DynamicMesh/DynamicMesh3.h"
 #include "CoreMinimal.h"
 
@@ -152,3 +157,168 @@ bool FMeshTriangulationBuildAllMeshesTest::RunTest(const FString& Parameters)
 
     return true;
 }
+
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPatternLiveDeformWeightsTest, "CanvasMesh.LiveDeformWeights",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPatternLiveDeformWeightsTest::RunTest(const FString& Parameters)
+{
+    // L-shaped (concave) outline
+    TArray<FVector2f> Poly = { {0,0}, {100,0}, {100,40}, {40,40}, {40,100}, {0,100} };
+    const TArray<FVector2f> Queries = { {20,20}, {70,20}, {20,70}, {100,20}, {40,40} };
+
+    for (const FVector2f& P : Queries)
+    {
+        TArray<float> W;
+        FPatternLiveDeform::ComputeMeanValueWeights(P, Poly, W);
+        TestEqual(TEXT("One weight per boundary sample"), W.Num(), Poly.Num());
+
+        float Sum = 0.f;
+        FVector2f Rebuilt = FVector2f::ZeroVector;
+        FVector2f Moved = FVector2f::ZeroVector;
+        for (int32 i = 0; i < W.Num(); ++i)
+        {
+            Sum += W[i];
+            Rebuilt += Poly[i] * W[i];
+            Moved += (Poly[i] + FVector2f(15.f, -5.f)) * W[i];
+        }
+
+        TestTrue(TEXT("Weights sum to one"), FMath::IsNearlyEqual(Sum, 1.f, 1e-4f));
+        TestTrue(TEXT("Weights reproduce the rest position"), Rebuilt.Equals(P, 1e-2f));
+        TestTrue(TEXT("Translating the outline translates the point"), Moved.Equals(P + FVector2f(15.f, -5.f), 1e-2f));
+    }
+
+    // live deformation uses the same samples as triangulation
+    FInterpCurve<FVector2D> Curve;
+    Curve.AddPoint(0, {0,0});
+    Curve.AddPoint(1, {1,1});
+    Curve.AddPoint(2, {2,0});
+
+    TArray<FVector2f> Samples;
+    FMeshTriangulation::SampleBoundary(Curve, Samples);
+    TestEqual(TEXT("Boundary sample count"), Samples.Num(), 2 * FMeshTriangulation::BoundarySamplesPerSegment);
+
+    return true;
+}
+
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPatternRetriangulationQueueTest, "CanvasMesh.RetriangulationQueue",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPatternRetriangulationQueueTest::RunTest(const FString& Parameters)
+{
+    FInterpCurve<FVector2D> Curve;
+    Curve.AddPoint(0.0f, FVector2D(0, 0));
+    Curve.AddPoint(1.0f, FVector2D(100, 0));
+    Curve.AddPoint(2.0f, FVector2D(100, 100));
+    Curve.AddPoint(3.0f, FVector2D(0, 100));
+
+    // cancelling drops everything immediately
+    {
+        FPatternRetriangulationQueue Queue;
+        Queue.Request(0, Curve, nullptr);
+        TestTrue(TEXT("Busy after a request"), Queue.IsBusy());
+        Queue.CancelAll();
+        TestFalse(TEXT("Idle after cancelling"), Queue.IsBusy());
+    }
+
+    // superseded requests converge; results for a missing actor are dropped, not applied
+    {
+        FPatternRetriangulationQueue Queue;
+        for (int32 i = 0; i < 5; ++i)
+        {
+            Curve.Points[2].OutVal.X = 100.0 + i * 10.0;
+            Queue.Request(0, Curve, nullptr);
+        }
+
+        int32 NumApplied = 0;
+        const double Deadline = FPlatformTime::Seconds() + 10.0;
+        while (Queue.IsBusy() && FPlatformTime::Seconds() < Deadline)
+        {
+            NumApplied += Queue.Tick(0.002);
+            FPlatformProcess::Sleep(0.001f);
+        }
+
+        TestFalse(TEXT("Queue converges"), Queue.IsBusy());
+        TestEqual(TEXT("Nothing applied without an actor"), NumApplied, 0);
+    }
+
+    return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMeshRebuildKeepsSeamTest, "CanvasMesh.RebuildKeepsSeamVertices",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMeshRebuildKeepsSeamTest::RunTest(const FString& Parameters)
+{
+    FInterpCurve<FVector2D> Curve;
+    Curve.AddPoint(0.0f, FVector2D(0, 0));
+    Curve.AddPoint(1.0f, FVector2D(100, 0));
+    Curve.AddPoint(2.0f, FVector2D(100, 100));
+    Curve.AddPoint(3.0f, FVector2D(0, 100));
+
+    APatternMesh* Actor = NewObject<APatternMesh>();
+    TestTrue(TEXT("Initial build"), FMeshTriangulation::RebuildMeshInPlace(Curve, Actor));
+
+    // seam vertices as the sewing would have stored them, plus one that is not on the boundary
+    const TArray<int32> Seam = { Actor->BoundarySampleVertexIDs[0], Actor->BoundarySampleVertexIDs[1] };
+    Actor->LastSeamVertexIDs = Seam;
+    Actor->LastSeamVertexIDs.Add(Actor->DynamicMesh.MaxVertexID() + 10);
+
+    // a drag moves a point; the rebuild records no seam of its own
+    Curve.Points[2].OutVal = FVector2D(120, 110);
+    TestTrue(TEXT("Rebuild after an edit"), FMeshTriangulation::RebuildMeshInPlace(Curve, Actor));
+    TestTrue(TEXT("Seam vertices survive the rebuild"), Actor->LastSeamVertexIDs == Seam);
+
+    return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPatternMeshCacheTest, "CanvasMesh.MeshCache",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPatternMeshCacheTest::RunTest(const FString& Parameters)
+{
+    FInterpCurve<FVector2D> Curve;
+    Curve.AddPoint(0.0f, FVector2D(0, 0));
+    Curve.AddPoint(1.0f, FVector2D(100, 0));
+    Curve.AddPoint(2.0f, FVector2D(100, 100));
+    Curve.AddPoint(3.0f, FVector2D(0, 100));
+
+    // keys follow the inputs that change the mesh
+    const FString Key = FPatternMeshCache::MakeCacheKey(Curve, false, 0, 0);
+    TestEqual(TEXT("Same shape gives the same key"), FPatternMeshCache::MakeCacheKey(Curve, false, 0, 0), Key);
+    TestNotEqual(TEXT("Seam recording changes the key"), FPatternMeshCache::MakeCacheKey(Curve, true, 0, 2), Key);
+
+    FInterpCurve<FVector2D> Moved = Curve;
+    Moved.Points[2].OutVal.X += 0.001;
+    TestNotEqual(TEXT("Moving a point changes the key"), FPatternMeshCache::MakeCacheKey(Moved, false, 0, 0), Key);
+
+    // cached layout round-trips everything the actor needs
+    FPatternMeshData Built;
+    TestTrue(TEXT("Shape triangulates"), FMeshTriangulation::BuildPatternMeshData(Curve, false, 0, 0, Built));
+
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes, true);
+    FPatternMeshCache::SerializeMeshData(Writer, Built);
+
+    FPatternMeshData Loaded;
+    FMemoryReader Reader(Bytes, true);
+    FPatternMeshCache::SerializeMeshData(Reader, Loaded);
+
+    TestFalse(TEXT("Entry reads back"), Reader.IsError());
+    TestEqual(TEXT("Section vertices"), Loaded.Vertices.Num(), Built.Vertices.Num());
+    TestEqual(TEXT("Section indices"), Loaded.Indices, Built.Indices);
+    TestEqual(TEXT("Dynamic mesh vertices"), Loaded.DynamicMesh.VertexCount(), Built.DynamicMesh.VertexCount());
+    TestEqual(TEXT("Dynamic mesh triangles"), Loaded.DynamicMesh.TriangleCount(), Built.DynamicMesh.TriangleCount());
+    TestEqual(TEXT("Poly index map"), Loaded.PolyIndexToVID, Built.PolyIndexToVID);
+    TestEqual(TEXT("Boundary samples"), Loaded.BoundarySamples2D.Num(), Built.BoundarySamples2D.Num());
+    TestEqual(TEXT("Boundary sample IDs"), Loaded.BoundarySampleVIDs, Built.BoundarySampleVIDs);
+    TestTrue(TEXT("Centroid"), Loaded.Centroid.Equals(Built.Centroid));
+
+    return true;
+}
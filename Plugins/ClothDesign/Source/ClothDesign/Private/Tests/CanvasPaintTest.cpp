@@ -3,6 +3,9 @@
 #include "Canvas/CanvasPaint.h"
 #include "ClothDesignCanvas.h"
 #include "Rendering/DrawElements.h"
+#include "Canvas/CanvasShapeCache.h"
+#include "Canvas/CanvasPointBatch.h"
+#include "Canvas/CanvasBackgroundTiles.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
 
@@ -49,3 +52,199 @@ bool FCanvasPaintTest::RunTest(const FString& Parameters)
     return true;
 }
 
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCanvasShapeCacheTest, "CanvasPaintTests.ShapeCache",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCanvasShapeCacheTest::RunTest(const FString& Parameters)
+{
+    FInterpCurve<FVector2D> Shape;
+    Shape.Points.Add(FInterpCurvePoint<FVector2D>(0.f, FVector2D(0, 0), FVector2D::ZeroVector, FVector2D::ZeroVector, CIM_Linear));
+    Shape.Points.Add(FInterpCurvePoint<FVector2D>(1.f, FVector2D(10, 0), FVector2D::ZeroVector, FVector2D::ZeroVector, CIM_Linear));
+    Shape.Points.Add(FInterpCurvePoint<FVector2D>(2.f, FVector2D(10, 10), FVector2D::ZeroVector, FVector2D::ZeroVector, CIM_Linear));
+
+    TArray<FSeamDefinition> Seams;
+    Seams.Add({ 0, { 0, 1 }, 1, { 0, 1 } });
+
+    FCanvasShapeCache Cache;
+    Cache.SetNumShapes(1);
+    const FCanvasCachedShape& Cached = Cache.GetShape(0, Shape, Seams);
+
+    const int32 Samples = FCanvasShapeCache::SamplesPerSegment;
+    TestEqual(TEXT("Closed triangle has three segments"), Cached.NumSegments(), 3);
+    TestEqual(TEXT("Samples are shared between segments"), Cached.Polyline.Num(), 2 * Samples + 2);
+    TestTrue(TEXT("Closing segment returns to the first point"), Cached.Polyline.Last().Equals(FVector2D(0, 0)));
+    TestTrue(TEXT("Bounds cover the shape"), Cached.Bounds.Max.Equals(FVector2D(10, 10)));
+    TestTrue(TEXT("Seam edge is highlighted"), Cached.SewnSegments[0]);
+    TestFalse(TEXT("Other edges are not highlighted"), Cached.SewnSegments[1]);
+
+    // an edit is only picked up once the shape is marked dirty
+    Shape.Points[1].OutVal = FVector2D(20, 0);
+    TestTrue(TEXT("Unmarked edit keeps the cached samples"), Cache.GetShape(0, Shape, Seams).Bounds.Max.Equals(FVector2D(10, 10)));
+    Cache.MarkShapeDirty(0);
+    TestTrue(TEXT("Marked edit re-samples the shape"), Cache.GetShape(0, Shape, Seams).Bounds.Max.Equals(FVector2D(20, 10)));
+
+    // dragging the active shape leaves the cached static layer valid
+    Cache.SetNumShapes(2);
+    Cache.SetActiveShape(0);
+    const uint32 Version = Cache.GetStaticVersion();
+    Cache.MarkShapeDirty(0);
+    TestEqual(TEXT("Active shape edits keep the static version"), Cache.GetStaticVersion(), Version);
+    Cache.MarkShapeDirty(1);
+    TestNotEqual(TEXT("Other shape edits change the static version"), Cache.GetStaticVersion(), Version);
+
+    return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCanvasPaintGridPolylineTest, "CanvasPaintTests.GridPolyline",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCanvasPaintGridPolylineTest::RunTest(const FString& Parameters)
+{
+    const FVector2D Size(100, 100);
+
+    // lines at 0, 50 and 100 on both axes, plus one corner connector
+    TArray<FVector2f> Points;
+    FCanvasPaint::BuildGridPolyline(Size, FVector2D::ZeroVector, FVector2D::UnitVector, 50.f, 0, Points);
+    TestEqual(TEXT("All lines are in one polyline"), Points.Num(), 13);
+
+    // every second line belongs to the coarser level and is skipped
+    Points.Reset();
+    FCanvasPaint::BuildGridPolyline(Size, FVector2D::ZeroVector, FVector2D::UnitVector, 50.f, 2, Points);
+    TestEqual(TEXT("Coarser lines are skipped"), Points.Num(), 5);
+
+    // connectors stay outside the widget
+    for (int32 i = 1; i < Points.Num(); ++i)
+    {
+        const bool bAlongLine = FMath::IsNearlyEqual(Points[i].X, Points[i - 1].X) || FMath::IsNearlyEqual(Points[i].Y, Points[i - 1].Y);
+        TestTrue(TEXT("Polyline only runs along axes"), bAlongLine);
+    }
+
+    return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCanvasPaintCullingTest, "CanvasPaintTests.Culling",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCanvasPaintCullingTest::RunTest(const FString& Parameters)
+{
+    SMockCanvas MockCanvas;
+    MockCanvas.ZoomFactor = 2.f;
+    FCanvasPaint Paint(&MockCanvas);
+
+    const FGeometry Geo = FGeometry::MakeRoot(FVector2f(200.f, 100.f), FSlateLayoutTransform());
+    const FBox2D Visible = Paint.GetVisibleWorldBounds(Geo, 8.f);
+    TestTrue(TEXT("Visible rect starts at the inverse-transformed corner"), Visible.Min.Equals(FVector2D(-4, -4)));
+    TestTrue(TEXT("Visible rect ends at the inverse-transformed corner"), Visible.Max.Equals(FVector2D(104, 54)));
+
+    // one shape inside the view and one far outside
+    TArray<FInterpCurve<FVector2D>> Shapes;
+    Shapes.AddDefaulted(2);
+    Shapes[0].Points.Add(FInterpCurvePoint<FVector2D>(0.f, FVector2D(10, 10)));
+    Shapes[0].Points.Add(FInterpCurvePoint<FVector2D>(1.f, FVector2D(20, 10)));
+    Shapes[1].Points.Add(FInterpCurvePoint<FVector2D>(0.f, FVector2D(500, 500)));
+    Shapes[1].Points.Add(FInterpCurvePoint<FVector2D>(1.f, FVector2D(510, 500)));
+
+    TArray<FSeamDefinition> Seams;
+    Seams.Add({ 1, { 0, 1 }, 1, { 1, 0 } });
+    Seams.Add({ 0, { 0, 1 }, 1, { 0, 1 } });
+
+    FCanvasShapeCache Cache;
+    const TArray<FBox2D>& SeamBounds = Cache.GetSeamBounds(Seams, Shapes);
+    TestFalse(TEXT("Off-screen seam is culled"), SeamBounds[0].Intersect(Visible));
+    TestTrue(TEXT("Seam reaching into the view is kept"), SeamBounds[1].Intersect(Visible));
+
+    TestTrue(TEXT("On-screen shape is kept"), Cache.GetShape(0, Shapes[0], Seams).Bounds.Intersect(Visible));
+    TestFalse(TEXT("Off-screen shape is culled"), Cache.GetShape(1, Shapes[1], Seams).Bounds.Intersect(Visible));
+
+    return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCanvasPointBatchTest, "CanvasPaintTests.PointBatch",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCanvasPointBatchTest::RunTest(const FString& Parameters)
+{
+    // a 2x DPI scale must reach the window-space vertices
+    const FGeometry Geo = FGeometry::MakeRoot(FVector2f(200.f, 100.f), FSlateLayoutTransform(2.f));
+    FCanvasPointBatch Batch(Geo);
+
+    Batch.AddBox(FVector2D(10, 10), 3.f, FLinearColor::White);
+    Batch.AddLine(FVector2D(0, 0), FVector2D(10, 0), 2.f, FLinearColor::White);
+    Batch.AddLine(FVector2D(5, 5), FVector2D(5, 5), 2.f, FLinearColor::White);
+
+    TestEqual(TEXT("Zero-length line is skipped"), Batch.NumQuads(), 2);
+    TestEqual(TEXT("Four vertices per quad"), Batch.GetVertices().Num(), 8);
+    TestEqual(TEXT("Two triangles per quad"), Batch.GetIndices().Num(), 12);
+
+    const FSlateVertex& Corner = Batch.GetVertices()[0];
+    TestTrue(TEXT("Box corner is in window space"), FVector2f(Corner.Position[0], Corner.Position[1]).Equals(FVector2f(14.f, 14.f)));
+
+    const FSlateVertex& LineCorner = Batch.GetVertices()[4];
+    TestTrue(TEXT("Line quad is offset by half its thickness"), FVector2f(LineCorner.Position[0], LineCorner.Position[1]).Equals(FVector2f(0.f, -2.f)));
+
+    return true;
+}
+
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCanvasBackgroundTilesTest, "CanvasPaintTests.BackgroundTiles",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCanvasBackgroundTilesTest::RunTest(const FString& Parameters)
+{
+    using FTiles = FCanvasBackgroundTiles;
+
+    // 2000 x 1000 halves to 1000 x 500, then to 500 x 250, which fits one 512 tile
+    const FIntPoint Source(2000, 1000);
+    TestEqual(TEXT("Levels stop at one tile"), FTiles::GetNumLevels(Source), 3);
+    TestTrue(TEXT("Level size"), FTiles::GetLevelSize(Source, 2) == FIntPoint(500, 250));
+    TestTrue(TEXT("Odd sizes round up"), FTiles::GetLevelSize(FIntPoint(5, 3), 1) == FIntPoint(3, 2));
+    TestEqual(TEXT("A small image is its own last level"), FTiles::GetNumLevels(FIntPoint(300, 200)), 1);
+
+    // about one texel per screen pixel
+    TestEqual(TEXT("Full resolution when zoomed in"), FTiles::SelectLevel(4.0, 3), 0);
+    TestEqual(TEXT("Full resolution at 1:1"), FTiles::SelectLevel(1.0, 3), 0);
+    TestEqual(TEXT("Half resolution at 1:2"), FTiles::SelectLevel(0.5, 3), 1);
+    TestEqual(TEXT("Never coarser than needed"), FTiles::SelectLevel(0.3, 3), 1);
+    TestEqual(TEXT("Clamped to the coarsest level"), FTiles::SelectLevel(0.01, 3), 2);
+
+    // 2000 x 1000 grey levels take 2,000,000 + 500,000 + 125,000 bytes
+    TestEqual(TEXT("Whole pyramid within budget"), FTiles::GetFinestLevelInBudget(Source, 1, 2625000), 0);
+    TestEqual(TEXT("Full resolution dropped when over budget"), FTiles::GetFinestLevelInBudget(Source, 1, 1000000), 1);
+    TestEqual(TEXT("Four bytes per BGRA texel"), FTiles::GetFinestLevelInBudget(Source, 4, 2625000), 1);
+    TestEqual(TEXT("Coarsest level always kept"), FTiles::GetFinestLevelInBudget(Source, 1, 0), 2);
+
+    // only tiles under the view are requested
+    const FIntRect Visible = FTiles::GetVisibleTiles(Source, 0, FBox2D(FVector2D(600, 100), FVector2D(1100, 400)));
+    TestTrue(TEXT("Visible tile range"), Visible == FIntRect(1, 0, 3, 1));
+    TestTrue(TEXT("Level 1 has two tiles"), FTiles::GetVisibleTiles(Source, 1, FBox2D(FVector2D(-50, -50), FVector2D(5000, 5000))) == FIntRect(0, 0, 2, 1));
+    TestTrue(TEXT("Nothing when the image is off screen"), FTiles::GetVisibleTiles(Source, 0, FBox2D(FVector2D(3000, 0), FVector2D(4000, 500))).Area() == 0);
+
+    // the last tile of a level is clipped to the image
+    const FBox2D Edge = FTiles::GetTileSourceRect(Source, { 1, 1, 0 });
+    TestTrue(TEXT("Tile rect in source texels"), Edge.Min.Equals(FVector2D(1024, 0)) && Edge.Max.Equals(FVector2D(2000, 1000)));
+
+    // 2 x 2 box filter, repeating the last column of an odd width
+    FImage Grey(3, 2, ERawImageFormat::G8);
+    const uint8 Values[] = { 0, 100, 200, 40, 60, 200 };
+    FMemory::Memcpy(Grey.RawData.GetData(), Values, sizeof(Values));
+    FImage Half;
+    FTiles::DownsampleLevel(Grey, Half);
+    TestTrue(TEXT("Downsampled size"), Half.SizeX == 2 && Half.SizeY == 1);
+    TestEqual(TEXT("Box filter average"), int32(Half.RawData[0]), 50);
+    TestEqual(TEXT("Edge texel repeats"), int32(Half.RawData[1]), 200);
+
+    // grey tiles are expanded to opaque BGRA
+    const FTiles::FTilePixels Tile = FTiles::CopyTile(Grey, 0, 0);
+    TestTrue(TEXT("Tile is clipped to the level"), Tile.Size == FIntPoint(3, 2));
+    TestEqual(TEXT("Four bytes per pixel"), Tile.Bytes.Num(), 3 * 2 * 4);
+    TestTrue(TEXT("Grey replicated into colour channels"), Tile.Bytes[4] == 100 && Tile.Bytes[5] == 100 && Tile.Bytes[6] == 100 && Tile.Bytes[7] == 255);
+    TestEqual(TEXT("Tiles past the image are empty"), FTiles::CopyTile(Grey, 1, 0).Bytes.Num(), 0);
+
+    return true;
+}
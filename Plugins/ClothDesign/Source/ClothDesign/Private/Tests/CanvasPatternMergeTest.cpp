@@ -1,4 +1,5 @@
 #include "Misc/AutomationTest.h"
+#include "PatternCreation/PatternSewing.h"
 #include "PatternCreation/PatternMerge.h"
 #include "PatternMesh.h"
 #include "PatternSewingConstraint.h"
@@ -171,3 +172,54 @@ bool FFPatternMergeRealisticTest::RunTest(const FString& Parameters)
 
     return true;
 }
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFPatternMergePreviewTest,
+    "CanvasPatternMerge.PreviewLeavesArraysUntouched",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFPatternMergePreviewTest::RunTest(const FString& Parameters)
+{
+    FPatternMerge::TestActors.Empty();
+    FPatternMerge::TestSeams.Empty();
+
+    TWeakObjectPtr<APatternMesh> Actor1 = NewObject<APatternMesh>();
+    TWeakObjectPtr<APatternMesh> Actor2 = NewObject<APatternMesh>();
+    FPatternMerge::TestActors.Add(Actor1);
+    FPatternMerge::TestActors.Add(Actor2);
+
+    FPatternSewingConstraint Seam;
+    Seam.MeshA = Actor1->MeshComponent;
+    Seam.MeshB = Actor2->MeshComponent;
+    FPatternMerge::TestSeams.Add(Seam);
+
+    FPatternMerge PatternMerge;
+    FPatternMergePreview Preview;
+    PatternMerge.BuildMergePreview(Preview, false);
+
+    TestEqual(TEXT("Preview should not remove actors"), FPatternMerge::TestActors.Num(), 2);
+    TestEqual(TEXT("Preview should not remove seams"), FPatternMerge::TestSeams.Num(), 1);
+    TestFalse(TEXT("Empty meshes should produce no preview results"), Preview.IsActive());
+    TestFalse(TEXT("No preview actor should be spawned"), Preview.PreviewActor.IsValid());
+
+    PatternMerge.CommitMergePreview(Preview);
+    TestEqual(TEXT("Committing an empty preview keeps actors"), FPatternMerge::TestActors.Num(), 2);
+
+    // scans for pattern pieces must be able to tell the preview apart
+    APatternMesh* PreviewLike = NewObject<APatternMesh>();
+    PreviewLike->Tags.Add(FPatternMergePreview::PreviewActorTag);
+    TestTrue(TEXT("Tagged actor is a preview"), FPatternMergePreview::IsPreviewActor(PreviewLike));
+    TestFalse(TEXT("Pattern pieces are not previews"), FPatternMergePreview::IsPreviewActor(Actor1.Get()));
+    TestFalse(TEXT("Null is not a preview"), FPatternMergePreview::IsPreviewActor(nullptr));
+
+    // a preview still held by the sewing manager is discarded with it
+    Actor1->SetIsTemporarilyHiddenInEditor(true);
+    {
+        FPatternSewing Sewing;
+        Sewing.MergePreview.Results.AddDefaulted();
+        Sewing.MergePreview.Results[0].SourceActors.Add(Actor1);
+    }
+    TestFalse(TEXT("Source pieces are shown again"), Actor1->IsTemporarilyHiddenInEditor());
+
+    return true;
+}
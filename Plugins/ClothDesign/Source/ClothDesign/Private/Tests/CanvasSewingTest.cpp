@@ -46,6 +46,51 @@ bool FPatternSewing_FinaliseSeamDefinition_Test::RunTest(const FString& Paramete
 
 
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPatternSewing_RebindSeamConstraints_Test,
+	"CanvasSewing.RebindSeamConstraints",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPatternSewing_RebindSeamConstraints_Test::RunTest(const FString& Parameters)
+{
+	FPatternSewing Sewing;
+
+	FInterpCurve<FVector2D> Curve;
+	Curve.Points.Add(FInterpCurvePoint(0.f, FVector2D(0,0)));
+	Curve.Points.Add(FInterpCurvePoint(1.f, FVector2D(10,10)));
+
+	TArray<FInterpCurve<FVector2D>> CompletedShapes;
+	CompletedShapes.Add(Curve);
+	CompletedShapes.Add(Curve);
+	CompletedShapes.Add(Curve);
+
+	// shapes 0 and 1 have meshes, shape 2 does not
+	Sewing.SpawnedPatternActors.Add(NewObject<APatternMesh>());
+	Sewing.SpawnedPatternActors.Add(NewObject<APatternMesh>());
+
+	FSeamDefinition Bound;
+	Bound.ShapeA = 0; Bound.EdgeA = { 0, 1 };
+	Bound.ShapeB = 1; Bound.EdgeB = { 0, 1 };
+	Sewing.SeamDefinitions.Add(Bound);
+
+	FSeamDefinition Unbound = Bound;
+	Unbound.ShapeB = 2;
+	Sewing.SeamDefinitions.Add(Unbound);
+
+	// stale constraints from a previous pattern are replaced
+	Sewing.AllDefinedSeams.AddDefaulted(5);
+
+	const int32 NumBound = Sewing.RebindSeamConstraints(CompletedShapes);
+
+	TestEqual(TEXT("Only the seam with both meshes is bound"), NumBound, 1);
+	TestEqual(TEXT("One constraint per definition"), Sewing.AllDefinedSeams.Num(), 2);
+	TestTrue(TEXT("Bound seam points at shape 0's mesh"), Sewing.AllDefinedSeams[0].MeshA == Sewing.SpawnedPatternActors[0]->MeshComponent);
+	TestEqual(TEXT("Bound seam has screen points"), Sewing.AllDefinedSeams[0].ScreenPointsB.Num(), 10);
+	TestNull(TEXT("Seam without a mesh stays unbound"), Sewing.AllDefinedSeams[1].MeshB);
+
+	return true;
+}
+
+
 
 #if WITH_DEV_AUTOMATION_TESTS
 
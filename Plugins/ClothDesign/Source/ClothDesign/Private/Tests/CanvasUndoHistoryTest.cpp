@@ -0,0 +1,199 @@
+#include "Misc/AutomationTest.h"
+#include "Canvas/CanvasUndoHistory.h"
+
+namespace
+{
+    /** Small stand-in for the canvas data the history operates on. */
+    struct FUndoTestCanvas
+    {
+        FInterpCurve<FVector2D> CurvePoints;
+        TArray<bool> bUseBezierPerPoint;
+        TArray<FInterpCurve<FVector2D>> CompletedShapes;
+        TArray<TArray<bool>> CompletedBezierFlags;
+        TArray<FShapeTransform2D> CompletedShapeTransforms;
+        FPatternSewing Sewing;
+        FVector2D PanOffset = FVector2D::ZeroVector;
+        float ZoomFactor = 1.f;
+        int32 SelectedSeamIndex = INDEX_NONE;
+
+        FCanvasUndoTarget Target()
+        {
+            return { CurvePoints, bUseBezierPerPoint, CompletedShapes, CompletedBezierFlags,
+                CompletedShapeTransforms, Sewing, PanOffset, ZoomFactor, SelectedSeamIndex };
+        }
+
+        void AddPoint(FInterpCurve<FVector2D>& Curve, const FVector2D& Pos)
+        {
+            Curve.Points.Add(FInterpCurvePoint<FVector2D>(Curve.Points.Num(), Pos));
+        }
+
+        void FinaliseShape()
+        {
+            CompletedShapes.Add(CurvePoints);
+            CompletedBezierFlags.Add(bUseBezierPerPoint);
+            CompletedShapeTransforms.AddDefaulted();
+            CurvePoints.Points.Empty();
+            bUseBezierPerPoint.Empty();
+        }
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCanvasUndoHistoryShapeEditTest,
+    "CanvasUndoHistory.ShapeEditUndoRedo",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCanvasUndoHistoryShapeEditTest::RunTest(const FString& Parameters)
+{
+    FUndoTestCanvas Canvas;
+    FCanvasUndoHistory History;
+
+    for (int32 s = 0; s < 3; ++s)
+    {
+        Canvas.AddPoint(Canvas.CurvePoints, FVector2D(s, 0));
+        Canvas.bUseBezierPerPoint.Add(false);
+        Canvas.FinaliseShape();
+    }
+
+    // move a point on the middle shape
+    FCanvasUndoDelta Delta = FCanvasUndoHistory::Capture(Canvas.Target(), ECanvasUndoScope::Shape, 1);
+    TestEqual(TEXT("Only the edited shape is recorded"), Delta.Shapes.Num(), 1);
+    History.Record(MoveTemp(Delta));
+    Canvas.CompletedShapes[1].Points[0].OutVal = FVector2D(50, 50);
+
+    TArray<int32> EditedShapes;
+    TestTrue(TEXT("Undo should succeed"), History.Undo(Canvas.Target(), &EditedShapes));
+    TestTrue(TEXT("Undo reports only the edited shape"), EditedShapes == TArray<int32>{ 1 });
+    TestTrue(TEXT("Point restored by undo"), Canvas.CompletedShapes[1].Points[0].OutVal.Equals(FVector2D(1, 0)));
+    TestTrue(TEXT("Other shapes untouched"), Canvas.CompletedShapes[2].Points[0].OutVal.Equals(FVector2D(2, 0)));
+    TestEqual(TEXT("Redo stack should have 1 item"), History.NumRedoSteps(), 1);
+    TestTrue(TEXT("Redo step keeps its scope"), History.GetNextRedoScope() == ECanvasUndoScope::Shape);
+    TestTrue(TEXT("Nothing left to undo"), History.GetNextUndoScope() == ECanvasUndoScope::None);
+
+    TestTrue(TEXT("Redo should succeed"), History.Redo(Canvas.Target()));
+    TestTrue(TEXT("Point reapplied by redo"), Canvas.CompletedShapes[1].Points[0].OutVal.Equals(FVector2D(50, 50)));
+    TestEqual(TEXT("Undo stack should have 1 item again"), History.NumUndoSteps(), 1);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCanvasUndoHistoryShapeMoveTest,
+    "CanvasUndoHistory.ShapeMoveUndoRedo",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCanvasUndoHistoryShapeMoveTest::RunTest(const FString& Parameters)
+{
+    FUndoTestCanvas Canvas;
+    FCanvasUndoHistory History;
+
+    Canvas.AddPoint(Canvas.CurvePoints, FVector2D(10, 0));
+    Canvas.bUseBezierPerPoint.Add(false);
+    Canvas.FinaliseShape();
+
+    // moving the whole shape records only its transform
+    FCanvasUndoDelta Delta = FCanvasUndoHistory::Capture(Canvas.Target(), ECanvasUndoScope::ShapeMove, 0);
+    TestEqual(TEXT("Move records no shape points"), Delta.Shapes.Num(), 0);
+    History.Record(MoveTemp(Delta));
+
+    FShapeTransform2D& Transform = Canvas.CompletedShapeTransforms[0];
+    Transform.Translation = FVector2D(100, 0);
+    Transform.RotateAbout(FVector2D(110, 0), 90.0);
+    TestTrue(TEXT("Rotation keeps the pivot in place"), Transform.TransformPoint(FVector2D(10, 0)).Equals(FVector2D(110, 0)));
+    TestTrue(TEXT("Inverse maps back to local"),
+        Transform.InverseTransformPoint(Transform.TransformPoint(FVector2D(3, 4))).Equals(FVector2D(3, 4)));
+    TestTrue(TEXT("Local points are untouched"), Canvas.CompletedShapes[0].Points[0].OutVal.Equals(FVector2D(10, 0)));
+
+    TArray<int32> EditedShapes;
+    TestTrue(TEXT("Undo should succeed"), History.Undo(Canvas.Target(), &EditedShapes));
+    TestTrue(TEXT("Undo restores the placement"), Canvas.CompletedShapeTransforms[0].IsIdentity());
+    TestEqual(TEXT("A move changes no shape geometry"), EditedShapes.Num(), 0);
+
+    TestTrue(TEXT("Redo should succeed"), History.Redo(Canvas.Target(), &EditedShapes));
+    TestEqual(TEXT("Redoing a move changes no shape geometry"), EditedShapes.Num(), 0);
+    TestTrue(TEXT("Redo reapplies the placement"),
+        Canvas.CompletedShapeTransforms[0].TransformPoint(FVector2D(10, 0)).Equals(FVector2D(110, 0)));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCanvasUndoHistoryShapeCountTest,
+    "CanvasUndoHistory.FinaliseAndClearUndoRedo",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCanvasUndoHistoryShapeCountTest::RunTest(const FString& Parameters)
+{
+    FUndoTestCanvas Canvas;
+    FCanvasUndoHistory History;
+
+    // finalise one shape
+    Canvas.AddPoint(Canvas.CurvePoints, FVector2D(1, 2));
+    Canvas.AddPoint(Canvas.CurvePoints, FVector2D(3, 4));
+    Canvas.bUseBezierPerPoint = { false, true };
+    History.Record(FCanvasUndoHistory::Capture(Canvas.Target(), ECanvasUndoScope::CurrentCurve | ECanvasUndoScope::ShapeCount));
+    Canvas.FinaliseShape();
+
+    TestTrue(TEXT("Undo finalise"), History.Undo(Canvas.Target()));
+    TestEqual(TEXT("Shape removed"), Canvas.CompletedShapes.Num(), 0);
+    TestEqual(TEXT("Current curve restored"), Canvas.CurvePoints.Points.Num(), 2);
+    TestEqual(TEXT("Bezier flags restored"), Canvas.bUseBezierPerPoint.Num(), 2);
+
+    TestTrue(TEXT("Redo finalise"), History.Redo(Canvas.Target()));
+    TestEqual(TEXT("Shape added back"), Canvas.CompletedShapes.Num(), 1);
+    TestTrue(TEXT("Shape content restored"), Canvas.CompletedShapes[0].Points[1].OutVal.Equals(FVector2D(3, 4)));
+    TestEqual(TEXT("Shape flags restored"), Canvas.CompletedBezierFlags[0].Num(), 2);
+    TestEqual(TEXT("Current curve emptied"), Canvas.CurvePoints.Points.Num(), 0);
+
+    // clearing the canvas is undoable too
+    Canvas.Sewing.SeamDefinitions.Add({ 0, { 0, 1 }, 0, { 1, 0 } });
+    History.Record(FCanvasUndoHistory::Capture(Canvas.Target(),
+        ECanvasUndoScope::CurrentCurve | ECanvasUndoScope::AllShapes | ECanvasUndoScope::Seams));
+    Canvas.CompletedShapes.Empty();
+    Canvas.CompletedBezierFlags.Empty();
+    Canvas.Sewing.SeamDefinitions.Empty();
+
+    TestTrue(TEXT("Undo clear"), History.Undo(Canvas.Target()));
+    TestEqual(TEXT("Shapes restored after clear"), Canvas.CompletedShapes.Num(), 1);
+    TestEqual(TEXT("Seams restored after clear"), Canvas.Sewing.SeamDefinitions.Num(), 1);
+
+    TestTrue(TEXT("Redo clear"), History.Redo(Canvas.Target()));
+    TestEqual(TEXT("Shapes cleared again"), Canvas.CompletedShapes.Num(), 0);
+    TestEqual(TEXT("Seams cleared again"), Canvas.Sewing.SeamDefinitions.Num(), 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCanvasUndoHistoryMemoryCapTest,
+    "CanvasUndoHistory.MemoryCap",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCanvasUndoHistoryMemoryCapTest::RunTest(const FString& Parameters)
+{
+    FUndoTestCanvas Canvas;
+    FCanvasUndoHistory History;
+
+    for (int32 i = 0; i < 256; ++i)
+    {
+        Canvas.AddPoint(Canvas.CurvePoints, FVector2D(i, i));
+        Canvas.bUseBezierPerPoint.Add(false);
+    }
+
+    const SIZE_T StepSize = FCanvasUndoHistory::Capture(Canvas.Target(), ECanvasUndoScope::CurrentCurve).GetAllocatedSize();
+    History.SetMaxMemoryBytes(StepSize * 4);
+
+    for (int32 i = 0; i < 10; ++i)
+    {
+        History.Record(FCanvasUndoHistory::Capture(Canvas.Target(), ECanvasUndoScope::CurrentCurve));
+    }
+
+    TestTrue(TEXT("Oldest steps dropped"), History.NumUndoSteps() <= 4);
+    TestTrue(TEXT("History within its cap"), History.GetUsedMemoryBytes() <= History.GetMaxMemoryBytes());
+
+    // a cap smaller than one step still keeps the newest step
+    History.SetMaxMemoryBytes(1);
+    TestEqual(TEXT("Newest step is kept"), History.NumUndoSteps(), 1);
+
+    History.Reset();
+    TestEqual(TEXT("Reset empties undo"), History.NumUndoSteps(), 0);
+    TestTrue(TEXT("Reset frees memory"), History.GetUsedMemoryBytes() == 0);
+
+    return true;
+}
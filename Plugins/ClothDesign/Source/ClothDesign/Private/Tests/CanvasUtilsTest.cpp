@@ -2,44 +2,6 @@
 #include "Canvas/CanvasUtils.h"
 #include "DynamicMesh/DynamicMesh3.h"
 
-IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCanvasUtilsUndoRedoTest, 
-    "CanvasUtils.UndoRedo", 
-    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
-
-bool FCanvasUtilsUndoRedoTest::RunTest(const FString& Parameters)
-{
-    TArray<FCanvasState> UndoStack;
-    TArray<FCanvasState> RedoStack;
-    FCanvasState Current;
-
-    Current.SelectedPointIndex = 5;
-    Current.ZoomFactor = 1.5f;
-    Current.PanOffset = FVector2D(10, 20);
-
-    // save state
-    FCanvasUtils::SaveStateForUndo(UndoStack, RedoStack, Current);
-
-    TestEqual(TEXT("Undo stack should have 1 item"), UndoStack.Num(), 1);
-    TestEqual(TEXT("Redo stack should be empty"), RedoStack.Num(), 0);
-
-    // change current state
-    Current.SelectedPointIndex = 7;
-
-    // undo
-    bool bUndid = FCanvasUtils::Undo(UndoStack, RedoStack, Current);
-    TestTrue(TEXT("Undo should succeed"), bUndid);
-    TestEqual(TEXT("Current state restored SelectedPointIndex"), Current.SelectedPointIndex, 5);
-    TestEqual(TEXT("Redo stack should have 1 item"), RedoStack.Num(), 1);
-
-    // redo
-    bool bRedid = FCanvasUtils::Redo(UndoStack, RedoStack, Current);
-    TestTrue(TEXT("Redo should succeed"), bRedid);
-    TestEqual(TEXT("Current state restored SelectedPointIndex after redo"), Current.SelectedPointIndex, 7);
-    TestEqual(TEXT("Undo stack should have 1 item again"), UndoStack.Num(), 1);
-
-    return true;
-}
-
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCanvasUtilsRecalculateTangentsTest, 
     "CanvasUtils.RecalculateNTangents", 
     EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
@@ -77,6 +39,49 @@ bool FCanvasUtilsRecalculateTangentsTest::RunTest(const FString& Parameters)
 }
 
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCanvasUtilsRecalculateTangentsAroundTest, 
+    "CanvasUtils.RecalculateNTangentsAround", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCanvasUtilsRecalculateTangentsAroundTest::RunTest(const FString& Parameters)
+{
+    FInterpCurve<FVector2D> Curve;
+    TArray<bool> bBezierFlags;
+    for (int32 i = 0; i < 8; ++i)
+    {
+        Curve.Points.Add(FInterpCurvePoint<FVector2D>(i, FVector2D(i * 10.0, (i % 2) * 5.0),
+            FVector2D::ZeroVector, FVector2D::ZeroVector, CIM_CurveUser));
+    }
+    bBezierFlags.Init(false, 8);
+    bBezierFlags[5] = true; // Bezier neighbour keeps its own tangents
+
+    FCanvasUtils::RecalculateNTangents(Curve, bBezierFlags);
+    const FVector2D BezierLeave(3, 3);
+    Curve.Points[5].LeaveTangent = BezierLeave;
+
+    // move one point and update only around it
+    Curve.Points[4].OutVal = FVector2D(42, -7);
+    FInterpCurve<FVector2D> Expected = Curve;
+    FCanvasUtils::RecalculateNTangentsAround(Curve, bBezierFlags, 4);
+    FCanvasUtils::RecalculateNTangents(Expected, bBezierFlags);
+
+    for (int32 i = 0; i < 8; ++i)
+    {
+        TestTrue(FString::Printf(TEXT("Point %d arrive matches full update"), i), Curve.Points[i].ArriveTangent.Equals(Expected.Points[i].ArriveTangent));
+        TestTrue(FString::Printf(TEXT("Point %d leave matches full update"), i), Curve.Points[i].LeaveTangent.Equals(Expected.Points[i].LeaveTangent));
+    }
+    TestTrue(TEXT("Bezier point is left alone"), Curve.Points[5].LeaveTangent.Equals(BezierLeave));
+
+    // end points clamp to the curve
+    Curve.Points[0].OutVal = FVector2D(-5, 0);
+    FCanvasUtils::RecalculateNTangentsAround(Curve, bBezierFlags, 0);
+    TestTrue(TEXT("First point keeps a zero arrive tangent"), Curve.Points[0].ArriveTangent.IsNearlyZero());
+    TestTrue(TEXT("Neighbour of the first point is updated"), Curve.Points[1].ArriveTangent.Equals((Curve.Points[1].OutVal - Curve.Points[0].OutVal) * 0.5f));
+
+    return true;
+}
+
+
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCanvasUtilsCentroidAndTranslateTest,
     "CanvasUtils.MeshCentroidTranslate",
     EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
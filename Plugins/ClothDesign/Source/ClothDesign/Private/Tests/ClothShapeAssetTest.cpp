@@ -1,5 +1,8 @@
 #include "Misc/AutomationTest.h"
 #include "ClothShapeAsset.h" // adjust include path
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
 
 // test defaults for FCurvePointData 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCurvePointData_DefaultsTest, 
@@ -68,3 +71,125 @@ bool UClothShapeAsset_AddDataTest::RunTest(const FString& Parameters)
 
     return true;
 }
+
+namespace
+{
+    UClothShapeAsset* MakePackedTestAsset(bool bQuantize)
+    {
+        UClothShapeAsset* Asset = NewObject<UClothShapeAsset>();
+        Asset->bQuantizePoints = bQuantize;
+
+        for (int32 s = 0; s < 2; ++s)
+        {
+            FShapeData Shape;
+            for (int32 i = 0; i < 5; ++i)
+            {
+                FCurvePointData Point;
+                Point.InputKey = i;
+                Point.Position = FVector2D(100.123456789 * s + i, 3.25 * i);
+                Point.ArriveTangent = FVector2D(-1.5, i);
+                Point.LeaveTangent = FVector2D(1.5, -i);
+                Point.bUseBezier = (i % 2) == 0;
+                Shape.CompletedClothShape.Add(Point);
+            }
+            Shape.Translation = FVector2D(10.0 * s, -5.0);
+            Shape.RotationDegrees = 30.0 * s;
+            Asset->ClothShapes.Add(Shape);
+        }
+
+        FCurvePointData Working;
+        Working.Position = FVector2D(7.0, 8.0);
+        Working.bUseBezier = true;
+        Asset->ClothCurvePoints.Add(Working);
+        return Asset;
+    }
+
+    UClothShapeAsset* RoundTrip(UClothShapeAsset* Source, bool bPersistent, int32& OutNumBytes)
+    {
+        TArray<uint8> Bytes;
+        FMemoryWriter Writer(Bytes, bPersistent);
+        FObjectAndNameAsStringProxyArchive WriteAr(Writer, false);
+        Source->Serialize(WriteAr);
+        OutNumBytes = Bytes.Num();
+
+        UClothShapeAsset* Loaded = NewObject<UClothShapeAsset>();
+        FMemoryReader Reader(Bytes, bPersistent);
+        Reader.SetCustomVersions(Writer.GetCustomVersions());
+        FObjectAndNameAsStringProxyArchive ReadAr(Reader, false);
+        Loaded->Serialize(ReadAr);
+        return Loaded;
+    }
+}
+
+// packed columns reproduce the shapes exactly at full precision
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(UClothShapeAsset_PackedRoundTripTest, 
+    "ClothShapeAsset.UClothShapeAsset.PackedRoundTrip", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool UClothShapeAsset_PackedRoundTripTest::RunTest(const FString& Parameters)
+{
+    UClothShapeAsset* Source = MakePackedTestAsset(false);
+
+    int32 PackedBytes = 0;
+    UClothShapeAsset* Loaded = RoundTrip(Source, true, PackedBytes);
+
+    TestEqual(TEXT("Shape count survives"), Loaded->ClothShapes.Num(), 2);
+    TestEqual(TEXT("Working curve survives"), Loaded->ClothCurvePoints.Num(), 1);
+    if (Loaded->ClothShapes.Num() != 2 || Loaded->ClothCurvePoints.Num() != 1)
+    {
+        return false;
+    }
+
+    for (int32 s = 0; s < 2; ++s)
+    {
+        const FShapeData& A = Source->ClothShapes[s];
+        const FShapeData& B = Loaded->ClothShapes[s];
+        TestEqual(TEXT("Point count survives"), B.CompletedClothShape.Num(), A.CompletedClothShape.Num());
+        TestTrue(TEXT("Translation survives"), B.Translation == A.Translation);
+        TestEqual(TEXT("Rotation survives"), B.RotationDegrees, A.RotationDegrees);
+        for (int32 i = 0; i < FMath::Min(A.CompletedClothShape.Num(), B.CompletedClothShape.Num()); ++i)
+        {
+            const FCurvePointData& PA = A.CompletedClothShape[i];
+            const FCurvePointData& PB = B.CompletedClothShape[i];
+            TestTrue(TEXT("Position is exact"), PA.Position == PB.Position);
+            TestTrue(TEXT("Tangents are exact"), PA.ArriveTangent == PB.ArriveTangent && PA.LeaveTangent == PB.LeaveTangent);
+            TestEqual(TEXT("Input key survives"), PB.InputKey, PA.InputKey);
+            TestEqual(TEXT("Bezier flag survives"), PB.bUseBezier, PA.bUseBezier);
+        }
+    }
+    TestTrue(TEXT("Working point survives"), Loaded->ClothCurvePoints[0].Position == FVector2D(7.0, 8.0) && Loaded->ClothCurvePoints[0].bUseBezier);
+
+    // the tagged path used for undo and copies must keep working too
+    int32 TaggedBytes = 0;
+    UClothShapeAsset* Tagged = RoundTrip(Source, false, TaggedBytes);
+    TestEqual(TEXT("Tagged path keeps the shapes"), Tagged->ClothShapes.Num(), 2);
+    TestTrue(TEXT("Packed layout is smaller than tagged"), PackedBytes < TaggedBytes);
+
+    return true;
+}
+
+// float quantization halves the vector columns and stays within float precision
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(UClothShapeAsset_QuantizedRoundTripTest, 
+    "ClothShapeAsset.UClothShapeAsset.QuantizedRoundTrip", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool UClothShapeAsset_QuantizedRoundTripTest::RunTest(const FString& Parameters)
+{
+    int32 FullBytes = 0;
+    RoundTrip(MakePackedTestAsset(false), true, FullBytes);
+
+    UClothShapeAsset* Source = MakePackedTestAsset(true);
+    int32 QuantizedBytes = 0;
+    UClothShapeAsset* Loaded = RoundTrip(Source, true, QuantizedBytes);
+
+    TestTrue(TEXT("Quantized asset is smaller"), QuantizedBytes < FullBytes);
+    TestTrue(TEXT("Quantize setting survives"), Loaded->bQuantizePoints);
+    TestEqual(TEXT("Shape count survives"), Loaded->ClothShapes.Num(), 2);
+    if (Loaded->ClothShapes.Num() == 2 && Loaded->ClothShapes[1].CompletedClothShape.Num() == 5)
+    {
+        const FVector2D Expected = Source->ClothShapes[1].CompletedClothShape[3].Position;
+        TestTrue(TEXT("Position within float precision"), Loaded->ClothShapes[1].CompletedClothShape[3].Position.Equals(Expected, 1e-4));
+    }
+
+    return true;
+}
@@ -1,4 +1,5 @@
 #include "ClothDesignCanvas.h"
+#include "PatternMesh.h"
 
 #include "Misc/AutomationTest.h"
 #include "Math/InterpCurve.h"
@@ -112,6 +113,80 @@ bool FClothCanvas_StateRoundtripTest::RunTest(const FString& Parameters)
 }
 
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClothCanvas_ShapeActorOwnershipTest,
+    "ClothDesignCanvas.ShapeActorOwnership",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FClothCanvas_ShapeActorOwnershipTest::RunTest(const FString& Parameters)
+{
+    SClothDesignCanvas Canvas;
+
+    FInterpCurve<FVector2D> Shape;
+    Shape.AddPoint(0.f, FVector2D(0.f, 0.f));
+    for (int32 i = 0; i < 2; ++i)
+    {
+        Canvas.CompletedShapes.Add(Shape);
+        Canvas.CompletedBezierFlags.Add(TArray<bool>{ false });
+    }
+
+    // as built by RegeneratePatternMeshes when shape 0 failed to triangulate
+    APatternMesh* Actor = NewObject<APatternMesh>();
+    Actor->SourceShapeIndex = 1;
+    Actor->SourcePatternGeneration = Canvas.PatternGeneration;
+    Canvas.SewingManager.SpawnedPatternActors.Add(Actor);
+
+    TestNull(TEXT("Actor of another shape is not returned"), Canvas.GetShapeActor(0));
+    TestNull(TEXT("Out of range index"), Canvas.GetShapeActor(1));
+
+    Canvas.SewingManager.SpawnedPatternActors.Insert(nullptr, 0);
+    TestTrue(TEXT("Actor found at its own index"), Canvas.GetShapeActor(1) == Actor);
+
+    // loading another pattern must not let its shapes reach the old actors
+    Canvas.RestoreCanvasState(Canvas.GetCurrentCanvasState());
+    TestNull(TEXT("Actors of a previous pattern are not returned"), Canvas.GetShapeActor(1));
+    TestTrue(TEXT("Meshes flagged for regeneration"), Canvas.bMeshesStale);
+
+    return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClothCanvas_SimplifyNothingFittedTest,
+    "ClothDesignCanvas.SimplifyNothingFitted",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FClothCanvas_SimplifyNothingFittedTest::RunTest(const FString& Parameters)
+{
+    SClothDesignCanvas Canvas;
+
+    FInterpCurve<FVector2D> Shape;
+    TArray<bool> Flags;
+    for (int32 i = 0; i < 32; ++i)
+    {
+        Shape.AddPoint(static_cast<float>(i), FVector2D(i, 0.f));
+        Flags.Add(false);
+    }
+    Canvas.CompletedShapes.Add(Shape);
+    Canvas.CompletedBezierFlags.Add(Flags);
+
+    // a sewn shape is never refitted, so the click changes nothing
+    FSeamDefinition Seam;
+    Seam.ShapeA = 0;
+    Seam.EdgeA = { 0, 1 };
+    Seam.ShapeB = 0;
+    Seam.EdgeB = { 2, 3 };
+    Canvas.SewingManager.SeamDefinitions.Add(Seam);
+
+    const uint32 EditSerialBefore = Canvas.EditSerial;
+    Canvas.SimplifyShapesClick();
+
+    TestEqual(TEXT("Shape left untouched"), Canvas.CompletedShapes[0].Points.Num(), 32);
+    TestEqual(TEXT("No undo step recorded"), Canvas.UndoHistory.NumUndoSteps(), 0);
+    TestEqual(TEXT("Nothing new to autosave"), Canvas.EditSerial, EditSerialBefore);
+
+    return true;
+}
+
+
 // background texture  
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClothCanvas_BackgroundTextureAndScaleTest,
     "ClothDesignCanvas.BackgroundTextureAndScale",
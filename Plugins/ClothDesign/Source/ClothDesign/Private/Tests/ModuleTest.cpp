@@ -17,6 +17,7 @@ bool FClothDesignModuleButtonTest::RunTest(const FString& Parameters)
 	Module.OnGenerateMeshClicked();
 	Module.OnSewingClicked();
 	Module.OnMergeMeshesClicked();
+	Module.OnCommitMergeClicked();
 
 	if (!Module.CanvasWidget.IsValid())
 	{
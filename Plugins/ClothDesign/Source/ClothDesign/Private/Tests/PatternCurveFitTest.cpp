@@ -0,0 +1,87 @@
+#include "Misc/AutomationTest.h"
+#include "PatternCreation/PatternCurveFit.h"
+#include "Canvas/CanvasUtils.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPatternCurveFitDenseCircleTest,
+	"PatternCurveFit.DenseCircle",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPatternCurveFitDenseCircleTest::RunTest(const FString& Parameters)
+{
+	// a traced circle: 400 N-points, every edge straight
+	const int32 NumPoints = 400;
+	const double Radius = 100.0;
+	const double Tolerance = 0.1;
+
+	FInterpCurve<FVector2D> Circle;
+	TArray<bool> Flags;
+	for (int32 i = 0; i < NumPoints; ++i)
+	{
+		const double Angle = UE_TWO_PI * i / NumPoints;
+		Circle.Points.Add(FInterpCurvePoint<FVector2D>(i, FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)) * Radius));
+		Circle.Points.Last().InterpMode = CIM_CurveAuto;
+		Flags.Add(false);
+	}
+	FCanvasUtils::RecalculateNTangents(Circle, Flags);
+
+	FInterpCurve<FVector2D> Fitted;
+	TArray<bool> FittedFlags;
+	TestTrue(TEXT("Circle is reduced"), FPatternCurveFit::FitShape(Circle, Flags, Tolerance, Fitted, FittedFlags));
+	TestTrue(TEXT("Far fewer control points"), Fitted.Points.Num() <= 16);
+	TestEqual(TEXT("Flags match points"), FittedFlags.Num(), Fitted.Points.Num());
+
+	// the polygon itself sits up to R(1 - cos(pi/N)) inside the circle
+	const double PolygonSag = Radius * (1.0 - FMath::Cos(UE_PI / NumPoints));
+	TArray<FVector2D> Samples;
+	FPatternCurveFit::SampleOutline(Fitted, FittedFlags, Samples);
+	double MaxError = 0.0;
+	for (const FVector2D& P : Samples)
+	{
+		MaxError = FMath::Max(MaxError, FMath::Abs(P.Size() - Radius));
+	}
+	TestTrue(FString::Printf(TEXT("Fit stays within tolerance (max error %f)"), MaxError), MaxError <= Tolerance * 1.5 + PolygonSag);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPatternCurveFitCornersTest,
+	"PatternCurveFit.Corners",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPatternCurveFitCornersTest::RunTest(const FString& Parameters)
+{
+	// a 100 x 100 square with 25 points per side
+	const FVector2D Corners[] = { FVector2D(0, 0), FVector2D(100, 0), FVector2D(100, 100), FVector2D(0, 100) };
+	FInterpCurve<FVector2D> Square;
+	TArray<bool> Flags;
+	for (int32 Side = 0; Side < 4; ++Side)
+	{
+		for (int32 Step = 0; Step < 25; ++Step)
+		{
+			const FVector2D P = FMath::Lerp(Corners[Side], Corners[(Side + 1) % 4], Step / 25.0);
+			Square.Points.Add(FInterpCurvePoint<FVector2D>(Square.Points.Num(), P));
+			Square.Points.Last().InterpMode = CIM_CurveAuto;
+			Flags.Add(false);
+		}
+	}
+	FCanvasUtils::RecalculateNTangents(Square, Flags);
+
+	FInterpCurve<FVector2D> Fitted;
+	TArray<bool> FittedFlags;
+	TestTrue(TEXT("Square is reduced"), FPatternCurveFit::FitShape(Square, Flags, 0.1, Fitted, FittedFlags));
+	TestEqual(TEXT("Only the corners remain"), Fitted.Points.Num(), 4);
+	TestFalse(TEXT("Corners stay N-points"), FittedFlags.Contains(true));
+	for (const FVector2D& Corner : Corners)
+	{
+		const bool bKept = Fitted.Points.ContainsByPredicate([&Corner](const FInterpCurvePoint<FVector2D>& P) { return P.OutVal.Equals(Corner, 1e-6); });
+		TestTrue(FString::Printf(TEXT("Corner %s kept"), *Corner.ToString()), bKept);
+	}
+
+	// a shape that is already minimal is left as it is
+	FInterpCurve<FVector2D> Refitted;
+	TArray<bool> RefittedFlags;
+	TestFalse(TEXT("Minimal shape is not replaced"), FPatternCurveFit::FitShape(Fitted, FittedFlags, 0.1, Refitted, RefittedFlags));
+
+	return true;
+}
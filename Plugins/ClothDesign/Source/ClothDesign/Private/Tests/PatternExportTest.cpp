@@ -0,0 +1,140 @@
+#include "Misc/AutomationTest.h"
+#include "PatternCreation/PatternExport.h"
+#include "DynamicMesh/DynamicMeshAttributeSet.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	/**
+	 * Two 10 x 10 pieces welded along x = 10, laid out like a merge result:
+	 * one triangle group and one set of UV elements per piece.
+	 */
+	void BuildTwoPieceGarment(UE::Geometry::FDynamicMesh3& Mesh)
+	{
+		using UE::Geometry::FIndex3i;
+
+		Mesh = UE::Geometry::FDynamicMesh3();
+		Mesh.EnableTriangleGroups();
+		Mesh.EnableAttributes();
+		UE::Geometry::FDynamicMeshUVOverlay* UVs = Mesh.Attributes()->PrimaryUV();
+
+		const FVector3d Positions[] = { {0, 0, 0}, {10, 0, 0}, {10, 10, 0}, {0, 10, 0}, {20, 0, 0}, {20, 10, 0} };
+		for (const FVector3d& P : Positions)
+		{
+			Mesh.AppendVertex(P);
+		}
+
+		const FIndex3i Pieces[2][2] = { { {0, 1, 2}, {0, 2, 3} }, { {1, 4, 5}, {1, 5, 2} } };
+		for (int32 Piece = 0; Piece < 2; ++Piece)
+		{
+			TMap<int32, int32> Elements;
+			for (const FIndex3i& Tri : Pieces[Piece])
+			{
+				FIndex3i TriUV;
+				for (int32 Corner = 0; Corner < 3; ++Corner)
+				{
+					const FVector3d P = Mesh.GetVertex(Tri[Corner]);
+					if (!Elements.Contains(Tri[Corner]))
+					{
+						Elements.Add(Tri[Corner], UVs->AppendElement(FVector2f(FVector2D(P.X, P.Y) * 0.01), Tri[Corner]));
+					}
+					TriUV[Corner] = Elements[Tri[Corner]];
+				}
+				const int32 TID = Mesh.AppendTriangle(Tri, Piece);
+				UVs->SetTriangle(TID, TriUV);
+			}
+		}
+	}
+
+	int32 CountLinesStartingWith(const FString& Text, const TCHAR* Prefix)
+	{
+		TArray<FString> Lines;
+		Text.ParseIntoArrayLines(Lines);
+		return Lines.FilterByPredicate([Prefix](const FString& Line) { return Line.StartsWith(Prefix, ESearchCase::CaseSensitive); }).Num();
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPatternExportGlbTest,
+	"PatternExport.Glb",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPatternExportGlbTest::RunTest(const FString& Parameters)
+{
+	UE::Geometry::FDynamicMesh3 Mesh;
+	BuildTwoPieceGarment(Mesh);
+
+	int32 NumSeams = 0;
+	for (const int32 EID : Mesh.EdgeIndicesItr())
+	{
+		NumSeams += FPatternExport::IsSeamEdge(Mesh, EID) ? 1 : 0;
+	}
+	TestEqual(TEXT("Only the welded edge is a seam"), NumSeams, 1);
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	TestTrue(TEXT("GLB written"), FPatternExport::WriteGlb(Writer, { &Mesh }, FPatternExportOptions()));
+	if (!TestTrue(TEXT("Has header and chunk headers"), Bytes.Num() > 28))
+	{
+		return false;
+	}
+
+	auto ReadU32 = [&Bytes](int32 Offset) { uint32 V; FMemory::Memcpy(&V, &Bytes[Offset], 4); return V; };
+	TestEqual(TEXT("Magic"), ReadU32(0), 0x46546C67u);
+	TestEqual(TEXT("Version"), ReadU32(4), 2u);
+	TestEqual(TEXT("Declared length matches"), ReadU32(8), uint32(Bytes.Num()));
+
+	const uint32 JsonLength = ReadU32(12);
+	TestEqual(TEXT("JSON chunk is 4-byte aligned"), JsonLength % 4, 0u);
+	const FUTF8ToTCHAR JsonText(reinterpret_cast<const ANSICHAR*>(&Bytes[20]), JsonLength);
+	const FString Json(JsonText.Length(), JsonText.Get());
+	TestTrue(TEXT("Pattern UVs are exported"), Json.Contains(TEXT("\"TEXCOORD_0\"")));
+	TestTrue(TEXT("Seams are a line primitive"), Json.Contains(TEXT("\"mode\":1")));
+	TestTrue(TEXT("Piece count is recorded"), Json.Contains(TEXT("\"pieceCount\":2")));
+
+	// 8 UV elements (welded corners are split per piece) with position, normal and UV,
+	// 4 triangles and 1 seam edge of 32-bit indices
+	const uint32 BinLength = ReadU32(20 + JsonLength);
+	TestEqual(TEXT("Binary chunk size"), BinLength, uint32(8 * (12 + 12 + 8) + 4 * (4 * 3 + 1 * 2)));
+	TestEqual(TEXT("Binary chunk ends the file"), 20 + JsonLength + 8 + BinLength, uint32(Bytes.Num()));
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPatternExportObjTest,
+	"PatternExport.Obj",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPatternExportObjTest::RunTest(const FString& Parameters)
+{
+	UE::Geometry::FDynamicMesh3 Mesh;
+	BuildTwoPieceGarment(Mesh);
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	TestTrue(TEXT("OBJ written"), FPatternExport::WriteObj(Writer, { &Mesh, nullptr, &Mesh }, FPatternExportOptions()));
+
+	Bytes.Add(0);
+	const FString Text(ANSI_TO_TCHAR(reinterpret_cast<const ANSICHAR*>(Bytes.GetData())));
+	TestEqual(TEXT("Objects"), CountLinesStartingWith(Text, TEXT("o ")), 2);
+	TestEqual(TEXT("Positions are shared between pieces"), CountLinesStartingWith(Text, TEXT("v ")), 12);
+	TestEqual(TEXT("UVs are per piece"), CountLinesStartingWith(Text, TEXT("vt ")), 16);
+	TestEqual(TEXT("Faces"), CountLinesStartingWith(Text, TEXT("f ")), 8);
+	TestEqual(TEXT("Piece groups"), CountLinesStartingWith(Text, TEXT("g piece_")), 4);
+	TestEqual(TEXT("Seam lines"), CountLinesStartingWith(Text, TEXT("l ")), 2);
+
+	// the second object's indices continue after the first one's
+	TestTrue(TEXT("Indices are global"), Text.Contains(TEXT("l 8 9")) || Text.Contains(TEXT("l 9 8")));
+
+	FPatternExportOptions NoSeams;
+	NoSeams.bWriteSeams = false;
+	TArray<uint8> NoSeamBytes;
+	FMemoryWriter NoSeamWriter(NoSeamBytes);
+	FPatternExport::WriteObj(NoSeamWriter, { &Mesh }, NoSeams);
+	NoSeamBytes.Add(0);
+	TestEqual(TEXT("Seams can be left out"),
+		CountLinesStartingWith(FString(ANSI_TO_TCHAR(reinterpret_cast<const ANSICHAR*>(NoSeamBytes.GetData()))), TEXT("l ")), 0);
+
+	return true;
+}
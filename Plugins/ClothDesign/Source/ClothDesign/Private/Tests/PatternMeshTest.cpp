@@ -2,6 +2,8 @@
 #include "Engine/World.h"
 #include "Engine/Engine.h"
 #include "GameFramework/Actor.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPatternMesh_DefaultsTest,
 	"PatternMesh.Defaults",
@@ -52,3 +54,73 @@ bool FPatternMesh_PolyIndexMappingTest::RunTest(const FString& Parameters)
 
 	return true;
 }
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPatternMesh_PackedMeshRoundTripTest,
+	"PatternMesh.PackedMeshRoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPatternMesh_PackedMeshRoundTripTest::RunTest(const FString& Parameters)
+{
+	// fan of triangles like the triangulator emits: flat, grouped, no attributes
+	UE::Geometry::FDynamicMesh3 Source;
+	Source.EnableTriangleGroups();
+	const int32 Centre = Source.AppendVertex(FVector3d(0.0, 0.0, 0.0));
+	const int32 NumRim = 12;
+	for (int32 i = 0; i < NumRim; ++i)
+	{
+		const double Angle = 2.0 * PI * i / NumRim;
+		Source.AppendVertex(FVector3d(100.0 * FMath::Cos(Angle), 50.0 * FMath::Sin(Angle), 0.0));
+	}
+	for (int32 i = 0; i < NumRim; ++i)
+	{
+		Source.AppendTriangle(Centre, 1 + i, 1 + (i + 1) % NumRim, i % 2);
+	}
+
+	for (const bool bQuantize : { false, true })
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes, true);
+		APatternMesh::SerializePackedMesh(Writer, Source, bQuantize);
+
+		UE::Geometry::FDynamicMesh3 Loaded;
+		FMemoryReader Reader(Bytes, true);
+		APatternMesh::SerializePackedMesh(Reader, Loaded, bQuantize);
+
+		TestFalse(TEXT("Reading should not fail"), Reader.IsError());
+		TestEqual(TEXT("Vertex count should survive"), Loaded.VertexCount(), Source.VertexCount());
+		TestEqual(TEXT("Triangle count should survive"), Loaded.TriangleCount(), Source.TriangleCount());
+		TestTrue(TEXT("Triangle groups should survive"), Loaded.HasTriangleGroups());
+		if (Loaded.VertexCount() != Source.VertexCount() || Loaded.TriangleCount() != Source.TriangleCount())
+		{
+			continue;
+		}
+
+		// 16 bits over a 200 unit extent is ~0.003 units per step
+		const double Tolerance = bQuantize ? 0.01 : 1e-4;
+		for (int32 VID = 0; VID < Source.VertexCount(); ++VID)
+		{
+			TestTrue(TEXT("Positions should match"), FVector3d::Distance(Loaded.GetVertex(VID), Source.GetVertex(VID)) <= Tolerance);
+		}
+		for (int32 TID = 0; TID < Source.TriangleCount(); ++TID)
+		{
+			TestTrue(TEXT("Triangles should match"), Loaded.GetTriangle(TID) == Source.GetTriangle(TID));
+			TestEqual(TEXT("Groups should match"), Loaded.GetTriangleGroup(TID), Source.GetTriangleGroup(TID));
+		}
+	}
+
+	// a truncated block is reported, not half-loaded
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes, true);
+	APatternMesh::SerializePackedMesh(Writer, Source, true);
+	Bytes.SetNum(Bytes.Num() - 4);
+
+	AddExpectedError(TEXT("remain"), EAutomationExpectedErrorFlags::Contains, 0);
+	UE::Geometry::FDynamicMesh3 Loaded;
+	FMemoryReader Reader(Bytes, true);
+	APatternMesh::SerializePackedMesh(Reader, Loaded, true);
+	TestTrue(TEXT("Truncated data should fail"), Reader.IsError());
+	TestEqual(TEXT("Truncated data should leave the mesh empty"), Loaded.VertexCount(), 0);
+
+	return true;
+}
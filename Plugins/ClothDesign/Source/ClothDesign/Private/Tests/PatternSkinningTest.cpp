@@ -0,0 +1,109 @@
+#include "Misc/AutomationTest.h"
+#include "PatternCreation/PatternSkinning.h"
+#include "BoneWeights.h"
+#include "DynamicMesh/DynamicMeshAttributeSet.h"
+#include "DynamicMesh/DynamicVertexSkinWeightsAttribute.h"
+
+using namespace UE::Geometry;
+using namespace UE::AnimationCore;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPatternSkinningTransferTest,
+	"PatternSkinning.TransferProximityWeights",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPatternSkinningTransferTest::RunTest(const FString& Parameters)
+{
+	// Body: one triangle, corner A bound to bone 1, corners B and C to bone 2
+	FDynamicMesh3 Body;
+	const int32 A = Body.AppendVertex(FVector3d(0, 0, 0));
+	const int32 B = Body.AppendVertex(FVector3d(100, 0, 0));
+	const int32 C = Body.AppendVertex(FVector3d(0, 100, 0));
+	Body.AppendTriangle(A, B, C);
+	Body.EnableAttributes();
+
+	FDynamicMeshVertexSkinWeightsAttribute* BodyWeights = new FDynamicMeshVertexSkinWeightsAttribute(&Body);
+	FBoneWeights Bone1, Bone2;
+	Bone1.SetBoneWeight(FBoneWeight(1, 1.0f), FBoneWeightsSettings());
+	Bone2.SetBoneWeight(FBoneWeight(2, 1.0f), FBoneWeightsSettings());
+	BodyWeights->SetValue(A, Bone1);
+	BodyWeights->SetValue(B, Bone2);
+	BodyWeights->SetValue(C, Bone2);
+	Body.Attributes()->AttachSkinWeightsAttribute(FName(TEXT("Default")), BodyWeights);
+
+	// Garment: one vertex hovering over corner A, one over corner B
+	FDynamicMesh3 Garment;
+	const int32 G0 = Garment.AppendVertex(FVector3d(0, 0, 5));
+	const int32 G1 = Garment.AppendVertex(FVector3d(100, 0, 5));
+	const int32 G2 = Garment.AppendVertex(FVector3d(0, 100, 5));
+	Garment.AppendTriangle(G0, G1, G2);
+
+	TestTrue(TEXT("Transfer should succeed"),
+		FPatternSkinning::TransferProximityWeights(Body, FTransform::Identity, Garment));
+
+	const FDynamicMeshVertexSkinWeightsAttribute* GarmentWeights =
+		Garment.Attributes()->GetSkinWeightsAttribute(FName(TEXT("Default")));
+	TestNotNull(TEXT("Garment should have a Default skin weight profile"), GarmentWeights);
+	if (!GarmentWeights)
+	{
+		return false;
+	}
+
+	FBoneWeights W0, W1;
+	GarmentWeights->GetValue(G0, W0);
+	GarmentWeights->GetValue(G1, W1);
+	TestEqual(TEXT("Vertex over A should take bone 1"), (int32)W0[0].GetBoneIndex(), 1);
+	TestEqual(TEXT("Vertex over B should take bone 2"), (int32)W1[0].GetBoneIndex(), 2);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPatternSkinningNoWeightsTest,
+	"PatternSkinning.BodyWithoutWeights",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPatternSkinningNoWeightsTest::RunTest(const FString& Parameters)
+{
+	FDynamicMesh3 Body;
+	Body.AppendTriangle(Body.AppendVertex(FVector3d(0, 0, 0)), Body.AppendVertex(FVector3d(1, 0, 0)), Body.AppendVertex(FVector3d(0, 1, 0)));
+
+	FDynamicMesh3 Garment;
+	Garment.AppendVertex(FVector3d(0, 0, 1));
+
+	TestFalse(TEXT("Transfer should fail without body skin weights"),
+		FPatternSkinning::TransferProximityWeights(Body, FTransform::Identity, Garment));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPatternSkinningRemapTest,
+	"PatternSkinning.RemapBoneIndices",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPatternSkinningRemapTest::RunTest(const FString& Parameters)
+{
+	FDynamicMesh3 Body;
+	const int32 V = Body.AppendVertex(FVector3d(0, 0, 0));
+	Body.EnableAttributes();
+
+	// half bone 1, half bone 2
+	FDynamicMeshVertexSkinWeightsAttribute* Weights = new FDynamicMeshVertexSkinWeightsAttribute(&Body);
+	FBoneWeights Split;
+	Split.SetBoneWeight(FBoneWeight(1, 0.5f), FBoneWeightsSettings());
+	Split.SetBoneWeight(FBoneWeight(2, 0.5f), FBoneWeightsSettings());
+	Weights->SetValue(V, Split);
+	Body.Attributes()->AttachSkinWeightsAttribute(FName(TEXT("Default")), Weights);
+
+	// mesh bone 1 sits at skeleton index 3; mesh bone 2 is missing from the skeleton
+	FPatternSkinning::RemapBoneIndices({ 0, 3, INDEX_NONE }, Body);
+
+	FBoneWeights Remapped;
+	Body.Attributes()->GetSkinWeightsAttribute(FName(TEXT("Default")))->GetValue(V, Remapped);
+	TestEqual(TEXT("Missing bones are dropped"), Remapped.Num(), 1);
+	if (Remapped.Num() == 1)
+	{
+		TestEqual(TEXT("Bone index follows the skeleton"), (int32)Remapped[0].GetBoneIndex(), 3);
+		TestEqual(TEXT("Remaining weight is renormalised"), Remapped[0].GetWeight(), 1.0f, 1e-3f);
+	}
+
+	return true;
+}
@@ -0,0 +1,234 @@
+#ifndef FCanvasBackgroundTiles_H
+#define FCanvasBackgroundTiles_H
+
+#include "CoreMinimal.h"
+#include "ImageCore.h"
+#include "Tasks/Task.h"
+#include "Styling/SlateBrush.h"
+#include "UObject/StrongObjectPtr.h"
+#include <atomic>
+
+class UTexture2D;
+class FSlateDynamicImageBrush;
+class FSlateWindowElementList;
+struct FGeometry;
+
+
+/** Identifies one tile of one level of the background pyramid. */
+struct FCanvasBackgroundTileKey
+{
+	int32 Level = 0;    ///< Pyramid level; 0 is full resolution, each level halves the previous one
+	int32 X = 0;        ///< Tile column within the level
+	int32 Y = 0;        ///< Tile row within the level
+
+	bool operator==(const FCanvasBackgroundTileKey& Other) const
+	{
+		return Level == Other.Level && X == Other.X && Y == Other.Y;
+	}
+
+	friend uint32 GetTypeHash(const FCanvasBackgroundTileKey& Key)
+	{
+		return HashCombineFast(GetTypeHash(Key.Level), HashCombineFast(GetTypeHash(Key.X), GetTypeHash(Key.Y)));
+	}
+};
+
+
+/**
+ * @brief Draws the background reference image as tiles from a CPU mip pyramid.
+ *
+ * Scanned patterns are often tens of thousands of pixels wide. Drawn as one brush, the whole
+ * texture had to stay resident even when only a corner was on screen, and a new brush was
+ * built every frame. Here the texture's source image is read once on a worker and reduced
+ * into a pyramid of half-size levels. Each paint picks the level that gives about one texel per
+ * screen pixel and only the tiles of that level that overlap the view are uploaded, on workers
+ * and a few per tick. Uploaded tiles keep their brush until a memory budget forces out the
+ * ones drawn longest ago. The coarsest level is a single tile and is drawn under the others,
+ * so the image never has holes while finer tiles load.
+ *
+ * The pyramid itself stays in memory, about a third more than the full image, and counts
+ * against the same budget as the uploaded tiles. When it does not fit, its finest levels are
+ * dropped, so very large scans are drawn from the finest level that fits. A higher budget takes
+ * effect for the next texture.
+ *
+ * Until the pyramid is ready, and for textures without editor source data or smaller than a
+ * tile, the texture itself is drawn with one cached brush.
+ */
+class FCanvasBackgroundTiles
+{
+public:
+	/** Edge length of a tile in texels. */
+	static constexpr int32 TileSize = 512;
+
+	/** Tile pixels produced by a worker, in BGRA8 order. */
+	struct FTilePixels
+	{
+		TArray<uint8> Bytes;            ///< Width * Height * 4 bytes, rows top to bottom
+		FIntPoint Size = FIntPoint::ZeroValue;
+	};
+
+	FCanvasBackgroundTiles() = default;
+	~FCanvasBackgroundTiles();
+
+	FCanvasBackgroundTiles(const FCanvasBackgroundTiles&) = delete;
+	FCanvasBackgroundTiles& operator=(const FCanvasBackgroundTiles&) = delete;
+
+	/**
+	 * @brief Switches to another background texture; does nothing if it is already shown.
+	 * @param InTexture New texture, or null to drop everything.
+	 *
+	 * Starts building the pyramid on a worker. The texture is kept alive until that finishes,
+	 * even if another texture is set meanwhile; the old build is cancelled, not waited for.
+	 */
+	void SetTexture(UTexture2D* InTexture);
+
+	/**
+	 * @brief Takes over a finished pyramid and uploads finished tiles, then trims the pyramid and the cache.
+	 * @param BudgetBytes Memory the pyramid and the uploaded tiles may use together; the coarsest
+	 *        level and tiles drawn in the last paint are always kept.
+	 */
+	void Tick(int64 BudgetBytes);
+
+	/**
+	 * @brief Draws the visible part of the image and requests tiles that are missing.
+	 * @param Geo Geometry of the canvas area; its local size bounds the visible part.
+	 * @param OutDraw Slate element list to append draw commands to.
+	 * @param Layer The rendering layer to use.
+	 * @param ScreenRect Where the whole image lies, in local space of Geo.
+	 * @param Tint Colour and opacity of the image.
+	 * @return The next available layer after drawing.
+	 */
+	int32 Draw(
+		const FGeometry& Geo,
+		FSlateWindowElementList& OutDraw,
+		int32 Layer,
+		const FBox2D& ScreenRect,
+		const FLinearColor& Tint);
+
+	/** @return Counter that changes whenever Draw would produce a different picture for the same view. */
+	uint32 GetVersion() const { return Version; }
+
+	/** @return Bytes of uploaded tile images currently cached. */
+	int64 GetCachedBytes() const { return CachedBytes; }
+
+	/** @return Bytes of pyramid level images currently held. */
+	int64 GetPyramidBytes() const { return Pyramid.IsValid() ? Pyramid->Bytes : 0; }
+
+	/**
+	 * @brief Number of pyramid levels for an image; the last one fits in a single tile.
+	 * @param SourceSize Full resolution size in texels.
+	 */
+	static int32 GetNumLevels(const FIntPoint& SourceSize);
+
+	/**
+	 * @brief Size of a pyramid level; odd sizes round up, so every source texel is covered.
+	 * @param SourceSize Full resolution size in texels.
+	 * @param Level Pyramid level.
+	 */
+	static FIntPoint GetLevelSize(const FIntPoint& SourceSize, int32 Level);
+
+	/**
+	 * @brief Picks the coarsest level that still has at least one texel per screen pixel.
+	 * @param ScreenPixelsPerTexel Screen pixels covered by one full resolution texel.
+	 * @param NumLevels Levels in the pyramid.
+	 */
+	static int32 SelectLevel(double ScreenPixelsPerTexel, int32 NumLevels);
+
+	/**
+	 * @brief Finest level from which the rest of the pyramid fits in a memory budget.
+	 * @param SourceSize Full resolution size in texels.
+	 * @param BytesPerPixel 1 for G8 levels, 4 for BGRA8.
+	 * @param BudgetBytes Memory the kept levels may use.
+	 * @return A level index; the coarsest level is returned even if it alone is over budget.
+	 */
+	static int32 GetFinestLevelInBudget(const FIntPoint& SourceSize, int32 BytesPerPixel, int64 BudgetBytes);
+
+	/**
+	 * @brief Tiles of a level that overlap a region of the image.
+	 * @param SourceSize Full resolution size in texels.
+	 * @param Level Pyramid level.
+	 * @param VisibleRect Region in full resolution texels.
+	 * @return Tile columns and rows, max exclusive; empty when nothing overlaps.
+	 */
+	static FIntRect GetVisibleTiles(const FIntPoint& SourceSize, int32 Level, const FBox2D& VisibleRect);
+
+	/**
+	 * @brief Part of the full resolution image a tile covers.
+	 * @param SourceSize Full resolution size in texels.
+	 * @param Key Tile to measure.
+	 */
+	static FBox2D GetTileSourceRect(const FIntPoint& SourceSize, const FCanvasBackgroundTileKey& Key);
+
+	/**
+	 * @brief Halves an 8-bit G8 or BGRA8 image with a 2 x 2 box filter; the last row and column repeat on odd sizes.
+	 * @param Src Image to reduce.
+	 * @param OutDest Receives the half-size image in the same format.
+	 */
+	static void DownsampleLevel(const FImage& Src, FImage& OutDest);
+
+	/**
+	 * @brief Copies one tile out of a pyramid level as BGRA8.
+	 * @param LevelImage G8 or BGRA8 level image.
+	 * @param TileX Tile column.
+	 * @param TileY Tile row.
+	 * @return Pixels of the tile; smaller than TileSize at the right and bottom edges.
+	 */
+	static FTilePixels CopyTile(const FImage& LevelImage, int32 TileX, int32 TileY);
+
+private:
+	using FLevelPtr = TSharedPtr<const FImage, ESPMode::ThreadSafe>;
+
+	/** Level images from full resolution down to a single tile; each level is shared read-only with tile workers. */
+	struct FPyramid
+	{
+		TArray<FLevelPtr> Levels;                   ///< Null below FirstLevel
+		FIntPoint SourceSize = FIntPoint::ZeroValue;
+		int32 BytesPerPixel = 4;
+		int32 FirstLevel = 0;                       ///< Finest level still held
+		int64 Bytes = 0;                            ///< Size of the held level images
+	};
+	using FPyramidPtr = TSharedPtr<FPyramid, ESPMode::ThreadSafe>;
+
+	/** An uploaded tile. */
+	struct FCachedTile
+	{
+		TSharedPtr<FSlateDynamicImageBrush> Brush;  ///< Null if the upload failed, so it is not retried
+		int64 Bytes = 0;
+		uint32 LastDrawn = 0;                       ///< DrawSerial of the last paint that used it
+	};
+
+	/** @brief Drops the pyramid, all tiles and the fallback brush; cancels a running pyramid build without waiting. */
+	void Reset();
+
+	/** @brief Frees the finest pyramid levels until the pyramid fits the budget. */
+	void TrimPyramid(int64 BudgetBytes);
+
+	/** @brief Draws a cached tile, or queues it when it is not uploaded yet. */
+	void DrawTile(
+		const FCanvasBackgroundTileKey& Key,
+		const FGeometry& Geo,
+		FSlateWindowElementList& OutDraw,
+		int32 Layer,
+		const FBox2D& ScreenRect,
+		const FLinearColor& Tint);
+
+	/** @brief Removes tiles not drawn in the last paint, oldest first, until the cache fits the budget. */
+	void Evict(int64 BudgetBytes);
+
+	TWeakObjectPtr<UTexture2D> Texture;                 ///< Texture currently shown
+	TStrongObjectPtr<UTexture2D> LoadingTexture;        ///< Held while a worker reads its source image; handed to a ticker on Reset
+	FSlateBrush TextureBrush;                           ///< Whole-texture brush used before the pyramid is ready
+
+	FPyramidPtr Pyramid;
+	UE::Tasks::TTask<FPyramidPtr> PendingPyramid;       ///< Invalid when no build is running
+	TSharedPtr<std::atomic<bool>, ESPMode::ThreadSafe> PyramidCancel;  ///< Set by Reset to stop the running build early
+
+	TMap<FCanvasBackgroundTileKey, FCachedTile> Tiles;
+	TMap<FCanvasBackgroundTileKey, UE::Tasks::TTask<FTilePixels>> PendingTiles;
+
+	int64 CachedBytes = 0;
+	uint32 DrawSerial = 0;       ///< Incremented by every Draw call
+	uint32 Version = 0;
+	uint32 Generation = 0;       ///< Part of the tile resource names, so a new texture never reuses an old name
+};
+
+#endif
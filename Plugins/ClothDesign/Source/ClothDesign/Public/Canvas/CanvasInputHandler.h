@@ -81,21 +81,6 @@ public:
 private:
 	SClothDesignCanvas* Canvas; /**< The canvas being controlled, to maintain context for input handling. */
 	bool bIsSeamReady = false; /**< Indicates if a seam is ready, helping to prevent incomplete operations. */
-
-	/**
-	 * @brief Calculates squared distance from a point to a line segment.
-	 * @param P The point to measure from.
-	 * @param A One endpoint of the line segment.
-	 * @param B The other endpoint of the line segment.
-	 * @return Squared distance from point P to segment AB.
-	 * 
-	 * This utility exists to determine proximity efficiently, supporting actions like snapping or selection 
-	 * without unnecessary computation.
-	 */
-	static float DistPointToSegmentSq(
-		const FVector2D& P,
-		const FVector2D& A,
-		const FVector2D& B);
 };
 
 #endif
\ No newline at end of file
@@ -14,6 +14,21 @@
 class SClothDesignCanvas;           /**< Represents the cloth design canvas; used for querying shape data and canvas state. */
 struct FGeometry;                   /**< Provides geometric information for Slate widgets (position, size, transform). */
 class FSlateWindowElementList;      /**< Container for Slate draw elements, used to record rendering commands. */
+struct FSeamDefinition;             /**< Seam between two shapes; used to decide which pass draws it. */
+
+
+/**
+ * @brief Which part of the canvas a painter submits.
+ *
+ * Static content is cached in an invalidation panel, while the shape being
+ * dragged (and the seams attached to it) is redrawn every frame on top.
+ */
+enum class EPaintPass : uint8
+{
+    All,    /**< Everything; used when no cached layer is available. */
+    Static, /**< Everything except the active shape and seams that move with it. */
+    Active  /**< Only the active shape and seams that move with it. */
+};
 
 
 /**
@@ -40,6 +55,13 @@ public:
      */
     FCanvasPaint(SClothDesignCanvas* InCanvas) : Canvas(InCanvas) {}
 
+    /**
+     * @brief Restricts the following draw calls to one pass.
+     * @param InPass Part of the canvas to submit.
+     * @param InActiveShapeIndex Completed shape being edited, or INDEX_NONE.
+     */
+    void SetPass(EPaintPass InPass, int32 InActiveShapeIndex);
+
     /**
      * @brief Draws the canvas background.
      * @param Geo Geometry information for the canvas area.
@@ -56,25 +78,24 @@ public:
         int32 Layer) const;
 
     /**
-     * @brief Draws a series of grid lines on the canvas.
-     * @param Geo Geometry information for the canvas area.
-     * @param OutDraw Slate element list to append draw commands to.
-     * @param Layer The rendering layer to use.
-     * @param bVertical Whether the lines are vertical (true) or horizontal (false).
-     * @param Spacing Distance between major grid lines.
-     * @param Color Colour of the lines.
-     * @param bSkipMajor Whether to skip major grid lines for minor grid drawing.
+     * @brief Appends one grid level (vertical and horizontal lines) as a single polyline.
+     * @param Size Local size of the canvas widget.
+     * @param ScreenOrigin Screen position of the world origin.
+     * @param ScreenScale Screen units per world unit on each axis.
+     * @param WorldSpacing Distance between lines in world units.
+     * @param SkipEvery Skip every n-th line (lines drawn by a coarser level), or 0 to keep all.
+     * @param OutPoints Polyline to append to.
      * 
-     * Handles both major and minor grid lines, providing visual guides for shape placement.
+     * Lines are joined in a serpentine order by connectors that run just outside the
+     * widget, where the canvas clip removes them, so a whole level is one draw element.
      */
-    void DrawGridLines(
-        const FGeometry& Geo,
-        FSlateWindowElementList& OutDraw,
-        int32 Layer,
-        bool bVertical,
-        float Spacing,
-        const FLinearColor& Color,
-        bool bSkipMajor) const;
+    static void BuildGridPolyline(
+        const FVector2D& Size,
+        const FVector2D& ScreenOrigin,
+        const FVector2D& ScreenScale,
+        float WorldSpacing,
+        int32 SkipEvery,
+        TArray<FVector2f>& OutPoints);
 
     /**
      * @brief Draws the complete grid over the canvas.
@@ -84,13 +105,25 @@ public:
      * @return The next available layer after drawing.
      * 
      * Combines vertical and horizontal grid lines, including minor subdivisions,
-     * to provide spatial context for drawing operations.
+     * to provide spatial context for drawing operations. Line density follows the zoom:
+     * minor lines fade out as they get dense, and each level is submitted as one element.
      */
     int32 DrawGrid(
         const FGeometry& Geo,
         FSlateWindowElementList& OutDraw,
         int32 Layer) const;
 
+    /**
+     * @brief Returns the world-space rectangle currently visible in the canvas.
+     * @param Geo Geometry information for the canvas area.
+     * @param PixelMargin Screen margin added on every side, so thick lines and point boxes
+     *        straddling the edge are not culled.
+     * @return Visible rectangle in canvas (world) coordinates.
+     * 
+     * Draw passes test cached world-space bounds against this box to skip off-screen content.
+     */
+    FBox2D GetVisibleWorldBounds(const FGeometry& Geo, float PixelMargin) const;
+
     /**
      * @brief Builds the shortest arc segments between points.
      * @param StartIdx Index of the start point.
@@ -148,9 +181,21 @@ public:
         int32 Layer) const;
 
 private:
+    /** @return Whether the current pass draws the given completed shape. */
+    bool ShouldDrawShape(int32 ShapeIndex) const;
+
+    /** @return Whether the current pass draws the given seam. */
+    bool ShouldDrawSeam(const FSeamDefinition& Seam) const;
+
     /** Pointer to the canvas instance to query shape data and state. */
     SClothDesignCanvas* Canvas;
 
+    /** Part of the canvas submitted by the draw calls. */
+    EPaintPass Pass = EPaintPass::All;
+
+    /** Completed shape being edited; drawn by the active pass only. */
+    int32 ActiveShapeIndex = INDEX_NONE;
+
     /** World spacing between major grid lines in units. */
     const float WorldGridSpacing = 100.f;
 
@@ -160,6 +205,18 @@ private:
     /** Spacing between minor grid lines. */
     const float SubGridSpacing = WorldGridSpacing / NumSubdivisions;
 
+    /** Half the edge length in pixels of the boxes drawn at points and handle ends. */
+    const float PointHalfSize = 3.f;
+
+    /** Screen margin in pixels kept around the view when culling shapes, handles and seams. */
+    const float CullPixelMargin = 8.f;
+
+    /** Screen spacing in pixels below which a grid level is hidden. */
+    const float MinGridPixelSpacing = 4.f;
+
+    /** Screen spacing in pixels at which a grid level is fully opaque. */
+    const float FullGridPixelSpacing = 12.f;
+
     // ---- UI colours ---- 
     static const FLinearColor GridColour;                /**< Colour for major grid lines. */
     static const FLinearColor GridColourSmall;           /**< Colour for minor grid lines. */
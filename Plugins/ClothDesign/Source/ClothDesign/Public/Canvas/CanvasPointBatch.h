@@ -0,0 +1,75 @@
+#ifndef FCanvasPointBatch_H
+#define FCanvasPointBatch_H
+
+#include "CoreMinimal.h"
+#include "Rendering/RenderingCommon.h"
+#include "Layout/Geometry.h"
+
+class FSlateWindowElementList;
+
+
+/**
+ * @brief Collects point boxes and handle lines of one paint layer into a single vertex batch.
+ *
+ * Drawing every control point and handle endpoint with its own MakeBox element costs one
+ * draw element (and one paint geometry) per point, which dominates paint time for
+ * patterns imported with thousands of points. This batch builds untextured quads in
+ * window space and submits them as one custom-verts element, so a whole layer of points
+ * and handles is one draw call regardless of point count.
+ */
+class FCanvasPointBatch
+{
+public:
+	/**
+	 * @brief Starts an empty batch for a widget.
+	 * @param Geo Geometry the local (widget-space) positions are relative to.
+	 */
+	explicit FCanvasPointBatch(const FGeometry& Geo);
+
+	/**
+	 * @brief Adds an axis-aligned box centred on a point.
+	 * @param LocalCentre Centre in widget-local coordinates.
+	 * @param HalfSize Half the box edge length in local units.
+	 * @param Colour Box colour.
+	 */
+	void AddBox(const FVector2D& LocalCentre, float HalfSize, const FLinearColor& Colour);
+
+	/**
+	 * @brief Adds a straight line as a thin quad.
+	 * @param LocalStart Start in widget-local coordinates.
+	 * @param LocalEnd End in widget-local coordinates.
+	 * @param Thickness Line width in local units.
+	 * @param Colour Line colour.
+	 *
+	 * Used for Bezier handle lines, which are short and do not need anti-aliasing.
+	 */
+	void AddLine(const FVector2D& LocalStart, const FVector2D& LocalEnd, float Thickness, const FLinearColor& Colour);
+
+	/**
+	 * @brief Appends the batch to the element list as one custom-verts element.
+	 * @param OutDraw Slate element list to append to.
+	 * @param Layer Layer to draw on.
+	 *
+	 * Does nothing for an empty batch. The batch is cleared afterwards so it can be reused.
+	 */
+	void Submit(FSlateWindowElementList& OutDraw, int32 Layer);
+
+	/** @return Number of quads added since the last submit. */
+	int32 NumQuads() const { return Vertices.Num() / 4; }
+
+	/** @return Window-space vertices, four per quad. */
+	const TArray<FSlateVertex>& GetVertices() const { return Vertices; }
+
+	/** @return Triangle indices, six per quad. */
+	const TArray<SlateIndex>& GetIndices() const { return Indices; }
+
+private:
+	/** @brief Appends a quad given its four local corners in winding order. */
+	void AddQuad(const FVector2f& A, const FVector2f& B, const FVector2f& C, const FVector2f& D, const FLinearColor& Colour);
+
+	FSlateRenderTransform RenderTransform; /**< Local to window space, including DPI scale. */
+	TArray<FSlateVertex> Vertices;         /**< Four vertices per quad. */
+	TArray<SlateIndex> Indices;            /**< Two triangles per quad. */
+};
+
+#endif
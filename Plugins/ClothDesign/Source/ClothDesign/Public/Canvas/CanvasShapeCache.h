@@ -0,0 +1,131 @@
+#ifndef FCanvasShapeCache_H
+#define FCanvasShapeCache_H
+
+#include "CoreMinimal.h"
+#include "Math/InterpCurve.h"
+#include "Math/Box2D.h"
+#include "Canvas/CanvasShapeTransform.h"
+
+struct FSeamDefinition;
+
+
+/**
+ * @brief Tessellated copy of one completed shape in the shape's local space.
+ *
+ * Segment i of the shape spans Polyline[SegmentStarts[i]] .. Polyline[SegmentStarts[i + 1]].
+ * For closed shapes the last segment is the straight line back to the first point.
+ */
+struct FCanvasCachedShape
+{
+	TArray<FVector2D> Polyline;           ///< Sampled curve in local space
+	TArray<int32> SegmentStarts;          ///< Start of each segment in Polyline, plus one end entry
+	TBitArray<> SewnSegments;             ///< Segments that lie on a seam edge
+	FBox2D Bounds = FBox2D(ForceInit);    ///< Local bounds of the polyline
+	FBox2D ControlBounds = FBox2D(ForceInit); ///< Local bounds of control points and Bezier handle ends
+	bool bClosed = false;                 ///< Whether the last segment closes the loop
+	bool bGeometryDirty = true;           ///< Polyline must be re-sampled before use
+	bool bSeamsDirty = true;              ///< SewnSegments must be rebuilt before use
+
+	/** @return Number of segments, including the closing one. */
+	int32 NumSegments() const { return FMath::Max(0, SegmentStarts.Num() - 1); }
+};
+
+/**
+ * @brief Per-shape tessellation cache for painting completed shapes.
+ *
+ * Sampling every Bezier segment and rebuilding the sewn-segment set each frame
+ * dominates paint time for larger patterns. This cache keeps the results in each
+ * shape's local space, so panning, zooming and moving whole shapes reuse them and
+ * only point edits trigger a rebuild. The cached bounds also let paint skip shapes
+ * and seams outside the view.
+ */
+class FCanvasShapeCache
+{
+public:
+	/** Samples taken per curve segment; matches the in-progress curve's smoothness. */
+	static constexpr int32 SamplesPerSegment = 10;
+
+	/**
+	 * @brief Returns the cached data for a shape, rebuilding stale parts first.
+	 * @param ShapeIndex Index of the shape in the completed shapes array.
+	 * @param Shape Control points of the shape.
+	 * @param Seams All seam definitions on the canvas.
+	 * @return Up-to-date cached shape.
+	 */
+	const FCanvasCachedShape& GetShape(
+		int32 ShapeIndex,
+		const FInterpCurve<FVector2D>& Shape,
+		const TArray<FSeamDefinition>& Seams);
+
+	/**
+	 * @brief Matches the cache size to the number of completed shapes.
+	 * @param NumShapes Current number of completed shapes.
+	 *
+	 * New entries start dirty; entries past the end are dropped.
+	 */
+	void SetNumShapes(int32 NumShapes);
+
+	/**
+	 * @brief Flags one shape for re-sampling after its points or tangents changed.
+	 * @param ShapeIndex Index of the edited shape.
+	 */
+	void MarkShapeDirty(int32 ShapeIndex);
+
+	/**
+	 * @brief Records that a shape's placement changed while its points did not.
+	 * @param ShapeIndex Index of the moved shape.
+	 *
+	 * Keeps the tessellation; only seam bounds and the cached layer are refreshed.
+	 */
+	void MarkShapeMoved(int32 ShapeIndex);
+
+	/** @brief Flags the sewn segments of every shape after seams changed. */
+	void MarkSeamsDirty();
+
+	/**
+	 * @brief Returns world-space bounds of every seam's two connector lines.
+	 * @param Seams All seam definitions on the canvas.
+	 * @param Shapes Completed shapes the seams refer to.
+	 * @param Transforms Placement of each shape; missing entries are identity.
+	 * @return One box per seam; an invalid box means the seam cannot be culled.
+	 *
+	 * Rebuilt only after seams or shape geometry changed.
+	 */
+	const TArray<FBox2D>& GetSeamBounds(
+		const TArray<FSeamDefinition>& Seams,
+		const TArray<FInterpCurve<FVector2D>>& Shapes,
+		const TArray<FShapeTransform2D>& Transforms = TArray<FShapeTransform2D>());
+
+	/** @brief Flags everything for rebuild (e.g. after undo or loading). */
+	void InvalidateAll();
+
+	/**
+	 * @brief Sets the shape drawn on top of the cached canvas layer.
+	 * @param ShapeIndex Shape being dragged, or INDEX_NONE.
+	 *
+	 * Edits to the active shape do not change the static version, so dragging it
+	 * never forces the cached layer to repaint.
+	 */
+	void SetActiveShape(int32 ShapeIndex);
+
+	/** @return Counter that changes whenever content outside the active shape changes. */
+	uint32 GetStaticVersion() const { return StaticVersion; }
+
+	/**
+	 * @brief Samples a curve into a polyline in the curve's own space.
+	 * @param Shape Control points of the shape.
+	 * @param Out Cached shape to fill.
+	 *
+	 * Each sample is evaluated once and shared by the two segments it joins.
+	 */
+	static void Tessellate(const FInterpCurve<FVector2D>& Shape, FCanvasCachedShape& Out);
+
+private:
+	TArray<FCanvasCachedShape> Entries; /**< One entry per completed shape, same order. */
+	TArray<FBox2D> SeamBounds;          /**< One box per seam definition, same order. */
+	bool bSeamBoundsDirty = true;       /**< SeamBounds must be rebuilt before use. */
+	int32 ActiveShapeIndex = INDEX_NONE; /**< Shape whose edits leave StaticVersion unchanged. */
+	uint32 StaticVersion = 0;           /**< Bumped by every change to cached static content. */
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef FShapeTransform2D_H
+#define FShapeTransform2D_H
+
+#include "CoreMinimal.h"
+#include "Math/Box2D.h"
+
+
+/**
+ * @brief Rigid 2D placement of a completed shape on the canvas.
+ *
+ * Completed shapes keep their control points in local space and carry one of these,
+ * so moving or rotating a whole piece changes two numbers instead of every point.
+ * Tessellation caches, undo records and triangulated meshes are all built in local
+ * space and stay valid across moves; only the placement on the canvas (and the 3D
+ * actor transform) changes. World = Rotate(Local) + Translation.
+ */
+struct FShapeTransform2D
+{
+	FVector2D Translation = FVector2D::ZeroVector; ///< Canvas-space offset applied after rotation
+	double RotationDegrees = 0.0;                  ///< Counter-clockwise rotation about the local origin
+
+	/** @return Canvas-space position of a local point. */
+	FVector2D TransformPoint(const FVector2D& Local) const;
+
+	/** @return Canvas-space direction of a local vector (e.g. a tangent); translation is ignored. */
+	FVector2D TransformVector(const FVector2D& Local) const;
+
+	/** @return Local position of a canvas-space point. */
+	FVector2D InverseTransformPoint(const FVector2D& World) const;
+
+	/** @return Canvas-space box enclosing a transformed local box; invalid boxes stay invalid. */
+	FBox2D TransformBox(const FBox2D& Local) const;
+
+	/**
+	 * @brief Rotates the placement about a fixed canvas-space point.
+	 * @param WorldPivot Point that keeps its canvas position.
+	 * @param DeltaDegrees Counter-clockwise rotation to add.
+	 */
+	void RotateAbout(const FVector2D& WorldPivot, double DeltaDegrees);
+
+	/** @return Whether this leaves local coordinates unchanged. */
+	bool IsIdentity() const { return Translation.IsZero() && RotationDegrees == 0.0; }
+
+	bool operator==(const FShapeTransform2D& Other) const
+	{
+		return Translation == Other.Translation && RotationDegrees == Other.RotationDegrees;
+	}
+	bool operator!=(const FShapeTransform2D& Other) const { return !(*this == Other); }
+
+	/**
+	 * @brief Looks up a shape's transform, treating missing entries as identity.
+	 * @param Transforms Per-shape transforms, index-aligned with the completed shapes.
+	 * @param ShapeIndex Shape to look up.
+	 * @return The shape's transform, or the identity.
+	 */
+	static const FShapeTransform2D& Get(const TArray<FShapeTransform2D>& Transforms, int32 ShapeIndex);
+
+	/** The transform that leaves points unchanged. */
+	static const FShapeTransform2D Identity;
+};
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef FCanvasSpatialIndex_H
+#define FCanvasSpatialIndex_H
+
+#include "CoreMinimal.h"
+#include "Math/InterpCurve.h"
+#include "Canvas/CanvasShapeTransform.h"
+
+struct FSeamDefinition;
+
+
+/**
+ * @brief Kind of element stored in the canvas hit-test index.
+ */
+enum class ECanvasHitType : uint8
+{
+	Point,         /**< Control point of a completed shape. */
+	ArriveHandle,  /**< Arrive tangent handle end of a Bezier point. */
+	LeaveHandle,   /**< Leave tangent handle end of a Bezier point. */
+	SeamLine       /**< One of the two connector lines of a seam. */
+};
+
+/**
+ * @brief One indexed element; points and handles are stored as zero-length segments.
+ */
+struct FCanvasHitItem
+{
+	FVector2D A = FVector2D::ZeroVector; ///< Segment start in world space
+	FVector2D B = FVector2D::ZeroVector; ///< Segment end in world space (equals A for points and handles)
+	ECanvasHitType Type = ECanvasHitType::Point;
+	int32 Index = INDEX_NONE;            ///< Shape index, or seam index for seam lines
+	int32 SubIndex = INDEX_NONE;         ///< Point index within the shape; unused for seam lines
+};
+
+
+/**
+ * @brief Uniform-grid index over completed-shape points, handle ends and seam lines.
+ *
+ * Selecting and sewing used to scan every point, handle and seam on each click. The
+ * index buckets these elements by world-space cell so a click only tests the few
+ * elements near it. It is updated lazily: edit sites mark shapes or seams dirty, and
+ * the next Sync re-buckets only those. Elements of the in-progress curve are not
+ * indexed; they change on every click and are few.
+ */
+class FCanvasSpatialIndex
+{
+public:
+	/** World-space edge length of one grid cell. */
+	static constexpr float CellSize = 32.f;
+
+	/** Cells a single seam line may cover before it is kept in the linear fallback list. */
+	static constexpr int32 MaxCellsPerSegment = 1024;
+
+	/**
+	 * @brief Brings the index up to date with the canvas data.
+	 * @param Shapes Completed shapes.
+	 * @param BezierFlags Per-shape flags; handles are only indexed for Bezier points.
+	 * @param Seams All seam definitions.
+	 * @param Transforms Placement of each shape; missing entries are identity.
+	 *
+	 * Shapes whose point count no longer matches are re-indexed even if not marked,
+	 * so an unreported edit can at worst leave positions stale, never out of range.
+	 */
+	void Sync(
+		const TArray<FInterpCurve<FVector2D>>& Shapes,
+		const TArray<TArray<bool>>& BezierFlags,
+		const TArray<FSeamDefinition>& Seams,
+		const TArray<FShapeTransform2D>& Transforms = TArray<FShapeTransform2D>());
+
+	/**
+	 * @brief Flags one shape for re-indexing after its points, tangents or placement changed.
+	 * @param ShapeIndex Index of the edited shape.
+	 */
+	void MarkShapeDirty(int32 ShapeIndex);
+
+	/** @brief Flags every seam line for re-indexing after seams changed. */
+	void MarkSeamsDirty();
+
+	/** @brief Flags everything for re-indexing (e.g. after undo or loading). */
+	void InvalidateAll();
+
+	/**
+	 * @brief Finds the nearest element of the given types closer than a distance.
+	 * @param Pos Query position in world space.
+	 * @param Types Element types to consider.
+	 * @param InOutBestDistSq Squared search radius in; squared distance of the hit out.
+	 * @param OutHit Nearest element; only written on a hit.
+	 * @return Whether an element strictly closer than the radius was found.
+	 */
+	bool FindNearest(
+		const FVector2D& Pos,
+		std::initializer_list<ECanvasHitType> Types,
+		float& InOutBestDistSq,
+		FCanvasHitItem& OutHit) const;
+
+	/** @return Number of occupied grid cells. */
+	int32 NumCells() const { return Cells.Num(); }
+
+	/**
+	 * @brief Squared distance from a point to a line segment.
+	 * @param P The point to measure from.
+	 * @param A Segment start.
+	 * @param B Segment end.
+	 * @return Squared distance from P to segment AB.
+	 */
+	static float DistPointToSegmentSq(const FVector2D& P, const FVector2D& A, const FVector2D& B);
+
+private:
+	/** @return Cell containing a world position. */
+	static FIntPoint CellOf(const FVector2D& Pos);
+
+	/** @brief Adds an item to every cell its segment overlaps, recording the cells used. */
+	void Insert(const FCanvasHitItem& Item, TSet<FIntPoint>& OutCells);
+
+	/** @brief Removes the items matching a predicate from the given cells. */
+	void RemoveFromCells(const TSet<FIntPoint>& CellKeys, TFunctionRef<bool(const FCanvasHitItem&)> Pred);
+
+	/** @brief Re-buckets the points and handles of one shape. */
+	void IndexShape(int32 ShapeIndex, const FInterpCurve<FVector2D>& Shape, const TArray<bool>& Flags, const FShapeTransform2D& Transform);
+
+	/** @brief Re-buckets both connector lines of one seam. */
+	void IndexSeam(int32 SeamIndex, const FSeamDefinition& Seam, const TArray<FInterpCurve<FVector2D>>& Shapes, const TArray<FShapeTransform2D>& Transforms);
+
+	TMap<FIntPoint, TArray<FCanvasHitItem>> Cells; /**< Items bucketed by world-space cell. */
+	TArray<FCanvasHitItem> Unbucketed;            /**< Seam lines too long to bucket; tested linearly. */
+
+	TArray<TSet<FIntPoint>> ShapeCells;           /**< Cells holding each shape's items. */
+	TArray<int32> ShapePointCounts;               /**< Point count each shape was indexed with. */
+	TBitArray<> DirtyShapes;                      /**< Shapes to re-index on the next Sync. */
+
+	TArray<TSet<FIntPoint>> SeamCells;            /**< Cells holding each seam's lines. */
+	bool bSeamsDirty = true;                      /**< All seams must be re-indexed on the next Sync. */
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define FCanvasState_H
 
 # include "PatternCreation/PatternSewing.h"
+# include "Canvas/CanvasShapeTransform.h"
 
 /*
  * Thesis reference:
@@ -77,6 +78,14 @@ struct FCanvasState
      */
     TArray<TArray<bool>> CompletedBezierFlags;
 
+    /**
+     * @brief Placement of each completed shape on the canvas.
+     *
+     * Shapes keep their points in local space; moving or rotating a piece only
+     * changes its entry here, so caches and meshes built from the points stay valid.
+     */
+    TArray<FShapeTransform2D> CompletedShapeTransforms;
+
     // --- Sewing data ---
 
     /**
@@ -138,6 +147,7 @@ struct FCanvasState
                 bUseBezierPerPoint == Other.bUseBezierPerPoint && 
                 CompletedShapes == Other.CompletedShapes &&
                 CompletedBezierFlags == Other.CompletedBezierFlags &&
+                CompletedShapeTransforms == Other.CompletedShapeTransforms &&
                 SelectedPointIndex == Other.SelectedPointIndex &&
                 PanOffset == Other.PanOffset &&
                 FMath::IsNearlyEqual(ZoomFactor, Other.ZoomFactor);
@@ -0,0 +1,43 @@
+#ifndef SCanvasStaticLayer_H
+#define SCanvasStaticLayer_H
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+
+class SClothDesignCanvas;
+
+
+/**
+ * @brief Paints the canvas content that does not change during an interaction.
+ *
+ * Background, grid, finalised seams and every completed shape except the one
+ * being dragged are drawn here. The canvas wraps this widget in an invalidation
+ * panel, so its draw elements are cached and replayed until the canvas
+ * invalidates it; the active shape is painted live on top by the canvas itself.
+ */
+class SCanvasStaticLayer : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SCanvasStaticLayer) : _Canvas(nullptr) {}
+		/** Canvas whose static content this layer paints. */
+		SLATE_ARGUMENT(SClothDesignCanvas*, Canvas)
+	SLATE_END_ARGS()
+
+	/**
+	 * @brief Constructs the layer for the given canvas.
+	 * @param InArgs Slate construction arguments.
+	 */
+	void Construct(const FArguments& InArgs);
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry,
+						  const FSlateRect& CullingRect, FSlateWindowElementList& OutDrawElements,
+						  int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+	/** @return Zero; the layer always fills the canvas it belongs to. */
+	virtual FVector2D ComputeDesiredSize(float) const override { return FVector2D::ZeroVector; }
+
+private:
+	SClothDesignCanvas* Canvas = nullptr; /**< Owning canvas; outlives this child widget. */
+};
+
+#endif
@@ -0,0 +1,196 @@
+#ifndef FCanvasUndoHistory_H
+#define FCanvasUndoHistory_H
+
+#include "CoreMinimal.h"
+#include "Math/InterpCurve.h"
+#include "PatternCreation/PatternSewing.h"
+#include "Canvas/CanvasShapeTransform.h"
+
+
+/**
+ * @brief Parts of the canvas an undoable edit can touch.
+ *
+ * Each edit declares what it is about to change, so only that part is recorded.
+ */
+enum class ECanvasUndoScope : uint8
+{
+	None         = 0,      ///< Only selection and view are recorded
+	CurrentCurve = 1 << 0, ///< The in-progress curve and its Bezier flags
+	Shape        = 1 << 1, ///< A single completed shape
+	ShapeCount   = 1 << 2, ///< Completed shapes are added or removed at the end
+	AllShapes    = 1 << 3, ///< Every completed shape (e.g. clearing the canvas)
+	Seams        = 1 << 4, ///< Seam definitions, constraints and the seam click workflow
+	ShapeMove    = 1 << 5  ///< Only the placement of a single completed shape
+};
+ENUM_CLASS_FLAGS(ECanvasUndoScope)
+
+/**
+ * @brief Recorded copy of one completed shape.
+ */
+struct FCanvasShapeUndoRecord
+{
+	int32 ShapeIndex = INDEX_NONE;      ///< Index of the shape in the completed shapes array
+	FInterpCurve<FVector2D> Curve;      ///< Control points of the shape
+	TArray<bool> BezierFlags;           ///< Per-point Bezier flags of the shape
+	FShapeTransform2D Transform;        ///< Placement of the shape on the canvas
+};
+
+/**
+ * @brief Recorded placement of one completed shape; its points are not copied.
+ */
+struct FCanvasShapeMoveUndoRecord
+{
+	int32 ShapeIndex = INDEX_NONE;      ///< Index of the moved shape
+	FShapeTransform2D Transform;        ///< Placement of the shape on the canvas
+};
+
+/**
+ * @brief Recorded copy of the sewing workflow.
+ */
+struct FCanvasSeamUndoRecord
+{
+	TArray<FSeamDefinition> SeamDefinitions;            ///< Seam definitions on the canvas
+	TArray<FPatternSewingConstraint> AllDefinedSeams;   ///< Runtime constraints matching the definitions
+	TMap<int32, TSet<int32>> PreviewPoints;             ///< Points highlighted while a seam is being built
+	ESeamClickState ClickState = ESeamClickState::None; ///< Step of the four-click seam workflow
+	FClickTarget AStart, AEnd, BStart, BEnd;            ///< Targets clicked so far
+};
+
+/**
+ * @brief One undo step: only the parts of the canvas an edit touched.
+ *
+ * Untouched shapes are not copied at all, so recording and applying a delta
+ * costs as much as the edit itself rather than the whole pattern. Applying a
+ * delta swaps its contents with the live canvas, which leaves the delta holding
+ * exactly the data needed to reverse it again.
+ */
+struct FCanvasUndoDelta
+{
+	ECanvasUndoScope Scope = ECanvasUndoScope::None; ///< Parts of the canvas recorded in this delta
+
+	FInterpCurve<FVector2D> CurvePoints;             ///< In-progress curve (CurrentCurve scope)
+	TArray<bool> bUseBezierPerPoint;                 ///< In-progress Bezier flags (CurrentCurve scope)
+
+	TArray<FCanvasShapeUndoRecord> Shapes;           ///< Completed shapes touched by the edit
+	int32 NumCompletedShapes = INDEX_NONE;           ///< Shape count to restore, or INDEX_NONE if unchanged
+	TArray<FCanvasShapeMoveUndoRecord> Moves;        ///< Shape placements (ShapeMove scope)
+
+	FCanvasSeamUndoRecord Seams;                     ///< Sewing state (Seams scope)
+
+	FVector2D PanOffset = FVector2D::ZeroVector;     ///< View pan at the time of the edit
+	float ZoomFactor = 1.f;                          ///< View zoom at the time of the edit
+	int32 SelectedSeamIndex = INDEX_NONE;            ///< Seam selection at the time of the edit
+
+	/**
+	 * @brief Approximate heap and inline memory held by this delta.
+	 * @return Size in bytes, used to enforce the history memory cap.
+	 */
+	SIZE_T GetAllocatedSize() const;
+};
+
+/**
+ * @brief References to the live canvas data an undo delta reads and writes.
+ *
+ * Keeps the history independent of the Slate widget so it can be unit tested.
+ */
+struct FCanvasUndoTarget
+{
+	FInterpCurve<FVector2D>& CurvePoints;
+	TArray<bool>& bUseBezierPerPoint;
+	TArray<FInterpCurve<FVector2D>>& CompletedShapes;
+	TArray<TArray<bool>>& CompletedBezierFlags;
+	TArray<FShapeTransform2D>& CompletedShapeTransforms;
+	FPatternSewing& Sewing;
+	FVector2D& PanOffset;
+	float& ZoomFactor;
+	int32& SelectedSeamIndex;
+};
+
+/**
+ * @brief Delta-based undo/redo history with a memory cap.
+ *
+ * Shapes are only ever appended to or truncated from the end of the completed
+ * shapes array, so a shape's index is a stable identity for the lifetime of
+ * the history. Loading a different pattern resets the history.
+ */
+class FCanvasUndoHistory
+{
+public:
+	/**
+	 * @brief Records the parts of the canvas an edit is about to change.
+	 * @param Target Live canvas data.
+	 * @param Scope Parts of the canvas the edit touches.
+	 * @param ShapeIndex Shape touched by a Shape-scoped edit.
+	 * @return A delta holding copies of only the requested parts.
+	 */
+	static FCanvasUndoDelta Capture(const FCanvasUndoTarget& Target, ECanvasUndoScope Scope, int32 ShapeIndex = INDEX_NONE);
+
+	/**
+	 * @brief Applies a delta to the canvas by swapping their contents.
+	 * @param Target Live canvas data.
+	 * @param Delta Delta to apply; afterwards it holds the inverse edit.
+	 */
+	static void Apply(const FCanvasUndoTarget& Target, FCanvasUndoDelta& Delta);
+
+	/**
+	 * @brief Pushes an edit onto the undo stack and clears the redo stack.
+	 * @param Delta Delta captured before the edit.
+	 *
+	 * The oldest steps are dropped once the history exceeds its memory cap.
+	 */
+	void Record(FCanvasUndoDelta&& Delta);
+
+	/**
+	 * @brief Reverts the most recent edit.
+	 * @param Target Live canvas data.
+	 * @param OutEditedShapes Optional; receives the existing shapes whose points changed.
+	 * @return True if there was an edit to undo.
+	 */
+	bool Undo(const FCanvasUndoTarget& Target, TArray<int32>* OutEditedShapes = nullptr);
+
+	/**
+	 * @brief Reapplies the most recently undone edit.
+	 * @param Target Live canvas data.
+	 * @param OutEditedShapes Optional; receives the existing shapes whose points changed.
+	 * @return True if there was an edit to redo.
+	 */
+	bool Redo(const FCanvasUndoTarget& Target, TArray<int32>* OutEditedShapes = nullptr);
+
+	/** @brief Drops all undo and redo steps. */
+	void Reset();
+
+	/**
+	 * @brief Sets the memory cap for the whole history.
+	 * @param InMaxMemoryBytes Cap in bytes; the newest step is always kept.
+	 */
+	void SetMaxMemoryBytes(SIZE_T InMaxMemoryBytes);
+
+	SIZE_T GetMaxMemoryBytes() const { return MaxMemoryBytes; }
+	SIZE_T GetUsedMemoryBytes() const { return UsedMemoryBytes; }
+	int32 NumUndoSteps() const { return UndoStack.Num(); }
+	int32 NumRedoSteps() const { return RedoStack.Num(); }
+
+	/** @return Scope of the step Undo would revert; None if there is nothing to undo. */
+	ECanvasUndoScope GetNextUndoScope() const { return UndoStack.Num() > 0 ? UndoStack.Last().Scope : ECanvasUndoScope::None; }
+
+	/** @return Scope of the step Redo would reapply; None if there is nothing to redo. */
+	ECanvasUndoScope GetNextRedoScope() const { return RedoStack.Num() > 0 ? RedoStack.Last().Scope : ECanvasUndoScope::None; }
+
+private:
+	/**
+	 * @brief Applies a delta and lists the shapes whose points it swapped.
+	 *
+	 * Placement-only and selection-only steps list nothing; shapes removed by the step are left out.
+	 */
+	static void ApplyAndCollect(const FCanvasUndoTarget& Target, FCanvasUndoDelta& Delta, TArray<int32>* OutEditedShapes);
+
+	/** @brief Drops the oldest undo steps until the history fits its cap. */
+	void EnforceMemoryCap();
+
+	TArray<FCanvasUndoDelta> UndoStack;             /**< Oldest step first. */
+	TArray<FCanvasUndoDelta> RedoStack;             /**< Most recently undone step last. */
+	SIZE_T UsedMemoryBytes = 0;                     /**< Sum of GetAllocatedSize over both stacks. */
+	SIZE_T MaxMemoryBytes = 64 * 1024 * 1024;       /**< Memory cap for both stacks together. */
+};
+
+#endif
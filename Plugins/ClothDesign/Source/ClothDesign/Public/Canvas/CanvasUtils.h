@@ -15,8 +15,8 @@
 /**
  * @brief Utility functions for managing canvas state and mesh operations.
  * 
- * This class centralises common operations on canvas states and mesh geometry,
- * providing support for undo/redo functionality and geometric transformations,
+ * This class centralises common operations on canvas curves and mesh geometry,
+ * providing support for tangent recalculation and geometric transformations,
  * so that these behaviours are consistent and maintainable across the application.
  */
 class FCanvasUtils
@@ -24,59 +24,43 @@ class FCanvasUtils
 	
 public:
 	/**
-	 * @brief Saves the current canvas state for undo purposes.
-	 * @param UndoStack Stack storing previous canvas states.
-	 * @param RedoStack Stack storing states that can be redone.
-	 * @param CurrentState The current canvas state to save.
-	 * 
-	 * This method ensures that changes can be reverted by maintaining a history of canvas states,
-	 * preventing loss of user work and enabling undo functionality.
-	 */
-	static void SaveStateForUndo(
-	  TArray<FCanvasState>& UndoStack,
-	  TArray<FCanvasState>& RedoStack,
-	  const FCanvasState& CurrentState);
-
-	/**
-	 * @brief Reverts the canvas to the previous state.
-	 * @param UndoStack Stack storing previous canvas states.
-	 * @param RedoStack Stack storing states that can be redone.
-	 * @param CurrentState The canvas state to update with the previous state.
-	 * @return True if the undo operation was successful, false otherwise.
+	 * @brief Recalculates tangents for a non-bezier/linear point curve.
+	 * @param Curve The curve to update.
+	 * @param bBezierFlags Flags indicating which points are Bezier handles.
 	 * 
-	 * Undo exists to allow users to safely experiment with designs without fear of making irreversible changes.
+	 * This ensures that curve tangents remain consistent after edits,
+	 * preserving smoothness and predictable behaviour in drawn paths.
 	 */
-	static bool Undo(
-	  TArray<FCanvasState>& UndoStack,
-	  TArray<FCanvasState>& RedoStack,
-	  FCanvasState& CurrentState);
+	static void RecalculateNTangents(
+		FInterpCurve<FVector2D>& Curve,
+		const TArray<bool>&      bBezierFlags);
 
 	/**
-	 * @brief Reapplies a previously undone canvas state.
-	 * @param UndoStack Stack storing previous canvas states.
-	 * @param RedoStack Stack storing states that can be redone.
-	 * @param CurrentState The canvas state to update with the redone state.
-	 * @return True if the redo operation was successful, false otherwise.
+	 * @brief Recalculates N-point tangents affected by moving a single point.
+	 * @param Curve The curve to update.
+	 * @param bBezierFlags Flags indicating which points are Bezier handles.
+	 * @param PointIndex Index of the point that moved.
 	 * 
-	 * Redo complements undo by allowing users to restore states they have reverted,
-	 * supporting flexible design experimentation.
+	 * Only the moved point and its two neighbours depend on its position, so dragging
+	 * a point costs the same on a curve of any length.
 	 */
-	static bool Redo(
-	  TArray<FCanvasState>& UndoStack,
-	  TArray<FCanvasState>& RedoStack,
-	  FCanvasState& CurrentState);
+	static void RecalculateNTangentsAround(
+		FInterpCurve<FVector2D>& Curve,
+		const TArray<bool>&      bBezierFlags,
+		int32                    PointIndex);
 
 	/**
-	 * @brief Recalculates tangents for a non-bezier/linear point curve.
+	 * @brief Recalculates N-point tangents for a contiguous range of points.
 	 * @param Curve The curve to update.
 	 * @param bBezierFlags Flags indicating which points are Bezier handles.
-	 * 
-	 * This ensures that curve tangents remain consistent after edits,
-	 * preserving smoothness and predictable behaviour in drawn paths.
+	 * @param FirstIndex First point to update; clamped to the curve.
+	 * @param LastIndex Last point to update (inclusive); clamped to the curve.
 	 */
-	static void RecalculateNTangents(
+	static void RecalculateNTangentsInRange(
 		FInterpCurve<FVector2D>& Curve,
-		const TArray<bool>&      bBezierFlags);
+		const TArray<bool>&      bBezierFlags,
+		int32                    FirstIndex,
+		int32                    LastIndex);
 
 	/**
 	 * @brief Computes the area-weighted centroid of a dynamic mesh.
@@ -108,6 +92,16 @@ public:
 	 */
 	static void TranslateDynamicMeshBy(UE::Geometry::FDynamicMesh3& Mesh, const FVector3d& Offset);
 
+	/**
+	 * @brief Checks whether a point lies inside a closed polyline (even-odd rule).
+	 * @param P The point to test.
+	 * @param Polyline Outline vertices; the last connects back to the first.
+	 * @return True if the point is inside.
+	 *
+	 * Used to pick whole shapes by clicking inside them.
+	 */
+	static bool IsPointInPolyline(const FVector2D& P, const TArray<FVector2D>& Polyline);
+
 };
 
 #endif
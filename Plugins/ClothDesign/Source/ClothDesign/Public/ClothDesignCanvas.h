@@ -9,6 +9,14 @@
 #include "Misc/PackageName.h"
 #include "PatternCreation/PatternAssets.h"
 #include "PatternCreation/PatternSewing.h"
+#include "Canvas/CanvasUndoHistory.h"
+#include "Canvas/CanvasShapeCache.h"
+#include "Canvas/CanvasSpatialIndex.h"
+#include "Canvas/CanvasBackgroundTiles.h"
+#include "PatternCreation/PatternLiveDeform.h"
+#include "PatternCreation/PatternRetriangulation.h"
+#include "PatternCreation/PatternAssetSaver.h"
+#include "PatternCreation/PatternImport.h"
 
 /*
  * Thesis reference:
@@ -93,6 +101,43 @@ public:
 						  const FSlateRect& CullingRect, FSlateWindowElementList& OutDrawElements,
 						  int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
 
+	/**
+	 * @brief Keeps the cached static layer in sync with the canvas state.
+	 *
+	 * Compares a key of everything the cached layer draws and invalidates it only when
+	 * that key changes, so dragging a single shape never repaints the rest of the pattern.
+	 *
+	 * @param AllottedGeometry Geometry of the widget.
+	 * @param InCurrentTime Current application time.
+	 * @param InDeltaTime Time since the last tick.
+	 */
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+
+	/**
+	 * @brief Returns the completed shape currently being dragged.
+	 *
+	 * The active shape is left out of the cached layer and painted live on top.
+	 *
+	 * @return Index of the dragged completed shape, or INDEX_NONE.
+	 */
+	int32 GetActiveShapeIndex() const;
+
+	/**
+	 * @brief Places a completed shape on the canvas without touching its points.
+	 * @param ShapeIndex Shape to place.
+	 * @param NewTransform New canvas placement.
+	 *
+	 * Tessellation and meshes are kept; the shape's 3D actor is moved by the same amount.
+	 */
+	void SetShapeTransform(int32 ShapeIndex, const FShapeTransform2D& NewTransform);
+
+	/**
+	 * @brief Rotates the selected completed shape about the centre of its bounds.
+	 * @param DeltaDegrees Counter-clockwise rotation to add.
+	 * @return True if a completed shape was selected.
+	 */
+	bool RotateSelectedShape(double DeltaDegrees);
+
 	// --- Mouse and key handling ---
 
 	/**
@@ -201,18 +246,44 @@ public:
 	 */
 	FReply OnModeButtonClicked(EClothEditorMode NewMode);
 
-	// --- Undo/Redo stacks ---
+	// --- Undo/Redo ---
+
+	/** Delta-based undo/redo history; each step records only what an edit touched. */
+	FCanvasUndoHistory UndoHistory; /**< Bounded by the ClothDesign.UndoMemoryMB console variable. */
+
+	/**
+	 * @brief Records the parts of the canvas an edit is about to change.
+	 *
+	 * Call before mutating canvas data so the edit can be undone. Only the
+	 * declared scope is copied, keeping undo cheap on large patterns.
+	 *
+	 * @param Scope Parts of the canvas the edit touches.
+	 * @param ShapeIndex Completed shape touched by a Shape-scoped edit.
+	 */
+	void SaveStateForUndo(ECanvasUndoScope Scope, int32 ShapeIndex = INDEX_NONE);
 
-	/** Undo history for canvas states; used to revert user actions. */
-	TArray<FCanvasState> UndoStack; /**< Maintains past states for undo operations. */
+	/**
+	 * @brief Records a state captured earlier, once the edit is known to change something.
+	 * @param Before Delta from FCanvasUndoHistory::Capture taken before the edit.
+	 */
+	void SaveStateForUndo(FCanvasUndoDelta&& Before);
 
-	/** Redo history for canvas states; used to reapply undone actions. */
-	TArray<FCanvasState> RedoStack; /**< Maintains states that can be redone. */
+	/**
+	 * @brief Reverts the most recent recorded edit.
+	 * @return true if an edit was undone.
+	 */
+	bool UndoLastEdit();
+
+	/**
+	 * @brief Reapplies the most recently undone edit.
+	 * @return true if an edit was redone.
+	 */
+	bool RedoLastEdit();
 
 	/**
 	 * @brief Returns a copy of the current canvas state.
 	 *
-	 * Used by undo/redo code and by save/load operations so callers obtain a
+	 * Used by save/load operations so callers obtain a
 	 * serialisable snapshot rather than relying on scattered member reads.
 	 *
 	 * @return A copy of the current FCanvasState.
@@ -308,12 +379,37 @@ public:
 
 	// --- Sewing / merging / mesh generation UI callbacks ---
 
+	/**
+	 * @brief Refits dense completed shapes with fewer Bezier and N-points (UI button callback).
+	 *
+	 * Uses the ClothDesign.FitTolerance deviation; shapes referenced by seams are left
+	 * alone because seams address their points by index. Undoable.
+	 */
+	void SimplifyShapesClick();
+
 	/** Initiates the seam click workflow (UI button callback). */
 	void SewingClick();
 
-	/** Merges selected sewn pieces (UI button callback). */
+	/** Previews merging the sewn pieces (UI button callback). */
 	void MergeClick();
 
+	/** Commits the previewed merge (UI button callback). */
+	void CommitMergeClick();
+
+	/**
+	 * @brief Returns the path of the body mesh merged garments are skinned to.
+	 *
+	 * @return Path string of the body skeletal mesh, or empty if none.
+	 */
+	FString GetSkinningBodyMeshPath() const;
+
+	/**
+	 * @brief Callback invoked when a body skeletal mesh is chosen for skinning.
+	 *
+	 * @param AssetData Asset metadata for the chosen skeletal mesh.
+	 */
+	void OnSkinningBodyMeshSelected(const FAssetData& AssetData);
+
 	/** Clears all sewing data (UI button callback). */
 	void ClearAllSewing();
 
@@ -323,11 +419,24 @@ public:
 	/**
 	 * @brief Saves the current canvas state under the given name.
 	 *
+	 * The canvas data is snapshotted and written in the background; a notification
+	 * reports the result once the file is on disk.
+	 *
 	 * @param SaveName Name to use for the saved asset/state.
 	 * @return FReply indicating whether the save action was handled (for UI binding).
 	 */
 	FReply SaveClick(const FString& SaveName);
 
+	/**
+	 * @brief Imports a DXF-AAMA/ASTM or SVG pattern file, replacing the canvas contents.
+	 *
+	 * The file is read on a worker thread; the canvas keeps responding and swaps the
+	 * pieces in from Tick once parsing has finished. A notification reports the result.
+	 *
+	 * @param FilePath .dxf or .svg file on disk.
+	 */
+	void ImportPatternFile(const FString& FilePath);
+
 	// UI accessors
 
 	/**
@@ -366,6 +475,15 @@ public:
 	/** Whether a whole shape is being dragged. */
 	bool bIsDraggingShape = false; /**< Used to move entire shapes. */
 
+	/** Canvas position where the current shape drag started. */
+	FVector2D ShapeDragAnchor = FVector2D::ZeroVector; /**< Drag offsets are measured from here, so a move is one transform update. */
+
+	/** Placement of the dragged shape when the drag started. */
+	FShapeTransform2D ShapeDragStartTransform; /**< Added to the drag offset on every update. */
+
+	/** Whether the current shape drag has been recorded for undo. */
+	bool bShapeDragRecorded = false; /**< Set on the first real move, so a click that only selects adds no undo step. */
+
 	/** Whether a tangent handle is being dragged. */
 	bool bIsDraggingTangent = false; /**< Used to manipulate Bezier tangents. */
 
@@ -393,6 +511,9 @@ public:
 	/** Flags indicating per-point Bezier usage for completed shapes. */
 	TArray<TArray<bool>> CompletedBezierFlags; /**< Preserves original curve topology for completed shapes. */
 
+	/** Canvas placement of each completed shape; its points are stored relative to this. */
+	TArray<FShapeTransform2D> CompletedShapeTransforms; /**< Index-aligned with CompletedShapes; moving a shape only changes its entry. */
+
 	/** Global toggle for whether to create Bezier points by default when adding new points. */
 	bool bUseBezierPoints = true; /**< Gives a sensible default for new points while allowing per-point overrides. */
 
@@ -427,10 +548,72 @@ public:
 	/** Index of the seam currently selected by the user (or INDEX_NONE). */
 	int32 SelectedSeamIndex = INDEX_NONE; /**< Used for seam editing and highlight operations. */
 
+	/** Tessellated completed shapes reused across frames until a shape or seam is edited. */
+	FCanvasShapeCache ShapeCache; /**< Edit sites mark shapes dirty so painting never re-samples unchanged curves. */
+
+	/** Grid index of completed-shape points, handles and seam lines used for click hit-testing. */
+	FCanvasSpatialIndex HitIndex; /**< Marked dirty at the same edit sites as ShapeCache; synced lazily before each query. */
+
+	/** Tiled, level-of-detail copy of the background texture that paint draws from. */
+	FCanvasBackgroundTiles BackgroundTiles; /**< Follows BackgroundTexture from Tick; uploads only the tiles the view needs. */
+
 private:
 	/** Last geometry passed to OnPaint/on-input; cached for hit-testing and coordinate transforms. */
 	FGeometry LastGeometry; /**< Cached geometry to avoid repeatedly querying Slate during input handling. */
 
+	/** Cached layer painting everything except the active shape. */
+	TSharedPtr<class SCanvasStaticLayer> StaticLayer; /**< Wrapped in an invalidation panel; null for canvases built without Construct. */
+
+	/** Latest canvas-space mouse position of a point or tangent drag not yet applied. */
+	TOptional<FVector2D> PendingDragPos; /**< Coalesces several mouse moves into one geometry update per frame. */
+
+	/** Mean-value binding of the dragged shape's 3D mesh to its outline. */
+	FPatternLiveDeform LiveDeform; /**< Bound on the first drag update; the mesh is re-triangulated on release. */
+
+	/** Background rebuilds of edited shapes' meshes. */
+	FPatternRetriangulationQueue RetriangulationQueue; /**< Fed on every drag update; results are swapped in from Tick. */
+
+	/** Background writer for manual saves and autosaves. */
+	FPatternAssetSaver AssetSaver; /**< Ticked from Tick; flushes pending saves when the canvas closes. */
+
+	/** Name of the last manual save. */
+	FString LastSaveName; /**< Autosaves are written next to it; empty until the first save. */
+
+	/** Counts recorded edits, undos and redos. */
+	uint32 EditSerial = 0; /**< Compared with AutosavedEditSerial so an unchanged canvas is not saved again. */
+
+	/** EditSerial when the last autosave was queued. */
+	uint32 AutosavedEditSerial = 0;
+
+	/** Time of the last autosave check that found edits, in Slate seconds. */
+	double LastAutosaveTime = 0.0;
+
+	/** Pattern file being parsed on a worker thread. */
+	UE::Tasks::TTask<FPatternImportResult> PendingImport; /**< Invalid when no import is running. */
+
+	/** @brief Applies a finished import to the canvas. */
+	void TickPendingImport();
+
+	/**
+	 * @brief Replaces the spawned pattern meshes with fresh ones for all completed shapes.
+	 *
+	 * Meshes come from the derived data cache where possible; seam constraints are
+	 * re-bound to the new mesh components afterwards.
+	 */
+	void RegeneratePatternMeshes();
+
+	/** @return A copy of the shape data that saving needs. */
+	FLoadedShapeData MakeSaveSnapshot() const;
+
+	/**
+	 * @brief Queues an autosave when the interval has passed and the canvas changed.
+	 * @param CurrentTime Slate time of this tick.
+	 */
+	void TickAutosave(double CurrentTime);
+
+	/** Hash of the state the static layer was last painted with. */
+	uint32 StaticLayerKey = 0; /**< Compared every tick to decide whether the cached layer is stale. */
+
 	/** Manages save/load of canvas state tied to assets. */
 	FPatternAssetManager AssetManager; /**< Centralises asset I/O so code does not duplicate load/save logic. */
 
@@ -450,12 +633,80 @@ private:
 	/**
 	 * @brief Restores the canvas to the supplied state snapshot.
 	 *
-	 * Used for undo/redo and for loading saved canvas states.
+	 * Used for loading saved canvas states; the undo history is reset because
+	 * its shape indices refer to the previous pattern.
 	 *
 	 * @param State The canvas state to restore.
 	 */
 	void RestoreCanvasState(const FCanvasState& State);
 
+	/**
+	 * @brief Bundles references to the canvas data the undo history edits.
+	 * @return Undo target pointing at this canvas' members.
+	 */
+	FCanvasUndoTarget MakeUndoTarget();
+
+	/**
+	 * @brief Moves the dragged point or tangent handle to the latest mouse position.
+	 *
+	 * Mouse moves only record the position; this applies it once per frame from Tick
+	 * (and on button release), updating just the tangents next to the dragged point.
+	 */
+	void ApplyPendingDrag();
+
+	/**
+	 * @brief Updates the spawned mesh of an edited completed shape while it is dragged.
+	 * @param ShapeIndex Index of the shape being dragged.
+	 *
+	 * Queues a background re-triangulation and deforms the current mesh to follow the
+	 * outline until it arrives; either step can be switched off by console variable.
+	 * Does nothing if the shape has no mesh yet.
+	 */
+	void UpdateLiveMesh(int32 ShapeIndex);
+
+	/**
+	 * @brief Drops the live-deform binding at the end of a drag.
+	 *
+	 * Without background re-triangulation the mesh is rebuilt synchronously here instead.
+	 */
+	void FinishLiveMesh();
+
+	/**
+	 * @brief Brings spawned meshes up to date after an edit made outside a drag.
+	 * @param ShapeIndex Edited shape, or INDEX_NONE for all shapes.
+	 *
+	 * With live updates on, the shapes are queued for background re-triangulation.
+	 * When meshes and shapes no longer line up (a shape was added or removed), the
+	 * meshes are flagged stale instead, so the regenerate reminder is shown.
+	 */
+	void RebuildEditedMeshes(int32 ShapeIndex);
+
+	/** Set when an edit left the spawned meshes behind the shapes. */
+	bool bMeshesStale = false; /**< Cleared by RegeneratePatternMeshes. */
+
+	/**
+	 * @brief The spawned actor built from a shape of the current pattern.
+	 * @param ShapeIndex Completed shape.
+	 * @return Null if no actor was built from that shape, e.g. after a load, import or merge.
+	 */
+	APatternMesh* GetShapeActor(int32 ShapeIndex) const;
+
+	/** Stamped on actors by RegeneratePatternMeshes; bumped whenever a different pattern is restored. */
+	uint32 PatternGeneration = 1; /**< Starts above the actors' default, so unstamped actors never match. */
+
+	/**
+	 * @brief Moves spawned actors of shapes whose placement differs from a previous one.
+	 * @param Previous Shape placements before an undo or redo step.
+	 */
+	void MoveActorsToTransforms(const TArray<FShapeTransform2D>& Previous);
+
+	/**
+	 * @brief Refreshes derived state after an undo or redo step was applied.
+	 *
+	 * Clears point selection (indices may no longer exist) and rebuilds the sewn-point cache.
+	 */
+	void OnUndoHistoryApplied();
+
 	/**
 	 * @brief Deletes any procedural cloth meshes previously spawned in the scene.
 	 *
@@ -474,6 +725,15 @@ private:
 
 	/** Unit test access for state roundtrip tests. */
 	friend class FClothCanvas_StateRoundtripTest;
+
+	/** Unit test access for driving drags through ApplyPendingDrag. */
+	friend class FInputHandler_DragShape;
+
+	/** Unit test access for the shape-to-actor ownership check. */
+	friend class FClothCanvas_ShapeActorOwnershipTest;
+
+	/** Unit test access for checking that a no-op simplify records no undo step. */
+	friend class FClothCanvas_SimplifyNothingFittedTest;
 };
 
 
@@ -0,0 +1,40 @@
+#pragma once
+// Using #pragma once here because this header contains U macros
+// UnrealHeaderTool (UHT) requires that reflected types are NOT inside #ifndef/#define include guards
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "ClothDesignExportCommandlet.generated.h"
+
+
+/**
+ * @class UClothDesignExportCommandlet
+ * @brief Exports the pattern pieces saved in a level as one merged garment, without the editor UI.
+ *
+ * Loads the level, welds every APatternMesh in it the way the canvas merge does (pieces whose
+ * edges coincide after sewing are joined) and writes the result with FPatternExport, so render
+ * and QA pipelines can pick garments up from a build machine:
+ *
+ *     UnrealEditor-Cmd <Project>.uproject -run=ClothDesignExport -Map=/Game/Garments/Shirt -Output=D:/Out/Shirt.glb
+ *
+ * Optional arguments: -Scale=<units per cm> (default 0.01), -NoSeams, -KeepZUp.
+ */
+UCLASS()
+class UClothDesignExportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	/** @brief Marks the commandlet as running without rendering or a client. */
+	UClothDesignExportCommandlet();
+
+	/**
+	 * @brief Runs the export.
+	 *
+	 * @param Params Command line after -run=ClothDesignExport.
+	 * @return 0 on success, 1 on bad arguments or a failed load, merge or write.
+	 */
+	virtual int32 Main(const FString& Params) override;
+};
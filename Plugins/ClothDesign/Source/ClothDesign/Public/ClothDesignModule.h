@@ -3,6 +3,7 @@
 
 #include "Modules/ModuleManager.h"
 #include "ClothDesignCanvas.h"
+#include "AssetThumbnail.h"
 
 /*
  * Thesis reference:
@@ -59,6 +60,9 @@ private:
 	/** The primary canvas widget for the 2D editor (kept so module can manage lifetime). */
 	TSharedPtr<SClothDesignCanvas> CanvasWidget; /**< Holds the central canvas instance used by the 2D editor tab. */
 
+	/** Thumbnails for the shape asset picker; shape assets carry CPU-drawn cached thumbnails (see FPatternThumbnail). */
+	TSharedPtr<FAssetThumbnailPool> ThumbnailPool; /**< Created with the load/save panel, released on shutdown. */
+
 	/** Currently entered save name used by the save UI. */
 	FString CurrentSaveName = TEXT("ShapeName"); /**< Default save name to reduce friction for new saves. */
 
@@ -83,13 +87,15 @@ private:
 	 * @param AllowedClass Class type that the picker should allow.
 	 * @param GetPath Function returning current path string (used to initialise display).
 	 * @param OnChanged Callback invoked when the user selects a different asset.
+	 * @param InThumbnailPool Optional pool; when set, the selected asset's thumbnail is shown.
 	 * @return A Slate widget containing the labelled object picker.
 	 */
 	TSharedRef<SWidget> MakeObjectPicker(
 		const FText& LabelText,
 		const UClass* AllowedClass,
 		TFunction<FString()> GetPath,
-		TFunction<void(const FAssetData&)> OnChanged);
+		TFunction<void(const FAssetData&)> OnChanged,
+		TSharedPtr<FAssetThumbnailPool> InThumbnailPool = nullptr);
 
 	/**
 	 * @brief Builds widgets that control background texture and related options.
@@ -201,15 +207,33 @@ private:
 	 */
 	FReply OnSewingClicked();
 
+	/**
+	 * @brief Called when the user clicks "Simplify Shapes".
+	 *
+	 * Refits dense outlines (e.g. imported ones) with fewer control points.
+	 *
+	 * @return FReply indicating whether the click was handled.
+	 */
+	FReply OnSimplifyShapesClicked();
+
 	/**
 	 * @brief Called when the user clicks "Merge Meshes".
 	 *
-	 * Begins the merge operation for sewn pattern pieces.
+	 * Builds an in-memory preview of the merged sewn pattern pieces.
 	 *
 	 * @return FReply indicating whether the click was handled.
 	 */
 	FReply OnMergeMeshesClicked();
 
+	/**
+	 * @brief Called when the user clicks "Commit Merge".
+	 *
+	 * Creates the merged assets and actors from the current preview.
+	 *
+	 * @return FReply indicating whether the click was handled.
+	 */
+	FReply OnCommitMergeClicked();
+
 	/**
 	 * @brief Called when the user clicks "Save".
 	 *
@@ -219,6 +243,16 @@ private:
 	 */
 	FReply OnSaveClicked();
 
+	/**
+	 * @brief Called when the user clicks "Import Pattern...".
+	 *
+	 * Asks for a DXF-AAMA/ASTM or SVG file and hands it to the canvas, which
+	 * parses it in the background.
+	 *
+	 * @return FReply indicating whether the click was handled.
+	 */
+	FReply OnImportPatternClicked();
+
 	/**
 	 * @brief Called when the user clicks "Clear".
 	 *
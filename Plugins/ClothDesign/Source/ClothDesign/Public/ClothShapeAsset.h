@@ -57,6 +57,43 @@ struct FShapeData
 	/** Array of curve points defining the completed shape */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Cloth Shape")
 	TArray<FCurvePointData> CompletedClothShape;
+
+	/** Canvas offset of the shape; the curve points are stored relative to it */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Cloth Shape")
+	FVector2D Translation = FVector2D::ZeroVector;
+
+	/** Counter-clockwise rotation of the shape about its local origin, in degrees */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Cloth Shape")
+	double RotationDegrees = 0.0;
+};
+
+/**
+ * @struct FSeamData
+ * @brief A seam between two completed shapes, stored by shape and control point index.
+ * 
+ * Only indices are saved; the runtime constraint with its mesh components is rebuilt
+ * from them once the pattern meshes exist again.
+ */
+USTRUCT(BlueprintType)
+struct FSeamData
+{
+	GENERATED_BODY()
+
+	/** Index of the first shape */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Seam")
+	int32 ShapeA = INDEX_NONE;
+
+	/** Control points on the first shape where the seam starts and ends */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Seam")
+	FIntPoint EdgeA = FIntPoint(INDEX_NONE, INDEX_NONE);
+
+	/** Index of the second shape */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Seam")
+	int32 ShapeB = INDEX_NONE;
+
+	/** Control points on the second shape where the seam starts and ends */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Seam")
+	FIntPoint EdgeB = FIntPoint(INDEX_NONE, INDEX_NONE);
 };
 
 /**
@@ -79,4 +116,28 @@ public:
 	/** Collection of completed cloth shapes */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Cloth Shapes")
 	TArray<FShapeData> ClothShapes;
+
+	/** Seams between completed shapes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Cloth Shapes")
+	TArray<FSeamData> Seams;
+
+	/** Store positions and tangents at float precision on disk; canvas coordinates do not need doubles */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Cloth Shapes|Storage")
+	bool bQuantizePoints = true;
+
+	/**
+	 * @brief Writes the shape arrays as packed, bulk-serialised columns instead of tagged properties.
+	 *
+	 * Tagged serialisation stores a name and size for every field of every point, which makes
+	 * large pattern libraries big and slow to load. Persistent archives get a struct-of-arrays
+	 * block after the tagged data instead; assets saved before the custom version still load
+	 * through the tagged path. Transactions and other in-memory archives are unchanged.
+	 *
+	 * @param Ar Archive to load from or save to.
+	 */
+	virtual void Serialize(FArchive& Ar) override;
+
+private:
+	/** @brief Reads or writes the packed shape block. */
+	void SerializePackedShapes(FArchive& Ar);
 };
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "PatternMesh.h"
 #include "ConstrainedDelaunay2.h"
 #include "MeshOpPreviewHelpers.h" 
+#include "Canvas/CanvasShapeTransform.h"
 
 /**
  *
@@ -11,6 +12,23 @@
  * See Chapter 4.6 for detailed explanations.
  */
 
+/**
+ * @brief Triangulated mesh data for one shape, built without touching the world.
+ *
+ * Vertices are already centred on Centroid, which becomes the actor's pivot.
+ */
+struct FPatternMeshData
+{
+    TArray<FVector> Vertices;                  ///< Section vertices, local to the pivot
+    TArray<int32> Indices;                     ///< Section triangle indices
+    UE::Geometry::FDynamicMesh3 DynamicMesh;   ///< Same mesh as a dynamic mesh, local to the pivot
+    TArray<int32> PolyIndexToVID;              ///< CDT input index to vertex ID
+    TArray<int32> SeamVertexIDs;               ///< Recorded seam vertices, if requested
+    TArray<FVector2f> BoundarySamples2D;       ///< Boundary samples in canvas space
+    TArray<int32> BoundarySampleVIDs;          ///< Vertex ID of each boundary sample
+    FVector Centroid = FVector::ZeroVector;    ///< Area-weighted centroid in canvas space (Z = 0)
+};
+
 /**
  * @brief Handles triangulation and procedural mesh generation from canvas shapes.
  * 
@@ -26,16 +44,105 @@ public:
      * @param CompletedShapes Curves representing the completed shapes on the canvas.
      * @param OutMeshes Array to receive generated dynamic meshes.
      * @param OutSpawnedActors Array to receive spawned mesh actors.
+     * @param ShapeTransforms Canvas placement of each shape; missing entries are identity.
      * 
      * This method abstracts the complex workflow of triangulation, vertex sampling,
      * and actor creation, so that canvas shapes can be visualised and further manipulated.
+     * Shapes are triangulated in their local space and the placement goes on the actor.
      */
     static void TriangulateAndBuildAllMeshes(
         const TArray<FInterpCurve<FVector2D>>& CompletedShapes,
         TArray<FDynamicMesh3>& OutMeshes,
-        TArray<TWeakObjectPtr<APatternMesh>>& OutSpawnedActors);
+        TArray<TWeakObjectPtr<APatternMesh>>& OutSpawnedActors,
+        const TArray<FShapeTransform2D>& ShapeTransforms = TArray<FShapeTransform2D>());
+
+    /**
+     * @brief Moves a pattern actor to follow a change of its shape's canvas placement.
+     * @param Actor Actor built from the shape.
+     * @param From Placement the actor currently reflects.
+     * @param To New placement.
+     *
+     * The mesh is not touched: the actor is translated by the move of its pivot and
+     * turned about the vertical axis by the change of rotation.
+     */
+    static void MoveActorWithShape(
+        APatternMesh* Actor,
+        const FShapeTransform2D& From,
+        const FShapeTransform2D& To);
+
+    /** Samples taken per curve segment along the shape boundary. */
+    static constexpr int BoundarySamplesPerSegment = 10;
+
+    /** Cells per side of the grid that seeds interior points. */
+    static constexpr int32 GridInteriorResolution = 40;
+
+    /**
+     * @brief Triangulates a shape into mesh data without spawning anything.
+     * @param Shape The shape to triangulate.
+     * @param bRecordSeam Whether to record seam vertices.
+     * @param StartPointIdx2D Start index for seam recording.
+     * @param EndPointIdx2D End index for seam recording.
+     * @param OutData Receives the centred mesh data.
+     * @param ShouldCancel Optional check polled between stages; returning true aborts the build.
+     * @return False if the shape has too few points to triangulate or the build was cancelled.
+     *
+     * Kept free of world access so it can run on a worker thread for live re-triangulation.
+     */
+    static bool BuildPatternMeshData(
+        const FInterpCurve<FVector2D>& Shape,
+        bool bRecordSeam,
+        int32 StartPointIdx2D,
+        int32 EndPointIdx2D,
+        FPatternMeshData& OutData,
+        const TFunction<bool()>& ShouldCancel = TFunction<bool()>());
+
+    /**
+     * @brief Re-triangulates a shape into its existing actor.
+     * @param Shape The edited shape.
+     * @param Actor Actor previously built from the same shape.
+     * @return False if the shape could not be triangulated.
+     *
+     * The actor and its mesh component are kept, so sewing constraints that reference
+     * the component stay valid. The actor is moved by the change of centroid so the
+     * unchanged parts of the pattern stay where they were in the level.
+     */
+    static bool RebuildMeshInPlace(
+        const FInterpCurve<FVector2D>& Shape,
+        APatternMesh* Actor);
+
+    /**
+     * @brief Swaps already built mesh data into an existing actor.
+     * @param Actor Actor previously built from the same shape.
+     * @param Data Mesh data built with BuildPatternMeshData.
+     * @return False if the actor or its mesh component is gone.
+     *
+     * The game-thread half of RebuildMeshInPlace, for data built elsewhere.
+     */
+    static bool ApplyRebuiltMesh(
+        APatternMesh* Actor,
+        FPatternMeshData&& Data);
+
+    /**
+     * @brief Samples a shape's closed boundary exactly as triangulation does.
+     * @param Shape The shape to sample.
+     * @param OutSamples Receives BoundarySamplesPerSegment samples per segment, in canvas space.
+     *
+     * The closing edge from the last point back to the first is not sampled.
+     */
+    static void SampleBoundary(
+        const FInterpCurve<FVector2D>& Shape,
+        TArray<FVector2f>& OutSamples);
 
 private:
+    /**
+     * @brief Copies built mesh data onto an actor and (re)creates its mesh section.
+     * @param Actor Actor to fill; its transform must already be final.
+     * @param Data Mesh data to move in.
+     */
+    static void ApplyPatternMeshData(
+        APatternMesh* Actor,
+        FPatternMeshData&& Data);
+
     /**
      * @brief Checks whether a 2D point lies inside a polygon.
      * @param Test The point to check.
@@ -141,27 +248,15 @@ private:
 
     /**
      * @brief Creates a procedural mesh actor in the scene.
-     * @param Vertices Mesh vertices.
-     * @param Indices Triangle indices.
-     * @param DynamicMesh The source dynamic mesh.
-     * @param SeamVertexIDs IDs of seam vertices.
-     * @param BoundarySamples2D Boundary samples of the original shape.
-     * @param BoundarySampleVIDs Corresponding vertex IDs for boundary samples.
+     * @param Data Built mesh data, moved onto the new actor.
      * @param OutSpawnedActors Array to receive spawned actor references.
-     * @param MeshCentroid Centroid of the mesh for positioning.
      * 
      * Encapsulates actor creation and mesh assignment, separating procedural generation
      * from low-level mesh data manipulation.
      */
     static void CreateProceduralMesh(
-        const TArray<FVector>& Vertices,
-        const TArray<int32>& Indices,
-        FDynamicMesh3&& DynamicMesh,
-        TArray<int32>&& SeamVertexIDs,
-        const TArray<FVector2f>& BoundarySamples2D,
-        const TArray<int32>& BoundarySampleVIDs,
-        TArray<TWeakObjectPtr<APatternMesh>>& OutSpawnedActors,
-        FVector MeshCentroid);
+        FPatternMeshData&& Data,
+        TArray<TWeakObjectPtr<APatternMesh>>& OutSpawnedActors);
 
     /**
      * @brief Triangulates a single shape and updates the last built mesh and seam data.
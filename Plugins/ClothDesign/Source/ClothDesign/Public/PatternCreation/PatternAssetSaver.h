@@ -0,0 +1,88 @@
+#ifndef FPatternAssetSaver_H
+#define FPatternAssetSaver_H
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "PatternCreation/PatternAssets.h"
+
+
+/**
+ * @brief Saves shape assets without blocking the editor.
+ *
+ * Asset arrays and the thumbnail are built on a worker and the file is written by the engine's
+ * async writer; only package serialisation stays on the game thread. A newer request for a
+ * queued asset replaces the older snapshot, so autosaves never pile up.
+ */
+class FPatternAssetSaver
+{
+public:
+	/** Called on the game thread once a save has been written or has failed. */
+	using FOnSaveFinished = TFunction<void(const FString& /*AssetName*/, bool /*bSucceeded*/)>;
+
+	~FPatternAssetSaver();
+
+	/**
+	 * @brief Queues a save of a canvas snapshot.
+	 * @param AssetPath Folder below the plugin's asset root.
+	 * @param AssetName Name of the asset to create or overwrite.
+	 * @param Snapshot Copy of the canvas data; taken over by the saver.
+	 * @param OnFinished Optional completion callback.
+	 */
+	void SaveAsync(const FString& AssetPath, const FString& AssetName, FLoadedShapeData&& Snapshot,
+		FOnSaveFinished OnFinished = nullptr);
+
+	/** @brief Advances running saves. Call once per frame on the game thread. */
+	void Tick();
+
+	/** @brief Blocks until every queued save has been written. */
+	void Flush();
+
+	/** @return Whether a save is running or queued. */
+	bool IsBusy() const;
+
+private:
+	struct FRequest
+	{
+		FString AssetPath;
+		FString AssetName;
+		FLoadedShapeData Snapshot;
+		FOnSaveFinished OnFinished;
+	};
+
+	/** Asset arrays produced by the worker. */
+	struct FBuiltArrays
+	{
+		TArray<FShapeData> Shapes;
+		TArray<FCurvePointData> CurvePoints;
+		TArray<FSeamData> Seams;
+		TArray<FColor> Thumbnail;   ///< FPatternThumbnail::DefaultSize squared pixels
+	};
+
+	enum class EStage : uint8
+	{
+		Idle,
+		Building,   ///< Worker converts the snapshot
+		Writing     ///< Package serialised, waiting for the file write
+	};
+
+	/** @return Whether the serialised package of the active request has reached disk. */
+	bool IsWriteFinished() const;
+
+	/** @brief Starts the next queued request, if any. */
+	void StartNext();
+
+	/** @brief Reports the active request and moves on to the next. */
+	void Finish(bool bSucceeded);
+
+	TArray<FRequest> Queue;                   ///< Requests waiting for the active one
+	FRequest Active;                          ///< Request being built or written
+	EStage Stage = EStage::Idle;              ///< Progress of Active
+	UE::Tasks::TTask<FBuiltArrays> BuildTask; ///< Converts Active.Snapshot
+
+	FString WriteFileName;                    ///< Package file Tick polls for the write to land
+	FDateTime PreviousTimeStamp;              ///< Modification time of WriteFileName before the save
+	int64 ExpectedFileSize = 0;               ///< Size of the serialised package
+	double WriteDeadline = 0.0;               ///< After this, Tick waits for the async writer
+};
+
+#endif
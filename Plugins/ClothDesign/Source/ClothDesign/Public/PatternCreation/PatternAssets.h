@@ -23,6 +23,8 @@ struct FLoadedShapeData
     TArray<TArray<bool>> CompletedBezierFlags;      /**< Tracks which points in each shape use Bezier handles. */
     FInterpCurve<FVector2D> CurvePoints;           /**< Stores the current working curve points. */
     TArray<bool> bUseBezierPerPoint;               /**< Indicates Bezier usage per point for the working curve. */
+    TArray<FShapeTransform2D> CompletedShapeTransforms; /**< Placement of each completed shape; missing entries are identity. */
+    TArray<FSeamDefinition> SeamDefinitions;       /**< Seams between completed shapes, by shape and point index. */
 };
 
 /**
@@ -42,6 +44,8 @@ public:
      * @param CompletedBezierFlags Bezier flags for each completed shape.
      * @param CurvePoints Current working curve points.
      * @param bUseBezierPerPoint Bezier usage flags for the current curve.
+     * @param CompletedShapeTransforms Optional placement of each completed shape; missing entries save as identity.
+     * @param SeamDefinitions Optional seams between completed shapes.
      * @return True if the asset was successfully saved, false otherwise.
      * 
      * Saving assets allows designs to be persisted beyond the current session,
@@ -53,7 +57,9 @@ public:
         const TArray<FInterpCurve<FVector2D>>& CompletedShapes,
         const TArray<TArray<bool>>& CompletedBezierFlags,
         const FInterpCurve<FVector2D>& CurvePoints,
-        const TArray<bool>& bUseBezierPerPoint
+        const TArray<bool>& bUseBezierPerPoint,
+        const TArray<FShapeTransform2D>& CompletedShapeTransforms = TArray<FShapeTransform2D>(),
+        const TArray<FSeamDefinition>& SeamDefinitions = TArray<FSeamDefinition>()
     );
 
     /**
@@ -69,6 +75,74 @@ public:
         UClothShapeAsset* ClothAsset,
         FCanvasState& OutState
     );
+
+    /**
+     * @brief Imports a DXF-AAMA/ASTM or SVG pattern file into a fresh canvas state.
+     * @param FilePath .dxf or .svg file on disk.
+     * @param OutState Canvas state to populate; each closed outline becomes a completed shape.
+     * @return True if at least one piece was imported, false otherwise.
+     *
+     * Reads on the calling thread; the canvas uses FPatternImport::ImportFileAsync and
+     * MakeCanvasState instead so large marker files never block the editor.
+     */
+    static bool ImportPatternFile(
+        const FString& FilePath,
+        FCanvasState& OutState
+    );
+
+    /**
+     * @brief Builds a fresh canvas state from imported or snapshotted shape data.
+     * @param Data Shapes, flags, transforms and seams; moved from.
+     * @param OutState Canvas state to populate, with selection, pan and zoom at their defaults.
+     */
+    static void MakeCanvasState(
+        FLoadedShapeData&& Data,
+        FCanvasState& OutState
+    );
+
+    /**
+     * @brief Converts canvas shape data into the arrays stored on the asset.
+     * @param Data Shapes, flags, transforms and seams to convert.
+     * @param OutShapes Receives one entry per completed shape.
+     * @param OutCurvePoints Receives the working curve.
+     * @param OutSeams Receives the seams between completed shapes.
+     *
+     * Touches no UObjects, so it can run on a worker thread from a snapshot of the canvas.
+     */
+    static void BuildAssetArrays(
+        const FLoadedShapeData& Data,
+        TArray<FShapeData>& OutShapes,
+        TArray<FCurvePointData>& OutCurvePoints,
+        TArray<FSeamData>& OutSeams
+    );
+
+    /**
+     * @brief Finds the shape asset for a path and name, loading or creating its package as needed.
+     * @param AssetPath Folder below the plugin's asset root.
+     * @param AssetName Name of the asset.
+     * @param OutPackageFileName Receives the file the package saves to.
+     * @return The asset, or nullptr if the path is invalid or the package could not be created.
+     */
+    static UClothShapeAsset* FindOrCreateShapeAsset(
+        const FString& AssetPath,
+        const FString& AssetName,
+        FString& OutPackageFileName
+    );
+
+    /**
+     * @brief Writes the asset's package to disk.
+     * @param Asset Asset whose package is saved.
+     * @param PackageFileName File to write.
+     * @param bAsyncWrite Serialise now but hand the file write to the async writer.
+     * @param OutFileSize Optional; receives the size the written file will have.
+     * @return True if the package was serialised (and, for synchronous writes, written).
+     */
+    static bool WriteShapeAsset(
+        UClothShapeAsset* Asset,
+        const FString& PackageFileName,
+        bool bAsyncWrite,
+        int64* OutFileSize = nullptr
+    );
 };
 
 /**
@@ -0,0 +1,83 @@
+#ifndef FPatternCurveFit_H
+#define FPatternCurveFit_H
+
+#include "CoreMinimal.h"
+#include "Math/InterpCurve.h"
+
+
+/**
+ * @brief Reduces dense closed outlines to a few Bezier and N-point control points.
+ *
+ * Imported and traced outlines can carry thousands of points, and painting, hit-testing,
+ * sampling and undo all scale with that count. Fitting works on the outline's polyline:
+ * Douglas-Peucker picks candidate breakpoints, the ones with a sharp local turn become
+ * corners, and each run between corners becomes either a straight N-point edge or a chain
+ * of least-squares cubic Beziers (Schneider's algorithm) that stays within the tolerance.
+ * Runs that meet at a corner keep independent tangents; everything else joins smoothly.
+ */
+class FPatternCurveFit
+{
+public:
+	/**
+	 * @brief Fits one closed shape.
+	 * @param Shape Shape to fit, in its local space.
+	 * @param BezierFlags Per-point Bezier flags of Shape.
+	 * @param Tolerance Largest allowed distance between the fitted and the original outline.
+	 * @param OutShape Receives the fitted shape.
+	 * @param OutBezierFlags Receives the fitted shape's Bezier flags.
+	 * @param CornerAngleDegrees Turns sharper than this between neighbouring samples are kept as corners.
+	 * @return True if the fitted shape has fewer control points than Shape.
+	 */
+	static bool FitShape(
+		const FInterpCurve<FVector2D>& Shape,
+		const TArray<bool>& BezierFlags,
+		double Tolerance,
+		FInterpCurve<FVector2D>& OutShape,
+		TArray<bool>& OutBezierFlags,
+		double CornerAngleDegrees = 30.0);
+
+	/**
+	 * @brief Fits several shapes in parallel, replacing those that get smaller.
+	 * @param Shapes Shapes to fit; replaced in place.
+	 * @param BezierFlags Per-shape Bezier flags, index-aligned with Shapes; replaced in place.
+	 * @param Tolerance Largest allowed distance between the fitted and the original outlines.
+	 * @param ShapeMask Optional; shapes whose bit is false are left alone.
+	 * @return Number of shapes that were replaced.
+	 */
+	static int32 FitShapes(
+		TArray<FInterpCurve<FVector2D>>& Shapes,
+		TArray<TArray<bool>>& BezierFlags,
+		double Tolerance,
+		const TBitArray<>* ShapeMask = nullptr);
+
+	/**
+	 * @brief Samples a closed shape into the polyline that fitting approximates.
+	 *
+	 * Straight N-point edges contribute only their end points, curved segments a fixed
+	 * number of samples, so dense polylines are not made denser.
+	 *
+	 * @param Shape Shape to sample.
+	 * @param BezierFlags Per-point Bezier flags of Shape.
+	 * @param OutPoints Receives the closed polyline, without repeating the first point.
+	 */
+	static void SampleOutline(
+		const FInterpCurve<FVector2D>& Shape,
+		const TArray<bool>& BezierFlags,
+		TArray<FVector2D>& OutPoints);
+
+	/**
+	 * @brief Douglas-Peucker simplification of a closed polyline.
+	 * @param Points Closed polyline, without repeating the first point.
+	 * @param Tolerance Largest allowed distance of a dropped point from the simplified outline.
+	 * @param OutKept Receives the indices of the kept points in ascending order; always contains 0.
+	 */
+	static void SimplifyClosed(
+		const TArray<FVector2D>& Points,
+		double Tolerance,
+		TArray<int32>& OutKept);
+
+	/** Samples taken per curved segment by SampleOutline. */
+	static constexpr int32 SamplesPerCurvedSegment = 8;
+};
+
+#endif
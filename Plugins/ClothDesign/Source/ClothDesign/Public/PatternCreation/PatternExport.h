@@ -0,0 +1,70 @@
+#ifndef FPatternExport_H
+#define FPatternExport_H
+
+#include "CoreMinimal.h"
+#include "DynamicMesh/DynamicMesh3.h"
+
+
+/** Settings shared by the glTF and OBJ writers. */
+struct FPatternExportOptions
+{
+	double Scale = 0.01;                ///< Multiplier from Unreal units (cm) to file units; glTF expects metres
+	bool bConvertToYUp = true;          ///< Write in the right-handed Y-up frame glTF and most OBJ tools expect
+	bool bWriteSeams = true;            ///< Write edges where two pattern pieces were welded as line elements
+};
+
+
+/**
+ * @brief Writes merged garments to binary glTF (.glb) and Wavefront OBJ for external pipelines.
+ *
+ * Input meshes are the ones FPatternMerge produces: welded, non-compact, with the pieces'
+ * pattern coordinates in UV layer 0 and the source piece index as triangle group. Both
+ * writers read straight from the mesh buffers through a fixed-size staging buffer; the only
+ * per-mesh allocation is the table that compacts vertex (or UV element) IDs into file indices.
+ *
+ * In glTF every UV element becomes a vertex, so pieces keep separate pattern coordinates
+ * along their seams. Seams are an extra LINES primitive over the same vertices, tagged
+ * "clothDesign": "seams" in its extras, and the mesh extras carry the piece count. OBJ
+ * writes one group per piece and the seams as "l" elements in a "seams" group.
+ */
+class FPatternExport
+{
+public:
+	/**
+	 * @brief Writes meshes to a .glb or .obj file, picking the writer from the extension.
+	 * @param FilePath Destination file; overwritten.
+	 * @param Meshes Meshes to write, one glTF node or OBJ object each; null and empty meshes are skipped.
+	 * @param Options Units, axes and seam settings.
+	 * @param OutError Receives the reason when the export fails.
+	 * @return True if the file was written.
+	 */
+	static bool ExportFile(const FString& FilePath, const TArray<const UE::Geometry::FDynamicMesh3*>& Meshes, const FPatternExportOptions& Options, FString& OutError);
+
+	/**
+	 * @brief Streams meshes into an archive as binary glTF 2.0.
+	 * @param Ar Archive to write to.
+	 * @param Meshes Meshes to write; null and empty meshes are skipped.
+	 * @param Options Units, axes and seam settings.
+	 * @return True if at least one mesh was written.
+	 */
+	static bool WriteGlb(FArchive& Ar, const TArray<const UE::Geometry::FDynamicMesh3*>& Meshes, const FPatternExportOptions& Options);
+
+	/**
+	 * @brief Streams meshes into an archive as Wavefront OBJ text.
+	 * @param Ar Archive to write to.
+	 * @param Meshes Meshes to write; null and empty meshes are skipped.
+	 * @param Options Units, axes and seam settings.
+	 * @return True if at least one mesh was written.
+	 */
+	static bool WriteObj(FArchive& Ar, const TArray<const UE::Geometry::FDynamicMesh3*>& Meshes, const FPatternExportOptions& Options);
+
+	/**
+	 * @brief Tells whether an edge joins two different pattern pieces.
+	 * @param Mesh Merged mesh with triangle groups.
+	 * @param EdgeID Edge to test.
+	 * @return True for interior edges whose triangles belong to different pieces.
+	 */
+	static bool IsSeamEdge(const UE::Geometry::FDynamicMesh3& Mesh, int32 EdgeID);
+};
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef FPatternImport_H
+#define FPatternImport_H
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "PatternCreation/PatternAssets.h"
+
+
+/** Settings shared by the DXF and SVG readers. */
+struct FPatternImportOptions
+{
+	double Scale = 1.0;                 ///< Multiplier from file units (after DXF unit conversion) to canvas units
+	bool bConvertDxfUnits = true;       ///< Convert DXF drawings with $INSUNITS set (inches, mm, m) to centimetres
+	bool bBoundaryLayerOnly = true;     ///< For DXF-AAMA files, keep only layer 1 (piece boundaries) when present
+	double CloseTolerance = 1e-3;       ///< Open outlines whose ends are this close (canvas units, after Scale) count as closed
+	double FitTolerance = 0.0;          ///< When positive, dense outlines are refitted with FPatternCurveFit to this deviation (canvas units)
+};
+
+
+/** Outcome of an import, handed back from the worker. */
+struct FPatternImportResult
+{
+	bool bSucceeded = false;
+	FString FilePath;
+	FString Error;                      ///< Reason for failure; empty on success
+	FLoadedShapeData Data;              ///< Imported pieces as completed shapes at identity placement
+};
+
+
+/**
+ * @brief Reads industry pattern files (DXF-AAMA/ASTM and SVG) into canvas shapes.
+ *
+ * Both readers stream the file in fixed-size chunks: DXF is consumed one group code/value
+ * pair at a time and SVG one tag at a time, so marker files of several megabytes never exist
+ * as a string or document tree in memory. Every closed outline becomes a completed shape.
+ * Straight runs become N-points; SVG Bezier, quadratic and arc segments become Bezier points
+ * whose tangents reproduce the original cubic exactly. Nothing here touches UObjects, so
+ * imports run on worker threads through ImportFileAsync.
+ */
+class FPatternImport
+{
+public:
+	/**
+	 * @brief Imports a .dxf or .svg file, picking the reader from the extension.
+	 * @param FilePath File on disk.
+	 * @param Options Scale and filtering settings.
+	 * @param OutData Receives the imported shapes; cleared first.
+	 * @param OutError Receives the reason when the import fails.
+	 * @return True if at least one closed outline was read.
+	 */
+	static bool ImportFile(const FString& FilePath, const FPatternImportOptions& Options, FLoadedShapeData& OutData, FString& OutError);
+
+	/**
+	 * @brief Runs ImportFile on a worker thread.
+	 * @param FilePath File on disk.
+	 * @param Options Scale and filtering settings.
+	 * @return Task producing the result; poll IsCompleted from the game thread.
+	 */
+	static UE::Tasks::TTask<FPatternImportResult> ImportFileAsync(const FString& FilePath, const FPatternImportOptions& Options = FPatternImportOptions());
+
+	/**
+	 * @brief Reads DXF (R12 POLYLINE/VERTEX, LWPOLYLINE, BLOCK/INSERT) outlines from an archive.
+	 * @param Ar Archive positioned at the start of the DXF text.
+	 * @param Options Scale and filtering settings.
+	 * @param OutData Receives the imported shapes; cleared first.
+	 * @param OutError Receives the reason when the import fails.
+	 * @return True if at least one closed outline was read.
+	 */
+	static bool ParseDxf(FArchive& Ar, const FPatternImportOptions& Options, FLoadedShapeData& OutData, FString& OutError);
+
+	/**
+	 * @brief Reads SVG path, polygon, polyline and rect outlines from an archive.
+	 * @param Ar Archive positioned at the start of the SVG text.
+	 * @param Options Scale and filtering settings.
+	 * @param OutData Receives the imported shapes; cleared first.
+	 * @param OutError Receives the reason when the import fails.
+	 * @return True if at least one closed outline was read.
+	 */
+	static bool ParseSvg(FArchive& Ar, const FPatternImportOptions& Options, FLoadedShapeData& OutData, FString& OutError);
+};
+
+#endif
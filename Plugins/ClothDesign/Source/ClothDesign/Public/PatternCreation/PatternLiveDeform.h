@@ -0,0 +1,80 @@
+#ifndef FPatternLiveDeform_H
+#define FPatternLiveDeform_H
+
+#include "CoreMinimal.h"
+
+class APatternMesh;
+
+
+/**
+ * @brief Deforms an existing pattern mesh to follow its edited 2D outline.
+ *
+ * Re-triangulating a pattern on every drag event is too slow for interactive editing.
+ * Instead, each mesh vertex is bound once to the boundary samples through mean-value
+ * coordinates, and moving the outline only re-evaluates those weights. The triangulation
+ * is kept, so the result is a position-only update; a full rebuild runs when the drag ends.
+ */
+class FPatternLiveDeform
+{
+public:
+	/**
+	 * @brief Computes mean-value coordinates of a point relative to a closed polygon.
+	 * @param P Point to express.
+	 * @param Poly Polygon vertices in order; the last connects back to the first.
+	 * @param OutWeights Receives one weight per polygon vertex, summing to one.
+	 *
+	 * Points on a vertex or an edge get the exact interpolating weights there.
+	 */
+	static void ComputeMeanValueWeights(const FVector2f& P, const TArray<FVector2f>& Poly, TArray<float>& OutWeights);
+
+	/** Per-edge intermediates of ComputeMeanValueWeights, kept between calls to avoid reallocating. */
+	struct FMeanValueScratch
+	{
+		TArray<FVector2f> D;      ///< Polygon vertices relative to the point
+		TArray<float> R;          ///< Distances to the polygon vertices
+		TArray<float> TanHalf;    ///< tan(alpha / 2) of the angle each edge subtends
+	};
+
+	/**
+	 * @brief ComputeMeanValueWeights reusing caller-owned buffers, for evaluating many points.
+	 * @param Scratch Buffers grown as needed; contents on return are unspecified.
+	 */
+	static void ComputeMeanValueWeights(
+		const FVector2f& P,
+		const TArray<FVector2f>& Poly,
+		TArray<float>& OutWeights,
+		FMeanValueScratch& Scratch);
+
+	/**
+	 * @brief Binds the current vertices of a pattern mesh to its boundary samples.
+	 * @param Actor Pattern mesh with boundary samples and a dynamic mesh.
+	 * @return True if the mesh could be bound.
+	 */
+	bool Bind(const APatternMesh& Actor);
+
+	/**
+	 * @brief Computes deformed vertex positions for a moved outline.
+	 * @param NewBoundary Boundary samples of the edited shape, in the same order as when bound.
+	 * @param OutLocalPositions Receives actor-local positions in procedural mesh vertex order.
+	 * @return False if not bound or the sample count changed (e.g. a point was added).
+	 */
+	bool Deform(const TArray<FVector2f>& NewBoundary, TArray<FVector>& OutLocalPositions) const;
+
+	/** @return Whether Bind succeeded since the last Reset. */
+	bool IsBound() const { return NumBoundary > 0; }
+
+	/** @return The actor the weights were computed for. */
+	APatternMesh* GetBoundActor() const { return BoundActor.Get(); }
+
+	/** @brief Drops the binding. */
+	void Reset();
+
+private:
+	TWeakObjectPtr<APatternMesh> BoundActor; /**< Actor the weights belong to. */
+	FVector2D Pivot = FVector2D::ZeroVector;  /**< Canvas-space pivot of the bound mesh. */
+	TArray<float> RestZ;                      /**< Per-vertex local Z, carried through unchanged. */
+	TArray<float> Weights;                    /**< NumVertices x NumBoundary, row-major. */
+	int32 NumBoundary = 0;                    /**< Boundary samples the weights refer to. */
+};
+
+#endif
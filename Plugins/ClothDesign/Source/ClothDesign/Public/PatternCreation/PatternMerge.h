@@ -14,9 +14,53 @@
  */
 
 // Forward declarations of classes used by FPatternMerge
+class AActor;
 class APatternMesh; /**< Represents a single pattern mesh in the canvas, used for merging and sewing operations. */
 struct FPatternSewingConstraint; /**< Represents a sewing constraint between pattern edges, used to determine adjacency. */
 
+/**
+ * @brief Merge results held in memory until the user commits them.
+ * 
+ * Previewing a merge only welds meshes and draws them through a single
+ * transient preview actor; no pattern actors, skeletal actors or assets
+ * are created or destroyed until the preview is committed.
+ */
+struct FPatternMergePreview
+{
+    /** @brief One merged component and the pieces it was built from. */
+    struct FResult
+    {
+        TArray<TWeakObjectPtr<APatternMesh>> SourceActors; /**< Pattern pieces welded into this result. */
+        FDynamicMesh3 Mesh; /**< Welded mesh in world space; see MergeActorsToDynamicMesh for its UVs and groups. */
+    };
+
+    /** @brief All merged components of the current preview. */
+    TArray<FResult> Results;
+
+    /** @brief Transient actor whose single mesh component draws every result. */
+    TWeakObjectPtr<APatternMesh> PreviewActor;
+
+    /** @brief Returns true while there are uncommitted merge results. */
+    bool IsActive() const { return Results.Num() > 0; }
+
+    /** @brief Actor tag marking preview actors, so scans for pattern pieces can skip them. */
+    static const FName PreviewActorTag;
+
+    /**
+     * @brief Tells whether an actor only draws a merge preview.
+     * @param Actor Actor to test; may be null.
+     * @return True for actors spawned by SpawnPreviewActor.
+     */
+    static bool IsPreviewActor(const AActor* Actor);
+
+    /**
+     * @brief Discards the preview.
+     * 
+     * Destroys the preview actor and unhides the source pieces.
+     */
+    void Clear();
+};
+
 /**
  * @brief Handles merging of sewn pattern mesh groups in the canvas.
  * 
@@ -49,9 +93,53 @@ public:
      * 
      * Identifies connected groups of sewn pattern meshes and merges them where safe.
      * The merge preserves external edges and ensures the canvas remains consistent.
+     * Equivalent to building a preview and committing it straight away.
      */
     void MergeSewnGroups() const;
 
+    /**
+     * @brief Welds every mergeable sewn group into memory without touching the scene.
+     * 
+     * The caller's actor and seam arrays are left untouched until the
+     * preview is committed.
+     * 
+     * @param OutPreview Receives the merged meshes; any previous preview is cleared.
+     * @param bShowPreview If true, spawns the transient preview actor and hides the source pieces.
+     * @return True if at least one group was merged.
+     */
+    bool BuildMergePreview(FPatternMergePreview& OutPreview, bool bShowPreview = true) const;
+
+    /**
+     * @brief Turns a merge preview into skeletal mesh assets and actors.
+     * 
+     * Source pieces and their internal seams are removed once for the whole
+     * commit. The preview is cleared afterwards.
+     * 
+     * @param Preview Preview built by BuildMergePreview.
+     */
+    void CommitMergePreview(FPatternMergePreview& Preview) const;
+
+    /**
+     * @brief Welds pattern pieces into one world-space mesh, without seams to guide it.
+     * 
+     * Pieces are appended as they are placed and welded wherever their edges coincide,
+     * which is what the sewn-group merge does after seams have aligned the pieces.
+     * Every merged mesh carries the pieces' 2D pattern coordinates in UV layer 0
+     * (canvas units * 0.01, as on the pattern mesh sections) and the index of the
+     * source piece as triangle group, so piece boundaries can be recovered after welding.
+     * Reads actor transforms, so it must run on the game thread.
+     * 
+     * @param Actors Pieces to weld; null entries are skipped.
+     * @param OutMerged Receives the welded mesh.
+     * @return True if the merged mesh has triangles.
+     */
+    static bool MergeActorsToDynamicMesh(
+        const TArray<APatternMesh*>& Actors,
+        FDynamicMesh3& OutMerged);
+
+    /** @brief Scale from canvas units to the pattern UVs written by the merge. */
+    static constexpr double PatternUVScale = 0.01;
+
     /**
      * @brief Test-only constructor that binds to static test arrays.
      * 
@@ -61,6 +149,13 @@ public:
     FPatternMerge()
         : SpawnedActorsRef(TestActors), AllSeamsRef(TestSeams) {}
 
+    /**
+     * @brief Optional body the merged garments are skinned to on commit.
+     * 
+     * When unset, garments are rigidly bound to the placeholder skeleton.
+     */
+    TWeakObjectPtr<USkeletalMesh> SkinningBodyMesh;
+
     /** @brief Static array used for test-only actor references. */
     static TArray<TWeakObjectPtr<APatternMesh>> TestActors;
 
@@ -69,6 +164,38 @@ public:
 
 private:
 
+    /**
+     * @brief Work item for merging one connected component off the game thread.
+     * 
+     * Holds plain pointers to the source meshes and their world transforms,
+     * gathered on the game thread, so the merge itself never touches actors.
+     */
+    struct FMergeJob
+    {
+        TArray<int32> Component; /**< Indices into the flat actor list. */
+        TArray<const FDynamicMesh3*> SourceMeshes; /**< Local-space meshes of the component's actors. */
+        TArray<FTransform> SourceTransforms; /**< World transform of each source mesh. */
+        TArray<FVector2D> SourcePivots; /**< Canvas-space pivot of each source mesh, for pattern UVs. */
+        FDynamicMesh3 Merged; /**< Welded world-space result. */
+        bool bSucceeded = false; /**< True if the merged mesh has triangles. */
+    };
+
+    /**
+     * @brief One skeletal mesh asset to create in the post-merge batch.
+     * 
+     * Collected per merged component so the skeleton lookup and package saving
+     * happen once for the whole merge rather than once per component.
+     */
+    struct FSkeletalAssetRequest
+    {
+        FDynamicMesh3 Mesh; /**< Merged mesh in actor-local space. */
+        FString AssetPathAndName; /**< Long package path of the new asset. */
+        FString Label; /**< Outliner label for the spawned skeletal actor. */
+        FTransform Transform; /**< World transform for the spawned skeletal actor. */
+        int32 PreviewResultIndex = INDEX_NONE; /**< Preview result the asset was built from. */
+        USkeletalMesh* Result = nullptr; /**< Created asset, or nullptr on failure. */
+    };
+
     /** @brief References to caller-owned pattern meshes for direct modification. */
     TArray<TWeakObjectPtr<APatternMesh>>& SpawnedActorsRef;
 
@@ -126,44 +253,109 @@ private:
         FDynamicMesh3& OutMerged);
 
     /**
-     * @brief Spawns a new APatternMesh actor from a merged dynamic mesh.
+     * @brief Collects the meshes and world transforms of a component's actors.
      * 
-     * Provides a procedural mesh actor to replace the individual meshes in the component.
+     * Must run on the game thread, as it reads actor transforms.
      */
-    static APatternMesh* SpawnMergedActorFromDynamicMesh(
-        FDynamicMesh3&& MergedMesh);
+    static void GatherMergeSources(
+        const TArray<int32>& Component,
+        const TArray<APatternMesh*>& Actors,
+        FMergeJob& OutJob);
 
     /**
-     * @brief Replaces original actors in a component with the merged actor.
+     * @brief Appends, welds and computes normals for already gathered source meshes.
      * 
-     * Ensures that the canvas now references only the new merged mesh and
-     * removes redundant actors.
+     * Touches no UObjects, so independent components can be merged in parallel.
+     * Pattern UVs are the source vertices plus their pivot; triangle groups are source indices.
      */
-    void ReplaceActorsWithMerged(
-        const TArray<int32>& Component,
-        const TArray<APatternMesh*>& Actors,
-        APatternMesh* MergedActor) const;
+    static bool MergeSourcesToDynamicMesh(
+        const TArray<const FDynamicMesh3*>& SourceMeshes,
+        const TArray<FTransform>& SourceTransforms,
+        const TArray<FVector2D>& SourcePivots,
+        FDynamicMesh3& OutMerged);
+
+    /**
+     * @brief Flattens a dynamic mesh into procedural mesh section arrays.
+     * 
+     * Handles non-compact meshes, which is what welding leaves behind.
+     */
+    static void ExtractSectionArrays(
+        const FDynamicMesh3& Mesh,
+        int32 VertexOffset,
+        TArray<FVector>& OutVerts,
+        TArray<int32>& OutInds);
+
+    /**
+     * @brief Spawns the transient actor that draws a merge preview.
+     * 
+     * Each result becomes one section of the actor's single mesh component.
+     */
+    static APatternMesh* SpawnPreviewActor(const FPatternMergePreview& Preview);
+
+    /**
+     * @brief Removes merged pieces from the caller's actor list and destroys them.
+     */
+    void RemoveMergedSources(const TSet<APatternMesh*>& Sources) const;
 
     /**
-     * @brief Removes seams that are internal to a merged component.
+     * @brief Removes seams whose both sides belong to merged pieces.
      * 
      * Prevents duplicate or conflicting seams from existing after merging.
      */
-    void RemoveInternalSeams(
-        const TArray<int32>& Component,
-        const TMap<APatternMesh*, int32>& ActorToIndex) const;
+    void RemoveSeamsWithin(const TSet<APatternMesh*>& Sources) const;
 
     /**
      * @brief Converts a FDynamicMesh to a USkeletalMesh asset.
      * 
      * Generates a reusable skeletal mesh from the procedural dynamic mesh.
+     * The mesh is expected to carry its skin weights already.
      * 
      * @param DynMesh Input dynamic mesh to convert.
      * @param AssetPathAndName Path and name for the resulting asset.
+     * @param SkeletonAsset Skeleton the new asset is bound to.
      */
     static USkeletalMesh* CreateSkeletalFromFDynamicMesh(
         UDynamicMesh* DynMesh,
-        const FString& AssetPathAndName);
+        const FString& AssetPathAndName,
+        USkeleton* SkeletonAsset);
+
+    /**
+     * @brief Loads the skeleton used for merged garments, once per session.
+     * 
+     * Shows a dialog if the skeleton asset is missing from the project.
+     * 
+     * @return The skeleton, or nullptr if it could not be loaded.
+     */
+    static USkeleton* LoadMergeSkeleton();
+
+    /**
+     * @brief Binds every vertex fully to the root bone.
+     * 
+     * @param Mesh Mesh that receives a "Default" skin weight profile.
+     */
+    static void AssignRigidBoneWeights(FDynamicMesh3& Mesh);
+
+    /**
+     * @brief Creates skeletal mesh assets for all merge results in one batch.
+     * 
+     * Resolves the skeleton once, builds every asset and then saves the
+     * resulting packages together without blocking on disk writes.
+     * 
+     * When skinning to a body, each mesh is moved into the space of the body's
+     * component in the level and its Transform is replaced with that component's,
+     * so the garment's bind pose matches the body's reference pose.
+     * 
+     * @param Requests Merge results; Result is filled in for each entry.
+     * @param BodyMesh Optional body to skin the garments to by proximity.
+     */
+    static void CreateSkeletalAssetsBatched(TArray<FSkeletalAssetRequest>& Requests, USkeletalMesh* BodyMesh = nullptr);
+
+    /**
+     * @brief Saves packages with asynchronous file writes.
+     * 
+     * @param Packages Packages to write to disk.
+     */
+    static void SavePackagesAsync(const TArray<UPackage*>& Packages);
 
     /** @brief Grants test class access to private members. */
     friend class FPatternMergeTests;
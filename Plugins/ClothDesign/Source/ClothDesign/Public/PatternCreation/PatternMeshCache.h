@@ -0,0 +1,55 @@
+#ifndef FPatternMeshCache_H
+#define FPatternMeshCache_H
+
+#include "CoreMinimal.h"
+#include "Math/InterpCurve.h"
+#include "PatternCreation/MeshTriangulation.h"
+
+
+/**
+ * @brief Stores triangulated pattern meshes in the derived data cache.
+ *
+ * Shape assets only persist curves, so every session used to re-triangulate every
+ * pattern on Generate. The cache key hashes the curve, the seam range and the meshing
+ * settings; an unchanged shape therefore loads its mesh, boundary samples and index
+ * maps with one cache read, locally or from a shared DDC. Live drag rebuilds bypass the
+ * cache so intermediate shapes do not fill it.
+ */
+class FPatternMeshCache
+{
+public:
+	/**
+	 * @brief Returns cached mesh data for a shape, triangulating and storing it on a miss.
+	 * @param Shape The shape to mesh.
+	 * @param bRecordSeam Whether to record seam vertices.
+	 * @param StartPointIdx2D Start index for seam recording.
+	 * @param EndPointIdx2D End index for seam recording.
+	 * @param OutData Receives the mesh data.
+	 * @return False if the shape could not be triangulated.
+	 */
+	static bool LoadOrBuild(
+		const FInterpCurve<FVector2D>& Shape,
+		bool bRecordSeam,
+		int32 StartPointIdx2D,
+		int32 EndPointIdx2D,
+		FPatternMeshData& OutData);
+
+	/**
+	 * @brief Builds the cache key for a shape and the current meshing settings.
+	 * @return DDC key; equal for equal inputs, different whenever the mesh could differ.
+	 */
+	static FString MakeCacheKey(
+		const FInterpCurve<FVector2D>& Shape,
+		bool bRecordSeam,
+		int32 StartPointIdx2D,
+		int32 EndPointIdx2D);
+
+	/**
+	 * @brief Reads or writes mesh data in the cached layout.
+	 * @param Ar Archive to load from or save to.
+	 * @param Data Mesh data to serialise.
+	 */
+	static void SerializeMeshData(FArchive& Ar, FPatternMeshData& Data);
+};
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef FPatternRetriangulationQueue_H
+#define FPatternRetriangulationQueue_H
+
+#include "CoreMinimal.h"
+#include "Math/InterpCurve.h"
+#include "Containers/Queue.h"
+#include "PatternCreation/MeshTriangulation.h"
+#include <atomic>
+
+class APatternMesh;
+
+
+/**
+ * @brief Re-triangulates edited shapes on worker threads and swaps the results in over several frames.
+ *
+ * A synchronous rebuild on every edit (or on mouse release) stalls the editor for large
+ * patterns. Instead, each edit snapshots the shape's curve and queues it here. At most one
+ * build per shape runs at a time; newer edits replace the waiting snapshot and cancel the
+ * running build at its next stage boundary. Finished builds are applied to their actors
+ * from Tick under a time budget, so the 3D view converges to the exact mesh a few frames
+ * after the user stops without ever blocking input.
+ */
+class FPatternRetriangulationQueue
+{
+public:
+	FPatternRetriangulationQueue();
+	~FPatternRetriangulationQueue();
+
+	/**
+	 * @brief Queues a rebuild of one shape from a snapshot of its curve.
+	 * @param ShapeIndex Index of the shape; used as the key that newer edits supersede.
+	 * @param Shape Current curve of the shape; copied.
+	 * @param Actor Actor the result is swapped into.
+	 */
+	void Request(int32 ShapeIndex, const FInterpCurve<FVector2D>& Shape, TWeakObjectPtr<APatternMesh> Actor);
+
+	/**
+	 * @brief Starts waiting builds and applies finished ones. Call once per frame on the game thread.
+	 * @param BudgetSeconds Time allowed for applying results; at least one is applied per call.
+	 * @param OutAppliedActors Optional list receiving the actors whose mesh was replaced.
+	 * @return Number of results applied.
+	 */
+	int32 Tick(double BudgetSeconds, TArray<APatternMesh*>* OutAppliedActors = nullptr);
+
+	/** @brief Cancels running builds and drops waiting snapshots and unapplied results. */
+	void CancelAll();
+
+	/** @return Whether any build is running, waiting, or finished but not yet applied. */
+	bool IsBusy() const;
+
+private:
+	/** Worker output; Data is empty for cancelled or failed builds. */
+	struct FResult
+	{
+		int32 ShapeIndex = INDEX_NONE;
+		uint32 Generation = 0;
+		bool bSucceeded = false;
+		FPatternMeshData Data;
+	};
+
+	/** State shared with workers, kept alive by them if the queue is destroyed first. */
+	struct FShared
+	{
+		TMap<int32, uint32> LatestGeneration;           /**< Newest requested generation per shape. */
+		FCriticalSection GenerationLock;                /**< Guards LatestGeneration. */
+		TQueue<FResult, EQueueMode::Mpsc> Results;      /**< Finished builds, drained by Tick. */
+		std::atomic<bool> bShutdown { false };          /**< Set by the queue's destructor. */
+
+		bool IsSuperseded(int32 ShapeIndex, uint32 Generation);
+	};
+
+	/** Per-shape scheduling state, game thread only. */
+	struct FShapeJob
+	{
+		TOptional<FInterpCurve<FVector2D>> Pending;     /**< Newest snapshot not yet started. */
+		uint32 PendingGeneration = 0;                   /**< Generation of Pending. */
+		TWeakObjectPtr<APatternMesh> Actor;             /**< Target of the newest request. */
+		bool bInFlight = false;                         /**< A worker is building this shape. */
+		uint32 InFlightGeneration = 0;                  /**< Generation the running worker builds. */
+	};
+
+	/** @brief Launches the waiting snapshot of a shape on a worker thread. */
+	void Launch(int32 ShapeIndex, FShapeJob& Job);
+
+	TSharedRef<FShared, ESPMode::ThreadSafe> Shared;   /**< Generations and result queue shared with workers. */
+	TMap<int32, FShapeJob> Jobs;                       /**< Scheduling state per shape. */
+	TMap<int32, FResult> Ready;                        /**< Newest finished result per shape, waiting to be applied. */
+	uint32 NextGeneration = 1;                         /**< Incremented for every request. */
+};
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "PatternSewingConstraint.h"
 #include "PatternMesh.h"
+#include "PatternCreation/PatternMerge.h"
 
 /*
  * Thesis reference:
@@ -66,6 +67,11 @@ enum class ESeamClickState : uint8
 class FPatternSewing
 {
 public:
+    FPatternSewing() = default;
+
+    /** @brief Discards an uncommitted merge preview, so its actor does not outlive the canvas. */
+    ~FPatternSewing();
+
     /** All seam definitions created on the canvas. */
     TArray<FSeamDefinition> SeamDefinitions;
 
@@ -84,6 +90,12 @@ public:
     /** Current preview points for the seam under construction. */
     TMap<int32, TSet<int32>> CurrentSeamPreviewPoints;
 
+    /** Merged pieces waiting for the user to commit them. */
+    FPatternMergePreview MergePreview;
+
+    /** Body mesh merged garments are skinned to; unset means rigid binding. */
+    TWeakObjectPtr<USkeletalMesh> SkinningBodyMesh;
+
     /**
      * @brief Finalises a seam definition using the given targets.
      * 
@@ -115,6 +127,18 @@ public:
      */
     void BuildAndAlignAllSeams();
 
+    /**
+     * @brief Rebuilds the runtime constraint of every seam definition against the current actors.
+     * 
+     * Constraints point at mesh components, which do not survive regenerating the meshes or
+     * reloading an asset, while definitions only use shape and point indices. Seams whose shapes
+     * have no mesh get an unbound constraint so both arrays stay index-aligned.
+     *
+     * @param CompletedShapes All completed shapes currently on the canvas.
+     * @return Number of seams bound to meshes on both sides.
+     */
+    int32 RebindSeamConstraints(const TArray<FInterpCurve<FVector2D>>& CompletedShapes);
+
     /**
      * @brief Clears all seams from the canvas.
      * 
@@ -123,12 +147,20 @@ public:
     void ClearAllSeams();
 
     /**
-     * @brief Merges the pattern meshes based on sewn seams.
+     * @brief Previews merging the pattern meshes based on sewn seams.
      * 
-     * Combines separate pattern pieces into unified meshes where seams allow.
+     * Combines separate pattern pieces into unified meshes where seams allow,
+     * but only in memory; nothing in the scene changes until the merge is committed.
      */
     void MergeSewnPatternPieces();
 
+    /**
+     * @brief Commits the current merge preview.
+     * 
+     * Creates the skeletal assets and actors and retires the merged pieces.
+     */
+    void CommitMergedPatternPieces();
+
     /**
      * @brief Builds sets of sewn points for all defined seams.
      * 
@@ -0,0 +1,71 @@
+#ifndef FPatternSkinning_H
+#define FPatternSkinning_H
+
+#include "CoreMinimal.h"
+#include "DynamicMesh/DynamicMesh3.h"
+
+class USkeletalMesh;
+class USkeletalMeshComponent;
+class UWorld;
+
+/**
+ * @brief Binds merged garments to a body skeleton by surface proximity.
+ *
+ * Each garment vertex takes the bone weights of the closest point on the
+ * body surface, interpolated across the body triangle it lands on. This
+ * gives a garment that follows the character without hand skinning.
+ */
+class FPatternSkinning
+{
+public:
+	/**
+	 * @brief Copies a skeletal mesh, including its skin weights, into a dynamic mesh.
+	 *
+	 * Must run on the game thread, as it reads the skeletal mesh asset.
+	 *
+	 * Bone indices are rewritten from the mesh's reference skeleton to the order of
+	 * its skeleton asset, which is what assets built against that skeleton expect.
+	 *
+	 * @param BodyMesh Body skeletal mesh to sample.
+	 * @param OutBodyMesh Receives the body surface in the asset's reference pose.
+	 * @return True if the body mesh has triangles and skin weights.
+	 */
+	static bool BuildBodySkinMesh(USkeletalMesh* BodyMesh, UE::Geometry::FDynamicMesh3& OutBodyMesh);
+
+	/**
+	 * @brief Transfers bone weights from the closest body surface point to every garment vertex.
+	 *
+	 * The closest points are found through an AABB tree over the body, and
+	 * vertices are processed in parallel. Weights are written to the garment's
+	 * "Default" skin weight profile, replacing any existing one.
+	 *
+	 * @param BodyMesh Body surface with a "Default" skin weight profile.
+	 * @param GarmentToBody Transform from garment vertex space into body space.
+	 * @param Garment Mesh that receives the transferred weights.
+	 * @return True if weights were transferred.
+	 */
+	static bool TransferProximityWeights(
+		const UE::Geometry::FDynamicMesh3& BodyMesh,
+		const FTransform& GarmentToBody,
+		UE::Geometry::FDynamicMesh3& Garment);
+
+	/**
+	 * @brief Rewrites the bone indices of a mesh's "Default" skin weights through a lookup table.
+	 * @param BoneIndexMap New index for each old bone index; INDEX_NONE drops that bone's influence.
+	 * @param Mesh Mesh whose weights are remapped; the remaining weights are renormalised.
+	 */
+	static void RemapBoneIndices(const TArray<int32>& BoneIndexMap, UE::Geometry::FDynamicMesh3& Mesh);
+
+	/**
+	 * @brief Finds a skeletal mesh component in a world that draws the given body.
+	 *
+	 * The body is picked as an asset; its placement in the level decides where garments are bound.
+	 *
+	 * @param World World to search; may be null.
+	 * @param BodyMesh Body asset to look for.
+	 * @return The first component using the body, or null if none does.
+	 */
+	static const USkeletalMeshComponent* FindBodyComponent(UWorld* World, const USkeletalMesh* BodyMesh);
+};
+
+#endif
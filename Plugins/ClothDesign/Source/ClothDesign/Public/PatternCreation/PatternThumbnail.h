@@ -0,0 +1,47 @@
+#ifndef FPatternThumbnail_H
+#define FPatternThumbnail_H
+
+#include "CoreMinimal.h"
+#include "PatternCreation/PatternAssets.h"
+
+class UObject;
+
+
+/**
+ * @brief Draws shape asset thumbnails on the CPU and caches them in the asset's package.
+ *
+ * Shape assets have no thumbnail renderer, so the Content Browser and the canvas's asset
+ * picker fell back to generic tiles and the only way to tell patterns apart was to load
+ * them. Here the pieces are rasterised in software (anti-aliased scanline fill plus outline),
+ * which needs no GPU or render thread and touches no UObjects, so it runs on a worker next
+ * to the rest of a background save. The image is stored as the package's cached thumbnail,
+ * which the editor shows for unloaded assets, so browsing never loads a pattern.
+ */
+class FPatternThumbnail
+{
+public:
+	/** Edge length of generated thumbnails; the editor's cached thumbnail size. */
+	static constexpr int32 DefaultSize = 256;
+
+	/**
+	 * @brief Rasterises the completed shapes at their canvas placement, fitted to the image.
+	 * @param Data Shapes and transforms to draw; the working curve is ignored.
+	 * @param Size Width and height in pixels.
+	 * @param OutPixels Receives Size * Size opaque pixels, rows top to bottom.
+	 */
+	static void Rasterize(const FLoadedShapeData& Data, int32 Size, TArray<FColor>& OutPixels);
+
+	/**
+	 * @brief Stores pixels as the cached thumbnail of an asset's package.
+	 *
+	 * Takes effect in the editor right away and is written with the package on its next save.
+	 * Must run on the game thread.
+	 *
+	 * @param Asset Asset the thumbnail belongs to.
+	 * @param Pixels Size * Size pixels from Rasterize.
+	 * @param Size Width and height in pixels.
+	 */
+	static void CacheInPackage(UObject* Asset, const TArray<FColor>& Pixels, int32 Size);
+};
+
+#endif
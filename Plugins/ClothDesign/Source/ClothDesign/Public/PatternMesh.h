@@ -72,6 +72,26 @@ public:
 	UPROPERTY()
 	TArray<FVector> BoundarySampleWorldPositions;
 
+	/**
+	 * @brief Canvas-space point the mesh vertices are centred on.
+	 *
+	 * DynamicMesh vertices are stored relative to this point, so adding it back gives
+	 * the canvas position a vertex was triangulated at.
+	 */
+	UPROPERTY()
+	FVector2D PatternPivot2D = FVector2D::ZeroVector;
+
+	/**
+	 * @brief Canvas shape this actor was triangulated from; INDEX_NONE for merged actors.
+	 *
+	 * The canvas finds a shape's actor by index, and loads, imports and merges can leave
+	 * another pattern's actor at that index. Mesh writes check this and the generation first.
+	 */
+	int32 SourceShapeIndex = INDEX_NONE;
+
+	/** @brief Canvas pattern generation the actor was built for; see SourceShapeIndex. */
+	uint32 SourcePatternGeneration = 0;
+
 	/**
 	 * @brief Sets the mapping from polygon indices to vertex IDs.
 	 * 
@@ -93,6 +113,30 @@ public:
 	 */
 	UE::Geometry::FDynamicMesh3 DynamicMesh;
 
+	/**
+	 * @brief Serialises the actor and, for package saves and loads, its DynamicMesh.
+	 *
+	 * DynamicMesh is not a UPROPERTY, so without this a reloaded level has pattern actors
+	 * with rendered sections but empty meshes, and sewing fails until regeneration.
+	 * Levels saved before the custom version load as before.
+	 *
+	 * @param Ar Archive to load from or save to.
+	 */
+	virtual void Serialize(FArchive& Ar) override;
+
+	/**
+	 * @brief Reads or writes a dynamic mesh in the compact pattern layout.
+	 *
+	 * Compact meshes without attributes (what triangulation produces) store positions as
+	 * 16-bit offsets within their bounds and triangles as zig-zag varint deltas. Any other
+	 * mesh falls back to the engine's full serialisation so nothing is lost.
+	 *
+	 * @param Ar Archive to load from or save to.
+	 * @param Mesh Mesh to serialise.
+	 * @param bQuantize Store positions as 16-bit offsets instead of floats when saving.
+	 */
+	static void SerializePackedMesh(FArchive& Ar, UE::Geometry::FDynamicMesh3& Mesh, bool bQuantize);
+
 private:
 
 	/** 